@@ -8,6 +8,8 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(solver.pri)
+
 SOURCES += \
     inputparameterspage.cpp \
     interaction.cpp \
@@ -15,7 +17,6 @@ SOURCES += \
     main.cpp \
     mainclass.cpp \
     modeselectionpage.cpp \
-    pipelineoptimizer.cpp \
     resultpage.cpp
 
 HEADERS += \
@@ -24,8 +25,6 @@ HEADERS += \
     loginpage.h \
     mainclass.h \
     modeselectionpage.h \
-    pipelineoptimizer.h \
-    pipelineparameters.h \
     resultpage.h
 
 # Default rules for deployment.
@@ -0,0 +1,978 @@
+#include "clidriver.h"
+#include "continuousoptimizer.h"
+#include "elevationprofile.h"
+#include "parameterfields.h"
+#include "parametersweep.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include "pressurelimit.h"
+#include "reliabilityanalysis.h"
+#include "resultcache.h"
+#include "routeoptimizer.h"
+#include "safetysensitivities.h"
+#include "scenarioreader.h"
+#include "steelgradecatalog.h"
+#include "thermalmodel.h"
+#include "thicknesscatalog.h"
+#include "waterhammer.h"
+#include <QByteArray>
+#include <QFile>
+#include <QScopedPointer>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+bool g_verbose = false;
+
+// Отладочные сообщения расчета выводятся только с --verbose
+void messageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+    if (type == QtDebugMsg && !g_verbose) {
+        return;
+    }
+    std::fprintf(stderr, "%s\n", message.toLocal8Bit().constData());
+}
+
+// messageHandler на время выполнения команды
+class MessageHandlerScope {
+public:
+    explicit MessageHandlerScope(bool verbose)
+        : m_previous(qInstallMessageHandler(messageHandler))
+    {
+        g_verbose = verbose;
+    }
+    ~MessageHandlerScope() { qInstallMessageHandler(m_previous); }
+
+private:
+    QtMessageHandler m_previous;
+};
+
+void printError(QIODevice* errors, const QString& message)
+{
+    errors->write(message.toLocal8Bit());
+    errors->write("\n");
+}
+
+void printUsage(QIODevice* errors)
+{
+    printError(errors,
+               "Использование: curwork-cli [КОМАНДА] [--input jsonl|csv] [--format ndjson|csv] "
+               "[--threads N] [--cache КАТАЛОГ] [--thicknesses sortament|ФАЙЛ] [--verbose] "
+               "[ключи команды] [файл | -]\n"
+               "  calculate [--continuous]             подбор толщины (по умолчанию)\n"
+               "  sweep --axis ПОЛЕ=ОТ:ДО:ШАГ|З1,З2,... развертка по параметрам\n"
+               "  reliability [--samples N] [--seed N] "
+               "[--vary ПОЛЕ=normal|lognormal:СРЕДНЕЕ:СКО|uniform:ОТ:ДО] вероятность отказа\n"
+               "  sensitivities                        производные коэффициентов запаса\n"
+               "  maop                                 наибольшее допустимое давление\n"
+               "  grade --grades ФАЙЛ                  самая дешевая марка стали\n"
+               "  route --route ФАЙЛ [--max-changes N] телескопическая трасса\n"
+               "  profile --profile ФАЙЛ               давление по профилю высот\n"
+               "  waterhammer --length L [--closure-time T] [--duration T] гидроудар\n"
+               "  thermal --inlet-temperature T --route ФАЙЛ [--density-curve ФАЙЛ] "
+               "[--viscosity-curve ФАЙЛ] остывание нефти");
+}
+
+// Команды консольного расчета
+enum class Command {
+    Calculate,
+    Sweep,
+    Reliability,
+    Sensitivities,
+    Maop,
+    Grade,
+    Route,
+    Profile,
+    WaterHammer,
+    Thermal
+};
+
+struct CommandName {
+    const char* name;
+    Command command;
+};
+
+const CommandName kCommands[] = {
+    { "calculate", Command::Calculate },
+    { "sweep", Command::Sweep },
+    { "reliability", Command::Reliability },
+    { "sensitivities", Command::Sensitivities },
+    { "maop", Command::Maop },
+    { "grade", Command::Grade },
+    { "route", Command::Route },
+    { "profile", Command::Profile },
+    { "waterhammer", Command::WaterHammer },
+    { "thermal", Command::Thermal },
+};
+
+// Ось развертки с именем поля для вывода
+struct NamedAxis {
+    QByteArray name;
+    SweepAxis axis;
+};
+
+// Ключи командной строки
+struct CliOptions {
+    Command command = Command::Calculate;
+    bool csv = false;
+    ScenarioReader::Format inputFormat = ScenarioReader::Format::Auto;
+    int threads = 1;
+    QString path;            // Пусто или "-" - input
+    QString cacheDirectory;
+    QString thicknesses;
+    bool continuous = false;
+    bool verbose = false;
+    QVector<NamedAxis> axes;  // sweep
+    ReliabilitySettings reliability;
+    QString grades;           // grade: каталог марок стали
+    QString route;            // route, thermal: участки трассы
+    int maxDiameterChanges = -1;
+    QString profile;          // profile: профиль высот
+    double length = 0.0;      // waterhammer: длина трубы, м
+    double closureTime = 0.0; // waterhammer: время закрытия задвижки, с
+    double duration = 300.0;  // waterhammer: продолжительность расчета, с
+    double inletTemperature = std::numeric_limits<double>::quiet_NaN();  // thermal: T в начале, °C
+    QString densityCurve;     // thermal: ρ(T)
+    QString viscosityCurve;   // thermal: ν(T)
+};
+
+// Числа через separator в [begin, end); false - пустое значение или не число
+bool parseNumberList(const char* begin, const char* end, char separator, QVector<double>& values)
+{
+    values.clear();
+    for (;;) {
+        double value = 0.0;
+        const char* stop = parseNumber(begin, end, value);
+        if (!stop) {
+            return false;
+        }
+        values.append(value);
+        if (stop == end) {
+            return true;
+        }
+        if (*stop != separator) {
+            return false;
+        }
+        begin = stop + 1;
+    }
+}
+
+// Ось развертки "ПОЛЕ=ОТ:ДО:ШАГ" или "ПОЛЕ=З1,З2,..."; false - неизвестное
+// поле или неверные значения
+// Одно число в аргументе; false - пустое значение или не число
+bool parseNumberArgument(const QString& text, double& value)
+{
+    const QByteArray spec = text.toLocal8Bit();
+    QVector<double> values;
+    if (!parseNumberList(spec.constData(), spec.constData() + spec.size(), ',', values) || values.size() != 1) {
+        return false;
+    }
+    value = values[0];
+    return std::isfinite(value);
+}
+
+bool parseAxis(const QString& text, NamedAxis& axis)
+{
+    const QByteArray spec = text.toLocal8Bit();
+    const int equals = spec.indexOf('=');
+    if (equals <= 0) {
+        return false;
+    }
+    axis.name = QByteArray(spec.constData(), equals);
+    double PipelineParameters::*field = SweepAxis::fieldByName(QString::fromLatin1(axis.name));
+    if (!field) {
+        return false;
+    }
+
+    const char* begin = spec.constData() + equals + 1;
+    const char* end = spec.constData() + spec.size();
+    QVector<double> values;
+    try {
+        if (parseNumberList(begin, end, ':', values) && values.size() == 3) {
+            axis.axis = SweepAxis::range(field, values[0], values[1], values[2]);
+        } else if (parseNumberList(begin, end, ',', values)) {
+            axis.axis = SweepAxis::list(field, values);
+        } else {
+            return false;
+        }
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    return true;
+}
+
+// Разбрасываемые параметры вероятностного расчета
+struct RandomVariableName {
+    const char* name;
+    RandomVariable ReliabilitySettings::*variable;
+};
+
+const RandomVariableName kRandomVariables[] = {
+    { "yieldStrength", &ReliabilitySettings::yieldStrength },
+    { "tensileStrength", &ReliabilitySettings::tensileStrength },
+    { "pressure", &ReliabilitySettings::pressure },
+    { "temperatureDelta", &ReliabilitySettings::temperatureDelta },
+};
+
+// Распределение "ПОЛЕ=ВИД:A:B[:СДВИГ]" (normal, lognormal - среднее и СКО,
+// uniform - границы; СДВИГ - importanceShift); false - неизвестное поле или
+// вид, неверные значения
+bool parseRandomVariable(const QString& text, ReliabilitySettings& settings)
+{
+    const QByteArray spec = text.toLocal8Bit();
+    const int equals = spec.indexOf('=');
+    const int colon = spec.indexOf(':', equals + 1);
+    if (equals <= 0 || colon < 0) {
+        return false;
+    }
+    const QByteArray name(spec.constData(), equals);
+    const QByteArray kind(spec.constData() + equals + 1, colon - equals - 1);
+    QVector<double> values;
+    if (!parseNumberList(spec.constData() + colon + 1, spec.constData() + spec.size(), ':', values) ||
+        values.size() < 2 || values.size() > 3) {
+        return false;
+    }
+
+    for (const RandomVariableName& v : kRandomVariables) {
+        if (name != v.name) {
+            continue;
+        }
+        RandomVariable& variable = settings.*v.variable;
+        try {
+            if (kind == "normal") {
+                variable = RandomVariable::normal(values[0], values[1]);
+            } else if (kind == "lognormal") {
+                variable = RandomVariable::logNormal(values[0], values[1]);
+            } else if (kind == "uniform") {
+                variable = RandomVariable::uniform(values[0], values[1]);
+            } else {
+                return false;
+            }
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+        variable.importanceShift = values.size() == 3 ? values[2] : 0.0;
+        return true;
+    }
+    return false;
+}
+
+// Разбор аргументов; false - неизвестный ключ или недопустимое значение
+bool parseArguments(const QStringList& arguments, CliOptions& options)
+{
+    // Первый аргумент - команда, если совпадает с ее именем
+    int i = 0;
+    if (!arguments.isEmpty()) {
+        for (const CommandName& c : kCommands) {
+            if (arguments[0] == QLatin1String(c.name)) {
+                options.command = c.command;
+                i = 1;
+            }
+        }
+    }
+
+    for (; i < arguments.size(); ++i) {
+        const QString& arg = arguments[i];
+        const bool hasValue = i + 1 < arguments.size();
+        if (arg == QLatin1String("--format") && hasValue) {
+            const QString& format = arguments[++i];
+            if (format == QLatin1String("csv")) {
+                options.csv = true;
+            } else if (format != QLatin1String("ndjson")) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--input") && hasValue) {
+            const QString& format = arguments[++i];
+            if (format == QLatin1String("jsonl")) {
+                options.inputFormat = ScenarioReader::Format::JsonLines;
+            } else if (format == QLatin1String("csv")) {
+                options.inputFormat = ScenarioReader::Format::Csv;
+            } else {
+                return false;
+            }
+        } else if (arg == QLatin1String("--threads") && hasValue) {
+            // 0 - по числу ядер; нечисловое или отрицательное значение - ошибка
+            bool ok = false;
+            options.threads = arguments[++i].toInt(&ok);
+            if (!ok || options.threads < 0) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--cache") && hasValue) {
+            options.cacheDirectory = arguments[++i];
+        } else if (arg == QLatin1String("--thicknesses") && hasValue) {
+            options.thicknesses = arguments[++i];
+        } else if (arg == QLatin1String("--continuous") && options.command == Command::Calculate) {
+            options.continuous = true;
+        } else if (arg == QLatin1String("--axis") && hasValue && options.command == Command::Sweep) {
+            NamedAxis axis;
+            if (!parseAxis(arguments[++i], axis)) {
+                return false;
+            }
+            options.axes.append(axis);
+        } else if (arg == QLatin1String("--samples") && hasValue && options.command == Command::Reliability) {
+            bool ok = false;
+            options.reliability.samples = arguments[++i].toLongLong(&ok);
+            if (!ok || options.reliability.samples <= 0) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--seed") && hasValue && options.command == Command::Reliability) {
+            bool ok = false;
+            options.reliability.seed = arguments[++i].toULongLong(&ok);
+            if (!ok) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--vary") && hasValue && options.command == Command::Reliability) {
+            if (!parseRandomVariable(arguments[++i], options.reliability)) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--grades") && hasValue && options.command == Command::Grade) {
+            options.grades = arguments[++i];
+        } else if (arg == QLatin1String("--route") && hasValue &&
+                   (options.command == Command::Route || options.command == Command::Thermal)) {
+            options.route = arguments[++i];
+        } else if (arg == QLatin1String("--max-changes") && hasValue && options.command == Command::Route) {
+            bool ok = false;
+            options.maxDiameterChanges = arguments[++i].toInt(&ok);
+            if (!ok || options.maxDiameterChanges < 0) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--profile") && hasValue && options.command == Command::Profile) {
+            options.profile = arguments[++i];
+        } else if (arg == QLatin1String("--length") && hasValue && options.command == Command::WaterHammer) {
+            if (!parseNumberArgument(arguments[++i], options.length) || !(options.length > 0.0)) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--closure-time") && hasValue && options.command == Command::WaterHammer) {
+            if (!parseNumberArgument(arguments[++i], options.closureTime) || !(options.closureTime >= 0.0)) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--duration") && hasValue && options.command == Command::WaterHammer) {
+            if (!parseNumberArgument(arguments[++i], options.duration) || !(options.duration >= 0.0)) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--inlet-temperature") && hasValue && options.command == Command::Thermal) {
+            if (!parseNumberArgument(arguments[++i], options.inletTemperature)) {
+                return false;
+            }
+        } else if (arg == QLatin1String("--density-curve") && hasValue && options.command == Command::Thermal) {
+            options.densityCurve = arguments[++i];
+        } else if (arg == QLatin1String("--viscosity-curve") && hasValue && options.command == Command::Thermal) {
+            options.viscosityCurve = arguments[++i];
+        } else if (arg == QLatin1String("--verbose")) {
+            options.verbose = true;
+        } else if (arg == QLatin1String("--help") || (arg.startsWith('-') && arg.size() > 1) ||
+                   !options.path.isEmpty()) {
+            return false;
+        } else {
+            options.path = arg;
+        }
+    }
+
+    // Обязательные ключи команд
+    return (options.command != Command::Sweep || !options.axes.isEmpty()) &&
+           (options.command != Command::Grade || !options.grades.isEmpty()) &&
+           (options.command != Command::Route || !options.route.isEmpty()) &&
+           (options.command != Command::Profile || !options.profile.isEmpty()) &&
+           (options.command != Command::WaterHammer || options.length > 0.0) &&
+           (options.command != Command::Thermal ||
+            (!options.route.isEmpty() && std::isfinite(options.inletTemperature)));
+}
+
+// Вывод результатов расчетных модулей: запись из именованных полей в строке
+// NDJSON или CSV. Заголовок CSV пишется по полям первой записи, у всех
+// записей команды поля одни и те же.
+class RecordWriter {
+public:
+    RecordWriter(QIODevice* output, bool csv)
+        : m_output(output)
+        , m_csv(csv)
+        , m_headerWritten(false)
+    {
+    }
+
+    RecordWriter& integer(const char* name, qint64 value)
+    {
+        return append(name, QByteArray::number(value));
+    }
+
+    RecordWriter& number(const char* name, double value)
+    {
+        return append(name, QByteArray::number(value, 'g', 17));
+    }
+
+    RecordWriter& flag(const char* name, bool value)
+    {
+        return append(name, m_csv ? (value ? "1" : "0") : (value ? "true" : "false"));
+    }
+
+    // Строка без разделителей CSV: в JSON - в кавычках, '"' и '\\' экранируются
+    RecordWriter& text(const char* name, const QByteArray& value)
+    {
+        if (m_csv) {
+            return append(name, value);
+        }
+        QByteArray quoted = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return append(name, quoted + '"');
+    }
+
+    // Поля результата одного диаметра, как в resultToJsonLine()
+    RecordWriter& result(const ValidationResult& r)
+    {
+        number("diameter", r.diameter);
+        number("thickness", r.isValid ? r.finalThickness : 0.0);
+        number("flowSpeed", r.flowSpeed);
+        number("safetyHoop", r.safetyHoop);
+        number("safetyAxial", r.safetyAxial);
+        number("safetyEquivalent", r.safetyEquivalent);
+        number("minSafety", std::min({ r.safetyHoop, r.safetyAxial, r.safetyEquivalent }));
+        flag("satisfiesFlowSpeed", r.satisfiesFlowSpeed);
+        flag("satisfiesHoopStress", r.satisfiesHoopStress);
+        flag("satisfiesAxialStress", r.satisfiesAxialStress);
+        flag("satisfiesEquivalentStress", r.satisfiesEquivalentStress);
+        flag("isOptimal", r.isOptimal);
+        return flag("isValid", r.isValid);
+    }
+
+    // Конец записи: вывод строки
+    void write()
+    {
+        if (m_csv) {
+            if (!m_headerWritten) {
+                m_header += '\n';
+                m_output->write(m_header);
+                m_headerWritten = true;
+            }
+            m_line += '\n';
+        } else {
+            m_line += "}\n";
+        }
+        m_output->write(m_line);
+        m_line.clear();
+        m_header.clear();
+    }
+
+private:
+    RecordWriter& append(const char* name, const QByteArray& value)
+    {
+        const bool first = m_line.isEmpty();
+        if (m_csv) {
+            if (!m_headerWritten) {
+                m_header += first ? "" : ",";
+                m_header += name;
+            }
+            m_line += first ? "" : ",";
+        } else {
+            m_line += first ? "{\"" : ",\"";
+            m_line += name;
+            m_line += "\":";
+        }
+        m_line += value;
+        return *this;
+    }
+
+    QIODevice* m_output;
+    bool m_csv;
+    bool m_headerWritten;
+    QByteArray m_header;
+    QByteArray m_line;
+};
+
+// Имена исходов и условий PressureLimit для вывода
+const char* pressureStatusName(PressureLimit::Status status)
+{
+    switch (status) {
+    case PressureLimit::Status::Found:
+        return "found";
+    case PressureLimit::Status::FlowSpeedFailed:
+        return "flowSpeedFailed";
+    case PressureLimit::Status::NotFeasible:
+        return "notFeasible";
+    case PressureLimit::Status::Unbounded:
+        return "unbounded";
+    case PressureLimit::Status::Invalid:
+        break;
+    }
+    return "invalid";
+}
+
+const char* pressureCriterionName(PressureCriterion criterion)
+{
+    switch (criterion) {
+    case PressureCriterion::Hoop:
+        return "hoop";
+    case PressureCriterion::Axial:
+        return "axial";
+    case PressureCriterion::Equivalent:
+        break;
+    }
+    return "equivalent";
+}
+
+// Участки из валидных результатов calculate(): диаметр и найденная толщина
+void designedSections(const QVector<ValidationResult>& results, QVector<PipeSection>& sections)
+{
+    sections.clear();
+    for (const ValidationResult& r : results) {
+        if (r.isValid) {
+            PipeSection s;
+            s.outerDiameter = r.diameter;
+            s.thickness = r.finalThickness;
+            sections.append(s);
+        }
+    }
+}
+
+// Обработка одного сценария: расчет и вывод строк результата. false -
+// сценарий рассчитан с ошибкой (сообщение уже выведено)
+using ScenarioHandler = std::function<bool(qint64 scenario, const PipelineParameters& params)>;
+
+// Чтение и обработка всех сценариев. Ошибка в записи пропускает сценарий,
+// ошибка чтения прерывает расчет. Возвращает код завершения.
+int processScenarios(ScenarioReader& reader, const ScenarioHandler& handler, QIODevice* errors)
+{
+    PipelineParameters params;
+    qint64 scenario = 0;
+    bool failed = false;
+    for (;;) {
+        const qint64 current = scenario;
+        try {
+            if (!reader.next(params)) {
+                break;
+            }
+            ++scenario;
+            if (!handler(current, params)) {
+                failed = true;
+            }
+        } catch (const std::invalid_argument& e) {
+            // Ошибка в записи: сценарий пропускается, чтение продолжается
+            scenario = current + 1;
+            failed = true;
+            printError(errors, QString("Строка %1 (сценарий %2): %3")
+                                   .arg(reader.lineNumber()).arg(current).arg(e.what()));
+        } catch (const std::exception& e) {
+            printError(errors, QString("Строка %1: %2").arg(reader.lineNumber()).arg(e.what()));
+            return 2;
+        }
+    }
+    return failed ? 1 : 0;
+}
+
+} // namespace
+
+int runCommandLine(const QStringList& arguments, QIODevice* input, QIODevice* output,
+                   QIODevice* errors)
+{
+    // === РАЗБОР АРГУМЕНТОВ ===
+
+    CliOptions options;
+    if (!parseArguments(arguments, options)) {
+        printUsage(errors);
+        return 2;
+    }
+    MessageHandlerScope messages(options.verbose);
+
+    // === ОТКРЫТИЕ ВХОДА ===
+
+    QFile file;
+    QIODevice* source = input;
+    if (!options.path.isEmpty() && options.path != QLatin1String("-")) {
+        file.setFileName(options.path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            printError(errors, QString("Не удалось открыть вход: %1").arg(file.errorString()));
+            return 2;
+        }
+        source = &file;
+    }
+
+    // === НАСТРОЙКА РАСЧЕТА ===
+
+    // Параметры и результаты переиспользуются между сценариями, поэтому
+    // память не растет с размером входа
+    PipelineOptimizer optimizer;
+    optimizer.setThreadCount(options.threads);
+    ResultCache cache;
+    if (!options.cacheDirectory.isEmpty()) {
+        if (!cache.openStore(options.cacheDirectory)) {
+            printError(errors, "Дисковый кэш недоступен, используется только кэш в памяти");
+        }
+        optimizer.setCache(&cache);
+    }
+    ThicknessCatalog thicknessCatalog;
+    if (!options.thicknesses.isEmpty()) {
+        try {
+            thicknessCatalog = options.thicknesses == QLatin1String("sortament")
+                                   ? ThicknessCatalog::fromSortament()
+                                   : ThicknessCatalog::fromFile(options.thicknesses);
+        } catch (const std::exception& e) {
+            printError(errors, e.what());
+            return 2;
+        }
+        optimizer.setThicknessCatalog(&thicknessCatalog);
+    }
+    SteelGradeCatalog gradeCatalog;
+    if (!options.grades.isEmpty()) {
+        try {
+            gradeCatalog = SteelGradeCatalog::fromFile(options.grades);
+        } catch (const std::exception& e) {
+            printError(errors, e.what());
+            return 2;
+        }
+    }
+    QVector<RouteSegment> route;
+    QVector<ThermalSegment> thermalRoute;
+    PropertySpline densityCurve;
+    PropertySpline viscosityCurve;
+    try {
+        if (options.command == Command::Route) {
+            route = readRouteSegments(options.route);
+        } else if (options.command == Command::Thermal) {
+            thermalRoute = readThermalSegments(options.route);
+            if (!options.densityCurve.isEmpty()) {
+                densityCurve = PropertySpline::fromFile(options.densityCurve);
+            }
+            if (!options.viscosityCurve.isEmpty()) {
+                viscosityCurve = PropertySpline::fromFile(options.viscosityCurve);
+            }
+        }
+    } catch (const std::exception& e) {
+        printError(errors, e.what());
+        return 2;
+    }
+    QScopedPointer<ElevationProfile> profile;
+    if (!options.profile.isEmpty()) {
+        try {
+            profile.reset(new ElevationProfile(options.profile));
+        } catch (const std::exception& e) {
+            printError(errors, e.what());
+            return 2;
+        }
+    }
+
+    // === РАСЧЕТ СЦЕНАРИЕВ ===
+
+    QVector<ValidationResult> results;
+    QVector<PipeSection> sections;
+    auto writeResults = [&](qint64 scenario) {
+        for (const ValidationResult& r : results) {
+            output->write(options.csv ? resultToCsvLine(scenario, r) : resultToJsonLine(scenario, r));
+        }
+    };
+
+    RecordWriter writer(output, options.csv);
+    ScenarioHandler handler;
+    switch (options.command) {
+    case Command::Calculate:
+        if (options.continuous) {
+            handler = [&](qint64 scenario, const PipelineParameters& params) {
+                ContinuousOptimizer continuousOptimizer(params);
+                continuousOptimizer.setThicknessCatalog(options.thicknesses.isEmpty() ? nullptr
+                                                                                      : &thicknessCatalog);
+                const ContinuousDesign design = continuousOptimizer.run();
+                results.clear();
+                if (design.snapped) {
+                    results.append(design.catalogResult);
+                    writeResults(scenario);
+                    return true;
+                }
+                // Допустимого размера каталога нет - строка с isValid = false
+                ValidationResult invalid{};
+                invalid.diameter = design.diameter;
+                results.append(invalid);
+                writeResults(scenario);
+                printError(errors, QString("Сценарий %1: нет допустимого размера каталога для "
+                                           "непрерывного подбора").arg(scenario));
+                return false;
+            };
+        } else {
+            handler = [&](qint64 scenario, const PipelineParameters& params) {
+                optimizer.calculate(params, results);
+                writeResults(scenario);
+                return true;
+            };
+        }
+        if (options.csv) {
+            output->write(resultCsvHeader());
+        }
+        break;
+
+    case Command::Sweep:
+        // По записи на каждый диаметр каждой точки: значения осей и результат
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            ParameterSweep sweep(params);
+            for (const NamedAxis& a : options.axes) {
+                sweep.addAxis(a.axis);
+            }
+            sweep.setThreadCount(options.threads);
+            sweep.run([&](qint64 point, const PipelineParameters& p, const QVector<ValidationResult>& pointResults) {
+                for (const ValidationResult& r : pointResults) {
+                    writer.integer("scenario", scenario).integer("point", point);
+                    for (const NamedAxis& a : options.axes) {
+                        writer.number(a.name.constData(), p.*a.axis.field);
+                    }
+                    writer.result(r).write();
+                }
+            });
+            return true;
+        };
+        break;
+
+    case Command::Reliability:
+        // По записи на каждый диаметр сценария
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            ReliabilityAnalysis analysis(params, options.reliability);
+            analysis.setThreadCount(options.threads);
+            for (const DiameterReliability& d : analysis.run()) {
+                writer.integer("scenario", scenario)
+                    .number("diameter", d.diameter)
+                    .number("thickness", d.thickness)
+                    .flag("designed", d.designed)
+                    .number("failureProbability", d.failureProbability)
+                    .number("standardError", d.standardError)
+                    .number("flowSpeedFailure", d.flowSpeedFailure)
+                    .number("hoopFailure", d.hoopFailure)
+                    .number("axialFailure", d.axialFailure)
+                    .number("equivalentFailure", d.equivalentFailure)
+                    .write();
+            }
+            return true;
+        };
+        break;
+
+    case Command::Sensitivities: {
+        // По записи на каждый валидный результат calculate(): запасы и их
+        // производные по полям в порядке parameterFields()
+        const char* const safetyNames[] = { "safetyHoop", "safetyAxial", "safetyEquivalent" };
+        QVector<QByteArray> gradientNames;
+        for (const char* safety : safetyNames) {
+            for (const ParameterField& f : parameterFields()) {
+                gradientNames.append(QByteArray(safety) + '.' + f.name);
+            }
+        }
+        handler = [&, safetyNames, gradientNames](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            for (const ValidationResult& r : results) {
+                if (!r.isValid) {
+                    continue;
+                }
+                const SafetySensitivities s = safetySensitivities(params, r.diameter, r.finalThickness);
+                const SafetyGradient* gradients[] = { &s.hoop, &s.axial, &s.equivalent };
+                writer.integer("scenario", scenario)
+                    .number("diameter", r.diameter)
+                    .number("thickness", r.finalThickness)
+                    .flag("isValid", s.isValid);
+                for (int j = 0; j < 3; ++j) {
+                    writer.number(safetyNames[j], gradients[j]->value);
+                    for (int k = 0; k < ParameterFieldCount; ++k) {
+                        writer.number(gradientNames[j * ParameterFieldCount + k].constData(),
+                                      gradients[j]->gradient[k]);
+                    }
+                }
+                writer.write();
+            }
+            return true;
+        };
+        break;
+    }
+
+    case Command::Maop:
+        // По записи на каждый валидный результат calculate(): p_max при
+        // найденной толщине
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            designedSections(results, sections);
+            PressureLimitSolver solver(params);
+            solver.setThreadCount(options.threads);
+            QVector<PressureLimit> limits;
+            solver.solve(sections, limits);
+            for (int i = 0; i < sections.size(); ++i) {
+                const PressureLimit& limit = limits[i];
+                writer.integer("scenario", scenario)
+                    .number("diameter", sections[i].outerDiameter)
+                    .number("thickness", sections[i].thickness)
+                    .text("status", pressureStatusName(limit.status))
+                    .number("pressure", limit.pressure)
+                    .number("surge", limit.surge)
+                    .text("limitingCriterion", pressureCriterionName(limit.limitingCriterion))
+                    .write();
+            }
+            return true;
+        };
+        break;
+
+    case Command::Grade:
+        // По записи на каждый валидный результат calculate(): самая дешевая
+        // марка при найденной толщине (σ_т и σ_п сценария не используются)
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            designedSections(results, sections);
+            QVector<GradeSelection> selections;
+            gradeCatalog.select(params, sections, selections);
+            for (int i = 0; i < sections.size(); ++i) {
+                const GradeSelection& selection = selections[i];
+                const SteelGrade* grade = selection.grade >= 0 ? &gradeCatalog.grades()[selection.grade] : nullptr;
+                writer.integer("scenario", scenario)
+                    .number("diameter", sections[i].outerDiameter)
+                    .number("thickness", sections[i].thickness)
+                    .flag("isValid", selection.isValid)
+                    .flag("satisfiesFlowSpeed", selection.satisfiesFlowSpeed)
+                    .text("grade", grade ? grade->name.toUtf8() : QByteArray())
+                    .number("price", grade ? grade->price : 0.0)
+                    .write();
+            }
+            return true;
+        };
+        break;
+
+    case Command::Route:
+        // По записи на каждый участок трассы: размеры трубы и итог по трассе.
+        // Без допустимых размеров - строки с нулевыми D и δ и сообщение об ошибке
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            RouteOptimizer routeOptimizer(params);
+            routeOptimizer.setThicknessCatalog(options.thicknesses.isEmpty() ? nullptr : &thicknessCatalog);
+            routeOptimizer.setMaxDiameterChanges(options.maxDiameterChanges);
+            routeOptimizer.setThreadCount(options.threads);
+            const RouteDesign design = routeOptimizer.run(route);
+            for (int i = 0; i < route.size(); ++i) {
+                const PipeSection section = design.isFeasible ? design.sections[i] : PipeSection{};
+                writer.integer("scenario", scenario)
+                    .integer("segment", i)
+                    .number("length", route[i].length)
+                    .number("pressure", route[i].pressure)
+                    .number("bendRadius", route[i].bendRadius)
+                    .number("diameter", section.outerDiameter)
+                    .number("thickness", section.thickness)
+                    .flag("feasible", design.isFeasible)
+                    .number("mass", design.mass)
+                    .integer("diameterChanges", design.diameterChanges)
+                    .write();
+            }
+            if (!design.isFeasible) {
+                printError(errors, QString("Сценарий %1: нет допустимых размеров труб для трассы").arg(scenario));
+                return false;
+            }
+            return true;
+        };
+        break;
+
+    case Command::Profile:
+        // По записи на каждый валидный результат calculate(): давление вдоль
+        // профиля и проверка точек, где рельеф поднимает давление
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            designedSections(results, sections);
+            for (const PipeSection& section : sections) {
+                const ProfileAnalysis a = profile->analyze(params, section.outerDiameter, section.thickness);
+                writer.integer("scenario", scenario)
+                    .number("diameter", section.outerDiameter)
+                    .number("thickness", section.thickness)
+                    .integer("points", a.points)
+                    .number("length", a.length)
+                    .number("hydraulicGradient", a.hydraulicGradient)
+                    .number("frictionLoss", a.frictionLoss)
+                    .number("staticHead", a.staticHead)
+                    .number("outletPressure", a.outletPressure)
+                    .number("minPressure", a.minPressure)
+                    .number("minPressureChainage", a.minPressureChainage)
+                    .number("maxPressure", a.maxPressure)
+                    .number("maxPressureChainage", a.maxPressureChainage)
+                    .integer("checkedPoints", a.checkedPoints)
+                    .integer("failedPoints", a.failedPoints)
+                    .number("firstFailureChainage", a.firstFailureChainage)
+                    .flag("passes", a.passes())
+                    .write();
+            }
+            return true;
+        };
+        break;
+
+    case Command::WaterHammer:
+        // По записи на каждый валидный результат calculate(): огибающая
+        // давлений при закрытии задвижки и проверка σ_кц по ней. Трубы, где
+        // установившийся поток невозможен, пропускаются с сообщением об ошибке
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            designedSections(results, sections);
+            WaterHammerSimulator simulator(params);
+            simulator.setValveCurve(WaterHammerSimulator::closureCurve(options.closureTime));
+            simulator.setDuration(options.duration);
+            simulator.setThreadCount(options.threads);
+            bool ok = true;
+            for (const PipeSection& section : sections) {
+                WaterHammerResult r;
+                try {
+                    r = simulator.run(section.outerDiameter, section.thickness, options.length);
+                } catch (const std::invalid_argument& e) {
+                    printError(errors, QString("Сценарий %1, диаметр %2 мм: %3")
+                                           .arg(scenario).arg(section.outerDiameter).arg(e.what()));
+                    ok = false;
+                    continue;
+                }
+                writer.integer("scenario", scenario)
+                    .number("diameter", section.outerDiameter)
+                    .number("thickness", section.thickness)
+                    .number("waveSpeed", r.waveSpeed)
+                    .number("flowSpeed", r.flowSpeed)
+                    .number("joukowskySurge", r.joukowskySurge)
+                    .number("peakPressure", r.peakPressure)
+                    .number("peakChainage", r.peakChainage)
+                    .number("lowestPressure", r.lowestPressure)
+                    .number("lowestChainage", r.lowestChainage)
+                    .number("surge", r.surge)
+                    .number("hoop", r.hoop)
+                    .flag("satisfiesHoopStress", r.satisfiesHoopStress)
+                    .write();
+            }
+            return ok;
+        };
+        break;
+
+    case Command::Thermal:
+        // По записи на каждый валидный результат calculate(): остывание нефти
+        // по трассе и проверка напряжений при местных ρ и Δt
+        handler = [&](qint64 scenario, const PipelineParameters& params) {
+            optimizer.calculate(params, results);
+            designedSections(results, sections);
+            ThermalModel model(params, options.inletTemperature);
+            if (!densityCurve.isEmpty()) {
+                model.setDensityCurve(densityCurve);
+            }
+            if (!viscosityCurve.isEmpty()) {
+                model.setViscosityCurve(viscosityCurve);
+            }
+            model.setRoute(thermalRoute);
+            model.setThreadCount(options.threads);
+            QVector<ThermalProfile> profiles;
+            model.run(sections, profiles);
+            for (int i = 0; i < sections.size(); ++i) {
+                const ThermalProfile& profile = profiles[i];
+                writer.integer("scenario", scenario)
+                    .number("diameter", sections[i].outerDiameter)
+                    .number("thickness", sections[i].thickness)
+                    .number("outletTemperature", profile.outletTemperature)
+                    .number("outletDensity", profile.density.last())
+                    .number("outletTemperatureDelta", profile.temperatureDelta.last())
+                    .number("frictionLoss", profile.frictionLoss)
+                    .integer("failedPoints", profile.failedPoints)
+                    .number("firstFailureChainage", profile.firstFailureChainage)
+                    .flag("passes", profile.passes())
+                    .write();
+            }
+            return true;
+        };
+        break;
+    }
+
+    ScenarioReader reader(source, options.inputFormat);
+    return processScenarios(reader, handler, errors);
+}
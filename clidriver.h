@@ -0,0 +1,115 @@
+#ifndef CLIDRIVER_H
+#define CLIDRIVER_H
+
+#include <QIODevice>
+#include <QStringList>
+
+// Консольный пакетный расчет без GUI (curwork-cli).
+//
+//   curwork-cli [КОМАНДА] [--input jsonl|csv] [--format ndjson|csv] [--threads N]
+//               [--cache КАТАЛОГ] [--thicknesses sortament|ФАЙЛ] [--verbose]
+//               [ключи команды] [файл | -]
+//
+// Вход - JSONL (по объекту параметров на строку) или CSV с заголовком, см.
+// ScenarioReader; по умолчанию формат определяется по первой строке. Файл
+// читается потоково, блоками фиксированного размера. Без файла или с "-"
+// читается input. Сценарии нумеруются с нуля в порядке входа. Ошибки пишутся
+// в errors с номером строки, расчет продолжается со следующего сценария.
+//
+// Первый аргумент, совпадающий с именем команды, выбирает команду:
+//
+//   calculate [--continuous]   (по умолчанию)
+//     Подбор толщины стенки (PipelineOptimizer::calculate()): по строке на
+//     каждый диаметр сценария (диаметр в мм, толщина стенки в м, см.
+//     resultToJsonLine()). С --cache результаты сохраняются в дисковом кэше
+//     (ResultCache) и повторные сценарии не пересчитываются. С --thicknesses
+//     толщина выбирается из сортамента ГОСТ 10704-91 или из каталога толщин в
+//     файле (см. ThicknessCatalog::fromFile()) вместо подбора с шагом 1 мм.
+//     С --continuous список диаметров сценария не используется: D и δ
+//     подбираются непрерывно по минимуму массы (ContinuousOptimizer) и
+//     привязываются к каталогу толщин (по умолчанию - к сортаменту),
+//     выводится одна строка; если допустимого размера каталога нет - строка
+//     с isValid = false (диаметр D*) и сообщение об ошибке.
+//
+//   sweep --axis ПОЛЕ=ОТ:ДО:ШАГ|З1,З2,... [--axis ...]
+//     Декартова развертка сценария по полям PipelineParameters
+//     (ParameterSweep): по записи на каждый диаметр каждой точки с номером
+//     точки, значениями осей и полями результата, как у calculate. Толщина
+//     подбирается с шагом 1 мм, без кэша.
+//
+//   reliability [--samples N] [--seed N] [--vary ПОЛЕ=ВИД:A:B[:СДВИГ] ...]
+//     Вероятность отказа каждого диаметра методом Монте-Карло
+//     (ReliabilityAnalysis), по умолчанию 10⁶ испытаний с seed 0. ПОЛЕ -
+//     yieldStrength, tensileStrength, pressure или temperatureDelta; ВИД -
+//     normal или lognormal (A - среднее, B - СКО) или uniform (A, B -
+//     границы); СДВИГ - сдвиг выборки по значимости (importanceShift).
+//     Неразбрасываемые параметры берутся из сценария.
+//
+//   sensitivities
+//     Коэффициенты запаса каждого валидного результата calculate() и их
+//     производные по скалярным параметрам (safetySensitivities()): поля
+//     safetyHoop, safetyAxial, safetyEquivalent и ЗАПАС.ПОЛЕ = ∂n/∂ПОЛЕ в
+//     порядке parameterFields().
+//
+//   maop
+//     Наибольшее допустимое давление (PressureLimitSolver) каждого валидного
+//     результата calculate() при найденной толщине: status (found,
+//     flowSpeedFailed, notFeasible, unbounded, invalid), pressure - p_max,
+//     МПа, surge - Δp гидроудара, МПа, limitingCriterion (hoop, axial,
+//     equivalent) - условие, нарушаемое выше p_max.
+//
+//   grade --grades ФАЙЛ
+//     Самая дешевая марка стали из каталога в файле (SteelGradeCatalog::fromFile())
+//     для каждого валидного результата calculate() при найденной толщине:
+//     grade - название марки и price - ее цена (пусто и 0, если ни одна
+//     марка не подходит). σ_т и σ_п сценария используются только при
+//     подборе толщины.
+//
+//   route --route ФАЙЛ [--max-changes N]
+//     Телескопическая трасса (RouteOptimizer): участки из файла (см.
+//     readRouteSegments()), давление и радиус изгиба сценария не
+//     используются. По записи на каждый участок: segment - номер, length,
+//     pressure, bendRadius - данные участка, diameter и thickness - размеры
+//     трубы, feasible, mass - масса стали трассы, кг, diameterChanges - смен
+//     диаметра. N - наибольшее число смен диаметра (по умолчанию без
+//     ограничения); каталог - из --thicknesses (по умолчанию сортамент).
+//     Если допустимых размеров нет - строки с нулевыми D и δ и сообщение об
+//     ошибке.
+//
+//   profile --profile ФАЙЛ
+//     Давление вдоль трассы по профилю высот (ElevationProfile, двоичный
+//     файл .bin или CSV) для каждого валидного результата calculate() при
+//     найденной толщине: поля ProfileAnalysis (давления в МПа, пикеты и
+//     длины в м) и passes. Давление сценария - давление в начале трассы;
+//     ошибка в данных профиля или нет вязкости - ошибка сценария.
+//
+//   waterhammer --length L [--closure-time T] [--duration T]
+//     Гидроудар при закрытии задвижки в конце трубы длиной L м
+//     (WaterHammerSimulator) для каждого валидного результата calculate()
+//     при найденной толщине: равномерное закрытие за T с (по умолчанию 0 -
+//     мгновенное), расчет --duration с (по умолчанию 300). Поля waveSpeed,
+//     flowSpeed, joukowskySurge, peakPressure, peakChainage, lowestPressure,
+//     lowestChainage, surge, hoop и satisfiesHoopStress (давления в МПа,
+//     пикеты в м). Трубы, где потери на трение не меньше давления, - с
+//     сообщением об ошибке, без записи.
+//
+//   thermal --inlet-temperature T --route ФАЙЛ [--density-curve ФАЙЛ]
+//           [--viscosity-curve ФАЙЛ]
+//     Остывание подогретой нефти по трассе (ThermalModel) для каждого
+//     валидного результата calculate() при найденной толщине: T - температура
+//     в начале трассы, °C, участки - из файла (см. readThermalSegments()),
+//     ρ(T) и ν(T) - таблицы в файлах (см. PropertySpline::fromFile(); по
+//     умолчанию - постоянные значения сценария). Поля outletTemperature,
+//     outletDensity, outletTemperatureDelta - в конце трассы, frictionLoss,
+//     МПа, failedPoints, firstFailureChainage, м, и passes.
+//
+// Записи команд, кроме calculate, - объекты NDJSON или строки CSV с
+// заголовком по полям записи.
+//
+// arguments - аргументы без имени программы. Возвращает код завершения:
+// 0 - все сценарии рассчитаны, 1 - были ошибки в сценариях, 2 - ошибка
+// аргументов, входа или чтения.
+int runCommandLine(const QStringList& arguments, QIODevice* input, QIODevice* output,
+                   QIODevice* errors);
+
+#endif // CLIDRIVER_H
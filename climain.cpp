@@ -0,0 +1,27 @@
+// Консольный пакетный расчет без GUI: аргументы, stdin, stdout и stderr
+// передаются в runCommandLine() (clidriver.h).
+
+#include "clidriver.h"
+#include <QFile>
+#include <QStringList>
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    // QCoreApplication не создается: расчету не нужен цикл событий
+    QStringList arguments;
+    for (int i = 1; i < argc; ++i) {
+        arguments.append(QString::fromLocal8Bit(argv[i]));
+    }
+
+    QFile input;
+    input.open(stdin, QIODevice::ReadOnly);
+    QFile output;
+    output.open(stdout, QIODevice::WriteOnly);
+    QFile errors;
+    errors.open(stderr, QIODevice::WriteOnly | QIODevice::Unbuffered);
+
+    const int code = runCommandLine(arguments, &input, &output, &errors);
+    output.flush();
+    return code;
+}
@@ -0,0 +1,502 @@
+#include "continuousoptimizer.h"
+#include "materialpolicy.h"
+#include "pipelineformulas.h"
+#include "parameterfields.h"
+#include "pipelineoptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <QDebug>
+
+namespace {
+
+// Переменные оптимизации: x[0] = D, x[1] = δ (обе в мм - одного масштаба)
+using Dual2 = Dual<2>;
+
+const double kMinDiameter = 100.0;   // Границы диаметров, как в calculate(), мм
+const double kMaxDiameter = 1400.0;
+
+// Условия g_i(x) ≤ 0, нормированные к безразмерному виду
+enum Constraint {
+    ConstraintSlowFlow,    // √(1/ϑ) - 1
+    ConstraintFastFlow,    // 1 - √(3/ϑ)
+    ConstraintHoop,        // (σ_кц/R1 - 1)·δ/D
+    ConstraintAxial,       // (σ_0 - max(R2 - ED/(2r), 0))/R2·δ/D, см. axialCondition()
+    ConstraintEquivalent,  // (σ_экв/(0.9σ_т) - 1)·δ/D
+    ConstraintMinDiameter, // 1 - D/100
+    ConstraintMaxDiameter, // D/1400 - 1
+    ConstraintCount
+};
+
+// Значения и градиенты массы и условий в точке x
+struct Point {
+    bool isValid = false;  // Расчет выполнен без геометрических и числовых ошибок
+    double x[2] = {};
+    double f = 0.0;
+    double gradF[2] = {};
+    double g[ConstraintCount] = {};
+    double gradG[ConstraintCount][2] = {};
+
+    // Суммарное нарушение условий Σ max(0, g_i)
+    double violation() const
+    {
+        double sum = 0.0;
+        for (double gi : g) {
+            sum += std::max(gi, 0.0);
+        }
+        return sum;
+    }
+};
+
+// Масса погонного метра, кг/м, при D и δ в мм
+template <class Real>
+Real massPerMetre(const Real& D, const Real& delta)
+{
+    return ContinuousOptimizer::SteelDensity * M_PI * (D - delta) * delta / 1000000.0;
+}
+
+void setValue(double& value, double gradient[2], const Dual2& x)
+{
+    value = x.value;
+    gradient[0] = x.gradient[0];
+    gradient[1] = x.gradient[1];
+}
+
+// Расчет точки с градиентами (напряжения считаются и при недопустимой скорости
+// потока - она входит в условия)
+class PointEvaluator {
+public:
+    explicit PointEvaluator(const PipelineParameters& params)
+        : m_params(params)
+        , m_material(m_params)
+    {
+        designResistance(m_params, m_R1, m_R2, m_allowEquiv);
+    }
+
+    Point evaluate(const double x[2]) const
+    {
+        Point pt;
+        pt.x[0] = x[0];
+        pt.x[1] = x[1];
+
+        const Dual2 D = Dual2::variable(x[0], 0);
+        const Dual2 delta = Dual2::variable(x[1], 1);
+        const BasicThicknessEvaluation<Dual2> ev =
+            evaluateThickness(m_material, m_params, m_R1, m_R2, m_allowEquiv,
+                              D / 1000.0, delta / 1000.0, false);
+        if (ev.outcome == ThicknessOutcome::Aborted) {
+            return pt;
+        }
+
+        pt.isValid = true;
+        setValue(pt.f, pt.gradF, massPerMetre(D, delta));
+
+        // Условия по скорости потока через внутренний диаметр: √(ϑ_0/ϑ) = d/d_0
+        // линейно по D и δ, поэтому линеаризация SQP для них точная
+        setValue(pt.g[ConstraintSlowFlow], pt.gradG[ConstraintSlowFlow], sqrt(kMinFlowSpeed / ev.flowSpeed) - 1.0);
+        setValue(pt.g[ConstraintFastFlow], pt.gradG[ConstraintFastFlow], 1.0 - sqrt(kMaxFlowSpeed / ev.flowSpeed));
+
+        // Условия по напряжениям умножаются на δ/D > 0: σ_кц ∝ D/δ, и
+        // (σ - R)·δ/D почти линейно по δ - иначе шаг по линеаризации 1/δ
+        // сильно промахивается. Знак условий при этом не меняется.
+        const Dual2 wall = delta / D;
+        setValue(pt.g[ConstraintHoop], pt.gradG[ConstraintHoop], (ev.hoop / m_R1 - 1.0) * wall);
+        setValue(pt.g[ConstraintAxial], pt.gradG[ConstraintAxial], axialCondition(D, ev.hoop) * wall);
+        setValue(pt.g[ConstraintEquivalent], pt.gradG[ConstraintEquivalent],
+                 (ev.equiv / m_allowEquiv - 1.0) * wall);
+        setValue(pt.g[ConstraintMinDiameter], pt.gradG[ConstraintMinDiameter],
+                 1.0 - D / kMinDiameter);
+        setValue(pt.g[ConstraintMaxDiameter], pt.gradG[ConstraintMaxDiameter],
+                 D / kMaxDiameter - 1.0);
+        return pt;
+    }
+
+private:
+    // Условие σ_пр ≤ R2 в непрерывном виде. По формуле 14 знак изгибного
+    // слагаемого совпадает со знаком σ_0 = μσ_кц - EαΔt, поэтому σ_пр скачком
+    // меняет знак при σ_0 = 0. Условие выполнено, если σ_0 < 0 или
+    // σ_0 + ED/(2r) ≤ R2, т. е. при σ_0 ≤ max(R2 - ED/(2r), 0) - эта граница
+    // непрерывна, в отличие от самого σ_пр.
+    Dual2 axialCondition(const Dual2& D, const Dual2& hoop) const
+    {
+        const Dual2 base = m_material.poissonRatio() * hoop + m_material.thermalTerm();
+        Dual2 limit = m_R2;
+        if (m_material.bendRadius() > 0) {
+            limit -= (m_material.steelYoungModulus() * D / 1000.0) / (2.0 * m_material.bendRadius());
+            if (limit < 0.0) {
+                limit = Dual2(0.0);
+            }
+        }
+        return (base - limit) / m_R2;
+    }
+
+    BasicScalarParameters<Dual2> m_params;
+    BasicRuntimeMaterial<Dual2> m_material;
+    Dual2 m_R1;
+    Dual2 m_R2;
+    Dual2 m_allowEquiv;
+};
+
+// === КВАДРАТИЧНАЯ ПОДЗАДАЧА ===
+
+// Линейное ограничение a·p ≤ b
+struct LinearConstraint {
+    double a[2];
+    double b;
+};
+
+// Решение 2×2 системы M·z = r; false - матрица вырождена
+bool solve2(const double M[2][2], const double r[2], double z[2])
+{
+    const double det = M[0][0] * M[1][1] - M[0][1] * M[1][0];
+    const double scale = std::abs(M[0][0] * M[1][1]) + std::abs(M[0][1] * M[1][0]);
+    if (!(std::abs(det) > 1e-14 * scale)) {
+        return false;
+    }
+    z[0] = (r[0] * M[1][1] - M[0][1] * r[1]) / det;
+    z[1] = (M[0][0] * r[1] - M[1][0] * r[0]) / det;
+    return true;
+}
+
+// Минимум q(p) = c·p + ½pᵀBp при rows[i].a·p ≤ rows[i].b (B положительно
+// определена). В двумерной задаче в решении активно не больше двух линейно
+// независимых ограничений, поэтому активные наборы перебираются полностью:
+// из точек Каруша-Куна-Таккера (допустимых, с неотрицательными множителями)
+// берется точка с наименьшим q. multipliers - множители ограничений.
+// false - ограничения несовместны.
+bool solveQuadratic(const double B[2][2], const double c[2], const QVector<LinearConstraint>& rows,
+                    double p[2], QVector<double>& multipliers)
+{
+    const int n = rows.size();
+    const double tolerance = 1e-10;
+    double bestValue = std::numeric_limits<double>::infinity();
+    bool found = false;
+
+    auto consider = [&](const double candidate[2], int i, double mi, int j, double mj) {
+        if (mi < -tolerance || mj < -tolerance) {
+            return;
+        }
+        for (const LinearConstraint& row : rows) {
+            const double lhs = row.a[0] * candidate[0] + row.a[1] * candidate[1];
+            if (lhs > row.b + tolerance * (1.0 + std::abs(row.b))) {
+                return;
+            }
+        }
+        const double value = c[0] * candidate[0] + c[1] * candidate[1] +
+                             0.5 * (candidate[0] * (B[0][0] * candidate[0] + B[0][1] * candidate[1]) +
+                                    candidate[1] * (B[1][0] * candidate[0] + B[1][1] * candidate[1]));
+        if (value < bestValue) {
+            bestValue = value;
+            found = true;
+            p[0] = candidate[0];
+            p[1] = candidate[1];
+            multipliers.fill(0.0, n);
+            if (i >= 0) {
+                multipliers[i] = std::max(mi, 0.0);
+            }
+            if (j >= 0) {
+                multipliers[j] = std::max(mj, 0.0);
+            }
+        }
+    };
+
+    // Без активных ограничений: B·p = -c
+    const double minusC[2] = {-c[0], -c[1]};
+    double candidate[2];
+    if (solve2(B, minusC, candidate)) {
+        consider(candidate, -1, 0.0, -1, 0.0);
+    }
+
+    // Одно активное ограничение: B·p + μa = -c, a·p = b
+    double Binv[2][2];
+    const double det = B[0][0] * B[1][1] - B[0][1] * B[1][0];
+    Binv[0][0] = B[1][1] / det;
+    Binv[0][1] = -B[0][1] / det;
+    Binv[1][0] = -B[1][0] / det;
+    Binv[1][1] = B[0][0] / det;
+    for (int i = 0; i < n; ++i) {
+        const double* a = rows[i].a;
+        const double Ba[2] = {Binv[0][0] * a[0] + Binv[0][1] * a[1], Binv[1][0] * a[0] + Binv[1][1] * a[1]};
+        const double Bc[2] = {Binv[0][0] * c[0] + Binv[0][1] * c[1], Binv[1][0] * c[0] + Binv[1][1] * c[1]};
+        const double aBa = a[0] * Ba[0] + a[1] * Ba[1];
+        if (!(aBa > 0.0)) {
+            continue;
+        }
+        const double mu = -(rows[i].b + a[0] * Bc[0] + a[1] * Bc[1]) / aBa;
+        candidate[0] = -Bc[0] - mu * Ba[0];
+        candidate[1] = -Bc[1] - mu * Ba[1];
+        consider(candidate, i, mu, -1, 0.0);
+    }
+
+    // Два активных ограничения: p - решение a_i·p = b_i, a_j·p = b_j,
+    // множители - из B·p + c + μ_i·a_i + μ_j·a_j = 0
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            const double A[2][2] = {{rows[i].a[0], rows[i].a[1]}, {rows[j].a[0], rows[j].a[1]}};
+            const double b[2] = {rows[i].b, rows[j].b};
+            if (!solve2(A, b, candidate)) {
+                continue;
+            }
+            const double At[2][2] = {{A[0][0], A[1][0]}, {A[0][1], A[1][1]}};
+            const double r[2] = {-(B[0][0] * candidate[0] + B[0][1] * candidate[1] + c[0]),
+                                 -(B[1][0] * candidate[0] + B[1][1] * candidate[1] + c[1])};
+            double mu[2];
+            if (solve2(At, r, mu)) {
+                consider(candidate, i, mu[0], j, mu[1]);
+            }
+        }
+    }
+    return found;
+}
+
+// ∇L = ∇f + Σ λ_i ∇g_i
+void lagrangianGradient(const Point& pt, const QVector<double>& lambda, double gradient[2])
+{
+    gradient[0] = pt.gradF[0];
+    gradient[1] = pt.gradF[1];
+    for (int i = 0; i < ConstraintCount; ++i) {
+        gradient[0] += lambda[i] * pt.gradG[i][0];
+        gradient[1] += lambda[i] * pt.gradG[i][1];
+    }
+}
+
+// Обновление BFGS с демпфированием Пауэлла: B остается положительно
+// определенной, хотя гессиан функции Лагранжа (масса - билинейная функция
+// D и δ) знаконеопределен
+void updateHessian(double B[2][2], const double s[2], double y[2])
+{
+    const double Bs[2] = {B[0][0] * s[0] + B[0][1] * s[1], B[1][0] * s[0] + B[1][1] * s[1]};
+    const double sBs = s[0] * Bs[0] + s[1] * Bs[1];
+    if (!(sBs > 0.0)) {
+        return;
+    }
+    double sy = s[0] * y[0] + s[1] * y[1];
+    if (sy < 0.2 * sBs) {
+        const double theta = 0.8 * sBs / (sBs - sy);
+        y[0] = theta * y[0] + (1.0 - theta) * Bs[0];
+        y[1] = theta * y[1] + (1.0 - theta) * Bs[1];
+        sy = s[0] * y[0] + s[1] * y[1];
+    }
+    for (int r = 0; r < 2; ++r) {
+        for (int c = 0; c < 2; ++c) {
+            B[r][c] += y[r] * y[c] / sy - Bs[r] * Bs[c] / sBs;
+        }
+    }
+}
+
+// Штрафная функция L1: φ = m + ν·Σ max(0, g_i); для некорректной точки - ∞
+double merit(const Point& pt, double penalty)
+{
+    return pt.isValid ? pt.f + penalty * pt.violation() : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+ContinuousOptimizer::ContinuousOptimizer(const PipelineParameters& params)
+    : m_params(params)
+    , m_thicknessCatalog(nullptr)
+    , m_tolerance(1e-9)
+    , m_maxIterations(100)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (!std::isfinite(params.*f.field)) {
+            throw std::invalid_argument(
+                QString("Поле \"%1\" не является конечным числом.").arg(f.name).toStdString());
+        }
+    }
+    if (params.massFlow <= 0 || params.density <= 0) {
+        throw std::invalid_argument("Массовый расход и плотность должны быть положительными.");
+    }
+    const DesignResistance resistance = DesignResistance::fromParameters(params);
+    if (!(resistance.R1 > 0.0 && resistance.R2 > 0.0 && resistance.allowEquiv > 0.0)) {
+        throw std::invalid_argument("Расчетные сопротивления стали должны быть положительными.");
+    }
+}
+
+double ContinuousOptimizer::steelMass(double outerDiameter, double thickness)
+{
+    return massPerMetre(outerDiameter, thickness * 1000.0);
+}
+
+ContinuousDesign ContinuousOptimizer::run() const
+{
+    ContinuousDesign design;
+    const PointEvaluator evaluator(m_params);
+    const DesignResistance resistance = DesignResistance::fromParameters(m_params);
+
+    // === НАЧАЛЬНАЯ ТОЧКА ===
+
+    // Середина окна скорости потока (ϑ = 2 м/с) и δ_0 по формуле 9 с запасом
+    const double yp = m_params.pressureReliability * m_params.pressure;
+    const double inner = 1000.0 * std::sqrt((4.0 * m_params.massFlow) / (2.0 * m_params.density * M_PI));
+    double x[2];
+    x[1] = std::max(1.5 * yp * inner / (2.0 * std::min(resistance.R1, resistance.R2) - 2.0 * yp), 0.5);
+    if (!std::isfinite(x[1]) || x[1] <= 0.0) {
+        x[1] = 0.05 * inner;
+    }
+    x[0] = std::min(std::max(inner + 2.0 * x[1], kMinDiameter), kMaxDiameter);
+
+    Point pt = evaluator.evaluate(x);
+    ++design.evaluations;
+    if (!pt.isValid) {
+        return design;
+    }
+
+    // === ИТЕРАЦИИ SQP ===
+
+    // Начальный гессиан - масштаб кривизны массы ρ_ст·π (кг/м на мм²)
+    const double curvature = SteelDensity * M_PI / 1000000.0;
+    double B[2][2] = {{curvature, 0.0}, {0.0, curvature}};
+    double penalty = 0.0;
+    double bestViolation = pt.violation();
+    int stalled = 0;  // Итераций подряд с ослаблением условий без уменьшения нарушения
+    QVector<LinearConstraint> rows;
+    QVector<double> multipliers;
+    QVector<double> lambda(ConstraintCount, 0.0);
+
+    for (int iteration = 0; iteration < m_maxIterations; ++iteration) {
+        design.iterations = iteration + 1;
+
+        // Линеаризация условий g_i + ∇g_i·p ≤ 0 и ограничение длины шага
+        // (|ΔD|, Δδ ≤ D/4; Δδ ≥ -δ/2 - толщина остается положительной).
+        // Если линеаризованные условия несовместны, нарушенные условия
+        // ослабляются: g_i + ∇g_i·p ≤ (1 - τ)·g_i, τ = 1, 1/2, ..., 2⁻⁹ (при
+        // τ = 0 допустим p = 0 - это признак несовместных условий).
+        double p[2] = {0.0, 0.0};
+        double relaxation = 1.0;
+        bool solved = false;
+        for (int attempt = 0; attempt <= 10 && !solved; ++attempt) {
+            relaxation = attempt < 10 ? 1.0 / (1 << attempt) : 0.0;
+            rows.clear();
+            auto addRow = [&rows](double a0, double a1, double b) {
+                const LinearConstraint row = {{a0, a1}, b};
+                rows.append(row);
+            };
+            for (int i = 0; i < ConstraintCount; ++i) {
+                const double slack = pt.g[i] > 0.0 ? (1.0 - relaxation) * pt.g[i] : 0.0;
+                addRow(pt.gradG[i][0], pt.gradG[i][1], slack - pt.g[i]);
+            }
+            const double radius = 0.25 * pt.x[0];
+            addRow(1.0, 0.0, radius);
+            addRow(-1.0, 0.0, radius);
+            addRow(0.0, 1.0, radius);
+            addRow(0.0, -1.0, 0.5 * pt.x[1]);
+            solved = solveQuadratic(B, pt.gradF, rows, p, multipliers);
+        }
+        if (!solved || relaxation == 0.0) {
+            break; // Линеаризованные условия не уменьшают нарушение - условия несовместны
+        }
+        for (int i = 0; i < ConstraintCount; ++i) {
+            lambda[i] = multipliers[i];
+        }
+
+        // Шаг в пределах точности: оптимум, если условия выполнены, иначе
+        // условия несовместны (нарушение дальше не уменьшается)
+        const double violation = pt.violation();
+        if (std::abs(p[0]) <= m_tolerance * pt.x[0] && std::abs(p[1]) <= m_tolerance * pt.x[1]) {
+            design.converged = violation <= m_tolerance;
+            break;
+        }
+        if (relaxation < 1.0) {
+            stalled = violation < 0.9 * bestViolation ? 0 : stalled + 1;
+            bestViolation = std::min(bestViolation, violation);
+            if (stalled >= 5) {
+                break; // Нарушение не уменьшается - условия, по-видимому, несовместны
+            }
+        }
+
+        // Штраф ν больше множителей Лагранжа - тогда шаг SQP убывает φ
+        for (double l : lambda) {
+            penalty = std::max(penalty, 2.0 * l);
+        }
+
+        // Поиск вдоль p с уменьшением шага вдвое (условие Армихо для φ)
+        const double slope = pt.gradF[0] * p[0] + pt.gradF[1] * p[1] - penalty * relaxation * violation;
+        const double current = merit(pt, penalty);
+        double step = 1.0;
+        Point next;
+        bool accepted = false;
+        for (int halving = 0; halving < 20; ++halving) {
+            const double trial[2] = {pt.x[0] + step * p[0], pt.x[1] + step * p[1]};
+            next = evaluator.evaluate(trial);
+            ++design.evaluations;
+            if (merit(next, penalty) <= current + 1e-4 * step * std::min(slope, 0.0)) {
+                accepted = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        if (!accepted) {
+            break;
+        }
+
+        // Обновление гессиана функции Лагранжа по изменению ∇L при тех же λ
+        double gradientBefore[2];
+        double gradientAfter[2];
+        lagrangianGradient(pt, lambda, gradientBefore);
+        lagrangianGradient(next, lambda, gradientAfter);
+        const double s[2] = {next.x[0] - pt.x[0], next.x[1] - pt.x[1]};
+        double y[2] = {gradientAfter[0] - gradientBefore[0], gradientAfter[1] - gradientBefore[1]};
+        updateHessian(B, s, y);
+        pt = next;
+    }
+
+    design.diameter = pt.x[0];
+    design.thickness = pt.x[1] / 1000.0;
+    design.mass = pt.f;
+
+    // === ПРИВЯЗКА К КАТАЛОГУ ===
+
+    // Толщина диаметра D, как в calculate() с этим каталогом
+    const ThicknessCatalog& catalog = m_thicknessCatalog ? *m_thicknessCatalog : ThicknessCatalog::sortament();
+    auto passingSize = [&](double D, ValidationResult& res) {
+        ThicknessCheck check;
+        const double delta = PipelineOptimizer::catalogThickness(m_params, resistance, catalog, D, &check,
+                                                                 &design.snapEvaluations);
+        if (delta == 0.0) {
+            return false;
+        }
+        res.diameter = D;
+        res.finalThickness = delta;
+        res.flowSpeed = check.flowSpeed;
+        res.satisfiesFlowSpeed = true;
+        res.satisfiesHoopStress = true;
+        res.satisfiesAxialStress = true;
+        res.satisfiesEquivalentStress = true;
+        res.safetyHoop = (check.hoop > 0.0) ? resistance.R1 / check.hoop : 0.0;
+        res.safetyAxial = (check.axial > 0.0) ? resistance.R2 / check.axial : 0.0;
+        res.safetyEquivalent = (check.equivalent > 0.0) ? resistance.allowEquiv / check.equivalent : 0.0;
+        res.isOptimal = true;
+        res.isValid = true;
+        return true;
+    };
+
+    // Ближайший допустимый диаметр не больше D* и ближайший больше D*; из двух
+    // берется более легкий (при равной массе - меньший)
+    const QVector<double>& diameters = catalog.diameters();
+    const int split = int(std::upper_bound(diameters.begin(), diameters.end(), design.diameter) - diameters.begin());
+    ValidationResult below{};
+    ValidationResult above{};
+    bool hasBelow = false;
+    bool hasAbove = false;
+    for (int i = split - 1; i >= 0 && !hasBelow; --i) {
+        hasBelow = passingSize(diameters[i], below);
+    }
+    for (int i = split; i < diameters.size() && !hasAbove; ++i) {
+        hasAbove = passingSize(diameters[i], above);
+    }
+    if (hasBelow || hasAbove) {
+        const double belowMass = hasBelow ? steelMass(below.diameter, below.finalThickness) : 0.0;
+        const double aboveMass = hasAbove ? steelMass(above.diameter, above.finalThickness) : 0.0;
+        const bool useBelow = hasBelow && (!hasAbove || belowMass <= aboveMass);
+        design.catalogResult = useBelow ? below : above;
+        design.catalogMass = useBelow ? belowMass : aboveMass;
+        design.snapped = true;
+    }
+
+    qDebug() << "Непрерывная оптимизация: D* =" << design.diameter << "мм, δ* =" << design.thickness
+             << "м, масса" << design.mass << "кг/м, итераций" << design.iterations
+             << ", расчетов" << design.evaluations << "+" << design.snapEvaluations;
+    return design;
+}
@@ -0,0 +1,77 @@
+#ifndef CONTINUOUSOPTIMIZER_H
+#define CONTINUOUSOPTIMIZER_H
+
+#include "pipelineparameters.h"
+#include "thicknesscatalog.h"
+
+// Результат непрерывной оптимизации
+struct ContinuousDesign {
+    bool converged = false;  // Выполнены условия оптимальности с заданной точностью
+    int iterations = 0;      // Итераций SQP
+    int evaluations = 0;     // Расчетов напряжений с производными при поиске D*, δ*
+    int snapEvaluations = 0; // Проверок толщин каталога при привязке
+
+    double diameter = 0.0;   // D*, мм
+    double thickness = 0.0;  // δ*, м
+    double mass = 0.0;       // Масса погонного метра трубы D* × δ*, кг/м
+
+    // Более легкий из ближайших к D* снизу и сверху допустимых размеров
+    // каталога (diameter в мм, finalThickness в м, как в
+    // PipelineOptimizer::calculate())
+    bool snapped = false;
+    ValidationResult catalogResult{};
+    double catalogMass = 0.0;  // кг/м
+};
+
+// Непрерывный подбор диаметра и толщины стенки минимальной массы.
+//
+// В отличие от PipelineOptimizer, который перебирает заданные диаметры и
+// толщины с шагом 1 мм (или из каталога), здесь D и δ - непрерывные
+// переменные: минимизируется масса погонного метра
+//     m = ρ_ст·π·(D - δ)·δ
+// при условиях 1 ≤ ϑ ≤ 3 м/с, σ_кц ≤ R1, σ_пр ≤ R2, σ_экв ≤ 0.9σ_т и
+// 100 ≤ D ≤ 1400 мм. Задача решается методом последовательного квадратичного
+// программирования (SQP): градиенты условий - точные, по тем же формулам с
+// дуальными числами (pipelineformulas.h), гессиан функции Лагранжа -
+// квазиньютоновский (BFGS), шаг принимается по штрафной функции L1. Обычно
+// хватает десятка-другого расчетов вместо тысяч при переборе по сетке.
+// С упругим изгибом (r > 0) σ_пр по формуле 14 меняется скачком, и условия
+// становятся только кусочно-гладкими - тогда найденный оптимум локальный.
+//
+// Найденный оптимум затем привязывается к каталогу: с каждой стороны от D*
+// ищется ближайший диаметр, у которого есть толщина с выполнением всех
+// условий (толщина - как в calculate() с этим каталогом, см.
+// PipelineOptimizer::catalogThickness()), и из двух размеров выбирается
+// более легкий.
+class ContinuousOptimizer {
+public:
+    // Плотность стали, кг/м³
+    static constexpr double SteelDensity = 7850.0;
+
+    // Проверка параметров: нечисловые значения, G ≤ 0, ρ ≤ 0 или
+    // неположительные расчетные сопротивления - std::invalid_argument.
+    // Список диаметров параметров не используется.
+    explicit ContinuousOptimizer(const PipelineParameters& params);
+
+    // Каталог для привязки оптимума (не принадлежит оптимизатору; nullptr -
+    // сортамент ГОСТ 10704-91 в диапазоне 100-1400 мм, по умолчанию)
+    void setThicknessCatalog(const ThicknessCatalog* catalog) { m_thicknessCatalog = catalog; }
+
+    // Относительная точность по D и δ (по умолчанию 1e-9) и предел итераций
+    void setTolerance(double tolerance) { m_tolerance = tolerance; }
+    void setMaxIterations(int count) { m_maxIterations = count; }
+
+    ContinuousDesign run() const;
+
+    // Масса погонного метра трубы с наружным диаметром outerDiameter (мм) и
+    // толщиной стенки thickness (м), кг/м
+    static double steelMass(double outerDiameter, double thickness);
+
+private:
+    PipelineParameters m_params;
+    const ThicknessCatalog* m_thicknessCatalog;
+    double m_tolerance;
+    int m_maxIterations;
+};
+
+#endif // CONTINUOUSOPTIMIZER_H
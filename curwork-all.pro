@@ -0,0 +1,12 @@
+# Сборка приложения, консольного расчета и тестов одной командой:
+#   qmake curwork-all.pro && make && make check
+# Приложение и консольный расчет лежат в одном каталоге, поэтому указаны файлами
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    gui \
+    cli \
+    tests
+
+gui.file = CurWork.pro
+cli.file = curwork-cli.pro
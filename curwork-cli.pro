@@ -0,0 +1,27 @@
+# Консольный пакетный расчет: только QtCore, без QApplication и виджетов
+QT = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = curwork-cli
+
+# Собирается в одном каталоге с CurWork.pro (curwork-all.pro): объектные
+# файлы отдельно, чтобы проекты не перезаписывали их друг у друга
+CONFIG(debug, debug|release): OBJECTS_DIR = debug/cli
+else: OBJECTS_DIR = release/cli
+
+include(solver.pri)
+include(engines.pri)
+
+SOURCES += \
+    clidriver.cpp \
+    climain.cpp
+
+HEADERS += \
+    clidriver.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,147 @@
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+
+// Дуальное число для прямого автоматического дифференцирования: значение и
+// производные по N независимым переменным.
+//
+// Расчетные формулы, записанные через шаблонный тип, с Dual<N> вместо double
+// за один проход дают и значения, и градиенты по всем N переменным - вместо
+// N + 1 расчетов с конечными разностями. Производные точные (до округления),
+// без подбора шага. Сравнения выполняются по значению, поэтому ветвления
+// (проверки условий, выбор знака в формуле 14) идут так же, как для double.
+template <int N>
+class Dual {
+public:
+    double value;
+    double gradient[N];
+
+    // Константа (нулевой градиент)
+    Dual(double v = 0.0)
+        : value(v)
+    {
+        for (int i = 0; i < N; ++i) {
+            gradient[i] = 0.0;
+        }
+    }
+
+    // Независимая переменная с номером index (∂x/∂x_index = 1)
+    static Dual variable(double v, int index)
+    {
+        Dual x(v);
+        x.gradient[index] = 1.0;
+        return x;
+    }
+
+    Dual& operator+=(const Dual& b)
+    {
+        value += b.value;
+        for (int i = 0; i < N; ++i) {
+            gradient[i] += b.gradient[i];
+        }
+        return *this;
+    }
+
+    Dual& operator-=(const Dual& b)
+    {
+        value -= b.value;
+        for (int i = 0; i < N; ++i) {
+            gradient[i] -= b.gradient[i];
+        }
+        return *this;
+    }
+
+    // (ab)' = a'b + ab'
+    Dual& operator*=(const Dual& b)
+    {
+        for (int i = 0; i < N; ++i) {
+            gradient[i] = gradient[i] * b.value + value * b.gradient[i];
+        }
+        value *= b.value;
+        return *this;
+    }
+
+    // (a/b)' = (a' - (a/b)b') / b
+    Dual& operator/=(const Dual& b)
+    {
+        value /= b.value;
+        for (int i = 0; i < N; ++i) {
+            gradient[i] = (gradient[i] - value * b.gradient[i]) / b.value;
+        }
+        return *this;
+    }
+};
+
+template <int N> inline Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template <int N> inline Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template <int N> inline Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template <int N> inline Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+
+template <int N> inline Dual<N> operator+(Dual<N> a, double b) { return a += Dual<N>(b); }
+template <int N> inline Dual<N> operator-(Dual<N> a, double b) { return a -= Dual<N>(b); }
+template <int N> inline Dual<N> operator*(Dual<N> a, double b) { return a *= Dual<N>(b); }
+template <int N> inline Dual<N> operator/(Dual<N> a, double b) { return a /= Dual<N>(b); }
+template <int N> inline Dual<N> operator+(double a, const Dual<N>& b) { return Dual<N>(a) += b; }
+template <int N> inline Dual<N> operator-(double a, const Dual<N>& b) { return Dual<N>(a) -= b; }
+template <int N> inline Dual<N> operator*(double a, const Dual<N>& b) { return Dual<N>(a) *= b; }
+template <int N> inline Dual<N> operator/(double a, const Dual<N>& b) { return Dual<N>(a) /= b; }
+
+template <int N>
+inline Dual<N> operator-(const Dual<N>& a)
+{
+    return Dual<N>(0.0) -= a;
+}
+
+// √a' = a' / (2√a)
+template <int N>
+inline Dual<N> sqrt(const Dual<N>& a)
+{
+    Dual<N> r(std::sqrt(a.value));
+    for (int i = 0; i < N; ++i) {
+        r.gradient[i] = a.gradient[i] / (2.0 * r.value);
+    }
+    return r;
+}
+
+template <int N>
+inline Dual<N> abs(const Dual<N>& a)
+{
+    return a.value < 0.0 ? -a : a;
+}
+
+// Сравнения - по значению
+template <int N> inline bool operator<(const Dual<N>& a, const Dual<N>& b) { return a.value < b.value; }
+template <int N> inline bool operator<=(const Dual<N>& a, const Dual<N>& b) { return a.value <= b.value; }
+template <int N> inline bool operator>(const Dual<N>& a, const Dual<N>& b) { return a.value > b.value; }
+template <int N> inline bool operator>=(const Dual<N>& a, const Dual<N>& b) { return a.value >= b.value; }
+template <int N> inline bool operator<(const Dual<N>& a, double b) { return a.value < b; }
+template <int N> inline bool operator<=(const Dual<N>& a, double b) { return a.value <= b; }
+template <int N> inline bool operator>(const Dual<N>& a, double b) { return a.value > b; }
+template <int N> inline bool operator>=(const Dual<N>& a, double b) { return a.value >= b; }
+
+// NaN или бесконечность в значении (для double - то же, что isnan || isinf)
+inline bool isNotFinite(double x)
+{
+    return std::isnan(x) || std::isinf(x);
+}
+
+template <int N>
+inline bool isNotFinite(const Dual<N>& x)
+{
+    return isNotFinite(x.value);
+}
+
+// Значение без производных
+inline double valueOf(double x)
+{
+    return x;
+}
+
+template <int N>
+inline double valueOf(const Dual<N>& x)
+{
+    return x.value;
+}
+
+#endif // DUALNUMBER_H
@@ -0,0 +1,213 @@
+#include "elevationprofile.h"
+#include "frictionloss.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include <QFileInfo>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Ускорение свободного падения, м/с²
+const double kGravity = 9.81;
+
+// Последовательное чтение двоичного профиля
+class BinaryCursor {
+public:
+    BinaryCursor(const uchar* data, qint64 size)
+        : m_p(data)
+        , m_end(data + size)
+    {
+    }
+
+    bool next(double& chainage, double& elevation)
+    {
+        if (m_end - m_p < 16) {
+            return false;
+        }
+        const quint64 x = qFromLittleEndian<quint64>(m_p);
+        const quint64 z = qFromLittleEndian<quint64>(m_p + 8);
+        std::memcpy(&chainage, &x, sizeof(double));
+        std::memcpy(&elevation, &z, sizeof(double));
+        m_p += 16;
+        ++m_point;
+        return true;
+    }
+
+    QString position() const { return QString("точка %1").arg(m_point); }
+
+private:
+    const uchar* m_p;
+    const uchar* m_end;
+    qint64 m_point = 0;
+};
+
+// Последовательное чтение профиля CSV прямо из отображенного файла
+class CsvCursor {
+public:
+    CsvCursor(const uchar* data, qint64 size)
+        : m_table(reinterpret_cast<const char*>(data), size)
+    {
+    }
+
+    bool next(double& chainage, double& elevation)
+    {
+        while (m_table.nextLine()) {
+            double values[2];
+            int tokens = 0;
+            int numbers = 0;
+            const char* token;
+            const char* tokenEnd;
+            while (m_table.nextToken(token, tokenEnd)) {
+                double value = 0.0;
+                if (TextTableReader::toNumber(token, tokenEnd, value)) {
+                    if (numbers < 2) {
+                        values[numbers] = value;
+                    }
+                    ++numbers;
+                }
+                ++tokens;
+            }
+            if (tokens == 0) {
+                continue;
+            }
+
+            // Заголовок - только первая значащая строка, в которой нет ни одного числа
+            const bool header = !m_seenData && numbers == 0;
+            m_seenData = true;
+            if (header) {
+                continue;
+            }
+            if (tokens != 2 || numbers != 2) {
+                throw std::invalid_argument(QString("Профиль высот, %1: ожидается \"пикет высота\".")
+                                                .arg(position()).toStdString());
+            }
+            chainage = values[0];
+            elevation = values[1];
+            return true;
+        }
+        return false;
+    }
+
+    QString position() const { return QString("строка %1").arg(m_table.lineNumber()); }
+
+private:
+    TextTableReader m_table;
+    bool m_seenData = false;
+};
+
+// Один проход по профилю
+template <class Cursor>
+ProfileAnalysis analyzeProfile(Cursor cursor, const PipelineParameters& params,
+                               double outerDiameter, double thickness)
+{
+    ProfileAnalysis a;
+    const FrictionLoss friction = FrictionLossModel(params).evaluate(outerDiameter, thickness);
+    if (!friction.isValid) {
+        throw std::invalid_argument("Недопустимые диаметр или толщина стенки трубы.");
+    }
+    a.hydraulicGradient = friction.pressureLoss / 1000.0;
+
+    const DesignResistance resistance = DesignResistance::fromParameters(params);
+    const double inletPressure = params.pressure;
+    const double staticScale = params.density * kGravity / 1000000.0;  // МПа на метр высоты
+    PipelineParameters local = params;
+
+    double x0 = 0.0;
+    double z0 = 0.0;
+    double previousChainage = 0.0;
+    double chainage = 0.0;
+    double elevation = 0.0;
+    while (cursor.next(chainage, elevation)) {
+        if (!std::isfinite(chainage) || !std::isfinite(elevation) ||
+            (a.points > 0 && chainage < previousChainage)) {
+            throw std::invalid_argument(QString("Профиль высот, %1: нечисловое значение или убывающий пикет.")
+                                            .arg(cursor.position()).toStdString());
+        }
+        if (a.points == 0) {
+            x0 = chainage;
+            z0 = elevation;
+        }
+        ++a.points;
+        previousChainage = chainage;
+
+        const double p = inletPressure - staticScale * (elevation - z0) - a.hydraulicGradient * (chainage - x0);
+        if (a.points == 1 || p < a.minPressure) {
+            a.minPressure = p;
+            a.minPressureChainage = chainage;
+        }
+        if (a.points == 1 || p > a.maxPressure) {
+            a.maxPressure = p;
+            a.maxPressureChainage = chainage;
+        }
+
+        if (p > inletPressure) {
+            ++a.checkedPoints;
+            local.pressure = p;
+            if (!PipelineOptimizer::checkThickness(local, resistance, outerDiameter, thickness).passes()) {
+                if (a.failedPoints == 0) {
+                    a.firstFailureChainage = chainage;
+                }
+                ++a.failedPoints;
+            }
+        }
+    }
+
+    if (a.points < 2) {
+        throw std::invalid_argument("Профиль высот должен содержать не меньше двух точек.");
+    }
+    a.length = chainage - x0;
+    a.staticHead = elevation - z0;
+    a.frictionLoss = a.hydraulicGradient * a.length;
+    a.outletPressure = inletPressure - staticScale * a.staticHead - a.frictionLoss;
+    return a;
+}
+
+} // namespace
+
+ElevationProfile::ElevationProfile(const QString& path, Format format)
+    : m_file(path)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_format(format)
+{
+    if (m_format == Format::Auto) {
+        m_format = QFileInfo(path).suffix().compare("bin", Qt::CaseInsensitive) == 0 ? Format::Binary
+                                                                                     : Format::Csv;
+    }
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть профиль высот %1: %2")
+                                     .arg(path, m_file.errorString()).toStdString());
+    }
+    m_size = m_file.size();
+    if (m_format == Format::Binary && m_size % 16 != 0) {
+        throw std::invalid_argument(QString("Размер двоичного профиля высот %1 не кратен 16 байтам.")
+                                        .arg(path).toStdString());
+    }
+    if (m_size > 0) {
+        m_data = m_file.map(0, m_size);
+        if (!m_data) {
+            throw std::runtime_error(QString("Не удалось отобразить в память профиль высот %1: %2")
+                                         .arg(path, m_file.errorString()).toStdString());
+        }
+    }
+}
+
+ElevationProfile::~ElevationProfile()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+    m_file.close();
+}
+
+ProfileAnalysis ElevationProfile::analyze(const PipelineParameters& params,
+                                          double outerDiameter, double thickness) const
+{
+    if (m_format == Format::Binary) {
+        return analyzeProfile(BinaryCursor(m_data, m_size), params, outerDiameter, thickness);
+    }
+    return analyzeProfile(CsvCursor(m_data, m_size), params, outerDiameter, thickness);
+}
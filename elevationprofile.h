@@ -0,0 +1,77 @@
+#ifndef ELEVATIONPROFILE_H
+#define ELEVATIONPROFILE_H
+
+#include "pipelineparameters.h"
+#include <QFile>
+#include <QString>
+
+// Давление вдоль трассы по профилю высот
+struct ProfileAnalysis {
+    qint64 points = 0;               // Точек профиля
+    double length = 0.0;             // Длина трассы (последний пикет - первый), м
+    double hydraulicGradient = 0.0;  // Потери давления на трение, МПа/м
+    double frictionLoss = 0.0;       // Потери на трение по всей трассе, МПа
+    double staticHead = 0.0;         // Разность высот конец - начало, м
+
+    double outletPressure = 0.0;     // Давление в конце трассы, МПа
+    double minPressure = 0.0;        // Наименьшее давление на трассе, МПа
+    double minPressureChainage = 0.0; // Пикет наименьшего давления, м
+    double maxPressure = 0.0;        // Наибольшее давление на трассе, МПа
+    double maxPressureChainage = 0.0; // Пикет наибольшего давления, м
+
+    qint64 checkedPoints = 0;        // Точек с давлением выше начального (проверены по напряжениям)
+    qint64 failedPoints = 0;         // Из них не прошедших проверку
+    double firstFailureChainage = -1.0; // Пикет первой такой точки (-1 - нет)
+
+    bool passes() const { return failedPoints == 0; }
+};
+
+// Профиль трассы: пикеты (расстояние от начала, м) и высоты (м).
+//
+// Файл отображается в память (QFile::map) и читается за один проход без
+// копирования, поэтому расход памяти не зависит от длины трассы. Форматы:
+//   - двоичный: подряд пары little-endian double (пикет, высота), без заголовка;
+//   - CSV: строка "пикет высота" (разделители - пробелы, ',' или ';'), пустые
+//     строки и строки с '#' пропускаются, первая строка может быть заголовком
+//     (строка, в которой нет ни одного числа).
+// Пикеты не должны убывать.
+//
+// analyze() считает давление в каждой точке
+//     p(x) = p_н - ρg(z(x) - z_н) - i·(x - x_н),
+// где p_н - эксплуатационное давление параметров в начале трассы, i -
+// гидравлический уклон (FrictionLossModel). В точках, где рельеф поднимает
+// давление выше начального, труба заново проверяется по всем условиям
+// calculate() (PipelineOptimizer::checkThickness()) при местном давлении.
+class ElevationProfile {
+public:
+    enum class Format {
+        Auto,    // По расширению: .bin - двоичный, иначе CSV
+        Binary,
+        Csv
+    };
+
+    // Ошибка открытия или отображения файла - std::runtime_error,
+    // размер двоичного файла не кратен 16 байтам - std::invalid_argument
+    explicit ElevationProfile(const QString& path, Format format = Format::Auto);
+    ~ElevationProfile();
+
+    ElevationProfile(const ElevationProfile&) = delete;
+    ElevationProfile& operator=(const ElevationProfile&) = delete;
+
+    Format format() const { return m_format; }
+
+    // Проход по трассе для трубы с наружным диаметром outerDiameter (мм) и
+    // толщиной стенки thickness (м). Ошибка в данных профиля (нечисловое
+    // значение, убывающий пикет, меньше двух точек) - std::invalid_argument
+    // с номером точки или строки; недопустимые параметры или размеры трубы
+    // (см. FrictionLossModel) - тоже std::invalid_argument.
+    ProfileAnalysis analyze(const PipelineParameters& params, double outerDiameter, double thickness) const;
+
+private:
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_size;
+    Format m_format;
+};
+
+#endif // ELEVATIONPROFILE_H
@@ -0,0 +1,27 @@
+# Расчетные модули поверх ядра (solver.pri): подключаются в консольном
+# расчете (curwork-cli.pro, команды clidriver.h) и в тестах. Приложение их
+# не использует, чтобы не увеличивать его сборку
+
+SOURCES += \
+    elevationprofile.cpp \
+    parametersweep.cpp \
+    pressurelimit.cpp \
+    propertyspline.cpp \
+    reliabilityanalysis.cpp \
+    routeoptimizer.cpp \
+    safetysensitivities.cpp \
+    steelgradecatalog.cpp \
+    thermalmodel.cpp \
+    waterhammer.cpp
+
+HEADERS += \
+    elevationprofile.h \
+    parametersweep.h \
+    pressurelimit.h \
+    propertyspline.h \
+    reliabilityanalysis.h \
+    routeoptimizer.h \
+    safetysensitivities.h \
+    steelgradecatalog.h \
+    thermalmodel.h \
+    waterhammer.h
@@ -0,0 +1,92 @@
+#include "frictionloss.h"
+#include <QtGlobal> // For M_PI
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Граница ламинарного режима
+const double kCriticalReynolds = 2320.0;
+
+// Предел шагов Ньютона для уравнения Колбрука - Уайта
+const int kMaxNewtonSteps = 8;
+
+} // namespace
+
+FrictionLossModel::FrictionLossModel(const PipelineParameters& params, double roughness)
+{
+    if (!(params.massFlow > 0.0) || !(params.density > 0.0) || !(params.viscosity > 0.0) ||
+        !std::isfinite(params.massFlow) || !std::isfinite(params.density) || !std::isfinite(params.viscosity)) {
+        throw std::invalid_argument("Массовый расход, плотность и вязкость должны быть положительными.");
+    }
+    if (!(roughness >= 0.0) || !std::isfinite(roughness)) {
+        throw std::invalid_argument("Шероховатость трубы должна быть неотрицательной.");
+    }
+
+    // ϑ = 4G/(ρπd²) (формула 1): Re = ϑd/ν = 4G/(πρν)/d,
+    // Δp на 1 км = λ·1000/d·ρϑ²/2 = λ·1000·ρ/2·(4G/(ρπ))²/d⁵
+    const double flowScale = 4.0 * params.massFlow / (params.density * M_PI);
+    m_reynoldsScale = flowScale / (params.viscosity * 1e-6);
+    m_lossScale = 1000.0 * params.density / 2.0 * flowScale * flowScale;
+    m_roughness = roughness / 1000.0;
+}
+
+double FrictionLossModel::frictionFactor(double reynolds, double relativeRoughness)
+{
+    if (!(reynolds > 0.0)) {
+        return 0.0;
+    }
+    if (reynolds < kCriticalReynolds) {
+        return 64.0 / reynolds;
+    }
+
+    // Свами - Джейн: λ = 0.25 / lg²(Δ/(3.7d) + 5.74/Re^0.9)
+    const double roughnessTerm = relativeRoughness / 3.7;
+    const double seed = std::log10(roughnessTerm + 5.74 / std::pow(reynolds, 0.9));
+    double x = -2.0 * seed;  // 1/√λ
+
+    // Ньютон для f(x) = x + 2·lg(Δ/(3.7d) + 2.51x/Re)
+    const double a = 2.51 / reynolds;
+    for (int step = 0; step < kMaxNewtonSteps; ++step) {
+        const double inner = roughnessTerm + a * x;
+        const double f = x + 2.0 * std::log10(inner);
+        const double df = 1.0 + 2.0 / M_LN10 * a / inner;
+        const double dx = f / df;
+        x -= dx;
+        if (std::abs(dx) <= 1e-14 * x) {
+            break;
+        }
+    }
+    return 1.0 / (x * x);
+}
+
+FrictionLoss FrictionLossModel::evaluate(double outerDiameter, double thickness) const
+{
+    FrictionLoss loss;
+    const double d = outerDiameter / 1000.0 - 2.0 * thickness;
+    if (!(d > 0.0) || !(thickness > 0.0) || !std::isfinite(d)) {
+        return loss;
+    }
+    loss.reynolds = m_reynoldsScale / d;
+    loss.frictionFactor = frictionFactor(loss.reynolds, m_roughness / d);
+    const double d2 = d * d;
+    loss.pressureLoss = loss.frictionFactor * m_lossScale / (d2 * d2 * d) / 1000000.0;
+    loss.isValid = std::isfinite(loss.pressureLoss);
+    return loss;
+}
+
+void FrictionLossModel::evaluate(const QVector<PipeSection>& sections, QVector<FrictionLoss>& losses) const
+{
+    losses.resize(sections.size());
+    for (int i = 0; i < sections.size(); ++i) {
+        losses[i] = evaluate(sections[i].outerDiameter, sections[i].thickness);
+    }
+}
+
+void FrictionLossModel::evaluate(const QVector<ValidationResult>& results, QVector<FrictionLoss>& losses) const
+{
+    losses.resize(results.size());
+    for (int i = 0; i < results.size(); ++i) {
+        losses[i] = evaluate(results[i].diameter, results[i].finalThickness);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef FRICTIONLOSS_H
+#define FRICTIONLOSS_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+
+// Потери давления на трение в трубе заданного размера
+struct FrictionLoss {
+    bool isValid = false;         // Расчет выполнен (d > 0, конечные значения)
+    double reynolds = 0.0;        // Re = ϑd/ν
+    double frictionFactor = 0.0;  // λ - коэффициент гидравлического сопротивления (Дарси)
+    double pressureLoss = 0.0;    // Потери давления на 1 км трубы, МПа/км
+};
+
+// Гидравлический расчет потерь на трение по формуле Дарси - Вейсбаха
+//     Δp = λ·(L/d)·ρϑ²/2
+// при массовом расходе, плотности и вязкости параметров.
+//
+// λ при Re < 2320 - ламинарный режим, 64/Re; иначе - решение уравнения
+// Колбрука - Уайта
+//     1/√λ = -2·lg(Δ/(3.7d) + 2.51/(Re·√λ))
+// методом Ньютона по x = 1/√λ. Начальное приближение - явная формула
+// Свами - Джейна, погрешность которой около 1%, поэтому двух-трех шагов
+// хватает до точности double.
+//
+// Скорость потока - та же, что в calculate() (формула 1), а Re и потери
+// зависят только от внутреннего диаметра. Постоянные множители считаются
+// один раз в конструкторе, так что расчет одного диаметра - это несколько
+// логарифмов, и его можно выполнять для всего каталога после calculate().
+class FrictionLossModel {
+public:
+    // Абсолютная шероховатость стальных труб по умолчанию, мм
+    static constexpr double DefaultRoughness = 0.1;
+
+    // Проверка параметров: G ≤ 0, ρ ≤ 0, ν ≤ 0 или шероховатость < 0
+    // (мм) - std::invalid_argument
+    explicit FrictionLossModel(const PipelineParameters& params, double roughness = DefaultRoughness);
+
+    // Труба с наружным диаметром outerDiameter (мм) и толщиной стенки thickness (м)
+    FrictionLoss evaluate(double outerDiameter, double thickness) const;
+
+    // Пакетный расчет по участкам
+    void evaluate(const QVector<PipeSection>& sections, QVector<FrictionLoss>& losses) const;
+
+    // Пакетный расчет по результатам calculate() (диаметр и finalThickness);
+    // для результатов без подобранной толщины isValid = false
+    void evaluate(const QVector<ValidationResult>& results, QVector<FrictionLoss>& losses) const;
+
+    // λ по числу Рейнольдса и относительной шероховатости Δ/d
+    static double frictionFactor(double reynolds, double relativeRoughness);
+
+private:
+    double m_reynoldsScale;  // Re·d = 4G/(πρν), м
+    double m_lossScale;      // Потери/λ·d⁵ = 1000·ρ/2·(4G/(πρ))², Па·м⁵ на 1 км
+    double m_roughness;      // Δ, м
+};
+
+#endif // FRICTIONLOSS_H
@@ -0,0 +1,101 @@
+#include "incrementaloptimizer.h"
+#include "parameterfields.h"
+#include <algorithm>
+
+namespace {
+
+double minSafety(const ValidationResult& res)
+{
+    return std::min({res.safetyHoop, res.safetyAxial, res.safetyEquivalent});
+}
+
+} // namespace
+
+void IncrementalOptimizer::reset()
+{
+    m_hasScalars = false;
+    m_entries.clear();
+    m_results.clear();
+    m_lastSolved = 0;
+}
+
+void IncrementalOptimizer::setThicknessCatalog(const ThicknessCatalog* catalog)
+{
+    if (catalog != m_optimizer.thicknessCatalog()) {
+        m_optimizer.setThicknessCatalog(catalog);
+        reset();
+    }
+}
+
+bool IncrementalOptimizer::sameScalars(const PipelineParameters& params) const
+{
+    if (params.mode != m_scalars.mode) {
+        return false;
+    }
+    for (const ParameterField& f : parameterFields()) {
+        if (!(params.*f.field == m_scalars.*f.field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const QVector<ValidationResult>& IncrementalOptimizer::update(const PipelineParameters& params)
+{
+    // === СБРОС ПРИ ИЗМЕНЕНИИ СКАЛЯРНЫХ ПАРАМЕТРОВ ===
+    if (!m_hasScalars || !sameScalars(params)) {
+        m_entries.clear();
+        m_scalars = params;
+        m_scalars.outerDiameters.clear();
+        m_hasScalars = true;
+    }
+
+    // === РАСЧЕТ ТОЛЬКО НОВЫХ ДИАМЕТРОВ ===
+    QVector<double> missing;
+    for (double d : params.outerDiameters) {
+        if (!m_entries.contains(d) && !missing.contains(d)) {
+            missing.append(d);
+        }
+    }
+    m_lastSolved = missing.size();
+
+    if (!missing.isEmpty()) {
+        PipelineParameters subset = m_scalars;
+        subset.outerDiameters = missing;
+        const QVector<ValidationResult> solved = m_optimizer.calculate(subset);
+
+        // Результаты calculate() идут в порядке диаметров, но без пропущенных
+        int next = 0;
+        for (double d : missing) {
+            Entry entry;
+            if (next < solved.size() && solved[next].diameter == d) {
+                entry.hasResult = true;
+                entry.result = solved[next++];
+            }
+            m_entries.insert(d, entry);
+        }
+    }
+
+    // === СБОРКА РЕЗУЛЬТАТОВ И ВЫБОР ОПТИМАЛЬНОГО ДИАМЕТРА ===
+
+    // Как в calculate(): лучший - первый диаметр с наибольшим минимальным запасом
+    m_results.clear();
+    int best = -1;
+    for (double d : params.outerDiameters) {
+        const Entry& entry = m_entries[d];
+        if (!entry.hasResult) {
+            continue;
+        }
+        m_results.append(entry.result);
+        if (entry.result.isValid &&
+            (best < 0 || minSafety(m_results[best]) < minSafety(entry.result))) {
+            best = m_results.size() - 1;
+        }
+    }
+
+    const double bestDiameter = best >= 0 ? m_results[best].diameter : 0.0;
+    for (auto& res : m_results) {
+        res.isOptimal = best >= 0 && qFuzzyCompare(res.diameter, bestDiameter);
+    }
+    return m_results;
+}
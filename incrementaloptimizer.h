@@ -0,0 +1,52 @@
+#ifndef INCREMENTALOPTIMIZER_H
+#define INCREMENTALOPTIMIZER_H
+
+#include "pipelineoptimizer.h"
+#include <QMap>
+#include <QVector>
+
+// Пересчет при небольших изменениях параметров (предварительный расчет при
+// вводе).
+//
+// Результат каждого диаметра зависит только от скалярных параметров и самого
+// диаметра, поэтому результаты запоминаются по диаметру. Пока скалярные
+// параметры и режим не меняются, рассчитываются только новые диаметры, а
+// удаленные просто выпадают из списка. Оптимальный диаметр заново выбирается
+// среди всех результатов. Подбор толщины связывает каждый скалярный параметр
+// (в том числе r, Δt, μ) со всеми диаметрами, поэтому изменение любого из них
+// пересчитывает все диаметры.
+//
+// Результаты совпадают с PipelineOptimizer::calculate() для тех же параметров.
+class IncrementalOptimizer {
+public:
+    // Расчет для params с использованием результатов предыдущих вызовов
+    const QVector<ValidationResult>& update(const PipelineParameters& params);
+
+    // Сколько диаметров рассчитано заново при последнем update()
+    int lastSolvedCount() const { return m_lastSolved; }
+
+    // Сброс запомненных результатов
+    void reset();
+
+    // Каталог допустимых толщин (см. PipelineOptimizer::setThicknessCatalog());
+    // при смене каталога запомненные результаты сбрасываются
+    void setThicknessCatalog(const ThicknessCatalog* catalog);
+
+private:
+    // Результат диаметра; hasResult = false - calculate() не формирует строку
+    struct Entry {
+        bool hasResult = false;
+        ValidationResult result;
+    };
+
+    bool sameScalars(const PipelineParameters& params) const;
+
+    PipelineOptimizer m_optimizer;
+    PipelineParameters m_scalars;    // Скалярные параметры запомненных результатов
+    bool m_hasScalars = false;
+    QMap<double, Entry> m_entries;   // Диаметр, мм → результат
+    QVector<ValidationResult> m_results;
+    int m_lastSolved = 0;
+};
+
+#endif // INCREMENTALOPTIMIZER_H
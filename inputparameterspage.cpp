@@ -1,4 +1,6 @@
 #include "inputparameterspage.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QVBoxLayout>
@@ -9,11 +11,18 @@
 #include <QDoubleSpinBox>
 #include <QSpinBox>
 #include <QMessageBox>
+#include <QCheckBox>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <algorithm>
 
 // Конструктор класса страницы ввода параметров
 InputParametersPage::InputParametersPage(QWidget *parent)
     : QWidget(parent)
     , m_mode(Mode::Mode1)           // Установка режима по умолчанию (упрощенный)
+    , m_previewEnabled(nullptr)
+    , m_preview(nullptr)
+    , m_previewTimer(nullptr)
 {
     setupForm();                    // Вызов метода создания и настройки формы
 }
@@ -33,7 +42,7 @@ PipelineParameters InputParametersPage::toParameters() const
         if (!m_density || !m_yieldStrength || !m_tensileStrength ||
             !m_fluidBulkModulus || !m_steelYoungModulus ||
             !m_temperatureDelta || !m_poissonRatio ||
-            !m_thermalExpansionCoeff || !m_bendRadius) {
+            !m_thermalExpansionCoeff || !m_bendRadius || !m_viscosity) {
             throw std::runtime_error("InputParametersPage: один или несколько виджетов Mode2 не инициализированы.");
         }
     }
@@ -53,19 +62,8 @@ PipelineParameters InputParametersPage::toParameters() const
     p.pressureReliability = m_pressureReliability->value();
     p.outerDiameters = outerDiameters();
 
-    // ВАЛИДАЦИЯ ВВЕДЕННЫХ ДИАМЕТРОВ
-    // Проверка: введен ли хотя бы один диаметр
-    if (p.outerDiameters.isEmpty()) {
-        throw std::invalid_argument("Введите хотя бы один наружный диаметр.");
-    }
-
-    // Проверка каждого диаметра на соответствие допустимому диапазону (100-1400 мм)
-    for (double d : p.outerDiameters) {
-        if ((d < 100.0) || (d > 1400.0)) {
-            throw std::invalid_argument(
-                QString("Диаметр %1 мм вне допустимого диапазона (100–1400 мм).").arg(d).toStdString());
-        }
-    }
+    // ВАЛИДАЦИЯ ВВЕДЕННЫХ ДИАМЕТРОВ (не пуст, каждый в диапазоне 100-1400 мм)
+    validateOuterDiameters(p.outerDiameters);
 
     // === ПАРАМЕТРЫ В ЗАВИСИМОСТИ ОТ РЕЖИМА ===
     if (m_mode == Mode::Mode2) {
@@ -80,18 +78,10 @@ PipelineParameters InputParametersPage::toParameters() const
         p.poissonRatio = m_poissonRatio->value();
         p.thermalExpansionCoeff = m_thermalExpansionCoeff->value();
         p.bendRadius = m_bendRadius->value();
+        p.viscosity = m_viscosity->value();
     } else {
         // РЕЖИМ 1: используются типовые значения
-
-        p.density = 850.0;
-        p.yieldStrength = 343.0;
-        p.tensileStrength = 490.0;
-        p.fluidBulkModulus = 1300.0;
-        p.steelYoungModulus = 200000.0;
-        p.temperatureDelta = 20.0;
-        p.poissonRatio = 0.3;
-        p.thermalExpansionCoeff = 11.4e-6;
-        p.bendRadius = 0.0;
+        setTypicalMode1Values(p);
     }
 
     return p;
@@ -115,6 +105,9 @@ void InputParametersPage::setMode(Mode mode)
         if (m_poissonRatio) m_poissonRatio->setVisible(showMode2Fields);
         if (m_thermalExpansionCoeff) m_thermalExpansionCoeff->setVisible(showMode2Fields);
         if (m_bendRadius) m_bendRadius->setVisible(showMode2Fields);
+        if (m_viscosity) m_viscosity->setVisible(showMode2Fields);
+
+        schedulePreview();  // Режим меняет набор параметров расчета
     }
 }
 // Метод создания и настройки пользовательского интерфейса
@@ -176,6 +169,12 @@ void InputParametersPage::setupForm()
     // Текстовое поле для ввода диаметров
     m_outerDiameters = new QLineEdit();
     m_outerDiameters->setPlaceholderText("Например: 530, 720, 820");
+    // Подсказка: стандартные диаметры сортамента в допустимом диапазоне
+    QStringList standardDiameters;
+    for (const Sortament::PipeSize& size : Sortament::diametersInRange(100.0, 1400.0)) {
+        standardDiameters << QString::number(size.outerDiameter);
+    }
+    m_outerDiameters->setToolTip("Стандартные диаметры (ГОСТ 10704-91): " + standardDiameters.join(", "));
     // Валидатор: только цифры, пробелы и запятые
     m_outerDiameters->setValidator(new QRegularExpressionValidator(
         QRegularExpression("^[\\d\\s,]+$"), this));
@@ -245,6 +244,13 @@ void InputParametersPage::setupForm()
     m_bendRadius->setDecimals(1);
     m_bendRadius->setSuffix(" м");
 
+    // Вязкость среды (для потерь давления на трение)
+    m_viscosity = new QDoubleSpinBox();
+    m_viscosity->setRange(0.5, 1000.0);
+    m_viscosity->setDecimals(2);
+    m_viscosity->setSuffix(" мм²/с");
+    m_viscosity->setValue(10.0);
+
     // Добавление виджетов Mode2 в форму
     m_formLayout->addRow("Плотность:", m_density);
     m_formLayout->addRow("Предел текучести:", m_yieldStrength);
@@ -255,6 +261,7 @@ void InputParametersPage::setupForm()
     m_formLayout->addRow("Коэффициент Пуассона:", m_poissonRatio);
     m_formLayout->addRow("Коэфф. лин. расширения:", m_thermalExpansionCoeff);
     m_formLayout->addRow("Радиус изгиба:", m_bendRadius);
+    m_formLayout->addRow("Кинематическая вязкость:", m_viscosity);
 
     // СКРЫТИЕ ПОЛЕЙ MODE2 ПО УМОЛЧАНИЮ (так как начальный режим - Mode1)
     m_density->setVisible(false);
@@ -266,6 +273,46 @@ void InputParametersPage::setupForm()
     m_poissonRatio->setVisible(false);
     m_thermalExpansionCoeff->setVisible(false);
     m_bendRadius->setVisible(false);
+    m_viscosity->setVisible(false);
+
+    // === ПАНЕЛЬ ПРЕДВАРИТЕЛЬНОГО РАСЧЕТА ===
+
+    m_sortamentThicknesses = new QCheckBox("Толщины стенок по сортаменту");
+    m_sortamentThicknesses->setToolTip("Толщина стенки выбирается из толщин ГОСТ 10704-91 для диаметра, "
+                                       "а не подбирается с шагом 1 мм; нестандартные диаметры не рассчитываются");
+    m_mainLayout->addWidget(m_sortamentThicknesses);
+
+    m_previewEnabled = new QCheckBox("Предварительный расчет при вводе");
+    m_previewEnabled->setChecked(true);
+    m_preview = new QLabel();
+    m_preview->setTextFormat(Qt::PlainText);
+    m_preview->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    m_preview->setWordWrap(true);
+    m_preview->setMinimumHeight(120);
+    m_mainLayout->addWidget(m_previewEnabled);
+    m_mainLayout->addWidget(m_preview);
+
+    // Изменения копятся 30 мс после последнего ввода, затем выполняется один
+    // пересчет; IncrementalOptimizer пересчитывает только затронутые диаметры
+    m_previewTimer = new QTimer(this);
+    m_previewTimer->setSingleShot(true);
+    m_previewTimer->setInterval(30);
+    connect(m_previewTimer, &QTimer::timeout, this, &InputParametersPage::updatePreview);
+
+    const QDoubleSpinBox *spinBoxes[] = {
+        m_pressure, m_massFlow, m_operationalFactor, m_reliabilityYield,
+        m_reliabilityStrength, m_responsibilityFactor, m_pressureReliability,
+        m_density, m_yieldStrength, m_tensileStrength, m_fluidBulkModulus,
+        m_steelYoungModulus, m_temperatureDelta, m_poissonRatio,
+        m_thermalExpansionCoeff, m_bendRadius, m_viscosity
+    };
+    for (const QDoubleSpinBox *box : spinBoxes) {
+        connect(box, qOverload<double>(&QDoubleSpinBox::valueChanged),
+                this, &InputParametersPage::schedulePreview);
+    }
+    connect(m_outerDiameters, &QLineEdit::textChanged, this, &InputParametersPage::schedulePreview);
+    connect(m_sortamentThicknesses, &QCheckBox::toggled, this, &InputParametersPage::schedulePreview);
+    connect(m_previewEnabled, &QCheckBox::toggled, this, &InputParametersPage::schedulePreview);
 
     // === СОЗДАНИЕ ПАНЕЛИ КНОПОК УПРАВЛЕНИЯ ===
 
@@ -339,6 +386,79 @@ void InputParametersPage::onBackClicked()
     emit backRequested();  // Сигнал для возврата на предыдущую страницу
 }
 
+const ThicknessCatalog* InputParametersPage::thicknessCatalog() const
+{
+    return m_sortamentThicknesses->isChecked() ? &ThicknessCatalog::sortament() : nullptr;
+}
+
+// СЛОТ: перезапуск таймера предварительного расчета при любом изменении ввода
+void InputParametersPage::schedulePreview()
+{
+    if (m_previewTimer) {
+        m_previewTimer->start();
+    }
+}
+
+// СЛОТ: предварительный расчет и вывод результатов в панель
+void InputParametersPage::updatePreview()
+{
+    if (!m_preview || !m_previewEnabled) {
+        return;
+    }
+    if (!m_previewEnabled->isChecked()) {
+        m_preview->clear();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<ValidationResult> results;
+    try {
+        m_previewOptimizer.setThicknessCatalog(thicknessCatalog());
+        results = m_previewOptimizer.update(toParameters());
+    } catch (const std::exception& e) {
+        // Незавершенный ввод (например, пустой список диаметров) - не ошибка
+        m_preview->setText(QString::fromUtf8(e.what()));
+        return;
+    }
+
+    // ФОРМИРОВАНИЕ ТЕКСТА ПАНЕЛИ: строка на каждый диаметр
+    QStringList lines;
+    lines << QString("Предварительный расчет: %1 мс, пересчитано диаметров: %2")
+                 .arg(timer.nsecsElapsed() / 1e6, 0, 'f', 2)
+                 .arg(m_previewOptimizer.lastSolvedCount());
+    for (const ValidationResult& res : results) {
+        // Сверка с сортаментом: нестандартный диаметр или стандартная толщина ≥ δ
+        QString sortament;
+        if (!Sortament::isStandardDiameter(res.diameter)) {
+            sortament = " (нет в сортаменте)";
+        } else if (res.isValid) {
+            const double standard = PipelineOptimizer::standardThickness(res.diameter, res.finalThickness);
+            sortament = standard > 0.0
+                ? QString(" (по сортаменту %1 мм)").arg(standard * 1000, 0, 'f', 1)
+                : QString(" (толще сортамента)");
+        }
+
+        if (!res.isValid) {
+            lines << QString("D = %1 мм%2: не подходит (ϑ = %3 м/с)")
+                         .arg(res.diameter)
+                         .arg(sortament)
+                         .arg(res.flowSpeed, 0, 'f', 2);
+            continue;
+        }
+        const double minSafety = std::min({res.safetyHoop, res.safetyAxial, res.safetyEquivalent});
+        lines << QString("D = %1 мм: δ = %2 мм%3, ϑ = %4 м/с, n_min = %5%6")
+                     .arg(res.diameter)
+                     .arg(res.finalThickness * 1000, 0, 'f', 1)
+                     .arg(sortament)
+                     .arg(res.flowSpeed, 0, 'f', 2)
+                     .arg(minSafety, 0, 'f', 3)
+                     .arg(res.isOptimal ? " - оптимальный" : "");
+    }
+    m_preview->setText(lines.join('\n'));
+}
+
 // Метод очистки всех полей ввода
 void InputParametersPage::clearFields()
 {
@@ -361,6 +481,7 @@ void InputParametersPage::clearFields()
     if (m_poissonRatio) m_poissonRatio->clear();
     if (m_thermalExpansionCoeff) m_thermalExpansionCoeff->clear();
     if (m_bendRadius) m_bendRadius->clear();
+    if (m_viscosity) m_viscosity->clear();
 
     // --- ДОБАВИТЬ ПРОВЕРКИ И ДЛЯ setValue ---
     if (m_pressure) m_pressure->setValue(10.0);
@@ -380,4 +501,5 @@ void InputParametersPage::clearFields()
     if (m_poissonRatio) m_poissonRatio->setValue(2.0);
     if (m_thermalExpansionCoeff) m_thermalExpansionCoeff->setValue(0.0);
     if (m_bendRadius) m_bendRadius->setValue(0.0);
+    if (m_viscosity) m_viscosity->setValue(10.0);
 }
@@ -4,8 +4,12 @@
 #include <QWidget>
 #include <QVector>
 #include "pipelineparameters.h"
+#include "incrementaloptimizer.h"
 
+class QCheckBox;
 class QDoubleSpinBox;
+class QLabel;
+class QTimer;
 class QSpinBox;
 class QLineEdit;
 class QFormLayout;
@@ -21,6 +25,10 @@ public:
     PipelineParameters toParameters() const;
     void setMode(Mode mode);
 
+    // Каталог толщин для расчета: сортамент, если выбран подбор толщин по
+    // сортаменту, иначе nullptr (шаг 1 мм)
+    const ThicknessCatalog* thicknessCatalog() const;
+
 
 signals:
     void nextRequested();
@@ -31,6 +39,8 @@ public slots:
 private slots:
     void onNextClicked();
     void onBackClicked();
+    void schedulePreview();  // Отложенный запуск предварительного расчета
+    void updatePreview();    // Предварительный расчет и вывод в панель
 
 private:
     void setupForm(); // Будет вызвана только один раз
@@ -47,6 +57,7 @@ private:
     QDoubleSpinBox *m_responsibilityFactor;
     QDoubleSpinBox *m_pressureReliability;
     QLineEdit *m_outerDiameters;
+    QCheckBox *m_sortamentThicknesses;
 
     // Поля Mode2 (будут скрыты/показаны)
     QDoubleSpinBox *m_density;
@@ -58,9 +69,16 @@ private:
     QDoubleSpinBox *m_poissonRatio;
     QDoubleSpinBox *m_thermalExpansionCoeff;
     QDoubleSpinBox *m_bendRadius;
+    QDoubleSpinBox *m_viscosity;
 
     QVBoxLayout *m_mainLayout;
     QFormLayout *m_formLayout;
+
+    // Предварительный расчет при вводе
+    QCheckBox *m_previewEnabled;
+    QLabel *m_preview;
+    QTimer *m_previewTimer;
+    IncrementalOptimizer m_previewOptimizer;
 };
 
 #endif // INPUTPARAMETERSPAGE_H
@@ -3,6 +3,7 @@
 #include "modeselectionpage.h"
 #include "inputparameterspage.h"
 #include "resultpage.h"
+#include "paretofront.h"
 #include "pipelineoptimizer.h"
 #include <QStackedWidget>
 #include <QMessageBox>
@@ -12,6 +13,7 @@
 #include <QApplication>
 #include <QThread>
 #include <QScreen>
+#include <QStandardPaths>
 
 // Конструктор главного класса приложения
 MainClass::MainClass(QWidget *parent)
@@ -62,6 +64,10 @@ MainClass::MainClass(QWidget *parent)
     // Сигналы от страницы результатов
     connect(m_resultPage, &ResultPage::restartRequested, this, &MainClass::onResultRestart);
     connect(m_resultPage, &ResultPage::exitRequested, this, &MainClass::onResultExit);
+
+    // Дисковый кэш результатов в стандартном каталоге кэша приложения;
+    // если он недоступен, используется только кэш в памяти
+    m_resultCache.openStore(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
 }
 
 // Метод центрирования окна на экране
@@ -136,6 +142,9 @@ void MainClass::onInputNext()
 
         // СОЗДАНИЕ ОБЪЕКТА ОПТИМИЗАТОРА И РАСЧЕТ РЕЗУЛЬТАТОВ
         PipelineOptimizer optimizer;
+        optimizer.setThreadCount(0);                 // Диаметры считаются на всех ядрах
+        optimizer.setCache(&m_resultCache);          // Повторные сценарии берутся из кэша
+        optimizer.setThicknessCatalog(m_inputPage->thicknessCatalog());  // Толщины по сортаменту
         auto results = optimizer.calculate(params);  // Основной расчет! Получаем validationResults
 
         // ПЕРЕМЕННЫЕ ДЛЯ ОТОБРАЖЕНИЯ РЕЗУЛЬТАТОВ
@@ -191,6 +200,9 @@ void MainClass::onInputNext()
             m_resultPage->setResults(optimalDiameter, optimalThickness, safetyHoop, safetyAxial,
                                      safetyEquivalent, minSafety, diametersForVisualization,
                                      backgroundImage, results);  // Ключевое: передаем ВСЕ результаты!
+
+            // 3. Парето-фронт по массе, запасу прочности и запасу по скорости
+            m_resultPage->setParetoFront(paretoFront(results));
         }
 
         qDebug() << "MainClass: results set successfully";
@@ -10,6 +10,7 @@
 #include "resultpage.h"
 #include "pipelineoptimizer.h"
 #include "pipelineparameters.h"
+#include "resultcache.h"
 
 class MainClass : public QMainWindow
 {
@@ -41,6 +42,7 @@ private:
     QString m_userName;
     Mode m_selectedMode;
     PipelineParameters m_currentParams;
+    ResultCache m_resultCache;  // Кэш результатов расчета (память + диск)
 };
 
 #endif // MAINCLASS_H
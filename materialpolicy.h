@@ -0,0 +1,175 @@
+#ifndef MATERIALPOLICY_H
+#define MATERIALPOLICY_H
+
+#include "pipelineparameters.h"
+
+// Политики материала для подбора толщины стенки.
+//
+// Подбор толщины (PipelineOptimizer) - шаблон по политике, которая дает
+// свойства среды и стали из формул 1, 4 и 14. Величины, известные при
+// компиляции, объявлены constexpr и сворачиваются в константы, а для прямой
+// трубы ветвь изгиба не компилируется совсем. Для произвольного ввода режима 2
+// используется RuntimeMaterial, а для расчета производных -
+// BasicRuntimeMaterial с дуальными числами (dualnumber.h).
+//
+// Политика с константами выбирается, только если параметры в точности равны
+// ее константам, поэтому результаты побитово совпадают с RuntimeMaterial.
+
+// === СВОЙСТВА СТАЛИ ===
+
+// Типовая сталь режима 1
+struct TypicalSteel {
+    static constexpr double yieldStrength = 343.0;        // σ_т, МПа
+    static constexpr double tensileStrength = 490.0;      // σ_п, МПа
+    static constexpr double youngModulus = 200000.0;      // E, МПа
+    static constexpr double poissonRatio = 0.3;           // μ
+    static constexpr double thermalExpansionCoeff = 11.4e-6; // α, 1/°C
+};
+
+// Трубные стали по СП 36.13330 (09Г2С, 17Г1С, 13Г1С-У, К52, К60 и др.):
+// марки различаются σ_т и σ_п, которые входят только в R1, R2 и σ_экв и
+// считаются один раз на расчет, а E, μ, α у них общие
+struct PipelineSteel {
+    static constexpr double youngModulus = 206000.0;
+    static constexpr double poissonRatio = 0.3;
+    static constexpr double thermalExpansionCoeff = 1.2e-5;
+};
+
+// Совпадают ли E, μ, α в параметрах со свойствами стали Steel
+template <class Steel>
+inline bool hasSteelProperties(const PipelineParameters& params)
+{
+    return params.steelYoungModulus == Steel::youngModulus &&
+           params.poissonRatio == Steel::poissonRatio &&
+           params.thermalExpansionCoeff == Steel::thermalExpansionCoeff;
+}
+
+// === ПОЛИТИКИ ===
+
+// Все величины из параметров (произвольный ввод режима 2). Real - тип
+// величин: double или дуальное число; Params - PipelineParameters или
+// структура с такими же именами полей типа Real.
+template <class Real>
+class BasicRuntimeMaterial {
+public:
+    static constexpr bool canBend = true;
+
+    template <class Params>
+    explicit BasicRuntimeMaterial(const Params& params)
+        : m_density(params.density)
+        , m_densityOverBulkModulus(params.density / params.fluidBulkModulus)
+        , m_steelYoungModulus(params.steelYoungModulus)
+        , m_poissonRatio(params.poissonRatio)
+        , m_thermalTerm(-params.steelYoungModulus * params.thermalExpansionCoeff *
+                        params.temperatureDelta)
+        , m_bendRadius(params.bendRadius)
+    {
+    }
+
+    const Real& density() const { return m_density; }
+    const Real& densityOverBulkModulus() const { return m_densityOverBulkModulus; }  // ρ/E_0
+    const Real& steelYoungModulus() const { return m_steelYoungModulus; }
+    const Real& poissonRatio() const { return m_poissonRatio; }
+    const Real& thermalTerm() const { return m_thermalTerm; }  // -EαΔt, МПа
+    const Real& bendRadius() const { return m_bendRadius; }
+
+private:
+    Real m_density;
+    Real m_densityOverBulkModulus;
+    Real m_steelYoungModulus;
+    Real m_poissonRatio;
+    Real m_thermalTerm;
+    Real m_bendRadius;
+};
+
+using RuntimeMaterial = BasicRuntimeMaterial<double>;
+
+// Прямая труба из стали Steel: свойства стали - константы, среда и Δt - из параметров
+template <class Steel>
+class SteelMaterial {
+public:
+    static constexpr bool canBend = false;
+
+    static bool matches(const PipelineParameters& params)
+    {
+        return hasSteelProperties<Steel>(params) && params.bendRadius == 0.0;
+    }
+
+    explicit SteelMaterial(const PipelineParameters& params)
+        : m_density(params.density)
+        , m_densityOverBulkModulus(params.density / params.fluidBulkModulus)
+        , m_thermalTerm(-Steel::youngModulus * Steel::thermalExpansionCoeff *
+                        params.temperatureDelta)
+    {
+    }
+
+    double density() const { return m_density; }
+    double densityOverBulkModulus() const { return m_densityOverBulkModulus; }
+    static constexpr double steelYoungModulus() { return Steel::youngModulus; }
+    static constexpr double poissonRatio() { return Steel::poissonRatio; }
+    double thermalTerm() const { return m_thermalTerm; }
+    static constexpr double bendRadius() { return 0.0; }
+
+private:
+    double m_density;
+    double m_densityOverBulkModulus;
+    double m_thermalTerm;
+};
+
+// Режим 1: типовые среда и сталь, прямая труба - все величины константы
+class Mode1Material {
+public:
+    static constexpr bool canBend = false;
+
+    static constexpr double densityValue = 850.0;          // ρ, кг/м³
+    static constexpr double fluidBulkModulusValue = 1300.0; // E_0, МПа
+    static constexpr double temperatureDeltaValue = 20.0;   // Δt, °C
+    static constexpr double viscosityValue = 10.0;          // ν, мм²/с (на напряжения не влияет)
+
+    static bool matches(const PipelineParameters& params)
+    {
+        return params.density == densityValue &&
+               params.fluidBulkModulus == fluidBulkModulusValue &&
+               params.temperatureDelta == temperatureDeltaValue &&
+               hasSteelProperties<TypicalSteel>(params) &&
+               params.bendRadius == 0.0;
+    }
+
+    explicit Mode1Material(const PipelineParameters&) {}
+
+    static constexpr double density() { return densityValue; }
+    static constexpr double densityOverBulkModulus() { return densityValue / fluidBulkModulusValue; }
+    static constexpr double steelYoungModulus() { return TypicalSteel::youngModulus; }
+    static constexpr double poissonRatio() { return TypicalSteel::poissonRatio; }
+    static constexpr double thermalTerm() {
+        return -TypicalSteel::youngModulus * TypicalSteel::thermalExpansionCoeff *
+               temperatureDeltaValue;
+    }
+    static constexpr double bendRadius() { return 0.0; }
+};
+
+// === ВЫБОР ПОЛИТИКИ ===
+
+enum class MaterialPolicy {
+    Runtime,        // RuntimeMaterial
+    Mode1,          // Mode1Material
+    PipelineSteel,  // SteelMaterial<PipelineSteel>
+    TypicalSteel    // SteelMaterial<TypicalSteel>
+};
+
+// Самая специализированная политика, константы которой совпадают с params
+inline MaterialPolicy selectMaterialPolicy(const PipelineParameters& params)
+{
+    if (Mode1Material::matches(params)) {
+        return MaterialPolicy::Mode1;
+    }
+    if (SteelMaterial<PipelineSteel>::matches(params)) {
+        return MaterialPolicy::PipelineSteel;
+    }
+    if (SteelMaterial<TypicalSteel>::matches(params)) {
+        return MaterialPolicy::TypicalSteel;
+    }
+    return MaterialPolicy::Runtime;
+}
+
+#endif // MATERIALPOLICY_H
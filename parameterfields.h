@@ -0,0 +1,45 @@
+#ifndef PARAMETERFIELDS_H
+#define PARAMETERFIELDS_H
+
+#include "pipelineparameters.h"
+#include <array>
+
+// Скалярное поле PipelineParameters с именем для ввода-вывода
+struct ParameterField {
+    const char* name;                  // Имя поля ("pressure", "massFlow", ...)
+    double PipelineParameters::*field; // Указатель на поле
+    bool mode2Only;                    // Задается пользователем только в режиме 2
+    bool optional;                     // Может отсутствовать: тогда типовое значение режима 1
+};
+
+using ParameterFieldList = std::array<ParameterField, ParameterFieldCount>;
+
+// Все скалярные поля PipelineParameters в порядке объявления. Имена
+// совпадают с ключами JSONL и столбцами CSV (ScenarioReader).
+inline const ParameterFieldList& parameterFields()
+{
+    static constexpr ParameterFieldList fields = {{
+        { "pressure", &PipelineParameters::pressure, false, false },
+        { "massFlow", &PipelineParameters::massFlow, false, false },
+        { "operationalFactor", &PipelineParameters::operationalFactor, false, false },
+        { "reliabilityYield", &PipelineParameters::reliabilityYield, false, false },
+        { "reliabilityStrength", &PipelineParameters::reliabilityStrength, false, false },
+        { "responsibilityFactor", &PipelineParameters::responsibilityFactor, false, false },
+        { "pressureReliability", &PipelineParameters::pressureReliability, false, false },
+        { "density", &PipelineParameters::density, true, false },
+        { "yieldStrength", &PipelineParameters::yieldStrength, true, false },
+        { "tensileStrength", &PipelineParameters::tensileStrength, true, false },
+        { "fluidBulkModulus", &PipelineParameters::fluidBulkModulus, true, false },
+        { "steelYoungModulus", &PipelineParameters::steelYoungModulus, true, false },
+        { "temperatureDelta", &PipelineParameters::temperatureDelta, true, false },
+        { "poissonRatio", &PipelineParameters::poissonRatio, true, false },
+        { "thermalExpansionCoeff", &PipelineParameters::thermalExpansionCoeff, true, false },
+        { "bendRadius", &PipelineParameters::bendRadius, true, false },
+        { "viscosity", &PipelineParameters::viscosity, true, true },
+    }};
+    static_assert(fields[ParameterFieldCount - 1].name != nullptr,
+                  "ParameterFieldCount должен совпадать с числом полей");
+    return fields;
+}
+
+#endif // PARAMETERFIELDS_H
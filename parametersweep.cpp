@@ -0,0 +1,160 @@
+#include "parametersweep.h"
+#include "parameterfields.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparallel.h"
+#include <cmath>
+#include <stdexcept>
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace {
+
+// Объем результатов одного тайла, который должен помещаться в кэш L2
+const int kTileBytes = 256 * 1024;
+
+} // namespace
+
+SweepAxis SweepAxis::list(double PipelineParameters::*field, const QVector<double>& values)
+{
+    if (!field || values.isEmpty()) {
+        throw std::invalid_argument("Ось развертки должна задавать поле и хотя бы одно значение.");
+    }
+    SweepAxis axis;
+    axis.field = field;
+    axis.values = values;
+    return axis;
+}
+
+SweepAxis SweepAxis::range(double PipelineParameters::*field, double from, double to, double step)
+{
+    if (!(step > 0.0) || !(to >= from)) {
+        throw std::invalid_argument("Диапазон развертки задан неверно: нужно from ≤ to и step > 0.");
+    }
+
+    // Значения считаются как from + k*step (без накопления ошибки округления);
+    // небольшой допуск включает правую границу, если она кратна шагу
+    const qint64 count = qint64(std::floor((to - from) / step + 1e-9)) + 1;
+    QVector<double> values;
+    values.reserve(count);
+    for (qint64 k = 0; k < count; ++k) {
+        values.append(from + k * step);
+    }
+    return list(field, values);
+}
+
+double PipelineParameters::*SweepAxis::fieldByName(const QString& name)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (name == QLatin1String(f.name)) {
+            return f.field;
+        }
+    }
+    return nullptr;
+}
+
+ParameterSweep::ParameterSweep(const PipelineParameters& base)
+    : m_base(base)
+    , m_threadCount(1)
+{
+}
+
+void ParameterSweep::addAxis(const SweepAxis& axis)
+{
+    m_axes.append(axis);
+}
+
+void ParameterSweep::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+qint64 ParameterSweep::pointCount() const
+{
+    qint64 count = 1;
+    for (const SweepAxis& axis : m_axes) {
+        count *= axis.values.size();
+    }
+    return count;
+}
+
+PipelineParameters ParameterSweep::point(qint64 index) const
+{
+    PipelineParameters p = m_base;
+    fillPoint(index, p);
+    return p;
+}
+
+// Подстановка значений осей для точки с номером index (смешанная система
+// счисления, последняя ось - младший разряд)
+void ParameterSweep::fillPoint(qint64 index, PipelineParameters& point) const
+{
+    for (int a = m_axes.size() - 1; a >= 0; --a) {
+        const SweepAxis& axis = m_axes[a];
+        const qint64 size = axis.values.size();
+        point.*axis.field = axis.values[index % size];
+        index /= size;
+    }
+}
+
+// Количество точек в тайле: результаты тайла должны помещаться в кэш L2
+int ParameterSweep::tilePoints() const
+{
+    const qint64 resultsPerPoint = qMax<qint64>(1, m_base.outerDiameters.size());
+    const qint64 bytesPerPoint = resultsPerPoint * qint64(sizeof(ValidationResult));
+    return int(qBound<qint64>(1, kTileBytes / bytesPerPoint, 4096));
+}
+
+void ParameterSweep::run(const Sink& sink)
+{
+    const qint64 points = pointCount();
+    if (points == 0) {
+        return;
+    }
+
+    const int tileSize = tilePoints();
+    const qint64 tileCount = (points + tileSize - 1) / tileSize;
+
+    // Рабочие буферы исполнителя: в памяти одновременно не больше одного
+    // тайла на поток
+    struct Worker {
+        PipelineOptimizer optimizer;
+        QVector<PipelineParameters> pointBuffer;
+        QVector<QVector<ValidationResult>> tileResults;
+    };
+    QVector<Worker> workers(parallelWorkerCount(tileCount, m_threadCount));
+    Worker* worker = workers.data();
+
+    // Тайлы отдаются приемнику строго по порядку: поток, закончивший тайл
+    // раньше очереди, ждет своей очереди
+    qint64 nextEmit = 0;
+    QMutex emitMutex;
+    QWaitCondition emitTurn;
+
+    parallelForBlocks(tileCount, m_threadCount, [&](qint64 tile, int w) {
+        QVector<PipelineParameters>& pointBuffer = worker[w].pointBuffer;
+        QVector<QVector<ValidationResult>>& tileResults = worker[w].tileResults;
+        if (pointBuffer.isEmpty()) {
+            pointBuffer.fill(m_base, tileSize);
+            tileResults.resize(tileSize);
+        }
+        const qint64 first = tile * tileSize;
+        const int count = int(qMin<qint64>(tileSize, points - first));
+
+        // R1, R2, допускаемое напряжение и термическая составляющая
+        // вычисляются в calculate() один раз на точку
+        for (int k = 0; k < count; ++k) {
+            fillPoint(first + k, pointBuffer[k]);
+            worker[w].optimizer.calculate(pointBuffer[k], tileResults[k]);
+        }
+
+        QMutexLocker locker(&emitMutex);
+        while (nextEmit != tile) {
+            emitTurn.wait(&emitMutex);
+        }
+        for (int k = 0; k < count; ++k) {
+            sink(first + k, pointBuffer[k], tileResults[k]);
+        }
+        ++nextEmit;
+        emitTurn.wakeAll();
+    });
+}
@@ -0,0 +1,60 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+#include <QString>
+#include <functional>
+
+// Ось развертки: список значений одного скалярного поля PipelineParameters
+struct SweepAxis {
+    double PipelineParameters::*field = nullptr; // Изменяемое поле (например, &PipelineParameters::pressure)
+    QVector<double> values;                      // Значения поля по оси
+
+    // Ось из явного списка значений
+    static SweepAxis list(double PipelineParameters::*field, const QVector<double>& values);
+
+    // Ось from, from + step, ... до to включительно
+    static SweepAxis range(double PipelineParameters::*field, double from, double to, double step);
+
+    // Поиск поля по имени ("pressure", "massFlow", "yieldStrength", ...)
+    static double PipelineParameters::*fieldByName(const QString& name);
+};
+
+// Декартова развертка расчета по нескольким параметрам.
+//
+// Каждая точка - базовые параметры с подставленными значениями осей; все точки
+// рассчитываются с одним и тем же списком диаметров. Последняя добавленная ось
+// меняется быстрее всех. Результаты не накапливаются: точки обрабатываются
+// блоками (тайлами), размер которых подобран так, чтобы результаты блока
+// помещались в кэш L2, и сразу передаются приемнику в порядке номеров точек.
+class ParameterSweep {
+public:
+    // Приемник результатов одной точки. Вызывается последовательно, по порядку
+    // точек; вектор результатов переиспользуется и действителен только внутри вызова.
+    using Sink = std::function<void(qint64 pointIndex, const PipelineParameters& point,
+                                    const QVector<ValidationResult>& results)>;
+
+    explicit ParameterSweep(const PipelineParameters& base);
+
+    void addAxis(const SweepAxis& axis);
+    const QVector<SweepAxis>& axes() const { return m_axes; }
+
+    // Количество потоков, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+
+    qint64 pointCount() const;
+    PipelineParameters point(qint64 index) const;
+
+    void run(const Sink& sink);
+
+private:
+    void fillPoint(qint64 index, PipelineParameters& point) const;
+    int tilePoints() const;
+
+    PipelineParameters m_base;
+    QVector<SweepAxis> m_axes;
+    int m_threadCount;
+};
+
+#endif // PARAMETERSWEEP_H
@@ -0,0 +1,71 @@
+#include "paretofront.h"
+#include "continuousoptimizer.h"
+#include "pipelineformulas.h"
+#include <QMap>
+#include <algorithm>
+#include <cmath>
+
+QVector<ParetoPoint> paretoFront(QVector<ParetoPoint> candidates)
+{
+    // Нечисловые значения в сравнениях не участвуют
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [](const ParetoPoint& p) {
+        return !std::isfinite(p.mass) || !std::isfinite(p.minSafety) || !std::isfinite(p.flowSpeedMargin);
+    }), candidates.end());
+
+    // При равной массе раньше идут лучшие по запасам - они отбрасывают худших
+    std::stable_sort(candidates.begin(), candidates.end(), [](const ParetoPoint& a, const ParetoPoint& b) {
+        if (a.mass != b.mass) {
+            return a.mass < b.mass;
+        }
+        if (a.minSafety != b.minSafety) {
+            return a.minSafety > b.minSafety;
+        }
+        return a.flowSpeedMargin > b.flowSpeedMargin;
+    });
+
+    // Лестница: запас прочности → запас по скорости (убывает с ростом ключа)
+    QMap<double, double> staircase;
+    QVector<ParetoPoint> front;
+    for (const ParetoPoint& p : candidates) {
+        auto it = staircase.lowerBound(p.minSafety);
+        if (it != staircase.end() && it.value() >= p.flowSpeedMargin) {
+            continue;
+        }
+
+        // Ступени с не большими обоими запасами больше не нужны: это ступень с
+        // тем же запасом прочности и ближайшие к ней слева
+        while (it != staircase.begin()) {
+            auto previous = std::prev(it);
+            if (previous.value() > p.flowSpeedMargin) {
+                break;
+            }
+            staircase.erase(previous);
+        }
+        if (it != staircase.end() && it.key() == p.minSafety) {
+            staircase.erase(it);
+        }
+        staircase.insert(p.minSafety, p.flowSpeedMargin);
+        front.append(p);
+    }
+    return front;
+}
+
+QVector<ParetoPoint> paretoFront(const QVector<ValidationResult>& results)
+{
+    QVector<ParetoPoint> candidates;
+    candidates.reserve(results.size());
+    for (int i = 0; i < results.size(); ++i) {
+        const ValidationResult& res = results[i];
+        if (!(res.satisfiesFlowSpeed && res.satisfiesHoopStress &&
+              res.satisfiesAxialStress && res.satisfiesEquivalentStress)) {
+            continue;
+        }
+        ParetoPoint p;
+        p.mass = ContinuousOptimizer::steelMass(res.diameter, res.finalThickness);
+        p.minSafety = std::min({res.safetyHoop, res.safetyAxial, res.safetyEquivalent});
+        p.flowSpeedMargin = std::min(res.flowSpeed - kMinFlowSpeed, kMaxFlowSpeed - res.flowSpeed);
+        p.index = i;
+        candidates.append(p);
+    }
+    return paretoFront(candidates);
+}
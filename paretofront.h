@@ -0,0 +1,34 @@
+#ifndef PARETOFRONT_H
+#define PARETOFRONT_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+
+// Вариант трубы по трем критериям выбора
+struct ParetoPoint {
+    double mass = 0.0;            // Масса погонного метра, кг/м (меньше - лучше)
+    double minSafety = 0.0;       // Минимальный коэффициент запаса (больше - лучше)
+    double flowSpeedMargin = 0.0; // Запас по скорости потока min(ϑ - 1, 3 - ϑ), м/с (больше - лучше)
+    int index = -1;               // Индекс варианта во входном списке
+};
+
+// Парето-фронт: варианты, которые нельзя улучшить ни по одному критерию без
+// ухудшения другого. Вариант отбрасывается, если есть другой, не худший по
+// всем трем критериям (из полностью совпадающих остается первый).
+//
+// Варианты сортируются по массе, после чего просматриваются по одному с
+// «лестницей» уже оставленных: по возрастанию запаса прочности запас по
+// скорости на ней убывает. Вариант доминируется, если на лестнице есть
+// ступень с не меньшими обоими запасами, - это первая ступень с запасом
+// прочности не меньше его. Каждый вариант входит в лестницу и покидает ее
+// не более одного раза, поэтому весь расчет - O(n log n).
+//
+// Результат упорядочен по возрастанию массы: каждый следующий вариант не легче,
+// но лучше всех предыдущих хотя бы по одному запасу - готовый ряд точек для графика.
+QVector<ParetoPoint> paretoFront(QVector<ParetoPoint> candidates);
+
+// Фронт по результатам calculate(): учитываются диаметры, прошедшие все
+// проверки; index - номер результата в results
+QVector<ParetoPoint> paretoFront(const QVector<ValidationResult>& results);
+
+#endif // PARETOFRONT_H
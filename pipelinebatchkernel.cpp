@@ -0,0 +1,449 @@
+#include "pipelinebatchkernel.h"
+#include "pipelineformulas.h"
+#include <QtGlobal> // For M_PI
+#include <cmath>
+
+// Векторные пути компилируются через #pragma GCC target. GCC под Windows
+// (MinGW) не выравнивает стек для векторов шире 16 байт (GCC bug 54412):
+// локальные __m256d/__m512d, вытесненные в стек, читаются выровненными
+// инструкциями по невыровненному адресу, и программа падает. Поэтому с MinGW
+// AVX2 и AVX-512 не собираются и не выбираются - используется SSE2 (ABI
+// Win64 выравнивает стек на 16 байт). В 32-битной Windows стек выровнен
+// только на 4 байта, и векторный расчет отключен совсем.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !(defined(_WIN32) && !defined(_WIN64))
+#define PIPELINE_BATCH_X86 1
+#include <immintrin.h>
+#if !(defined(_WIN32) && !defined(__clang__))
+#define PIPELINE_BATCH_WIDE 1  // AVX2 и AVX-512
+#endif
+#endif
+
+StressConstants StressConstants::fromParameters(const PipelineParameters& params,
+                                                double R1, double R2, double allowEquiv)
+{
+    StressConstants c;
+    c.massFlow = params.massFlow;
+    c.density = params.density;
+    c.fluidBulkModulus = params.fluidBulkModulus;
+    c.steelYoungModulus = params.steelYoungModulus;
+    c.pressure = params.pressure;
+    c.pressureReliability = params.pressureReliability;
+    c.poissonRatio = params.poissonRatio;
+    c.thermalTerm = -params.steelYoungModulus *
+                    params.thermalExpansionCoeff *
+                    params.temperatureDelta;
+    c.bendRadius = params.bendRadius;
+    c.R1 = R1;
+    c.R2 = R2;
+    c.allowEquiv = allowEquiv;
+    return c;
+}
+
+void StressBatch::resize(int count)
+{
+    m_count = count;
+    const int padded = (count + LaneAlignment - 1) / LaneAlignment * LaneAlignment;
+
+    outerDiameter.resize(padded);
+    thickness.resize(padded);
+    flowSpeed.resize(padded);
+    waveSpeed.resize(padded);
+    pressureSurge.resize(padded);
+    hoop.resize(padded);
+    axial.resize(padded);
+    equivalent.resize(padded);
+    flags.resize(padded);
+
+    // Дополнительные дорожки с D = 0 отсекаются проверкой геометрии
+    for (int i = count; i < padded; ++i) {
+        outerDiameter[i] = 0.0;
+        thickness[i] = 0.0;
+    }
+}
+
+#ifdef PIPELINE_BATCH_X86
+
+// === SSE2: 2 ДОРОЖКИ DOUBLE, 4 FLOAT ===
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2 {
+
+struct Ops {
+    using Vec = __m128d;
+    using Mask = __m128d;
+    static const int Width = 2;
+
+    static Vec set1(double v) { return _mm_set1_pd(v); }
+    static Vec load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm_div_pd(a, b); }
+    static Vec sqrt(Vec a) { return _mm_sqrt_pd(a); }
+    static Vec abs(Vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm_cmple_pd(a, b); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm_cmpge_pd(a, b); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm_cmpgt_pd(a, b); }
+    static Mask isFinite(Vec a) { return _mm_cmpeq_pd(_mm_mul_pd(a, _mm_setzero_pd()), _mm_setzero_pd()); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm_and_pd(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm_or_pd(a, b); }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static int bits(Mask m) { return _mm_movemask_pd(m); }
+};
+
+struct FloatOps {
+    using Vec = __m128;
+    using Mask = __m128;
+    static const int Width = 4;
+
+    static Vec set1(float v) { return _mm_set1_ps(v); }
+    static Vec load(const double* p) { return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(p)),
+                                                            _mm_cvtpd_ps(_mm_loadu_pd(p + 2))); }
+    static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+    static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+    static Vec abs(Vec a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm_cmple_ps(a, b); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm_cmpge_ps(a, b); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm_cmpgt_ps(a, b); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static int bits(Mask m) { return _mm_movemask_ps(m); }
+};
+
+#include "pipelinebatchkernelimpl.h"
+
+} // namespace sse2
+#pragma GCC pop_options
+
+#ifdef PIPELINE_BATCH_WIDE
+
+// === AVX2: 4 ДОРОЖКИ DOUBLE, 8 FLOAT ===
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+
+struct Ops {
+    using Vec = __m256d;
+    using Mask = __m256d;
+    static const int Width = 4;
+
+    static Vec set1(double v) { return _mm256_set1_pd(v); }
+    static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+    static Vec sqrt(Vec a) { return _mm256_sqrt_pd(a); }
+    static Vec abs(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mask isFinite(Vec a) { return _mm256_cmp_pd(_mm256_mul_pd(a, _mm256_setzero_pd()), _mm256_setzero_pd(), _CMP_EQ_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_pd(b, a, m); }
+    static int bits(Mask m) { return _mm256_movemask_pd(m); }
+};
+
+struct FloatOps {
+    using Vec = __m256;
+    using Mask = __m256;
+    static const int Width = 8;
+
+    static Vec set1(float v) { return _mm256_set1_ps(v); }
+    static Vec load(const double* p) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(p))),
+                                    _mm256_cvtpd_ps(_mm256_loadu_pd(p + 4)), 1);
+    }
+    static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+    static Vec sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+    static Vec abs(Vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_ps(b, a, m); }
+    static int bits(Mask m) { return _mm256_movemask_ps(m); }
+};
+
+#include "pipelinebatchkernelimpl.h"
+
+} // namespace avx2
+#pragma GCC pop_options
+
+// === AVX-512: 8 ДОРОЖЕК DOUBLE, 16 FLOAT ===
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace avx512 {
+
+struct Ops {
+    using Vec = __m512d;
+    using Mask = __mmask8;
+    static const int Width = 8;
+
+    static Vec set1(double v) { return _mm512_set1_pd(v); }
+    static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm512_storeu_pd(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm512_div_pd(a, b); }
+    static Vec sqrt(Vec a) { return _mm512_sqrt_pd(a); }
+    static Vec abs(Vec a) { return _mm512_abs_pd(a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static Mask isFinite(Vec a) { return _mm512_cmp_pd_mask(_mm512_mul_pd(a, _mm512_setzero_pd()), _mm512_setzero_pd(), _CMP_EQ_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return a & b; }
+    static Mask maskOr(Mask a, Mask b) { return a | b; }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_pd(m, b, a); }
+    static int bits(Mask m) { return m; }
+};
+
+struct FloatOps {
+    using Vec = __m512;
+    using Mask = __mmask16;
+    static const int Width = 16;
+
+    static Vec set1(float v) { return _mm512_set1_ps(v); }
+    static Vec load(const double* p) {
+        // Две половины по 8 дорожек (без AVX512DQ: вставка через double)
+        const __m256 low = _mm512_cvtpd_ps(_mm512_loadu_pd(p));
+        const __m256 high = _mm512_cvtpd_ps(_mm512_loadu_pd(p + 8));
+        return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(low)),
+                                                   _mm256_castps_pd(high), 1));
+    }
+    static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+    static Vec sqrt(Vec a) { return _mm512_sqrt_ps(a); }
+    static Vec abs(Vec a) { return _mm512_abs_ps(a); }
+    static Mask cmpLe(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+    static Mask cmpGe(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+    static Mask cmpGt(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static Mask maskAnd(Mask a, Mask b) { return a & b; }
+    static Mask maskOr(Mask a, Mask b) { return a | b; }
+    static Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_ps(m, b, a); }
+    static int bits(Mask m) { return m; }
+};
+
+#include "pipelinebatchkernelimpl.h"
+
+} // namespace avx512
+#pragma GCC pop_options
+
+#endif // PIPELINE_BATCH_WIDE
+
+#endif // PIPELINE_BATCH_X86
+
+// Определение лучшего набора инструкций процессора
+SimdIsa detectSimdIsa()
+{
+#ifdef PIPELINE_BATCH_X86
+    static const SimdIsa isa = []() {
+        __builtin_cpu_init();
+#ifdef PIPELINE_BATCH_WIDE
+        if (__builtin_cpu_supports("avx512f")) return SimdIsa::Avx512;
+        if (__builtin_cpu_supports("avx2")) return SimdIsa::Avx2;
+#endif
+        if (__builtin_cpu_supports("sse2")) return SimdIsa::Sse2;
+        return SimdIsa::None;
+    }();
+    return isa;
+#else
+    return SimdIsa::None;
+#endif
+}
+
+// Запуск пакетного расчета с выбранным набором инструкций
+void evaluateStressBatch(const StressConstants& constants, StressBatch& batch, SimdIsa isa)
+{
+    evaluateStressBatch(constants, batch, 0, batch.paddedSize(), isa);
+}
+
+void evaluateStressBatch(const StressConstants& constants, StressBatch& batch,
+                         int begin, int end, SimdIsa isa)
+{
+    end = qMin((end + StressBatch::LaneAlignment - 1) / StressBatch::LaneAlignment
+                   * StressBatch::LaneAlignment,
+               batch.paddedSize());
+
+#ifdef PIPELINE_BATCH_X86
+    switch (isa) {
+#ifdef PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx512:
+        avx512::evaluateLanes<avx512::Ops>(constants, batch, begin, end);
+        return;
+    case SimdIsa::Avx2:
+        avx2::evaluateLanes<avx2::Ops>(constants, batch, begin, end);
+        return;
+#else
+    case SimdIsa::Avx512:  // Не собраны, см. PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx2:
+#endif
+    case SimdIsa::Sse2:
+        sse2::evaluateLanes<sse2::Ops>(constants, batch, begin, end);
+        return;
+    case SimdIsa::None:
+        break;
+    }
+#else
+    Q_UNUSED(constants);
+    Q_UNUSED(isa);
+#endif
+    // Без векторных инструкций вызывающий код использует скалярный расчет
+    for (int i = begin; i < end; ++i) {
+        batch.flags[i] = 0;
+    }
+}
+
+void evaluateLocalStressBatch(const StressConstants& constants, StressBatch& batch,
+                              const double* density, const double* thermalTerm,
+                              int begin, int end, SimdIsa isa)
+{
+    end = qMin((end + StressBatch::LaneAlignment - 1) / StressBatch::LaneAlignment
+                   * StressBatch::LaneAlignment,
+               batch.paddedSize());
+
+#ifdef PIPELINE_BATCH_X86
+    switch (isa) {
+#ifdef PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx512:
+        avx512::evaluateLanes<avx512::Ops, true>(constants, batch, begin, end, density, thermalTerm);
+        return;
+    case SimdIsa::Avx2:
+        avx2::evaluateLanes<avx2::Ops, true>(constants, batch, begin, end, density, thermalTerm);
+        return;
+#else
+    case SimdIsa::Avx512:  // Не собраны, см. PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx2:
+#endif
+    case SimdIsa::Sse2:
+        sse2::evaluateLanes<sse2::Ops, true>(constants, batch, begin, end, density, thermalTerm);
+        return;
+    case SimdIsa::None:
+        break;
+    }
+#else
+    Q_UNUSED(constants);
+    Q_UNUSED(density);
+    Q_UNUSED(thermalTerm);
+    Q_UNUSED(isa);
+#endif
+    // Без векторных инструкций вызывающий код использует скалярный расчет
+    for (int i = begin; i < end; ++i) {
+        batch.flags[i] = 0;
+    }
+}
+
+void screenStressBatch(const StressConstants& constants, StressBatch& batch,
+                       int begin, int end, SimdIsa isa)
+{
+    end = qMin((end + StressBatch::LaneAlignment - 1) / StressBatch::LaneAlignment
+                   * StressBatch::LaneAlignment,
+               batch.paddedSize());
+
+#ifdef PIPELINE_BATCH_X86
+    switch (isa) {
+#ifdef PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx512:
+        avx512::screenLanes<avx512::FloatOps>(constants, batch, begin, end);
+        return;
+    case SimdIsa::Avx2:
+        avx2::screenLanes<avx2::FloatOps>(constants, batch, begin, end);
+        return;
+#else
+    case SimdIsa::Avx512:  // Не собраны, см. PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx2:
+#endif
+    case SimdIsa::Sse2:
+        sse2::screenLanes<sse2::FloatOps>(constants, batch, begin, end);
+        return;
+    case SimdIsa::None:
+        break;
+    }
+#else
+    Q_UNUSED(constants);
+    Q_UNUSED(isa);
+#endif
+    // Без векторных инструкций все дорожки остаются расчету в double
+    for (int i = begin; i < end; ++i) {
+        batch.flags[i] = LaneUnresolved;
+    }
+}
+
+int confirmStressBatch(const StressConstants& constants, StressBatch& batch,
+                       int begin, int end, SimdIsa isa)
+{
+    const int count = qMin(end, batch.paddedSize());
+    int evaluated = 0;
+    for (int group = begin; group < count; group += StressBatch::LaneAlignment) {
+        const int groupEnd = group + StressBatch::LaneAlignment;
+        bool unresolved = false;
+        for (int i = group; i < groupEnd; ++i) {
+            unresolved |= (batch.flags[i] & LaneUnresolved) != 0;
+        }
+        if (unresolved) {
+            evaluateStressBatch(constants, batch, group, groupEnd, isa);
+            evaluated += qMin(groupEnd, end) - group;
+        }
+    }
+    return evaluated;
+}
+
+void advanceCharacteristics(const CharacteristicConstants& constants,
+                            const double* p, const double* v, double* pOut, double* vOut,
+                            double* pMax, double* pMin, int count, SimdIsa isa)
+{
+    int done = 0;
+#ifdef PIPELINE_BATCH_X86
+    switch (isa) {
+#ifdef PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx512:
+        done = avx512::characteristicLanes<avx512::Ops>(constants, p, v, pOut, vOut, pMax, pMin, count);
+        break;
+    case SimdIsa::Avx2:
+        done = avx2::characteristicLanes<avx2::Ops>(constants, p, v, pOut, vOut, pMax, pMin, count);
+        break;
+#else
+    case SimdIsa::Avx512:  // Не собраны, см. PIPELINE_BATCH_WIDE
+    case SimdIsa::Avx2:
+#endif
+    case SimdIsa::Sse2:
+        done = sse2::characteristicLanes<sse2::Ops>(constants, p, v, pOut, vOut, pMax, pMin, count);
+        break;
+    case SimdIsa::None:
+        break;
+    }
+#else
+    Q_UNUSED(isa);
+#endif
+    // Остаток (или весь диапазон без векторных инструкций) - тот же порядок операций
+    const double impedance = constants.impedance;
+    const double friction = constants.friction;
+    const double inverseImpedance = 0.5 / impedance;
+    for (int i = done; i < count; ++i) {
+        const double vA = v[i - 1];
+        const double vB = v[i + 1];
+        const double cPlus = (p[i - 1] + impedance * vA) - friction * vA * std::abs(vA);
+        const double cMinus = (p[i + 1] - impedance * vB) + friction * vB * std::abs(vB);
+        const double pressure = 0.5 * (cPlus + cMinus);
+        pOut[i] = pressure;
+        vOut[i] = (cPlus - cMinus) * inverseImpedance;
+        if (pMax) {
+            pMax[i] = pressure > pMax[i] ? pressure : pMax[i];
+            pMin[i] = pMin[i] > pressure ? pressure : pMin[i];
+        }
+    }
+}
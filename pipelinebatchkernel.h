@@ -0,0 +1,136 @@
+#ifndef PIPELINEBATCHKERNEL_H
+#define PIPELINEBATCHKERNEL_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+#include <QtGlobal>
+
+// Набор векторных инструкций для пакетного расчета
+enum class SimdIsa {
+    None,   // Векторный расчет недоступен - используется скалярный путь
+    Sse2,   // 2 дорожки double
+    Avx2,   // 4 дорожки double
+    Avx512  // 8 дорожек double
+};
+
+// Флаги результата одной дорожки пакетного расчета
+enum StressLaneFlag : quint8 {
+    LaneValid = 0x01,            // Расчет не прерван геометрической или числовой ошибкой
+    LaneFlowSpeed = 0x02,        // Скорость потока в диапазоне 1-3 м/с
+    LaneHoopStress = 0x04,       // σ_кц ≤ R1
+    LaneAxialStress = 0x08,      // σ_пр ≤ R2
+    LaneEquivalentStress = 0x10, // σ_экв ≤ 0.9σ_т
+    LaneUnresolved = 0x80        // Отбраковка в float не дала ответа - нужен расчет в double
+};
+
+// Величины, общие для всех дорожек пакета (не зависят от диаметра)
+struct StressConstants {
+    double massFlow;             // G, кг/с
+    double density;              // ρ, кг/м³
+    double fluidBulkModulus;     // E_0, МПа
+    double steelYoungModulus;    // E, МПа
+    double pressure;             // p, МПа
+    double pressureReliability;  // y_fp
+    double poissonRatio;         // μ
+    double thermalTerm;          // -EαΔt, МПа
+    double bendRadius;           // r, м (0 - прямая труба)
+    double R1;                   // Расчетное сопротивление по текучести, МПа
+    double R2;                   // Расчетное сопротивление по прочности, МПа
+    double allowEquiv;           // Допускаемое эквивалентное напряжение, МПа
+
+    static StressConstants fromParameters(const PipelineParameters& params,
+                                          double R1, double R2, double allowEquiv);
+};
+
+// Пакет диаметров в виде структуры массивов (SoA).
+// Массивы дополняются до кратного 16 числа дорожек; дополнительные дорожки
+// имеют D = 0 и всегда получают пустые флаги.
+struct StressBatch {
+    static constexpr int LaneAlignment = 16; // Ширина самого широкого вектора (AVX-512, float)
+
+    // Вход
+    QVector<double> outerDiameter;  // D, м
+    QVector<double> thickness;      // δ, м
+
+    // Выход
+    QVector<double> flowSpeed;      // ϑ, м/с
+    QVector<double> waveSpeed;      // c, м/с
+    QVector<double> pressureSurge;  // Δp, МПа
+    QVector<double> hoop;           // σ_кц, МПа
+    QVector<double> axial;          // σ_пр, МПа
+    QVector<double> equivalent;     // σ_экв, МПа
+    QVector<quint8> flags;          // Комбинация StressLaneFlag
+
+    void resize(int count);
+    int size() const { return m_count; }
+    int paddedSize() const { return outerDiameter.size(); }
+
+private:
+    int m_count = 0;
+};
+
+// Определение лучшего набора инструкций процессора (результат кэшируется).
+// В сборке MinGW - не выше SSE2 (AVX2 и AVX-512 не собираются и при явном
+// выборе заменяются на SSE2, см. pipelinebatchkernel.cpp).
+SimdIsa detectSimdIsa();
+
+// Расчет скорости потока, гидроудара и напряжений (формулы 1, 3, 4, 8, 10, 14, 15)
+// для всех дорожек пакета. Результаты побитово совпадают со скалярным расчетом.
+void evaluateStressBatch(const StressConstants& constants, StressBatch& batch,
+                         SimdIsa isa = detectSimdIsa());
+
+// То же для дорожек [begin, end). begin должен быть кратен StressBatch::LaneAlignment;
+// end округляется вверх до кратного. Разные потоки могут одновременно
+// обрабатывать непересекающиеся диапазоны одного пакета.
+void evaluateStressBatch(const StressConstants& constants, StressBatch& batch,
+                         int begin, int end, SimdIsa isa = detectSimdIsa());
+
+// То же с плотностью среды ρ (кг/м³) и температурным членом -EαΔt (МПа)
+// своими для каждой дорожки (например, по температуре в точках трассы):
+// массивы density и thermalTerm не короче batch.paddedSize(), а
+// constants.density и constants.thermalTerm не используются. Результаты
+// побитово совпадают со скалярным расчетом с этими ρ и Δt.
+void evaluateLocalStressBatch(const StressConstants& constants, StressBatch& batch,
+                              const double* density, const double* thermalTerm,
+                              int begin, int end, SimdIsa isa = detectSimdIsa());
+
+// === ДВУХЭТАПНЫЙ РАСЧЕТ (FLOAT + DOUBLE) ===
+//
+// Отбраковка: те же формулы в одинарной точности (вдвое больше дорожек на
+// вектор, в память пишутся только флаги) с консервативной оценкой
+// погрешности. Дорожка считается решенной, только если δ заведомо
+// отвергается: геометрия корректна, 1 ≤ ϑ ≤ 3 м/с и каждое из условий
+// напряжений выполнено или нарушено с запасом больше оценки погрешности
+// (хотя бы одно нарушено). Для нее флаги совпадают с расчетом в double, а
+// ϑ и напряжения не рассчитываются. Остальные дорожки получают LaneUnresolved.
+void screenStressBatch(const StressConstants& constants, StressBatch& batch,
+                       int begin, int end, SimdIsa isa = detectSimdIsa());
+
+// Расчет в double групп по LaneAlignment дорожек из [begin, end), в которых
+// есть дорожки с LaneUnresolved. Возвращает число рассчитанных дорожек
+// (в пределах end). Диапазон - как у evaluateStressBatch().
+int confirmStressBatch(const StressConstants& constants, StressBatch& batch,
+                       int begin, int end, SimdIsa isa = detectSimdIsa());
+
+// === МЕТОД ХАРАКТЕРИСТИК ===
+
+// Величины шага по характеристикам, общие для всех узлов трубы
+struct CharacteristicConstants {
+    double impedance;  // B = ρc, Па·с/м
+    double friction;   // R = ρλΔx/(2d), Па·с²/м²
+};
+
+// Шаг по времени во внутренних узлах трубы при числе Куранта 1: для узлов
+// k = 0..count-1 по давлению p (Па) и скорости v (м/с) в узлах k-1 и k+1
+//     C+ = p[k-1] + B·v[k-1] - R·v[k-1]·|v[k-1]|
+//     C- = p[k+1] - B·v[k+1] + R·v[k+1]·|v[k+1]|
+//     pOut[k] = (C+ + C-)/2,  vOut[k] = (C+ - C-)/(2B).
+// p[-1], v[-1], p[count] и v[count] должны существовать. Если pMax не
+// nullptr, огибающие pMax[k] и pMin[k] обновляются новым давлением.
+// Результат побитово не зависит от набора инструкций.
+void advanceCharacteristics(const CharacteristicConstants& constants,
+                            const double* p, const double* v, double* pOut, double* vOut,
+                            double* pMax, double* pMin, int count,
+                            SimdIsa isa = detectSimdIsa());
+
+#endif // PIPELINEBATCHKERNEL_H
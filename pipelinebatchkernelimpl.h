@@ -0,0 +1,288 @@
+// Обобщенные векторные ядра: пакетный расчет напряжений и шаг метода характеристик.
+//
+// Файл намеренно не имеет защиты от повторного включения: pipelinebatchkernel.cpp
+// включает его внутри каждой области #pragma GCC target, чтобы шаблон
+// компилировался под соответствующий набор инструкций (SSE2, AVX2, AVX-512).
+// Ops задает тип вектора, тип маски и операции над ними: Ops - для double
+// (evaluateLanes, characteristicLanes), FloatOps - для отбраковки в float (screenLanes).
+//
+// Порядок операций повторяет скалярный расчет в pipelineoptimizer.cpp, поэтому
+// результаты совпадают бит в бит (требуется -ffp-contract=off, см. CurWork.pro).
+
+// Расчет дорожек [begin, end) (см. evaluateStressBatch()).
+// При LocalFluid = true плотность и температурный член -EαΔt берутся для
+// каждой дорожки из массивов laneDensity и laneThermalTerm, а не из c.
+template <typename Ops, bool LocalFluid = false>
+void evaluateLanes(const StressConstants& c, StressBatch& batch, int begin, int end,
+                   const double* laneDensity = nullptr, const double* laneThermalTerm = nullptr)
+{
+    using Vec = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec zero = Ops::set1(0.0);
+    const Vec one = Ops::set1(1.0);
+    const Vec two = Ops::set1(2.0);
+    const Vec minFlow = Ops::set1(kMinFlowSpeed);
+    const Vec maxFlow = Ops::set1(kMaxFlowSpeed);
+    const Vec million = Ops::set1(1000000.0);
+
+    // Скалярные сомножители вычисляются так же, как в скалярном расчете
+    const Vec flowNumerator = Ops::set1(4.0 * c.massFlow);
+    Vec flowDensity = Ops::set1(c.density * M_PI);
+    Vec fluidCompliance = Ops::set1(c.density / c.fluidBulkModulus);
+    Vec density = Ops::set1(c.density);
+    const Vec youngModulus = Ops::set1(c.steelYoungModulus);
+    const Vec pressure = Ops::set1(c.pressure);
+    const Vec pressureReliability = Ops::set1(c.pressureReliability);
+    const Vec poissonRatio = Ops::set1(c.poissonRatio);
+    Vec thermalTerm = Ops::set1(c.thermalTerm);
+    const Vec pi = Ops::set1(M_PI);
+    const Vec bulkModulus = Ops::set1(c.fluidBulkModulus);
+    const Vec bendDenominator = Ops::set1(2.0 * c.bendRadius);
+    const Vec R1 = Ops::set1(c.R1);
+    const Vec R2 = Ops::set1(c.R2);
+    const Vec allowEquiv = Ops::set1(c.allowEquiv);
+    const bool hasBend = c.bendRadius > 0;
+
+    for (int i = begin; i < end; i += Ops::Width) {
+        Vec D = Ops::load(batch.outerDiameter.constData() + i);
+        Vec delta = Ops::load(batch.thickness.constData() + i);
+        if (LocalFluid) {
+            density = Ops::load(laneDensity + i);
+            flowDensity = Ops::mul(density, pi);
+            fluidCompliance = Ops::div(density, bulkModulus);
+            thermalTerm = Ops::load(laneThermalTerm + i);
+        }
+
+        // Геометрия: 0 < δ < D/2, d = D - 2δ > 0 (формула 8)
+        Vec di = Ops::sub(D, Ops::mul(two, delta));
+        Mask geometryFailed = Ops::maskOr(Ops::cmpLe(delta, zero),
+                                          Ops::maskOr(Ops::cmpGe(delta, Ops::div(D, two)),
+                                                      Ops::cmpLe(di, zero)));
+
+        // ϑ = 4G / (ρ * π * d²) (формула 1)
+        Vec theta = Ops::div(flowNumerator, Ops::mul(Ops::mul(flowDensity, di), di));
+        Mask flowFinite = Ops::isFinite(theta);
+        Mask flowOk = Ops::maskAnd(Ops::cmpGe(theta, minFlow), Ops::cmpLe(theta, maxFlow));
+
+        // c = 1 / √(ρ/E₀ + d/(E*δ)) (формула 4)
+        Vec waveSpeed = Ops::div(one, Ops::sqrt(Ops::add(fluidCompliance,
+                                                         Ops::div(di, Ops::mul(youngModulus, delta)))));
+
+        // Δp = ρ * c * ϑ, МПа (формула 3)
+        Vec surge = Ops::div(Ops::mul(Ops::mul(density, waveSpeed), theta), million);
+        Vec pressureAtSurge = Ops::add(pressure, surge);
+
+        // σ_кц = (y_fp * p_гуд * D) / (2δ) (формула 10)
+        Vec hoop = Ops::div(Ops::mul(Ops::mul(pressureReliability, pressureAtSurge), D),
+                            Ops::mul(two, delta));
+
+        // σ_пр = μσ_кц - EαΔt ± ED/(2r) (формула 14)
+        Vec bendTerm = hasBend ? Ops::div(Ops::mul(youngModulus, D), bendDenominator) : zero;
+        Vec axialBase = Ops::add(Ops::mul(poissonRatio, hoop), thermalTerm);
+        Vec axialPlus = Ops::add(axialBase, bendTerm);
+        Vec axialMinus = Ops::sub(axialBase, bendTerm);
+        Vec axial = Ops::select(Ops::cmpGt(Ops::abs(axialPlus), Ops::abs(axialMinus)),
+                                axialPlus, axialMinus);
+
+        // σ_экв = √(σ_кц² - σ_кц * σ_пр + σ_пр²) (формула 15)
+        Vec equiv = Ops::sqrt(Ops::add(Ops::sub(Ops::mul(hoop, hoop), Ops::mul(hoop, axial)),
+                                       Ops::mul(axial, axial)));
+
+        // Одна сводная проверка на NaN/Inf вместо проверки после каждой формулы
+        Mask stressFinite = Ops::maskAnd(
+            Ops::maskAnd(Ops::maskAnd(Ops::isFinite(waveSpeed), Ops::isFinite(surge)),
+                         Ops::maskAnd(Ops::isFinite(pressureAtSurge), Ops::isFinite(hoop))),
+            Ops::maskAnd(Ops::isFinite(axial), Ops::isFinite(equiv)));
+
+        Ops::store(batch.flowSpeed.data() + i, theta);
+        Ops::store(batch.waveSpeed.data() + i, waveSpeed);
+        Ops::store(batch.pressureSurge.data() + i, surge);
+        Ops::store(batch.hoop.data() + i, hoop);
+        Ops::store(batch.axial.data() + i, axial);
+        Ops::store(batch.equivalent.data() + i, equiv);
+
+        // Дорожка валидна, если геометрия корректна, ϑ конечна и при допустимой
+        // скорости потока конечны все напряжения
+        int geometryBits = Ops::bits(geometryFailed);
+        int flowFiniteBits = Ops::bits(flowFinite);
+        int flowBits = Ops::bits(flowOk);
+        int stressFiniteBits = Ops::bits(stressFinite);
+        int hoopBits = Ops::bits(Ops::cmpLe(hoop, R1));
+        int axialBits = Ops::bits(Ops::cmpLe(axial, R2));
+        int equivBits = Ops::bits(Ops::cmpLe(equiv, allowEquiv));
+
+        for (int lane = 0; lane < Ops::Width; ++lane) {
+            const int bit = 1 << lane;
+            quint8 laneFlags = 0;
+            if (!(geometryBits & bit) && (flowFiniteBits & bit)) {
+                if (!(flowBits & bit)) {
+                    laneFlags = LaneValid;
+                } else if (stressFiniteBits & bit) {
+                    laneFlags = LaneValid | LaneFlowSpeed;
+                    if (hoopBits & bit) laneFlags |= LaneHoopStress;
+                    if (axialBits & bit) laneFlags |= LaneAxialStress;
+                    if (equivBits & bit) laneFlags |= LaneEquivalentStress;
+                }
+            }
+            batch.flags[i + lane] = laneFlags;
+        }
+    }
+}
+
+// Отбраковка в одинарной точности (см. screenStressBatch()).
+//
+// Оценка погрешности: каждая операция float дает относительную ошибку не
+// больше 2^-24 ≈ 6e-8, а цепочка до σ_экв - около двадцати операций над
+// положительными величинами, т.е. ~1.2e-6. Допуск tolerance = 1e-5 берется
+// с запасом почти на порядок. Исключение - d = D - 2δ: при тонкой стенке
+// округление D и δ дает ошибку d порядка 2^-24·D, т.е. относительную
+// 2^-24·D/d, которая через ϑ ~ 1/d² и c переходит во все напряжения. Поэтому
+// допуск каждой дорожки умножается на D/d. σ_пр - сумма слагаемых разного
+// знака, поэтому ее погрешность оценивается от суммы модулей слагаемых, а
+// неоднозначный выбор знака ED/(2r) (|σ+| ≈ |σ-|) оставляется расчету в double.
+template <typename Ops>
+void screenLanes(const StressConstants& c, StressBatch& batch, int begin, int end)
+{
+    using Vec = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    const Vec tolerance = Ops::set1(1e-5f);
+    const Vec lowerFactor = Ops::set1(1.0f - 1e-5f);
+    const Vec zero = Ops::set1(0.0f);
+    const Vec one = Ops::set1(1.0f);
+    const Vec two = Ops::set1(2.0f);
+    const Vec minFlow = Ops::set1(float(kMinFlowSpeed));
+    const Vec maxFlow = Ops::set1(float(kMaxFlowSpeed));
+    const Vec million = Ops::set1(1000000.0f);
+    const Vec limit = Ops::set1(1e30f);  // Значения больше - возможное переполнение
+
+    const Vec flowNumerator = Ops::set1(float(4.0 * c.massFlow));
+    const Vec flowDensity = Ops::set1(float(c.density * M_PI));
+    const Vec fluidCompliance = Ops::set1(float(c.density / c.fluidBulkModulus));
+    const Vec density = Ops::set1(float(c.density));
+    const Vec youngModulus = Ops::set1(float(c.steelYoungModulus));
+    const Vec pressure = Ops::set1(float(c.pressure));
+    const Vec pressureReliability = Ops::set1(float(c.pressureReliability));
+    const Vec poissonRatio = Ops::set1(float(c.poissonRatio));
+    const Vec thermalTerm = Ops::set1(float(c.thermalTerm));
+    const Vec bendDenominator = Ops::set1(float(2.0 * c.bendRadius));
+    const Vec R1 = Ops::set1(float(c.R1));
+    const Vec R2 = Ops::set1(float(c.R2));
+    const Vec allowEquiv = Ops::set1(float(c.allowEquiv));
+    const bool hasBend = c.bendRadius > 0;
+
+    for (int i = begin; i < end; i += Ops::Width) {
+        Vec D = Ops::load(batch.outerDiameter.constData() + i);
+        Vec delta = Ops::load(batch.thickness.constData() + i);
+
+        // Геометрия с запасом: 0 < δ < D/2, d > 0
+        Vec di = Ops::sub(D, Ops::mul(two, delta));
+        Mask geometryOk = Ops::maskAnd(Ops::cmpGt(delta, zero),
+                                       Ops::maskAnd(Ops::cmpGt(Ops::mul(Ops::div(D, two), lowerFactor), delta),
+                                                    Ops::cmpGt(di, Ops::mul(D, tolerance))));
+
+        // Допуск дорожки с учетом потери точности в d = D - 2δ
+        Vec laneTolerance = Ops::mul(tolerance, Ops::div(D, di));
+
+        // ϑ заведомо в диапазоне 1-3 м/с (NaN и Inf не проходят сравнения)
+        Vec theta = Ops::div(flowNumerator, Ops::mul(Ops::mul(flowDensity, di), di));
+        Mask flowOk = Ops::maskAnd(Ops::cmpGe(Ops::mul(theta, Ops::sub(one, laneTolerance)), minFlow),
+                                   Ops::cmpLe(Ops::mul(theta, Ops::add(one, laneTolerance)), maxFlow));
+
+        Vec waveSpeed = Ops::div(one, Ops::sqrt(Ops::add(fluidCompliance,
+                                                         Ops::div(di, Ops::mul(youngModulus, delta)))));
+        Vec surge = Ops::div(Ops::mul(Ops::mul(density, waveSpeed), theta), million);
+        Vec hoop = Ops::div(Ops::mul(Ops::mul(pressureReliability, Ops::add(pressure, surge)), D),
+                            Ops::mul(two, delta));
+
+        Vec bendTerm = hasBend ? Ops::div(Ops::mul(youngModulus, D), bendDenominator) : zero;
+        Vec axialBase = Ops::add(Ops::mul(poissonRatio, hoop), thermalTerm);
+        Vec axialPlus = Ops::add(axialBase, bendTerm);
+        Vec axialMinus = Ops::sub(axialBase, bendTerm);
+        Vec axial = Ops::select(Ops::cmpGt(Ops::abs(axialPlus), Ops::abs(axialMinus)),
+                                axialPlus, axialMinus);
+        Vec equiv = Ops::sqrt(Ops::add(Ops::sub(Ops::mul(hoop, hoop), Ops::mul(hoop, axial)),
+                                       Ops::mul(axial, axial)));
+
+        // Оценки абсолютной погрешности
+        Vec hoopError = Ops::mul(laneTolerance, hoop);
+        Vec axialError = Ops::mul(laneTolerance, Ops::add(Ops::add(Ops::abs(Ops::mul(poissonRatio, hoop)),
+                                                                   Ops::abs(thermalTerm)),
+                                                          bendTerm));
+        Vec equivError = Ops::add(Ops::mul(laneTolerance, Ops::add(Ops::mul(two, hoop), equiv)),
+                                  Ops::mul(two, axialError));
+
+        Mask finite = Ops::maskAnd(Ops::maskAnd(Ops::cmpGt(limit, hoop), Ops::cmpGt(limit, equiv)),
+                                   Ops::cmpGt(limit, Ops::abs(axial)));
+        Mask signOk = Ops::cmpGt(Ops::abs(Ops::sub(Ops::abs(axialPlus), Ops::abs(axialMinus))),
+                                 Ops::mul(two, axialError));
+
+        Mask hoopPass = Ops::cmpLe(Ops::add(hoop, hoopError), R1);
+        Mask hoopFail = Ops::cmpGt(Ops::sub(hoop, hoopError), R1);
+        Mask axialPass = Ops::cmpLe(Ops::add(axial, axialError), R2);
+        Mask axialFail = Ops::cmpGt(Ops::sub(axial, axialError), R2);
+        Mask equivPass = Ops::cmpLe(Ops::add(equiv, equivError), allowEquiv);
+        Mask equivFail = Ops::cmpGt(Ops::sub(equiv, equivError), allowEquiv);
+
+        Mask resolved = Ops::maskAnd(
+            Ops::maskAnd(Ops::maskAnd(geometryOk, flowOk), Ops::maskAnd(finite, signOk)),
+            Ops::maskAnd(Ops::maskAnd(Ops::maskOr(hoopPass, hoopFail), Ops::maskOr(axialPass, axialFail)),
+                         Ops::maskAnd(Ops::maskOr(equivPass, equivFail),
+                                      Ops::maskOr(hoopFail, Ops::maskOr(axialFail, equivFail)))));
+
+        int resolvedBits = Ops::bits(resolved);
+        int hoopBits = Ops::bits(hoopPass);
+        int axialBits = Ops::bits(axialPass);
+        int equivBits = Ops::bits(equivPass);
+
+        for (int lane = 0; lane < Ops::Width; ++lane) {
+            const int bit = 1 << lane;
+            quint8 laneFlags = LaneUnresolved;
+            if (resolvedBits & bit) {
+                laneFlags = LaneValid | LaneFlowSpeed;
+                if (hoopBits & bit) laneFlags |= LaneHoopStress;
+                if (axialBits & bit) laneFlags |= LaneAxialStress;
+                if (equivBits & bit) laneFlags |= LaneEquivalentStress;
+            }
+            batch.flags[i + lane] = laneFlags;
+        }
+    }
+}
+
+// Шаг метода характеристик во внутренних узлах (см. advanceCharacteristics()).
+// Обрабатывает целое число векторов и возвращает количество узлов; остаток
+// досчитывается скалярно в том же порядке операций.
+template <typename Ops>
+int characteristicLanes(const CharacteristicConstants& c, const double* p, const double* v,
+                        double* pOut, double* vOut, double* pMax, double* pMin, int count)
+{
+    using Vec = typename Ops::Vec;
+
+    const Vec half = Ops::set1(0.5);
+    const Vec impedance = Ops::set1(c.impedance);
+    const Vec friction = Ops::set1(c.friction);
+    const Vec inverseImpedance = Ops::set1(0.5 / c.impedance);
+    const int vectorEnd = count - count % Ops::Width;
+
+    for (int i = 0; i < vectorEnd; i += Ops::Width) {
+        // C+: из узла i-1, C-: из узла i+1
+        Vec vA = Ops::load(v + i - 1);
+        Vec vB = Ops::load(v + i + 1);
+        Vec cPlus = Ops::sub(Ops::add(Ops::load(p + i - 1), Ops::mul(impedance, vA)),
+                             Ops::mul(Ops::mul(friction, vA), Ops::abs(vA)));
+        Vec cMinus = Ops::add(Ops::sub(Ops::load(p + i + 1), Ops::mul(impedance, vB)),
+                              Ops::mul(Ops::mul(friction, vB), Ops::abs(vB)));
+
+        Vec pressure = Ops::mul(half, Ops::add(cPlus, cMinus));
+        Ops::store(pOut + i, pressure);
+        Ops::store(vOut + i, Ops::mul(Ops::sub(cPlus, cMinus), inverseImpedance));
+        if (pMax) {
+            Vec high = Ops::load(pMax + i);
+            Vec low = Ops::load(pMin + i);
+            Ops::store(pMax + i, Ops::select(Ops::cmpGt(pressure, high), pressure, high));
+            Ops::store(pMin + i, Ops::select(Ops::cmpGt(low, pressure), pressure, low));
+        }
+    }
+    return vectorEnd;
+}
@@ -0,0 +1,219 @@
+#ifndef PIPELINEFORMULAS_H
+#define PIPELINEFORMULAS_H
+
+#include "dualnumber.h"
+#include "parameterfields.h"
+#include "pipelineparameters.h"
+#include <QtGlobal> // For M_PI
+#include <cmath>
+#include <type_traits>
+
+// Расчетные формулы для одной толщины стенки, общие для подбора толщины
+// (PipelineOptimizer) и расчетов поверх него.
+//
+// Формулы записаны через шаблонный скалярный тип: с PipelineParameters
+// расчет идет в double (основной путь, константы политик материала
+// сворачиваются), а с BasicScalarParameters<Dual<N>> те же формулы дают
+// значения вместе с производными (dualnumber.h).
+
+// Допустимый диапазон скорости потока, м/с
+constexpr double kMinFlowSpeed = 1.0;
+constexpr double kMaxFlowSpeed = 3.0;
+
+// Исход расчета при фиксированной толщине стенки
+enum class ThicknessOutcome {
+    Rejected,        // Условия прочности не выполнены - нужна более толстая стенка
+    Accepted,        // Все условия прочности выполнены
+    FlowSpeedFailed, // Скорость потока вне диапазона 1-3 м/с
+    Aborted          // Геометрическая или числовая ошибка - результат не формируется
+};
+
+// Результат расчета напряжений для одной толщины стенки (Real - double или
+// дуальное число, см. dualnumber.h)
+template <class Real>
+struct BasicThicknessEvaluation {
+    ThicknessOutcome outcome = ThicknessOutcome::Aborted;
+    Real flowSpeed = 0.0;
+    Real hoop = 0.0;
+    Real axial = 0.0;
+    Real equiv = 0.0;
+    bool satisfiesHoopStress = false;
+    bool satisfiesAxialStress = false;
+    bool satisfiesEquivalentStress = false;
+};
+
+using ThicknessEvaluation = BasicThicknessEvaluation<double>;
+
+// Тип скалярных параметров Params (double для PipelineParameters)
+template <class Params>
+using ParameterType = typename std::decay<decltype(std::declval<Params>().pressure)>::type;
+
+// Скалярные поля PipelineParameters с типом Real (для дуальных чисел -
+// константы с нулевым градиентом, пока их не отметить переменными)
+template <class Real>
+struct BasicScalarParameters {
+    Real pressure;
+    Real massFlow;
+    Real operationalFactor;
+    Real reliabilityYield;
+    Real reliabilityStrength;
+    Real responsibilityFactor;
+    Real pressureReliability;
+    Real density;
+    Real yieldStrength;
+    Real tensileStrength;
+    Real fluidBulkModulus;
+    Real steelYoungModulus;
+    Real temperatureDelta;
+    Real poissonRatio;
+    Real thermalExpansionCoeff;
+    Real bendRadius;
+    Real viscosity;
+
+    explicit BasicScalarParameters(const PipelineParameters& params)
+    {
+        const ParameterFieldList& fields = parameterFields();
+        for (int k = 0; k < ParameterFieldCount; ++k) {
+            field(k) = Real(params.*fields[k].field);
+        }
+    }
+
+    // Поле с номером k в parameterFields()
+    Real& field(int k)
+    {
+        static Real BasicScalarParameters::* const members[] = {
+            &BasicScalarParameters::pressure, &BasicScalarParameters::massFlow,
+            &BasicScalarParameters::operationalFactor, &BasicScalarParameters::reliabilityYield,
+            &BasicScalarParameters::reliabilityStrength, &BasicScalarParameters::responsibilityFactor,
+            &BasicScalarParameters::pressureReliability, &BasicScalarParameters::density,
+            &BasicScalarParameters::yieldStrength, &BasicScalarParameters::tensileStrength,
+            &BasicScalarParameters::fluidBulkModulus, &BasicScalarParameters::steelYoungModulus,
+            &BasicScalarParameters::temperatureDelta, &BasicScalarParameters::poissonRatio,
+            &BasicScalarParameters::thermalExpansionCoeff, &BasicScalarParameters::bendRadius,
+            &BasicScalarParameters::viscosity
+        };
+        static_assert(sizeof(members) / sizeof(members[0]) == ParameterFieldCount,
+                      "BasicScalarParameters должна содержать все скалярные поля");
+        return this->*members[k];
+    }
+};
+
+// Расчетные сопротивления R1, R2 и допускаемое эквивалентное напряжение
+template <class Params, class Real = ParameterType<Params>>
+void designResistance(const Params& params, Real& R1, Real& R2, Real& allowEquiv)
+{
+    R1 = (params.operationalFactor * params.yieldStrength) /
+         (params.reliabilityYield * params.responsibilityFactor);
+    R2 = (params.operationalFactor * params.tensileStrength) /
+         (params.reliabilityStrength * params.responsibilityFactor);
+    allowEquiv = 0.9 * params.yieldStrength;
+}
+
+// Расчет скорости потока, гидроудара и напряжений для толщины delta (формулы 1, 3, 4, 8, 10, 14, 15).
+// Свойства среды и стали берутся из политики material (см. materialpolicy.h).
+// При stopOnFlowSpeed = false напряжения считаются и при недопустимой скорости потока.
+//
+// Params - PipelineParameters (расчет в double) или BasicScalarParameters с
+// дуальными числами (значения вместе с производными); тип R1, R2, D и δ -
+// тот же, что у параметров.
+template <class Material, class Params>
+BasicThicknessEvaluation<ParameterType<Params>> evaluateThickness(
+    const Material& material, const Params& params,
+    const ParameterType<Params>& R1, const ParameterType<Params>& R2,
+    const ParameterType<Params>& allowEquiv,
+    const ParameterType<Params>& Di_m, const ParameterType<Params>& delta,
+    bool stopOnFlowSpeed = true)
+{
+    using Real = ParameterType<Params>;
+    using std::abs;
+    using std::sqrt;
+
+    BasicThicknessEvaluation<Real> ev;
+
+    // Проверка толщины стенки на физическую реализуемость
+    if (delta <= 0 || delta >= Di_m / 2.0) {
+        return ev;
+    }
+
+    // d = D - 2δ (формула 8)
+    Real di = Di_m - 2.0 * delta;
+    if (di <= 0) {
+        return ev;
+    }
+
+    // ϑ = 4G / (ρ * π * d²) (формула 1)
+    Real theta = (4.0 * params.massFlow) /
+                 (material.density() * M_PI * di * di);
+    if (isNotFinite(theta)) {
+        return ev;
+    }
+
+    ev.flowSpeed = theta;
+    const bool flowSpeedFailed = !(theta >= kMinFlowSpeed && theta <= kMaxFlowSpeed);
+    if (flowSpeedFailed && stopOnFlowSpeed) {
+        ev.outcome = ThicknessOutcome::FlowSpeedFailed;
+        return ev;
+    }
+
+    // c = 1 / √(ρ/E₀ + d/(E*δ)) (формула 4)
+    Real waveSpeed_val = 1.0 / sqrt(
+                             material.densityOverBulkModulus() +
+                             di / (material.steelYoungModulus() * delta)
+                             );
+    if (isNotFinite(waveSpeed_val)) {
+        return ev;
+    }
+
+    // Δp = ρ * c * ϑ, МПа (формула 3)
+    Real pressureSurge_val = material.density() * waveSpeed_val * theta / 1000000.0;
+    if (isNotFinite(pressureSurge_val)) {
+        return ev;
+    }
+
+    Real pressureAtSurge_val = params.pressure + pressureSurge_val;
+    if (isNotFinite(pressureAtSurge_val)) {
+        return ev;
+    }
+
+    // σ_кц = (y_fp * p_гуд * D) / (2δ) (формула 10)
+    Real hoop = (params.pressureReliability * pressureAtSurge_val * Di_m) /
+                (2.0 * delta);
+    if (isNotFinite(hoop)) {
+        return ev;
+    }
+
+    // σ_пр = μσ_кц - EαΔt ± ED/(2r) (формула 14)
+    Real axial = material.poissonRatio() * hoop + material.thermalTerm();
+    if (Material::canBend && material.bendRadius() > 0) {
+        Real bendTerm = (material.steelYoungModulus() * Di_m) / (2.0 * material.bendRadius());
+        Real axialPlus = axial + bendTerm;
+        Real axialMinus = axial - bendTerm;
+        axial = abs(axialPlus) > abs(axialMinus) ? axialPlus : axialMinus;
+    }
+    if (isNotFinite(axial)) {
+        return ev;
+    }
+
+    // σ_экв = √(σ_кц² - σ_кц * σ_пр + σ_пр²) (формула 15)
+    Real equiv = sqrt(hoop * hoop - hoop * axial + axial * axial);
+    if (isNotFinite(equiv)) {
+        return ev;
+    }
+
+    ev.hoop = hoop;
+    ev.axial = axial;
+    ev.equiv = equiv;
+    ev.satisfiesHoopStress = hoop <= R1;
+    ev.satisfiesAxialStress = axial <= R2;
+    ev.satisfiesEquivalentStress = equiv <= allowEquiv;
+    if (flowSpeedFailed) {
+        ev.outcome = ThicknessOutcome::FlowSpeedFailed;
+    } else {
+        ev.outcome = (ev.satisfiesHoopStress && ev.satisfiesAxialStress && ev.satisfiesEquivalentStress)
+                         ? ThicknessOutcome::Accepted
+                         : ThicknessOutcome::Rejected;
+    }
+    return ev;
+}
+
+#endif // PIPELINEFORMULAS_H
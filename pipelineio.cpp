@@ -0,0 +1,205 @@
+#include "pipelineio.h"
+#include "materialpolicy.h"
+#include "sortament.h"
+#include <QString>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Запись числа без потери точности (17 значащих цифр)
+inline void appendNumber(QByteArray& out, double value)
+{
+    out += QByteArray::number(value, 'g', 17);
+}
+
+// Минимальный коэффициент запаса (поле minSafery в calculate() не заполняется)
+inline double minSafety(const ValidationResult& r)
+{
+    return std::min({r.safetyHoop, r.safetyAxial, r.safetyEquivalent});
+}
+
+inline void appendBool(QByteArray& out, bool value)
+{
+    out += value ? "true" : "false";
+}
+
+// Разделитель лексем текстовой таблицы
+inline bool isTableSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';';
+}
+
+} // namespace
+
+void setTypicalMode1Values(PipelineParameters& p)
+{
+    // Значения совпадают с константами Mode1Material, для которой подбор
+    // толщины компилируется со свернутыми константами
+    p.density = Mode1Material::densityValue;
+    p.yieldStrength = TypicalSteel::yieldStrength;
+    p.tensileStrength = TypicalSteel::tensileStrength;
+    p.fluidBulkModulus = Mode1Material::fluidBulkModulusValue;
+    p.steelYoungModulus = TypicalSteel::youngModulus;
+    p.temperatureDelta = Mode1Material::temperatureDeltaValue;
+    p.poissonRatio = TypicalSteel::poissonRatio;
+    p.thermalExpansionCoeff = TypicalSteel::thermalExpansionCoeff;
+    p.bendRadius = 0.0;
+    p.viscosity = Mode1Material::viscosityValue;
+}
+
+void validateOuterDiameters(const QVector<double>& diameters)
+{
+    // Проверка: введен ли хотя бы один диаметр
+    if (diameters.isEmpty()) {
+        throw std::invalid_argument("Введите хотя бы один наружный диаметр.");
+    }
+
+    // Проверка каждого диаметра на соответствие допустимому диапазону (100-1400 мм);
+    // нечисловое значение тоже вне диапазона
+    for (double d : diameters) {
+        if (!(d >= 100.0 && d <= 1400.0)) {
+            throw std::invalid_argument(
+                QString("Диаметр %1 мм вне допустимого диапазона (100–1400 мм).").arg(d).toStdString());
+        }
+    }
+}
+
+void setCatalogDiameters(QVector<double>& diameters)
+{
+    constexpr Sortament::DiameterRange range = Sortament::diametersInRange(100.0, 1400.0);
+    diameters.clear();
+    diameters.reserve(range.size());
+    for (const Sortament::PipeSize& size : range) {
+        diameters.append(size.outerDiameter);
+    }
+}
+
+QByteArray resultToJsonLine(qint64 scenario, const ValidationResult& r)
+{
+    QByteArray out;
+    out.reserve(384);
+    out += "{\"scenario\":";
+    out += QByteArray::number(scenario);
+    out += ",\"diameter\":";
+    appendNumber(out, r.diameter);
+    out += ",\"thickness\":";
+    appendNumber(out, r.isValid ? r.finalThickness : 0.0);
+    out += ",\"flowSpeed\":";
+    appendNumber(out, r.flowSpeed);
+    out += ",\"safetyHoop\":";
+    appendNumber(out, r.safetyHoop);
+    out += ",\"safetyAxial\":";
+    appendNumber(out, r.safetyAxial);
+    out += ",\"safetyEquivalent\":";
+    appendNumber(out, r.safetyEquivalent);
+    out += ",\"minSafety\":";
+    appendNumber(out, minSafety(r));
+    out += ",\"satisfiesFlowSpeed\":";
+    appendBool(out, r.satisfiesFlowSpeed);
+    out += ",\"satisfiesHoopStress\":";
+    appendBool(out, r.satisfiesHoopStress);
+    out += ",\"satisfiesAxialStress\":";
+    appendBool(out, r.satisfiesAxialStress);
+    out += ",\"satisfiesEquivalentStress\":";
+    appendBool(out, r.satisfiesEquivalentStress);
+    out += ",\"isOptimal\":";
+    appendBool(out, r.isOptimal);
+    out += ",\"isValid\":";
+    appendBool(out, r.isValid);
+    out += "}\n";
+    return out;
+}
+
+QByteArray resultCsvHeader()
+{
+    return "scenario,diameter,thickness,flowSpeed,safetyHoop,safetyAxial,safetyEquivalent,minSafety,"
+           "satisfiesFlowSpeed,satisfiesHoopStress,satisfiesAxialStress,satisfiesEquivalentStress,"
+           "isOptimal,isValid\n";
+}
+
+QByteArray resultToCsvLine(qint64 scenario, const ValidationResult& r)
+{
+    QByteArray out;
+    out.reserve(256);
+    out += QByteArray::number(scenario);
+    const double numbers[] = {
+        r.diameter, r.isValid ? r.finalThickness : 0.0, r.flowSpeed,
+        r.safetyHoop, r.safetyAxial, r.safetyEquivalent, minSafety(r)
+    };
+    for (double value : numbers) {
+        out += ',';
+        appendNumber(out, value);
+    }
+    const bool flags[] = {
+        r.satisfiesFlowSpeed, r.satisfiesHoopStress, r.satisfiesAxialStress,
+        r.satisfiesEquivalentStress, r.isOptimal, r.isValid
+    };
+    for (bool flag : flags) {
+        out += flag ? ",1" : ",0";
+    }
+    out += '\n';
+    return out;
+}
+
+const char* parseNumber(const char* begin, const char* end, double& value)
+{
+    // Граница числа: цифры, знаки, точка, показатель и буквы inf/nan; лишние
+    // символы внутри отвергает toDouble()
+    const char* stop = begin;
+    while (stop < end && (std::isalnum(static_cast<unsigned char>(*stop)) ||
+                          *stop == '+' || *stop == '-' || *stop == '.')) {
+        ++stop;
+    }
+    bool ok = false;
+    value = QByteArray::fromRawData(begin, int(stop - begin)).toDouble(&ok);
+    return ok && std::isfinite(value) ? stop : nullptr;
+}
+
+TextTableReader::TextTableReader(const char* data, qint64 size)
+    : m_p(data)
+    , m_end(data + size)
+    , m_q(data)
+    , m_lineEnd(data)
+    , m_lineNumber(0)
+{
+}
+
+bool TextTableReader::nextLine()
+{
+    if (m_p >= m_end) {
+        return false;
+    }
+    m_q = m_p;
+    m_lineEnd = static_cast<const char*>(std::memchr(m_p, '\n', size_t(m_end - m_p)));
+    if (!m_lineEnd) {
+        m_lineEnd = m_end;
+    }
+    m_p = m_lineEnd + (m_lineEnd < m_end ? 1 : 0);
+    ++m_lineNumber;
+    return true;
+}
+
+bool TextTableReader::nextToken(const char*& token, const char*& tokenEnd)
+{
+    while (m_q < m_lineEnd && isTableSeparator(*m_q)) {
+        ++m_q;
+    }
+    if (m_q == m_lineEnd || *m_q == '#') {
+        return false;
+    }
+    token = m_q;
+    while (m_q < m_lineEnd && !isTableSeparator(*m_q) && *m_q != '#') {
+        ++m_q;
+    }
+    tokenEnd = m_q;
+    return true;
+}
+
+bool TextTableReader::toNumber(const char* token, const char* tokenEnd, double& value)
+{
+    return parseNumber(token, tokenEnd, value) == tokenEnd;
+}
@@ -0,0 +1,59 @@
+#ifndef PIPELINEIO_H
+#define PIPELINEIO_H
+
+#include "pipelineparameters.h"
+#include <QByteArray>
+
+// Типовые значения параметров режима 1 (плотность, свойства стали и среды)
+void setTypicalMode1Values(PipelineParameters& p);
+
+// Проверка списка диаметров: не пуст, каждый в диапазоне 100-1400 мм
+void validateOuterDiameters(const QVector<double>& diameters);
+
+// Все стандартные диаметры сортамента в допустимом диапазоне 100-1400 мм
+// (значение "catalog" поля outerDiameters)
+void setCatalogDiameters(QVector<double>& diameters);
+
+// Результат одного диаметра как строка NDJSON (с переводом строки)
+QByteArray resultToJsonLine(qint64 scenario, const ValidationResult& result);
+
+// Заголовок и строка CSV (с переводом строки)
+QByteArray resultCsvHeader();
+QByteArray resultToCsvLine(qint64 scenario, const ValidationResult& result);
+
+// Конечное число в начале [begin, end) без учета локали: десятичная точка,
+// как в JSON и CSV. Возвращает указатель за числом или nullptr, если числа нет
+// или оно не конечное (nan, inf).
+// Разбор через QByteArray::toDouble(), а не std::from_chars: вещественный
+// from_chars нет в MinGW до GCC 12.
+const char* parseNumber(const char* begin, const char* end, double& value);
+
+// Построчный разбор текстовой таблицы в памяти (каталоги толщин и марок
+// стали, профиль высот): строки разделяются '\n', лексемы - пробелами,
+// табуляцией, ',' или ';', от '#' до конца строки - комментарий. Данные не
+// копируются и должны существовать, пока используется разбор.
+class TextTableReader {
+public:
+    TextTableReader(const char* data, qint64 size);
+
+    // Переход к следующей строке; false в конце данных
+    bool nextLine();
+
+    // Номер текущей строки (с 1)
+    qint64 lineNumber() const { return m_lineNumber; }
+
+    // Следующая лексема текущей строки; false в конце строки или перед '#'
+    bool nextToken(const char*& token, const char*& tokenEnd);
+
+    // Лексема [token, tokenEnd) целиком - конечное число (см. parseNumber())
+    static bool toNumber(const char* token, const char* tokenEnd, double& value);
+
+private:
+    const char* m_p;        // Начало следующей строки
+    const char* m_end;
+    const char* m_q;        // Позиция в текущей строке
+    const char* m_lineEnd;
+    qint64 m_lineNumber;
+};
+
+#endif // PIPELINEIO_H
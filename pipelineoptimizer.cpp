@@ -1,268 +1,812 @@
 #include "pipelineoptimizer.h"
+#include "materialpolicy.h"
+#include "pipelinebatchkernel.h"
+#include "parameterfields.h"
+#include "pipelineformulas.h"
+#include "pipelineio.h"
+#include "pipelineparallel.h"
+#include "resultcache.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <QDebug>
+#include <stdexcept>
 
-// Основной метод расчета оптимальных параметров трубопровода
-QVector<ValidationResult> PipelineOptimizer::calculate(const PipelineParameters& params)
+namespace {
+
+// Преобразование дорожки пакетного расчета в результат для одной толщины.
+// У дорожек, отвергнутых отбраковкой в float, ϑ и напряжения не рассчитаны -
+// от отвергнутой толщины дальше используются только флаги условий.
+ThicknessEvaluation laneEvaluation(const StressBatch& batch, int lane)
 {
-    QVector<ValidationResult> results;          // Вектор для хранения результатов расчета
-    results.reserve(params.outerDiameters.size()); // Резервирование памяти для эффективности
+    ThicknessEvaluation ev;
+    const quint8 flags = batch.flags[lane];
+    if (!(flags & LaneValid)) {
+        return ev;
+    }
 
-    // === РАСЧЕТ РАСЧЕТНЫХ СОПРОТИВЛЕНИЙ ПО ТЕКУЧЕСТИ И ПРОЧНОСТИ ===
+    ev.flowSpeed = batch.flowSpeed[lane];
+    if (!(flags & LaneFlowSpeed)) {
+        ev.outcome = ThicknessOutcome::FlowSpeedFailed;
+        return ev;
+    }
 
-    // R1 - расчетное сопротивление по текучести (формула из СНиП/СП)
-    double R1 = (params.operationalFactor * params.yieldStrength) /
-                (params.reliabilityYield * params.responsibilityFactor);
+    ev.hoop = batch.hoop[lane];
+    ev.axial = batch.axial[lane];
+    ev.equiv = batch.equivalent[lane];
+    ev.satisfiesHoopStress = flags & LaneHoopStress;
+    ev.satisfiesAxialStress = flags & LaneAxialStress;
+    ev.satisfiesEquivalentStress = flags & LaneEquivalentStress;
+    ev.outcome = (ev.satisfiesHoopStress && ev.satisfiesAxialStress && ev.satisfiesEquivalentStress)
+                     ? ThicknessOutcome::Accepted
+                     : ThicknessOutcome::Rejected;
+    return ev;
+}
 
-    // R2 - расчетное сопротивление по прочности (формула из СНиП/СП)
-    double R2 = (params.operationalFactor * params.tensileStrength) /
-                (params.reliabilityStrength * params.responsibilityFactor);
+// Размер блока диаметров, выдаваемого одному потоку (кратен ширине пакета)
+const int kSweepChunk = 256;
+static_assert(kSweepChunk % StressBatch::LaneAlignment == 0,
+              "Блок должен состоять из целых векторов пакета");
+
+struct SweepContext;
+struct SweepBuffers;
+
+// Обработка блока диаметров (sweepChunk для выбранной политики материала)
+using SweepChunkFunction = void (*)(const SweepContext& ctx, const SweepBuffers& buffers, int chunk,
+                                    ThicknessSolverStats& stats);
+
+// Величины, общие для всех диаметров одного расчета
+struct SweepContext {
+    const PipelineParameters* params;  // Скалярные параметры (список диаметров не используется)
+    const double* diameters;           // Наружные диаметры, мм
+    int diameterCount;
+    double R1;
+    double R2;
+    double allowEquiv;
+    bool monotoneMargins;  // Можно ли искать толщину бисекцией
+    SimdIsa isa;
+    StressConstants constants;
+    SweepChunkFunction sweepChunk;
+
+    // Окно скорости потока при δ_0, мм: диаметры вне [flowWindowMin,
+    // flowWindowMax] не попадают в пакетный расчет (см. setFlowWindow())
+    double flowWindowMin;
+    double flowWindowMax;
+    bool sortedDiameters;  // Диаметры по неубыванию - окно ищется двоичным поиском
+
+    const ThicknessCatalog* thicknessCatalog;  // Допустимые толщины (nullptr - шаг 1 мм)
+    bool screening;  // Двухэтапный пакетный расчет: отбраковка в float, уточнение в double
+};
+
+// Толщина стенки по формуле 9, м: δ = (y_fp * p * D) / (2 * min(R1, R2)).
+// Определяет минимальную толщину стенки из условия прочности
+inline double formulaThickness(const PipelineParameters& params, double R1, double R2, double Di_m)
+{
+    return (params.pressureReliability * params.pressure * Di_m) / (2.0 * qMin(R1, R2));
+}
 
-    // Допускаемое эквивалентное напряжение (f_eq = 0.9 по СП 36.13330)
-    double allowEquiv = 0.9 * params.yieldStrength;
+// Начальная толщина стенки, м: δ_0 по формуле 9 или, с каталогом толщин,
+// наименьшая допустимая толщина не меньше δ_0 (0 - такой толщины нет).
+// allowed и first - толщины диаметра в каталоге и индекс начальной.
+double initialThickness(const SweepContext& ctx, double Di, double Di_m,
+                        ThicknessCatalog::Thicknesses* allowed = nullptr, int* first = nullptr)
+{
+    const double delta = formulaThickness(*ctx.params, ctx.R1, ctx.R2, Di_m);
+    if (!ctx.thicknessCatalog) {
+        return delta;
+    }
 
-    qDebug() << "calculate: R1 =" << R1 << ", R2 =" << R2 << ", allowEquiv =" << allowEquiv;
+    const ThicknessCatalog::Thicknesses thicknesses = ctx.thicknessCatalog->thicknesses(Di);
+    const int index = thicknesses.lowerBound(delta);
+    if (allowed) {
+        *allowed = thicknesses;
+        *first = index;
+    }
+    return index < thicknesses.count ? thicknesses[index] : 0.0;
+}
 
-    // === ЦИКЛ ПЕРЕБОРА КАЖДОГО ДИАМЕТРА ИЗ СОРТАМЕНТА ===
-    for (double Di : params.outerDiameters) {
-        qDebug() << "calculate: Обработка диаметра:" << Di;
+// Окно скорости потока для δ_0 = y_fp·p·D / (2·min(R1, R2)).
+//
+// При δ_0 внутренний диаметр d = D·s, s = 1 - y_fp·p / min(R1, R2), и
+// ϑ = 4G / (ρπd²) монотонно убывает с ростом D, поэтому 1 ≤ ϑ ≤ 3 выполняется
+// только при √(4G / (3ρπ)) / s ≤ D ≤ √(4G / (ρπ)) / s. Границы расширяются на
+// относительный запас, много больший погрешности округления. Окно только
+// исключает диаметры из пакетного расчета: диаметры вне него решаются
+// скалярно (solveDiameter()), и исход каждого по-прежнему определяется
+// точным расчетом. С каталогом толщин начальная толщина больше δ_0, и окно -
+// лишь оценка, от которой зависит только скорость расчета.
+void setFlowWindow(SweepContext& ctx, const PipelineParameters& load)
+{
+    const double margin = 1e-9;
+    const double s = 1.0 - load.pressureReliability * load.pressure / qMin(ctx.R1, ctx.R2);
+    const double dFast = std::sqrt((4.0 * load.massFlow) / (kMaxFlowSpeed * load.density * M_PI)); // ϑ = 3
+    const double dSlow = std::sqrt((4.0 * load.massFlow) / (kMinFlowSpeed * load.density * M_PI)); // ϑ = 1
+
+    ctx.flowWindowMin = 0.0;
+    ctx.flowWindowMax = std::numeric_limits<double>::infinity();
+    if (s > 0.0 && std::isfinite(s) && std::isfinite(dFast) && std::isfinite(dSlow)) {
+        ctx.flowWindowMin = 1000.0 * dFast / s * (1.0 - margin);
+        ctx.flowWindowMax = 1000.0 * dSlow / s * (1.0 + margin);
+    }
+}
 
-        // Создаем структуру результата для текущего диаметра
-        ValidationResult res;
-        res.diameter = Di;    // Наружный диаметр в мм
-        res.isOptimal = false; // Пока не оптимальный
-        res.isValid = false;   // Пока не валидный
+// Минимальный коэффициент запаса (наименьший из трех)
+double minSafety(const ValidationResult& res)
+{
+    return std::min({res.safetyHoop, res.safetyAxial, res.safetyEquivalent});
+}
 
-        // === ПРЕОБРАЗОВАНИЕ ЕДИНИЦ И БАЗОВАЯ ВАЛИДАЦИЯ ===
+// Сетка толщин с шагом 1 мм без хранения: δ_k получается k-кратным
+// прибавлением 0.001 м к δ_0, как при пошаговом переборе, поэтому толщины
+// совпадают с ним бит в бит. Сетка заканчивается перед первой толщиной,
+// достигающей радиуса трубы (δ ≥ D/2). δ_k досчитывается от опорной точки -
+// последней отвергнутой толщины; нижняя граница поиска только растет, и за
+// весь подбор прибавлений не больше, чем точек в сетке.
+class SteppedThicknessGrid {
+public:
+    SteppedThicknessGrid(double initial, double radius)
+        : m_index(0)
+        , m_value(initial)
+        , m_radius(radius)
+    {
+    }
 
-        double Di_m = Di / 1000.0; // Преобразование мм → м для расчетов
+    // Число точек сетки сверху - с запасом на погрешность прибавлений
+    int sizeBound() const
+    {
+        const double steps = std::ceil((m_radius - m_value) / 0.001) + 2.0;
+        return steps < double(std::numeric_limits<int>::max()) ? int(qMax(steps, 1.0))
+                                                                : std::numeric_limits<int>::max();
+    }
 
-        // Проверка базовых значений на корректность
-        if (Di_m <= 0 || params.massFlow <= 0 || params.density <= 0) {
-            results.append(res);  // Добавляем пустой результат и переходим к следующему диаметру
-            continue;
+    // δ_k (k не меньше опорного номера). Если сетка кончается раньше k -
+    // false, а size - число точек сетки
+    bool at(int k, double& value, int& size) const
+    {
+        double delta = m_value;
+        for (int i = m_index; i < k; ++i) {
+            delta += 0.001; // Увеличение на 1 мм (0.001 м)
+            if (!(delta < m_radius)) {
+                size = i + 1;
+                return false;
+            }
         }
+        value = delta;
+        return true;
+    }
+
+    // Перенос опорной точки: δ_k = value
+    void advance(int k, double value)
+    {
+        m_index = k;
+        m_value = value;
+    }
+
+private:
+    int m_index;
+    double m_value;
+    double m_radius;
+};
+
+// Подбор толщины стенки для диаметра с индексом i.
+// Возвращает false, если результат для диаметра не формируется.
+// inBatch - рассчитан ли δ_0 диаметра в пакете batch.
+template <class Material>
+bool solveDiameter(const SweepContext& ctx, const Material& material, const StressBatch& batch, int i,
+                   bool inBatch, ThicknessSolverStats& stats, ValidationResult& res)
+{
+    const PipelineParameters& params = *ctx.params;
+    const double R1 = ctx.R1;
+    const double R2 = ctx.R2;
+    const double allowEquiv = ctx.allowEquiv;
+
+    double Di = ctx.diameters[i];
 
-        // === РАСЧЕТ НАЧАЛЬНОЙ ТОЛЩИНЫ СТЕНКИ (ФОРМУЛА 9) ===
+    // Создаем структуру результата для текущего диаметра
+    res = ValidationResult();
+    res.diameter = Di;    // Наружный диаметр в мм
+    res.isOptimal = false; // Пока не оптимальный
+    res.isValid = false;   // Пока не валидный
 
-        // δ = (y_fp * p * D) / (2 * min(R1, R2))
-        // Определяет минимальную толщину стенки из условия прочности
-        double delta = (params.pressureReliability * params.pressure * Di_m) /
-                       (2.0 * qMin(R1, R2));
-        double initial_delta = delta; // Сохраняем начальное значение для возможного использования
+    // === ПРЕОБРАЗОВАНИЕ ЕДИНИЦ И БАЗОВАЯ ВАЛИДАЦИЯ ===
 
-        bool foundValid = false; // Флаг: найден ли подходящий вариант для этого диаметра
+    double Di_m = Di / 1000.0; // Преобразование мм → м для расчетов
+
+    // Проверка базовых значений на корректность
+    if (Di_m <= 0 || params.massFlow <= 0 || params.density <= 0) {
+        return true;  // Пустой результат
+    }
+
+    // === РАСЧЕТ НАЧАЛЬНОЙ ТОЛЩИНЫ СТЕНКИ (ФОРМУЛА 9) ===
+
+    ThicknessCatalog::Thicknesses allowed;
+    int firstAllowed = 0;
+    double delta = initialThickness(ctx, Di, Di_m, &allowed, &firstAllowed);
+    const double initialDelta = delta;
+    if (ctx.thicknessCatalog && delta == 0.0) {
+        // Диаметра нет в каталоге - невалидный результат; все толщины тоньше
+        // δ_0 - пропуск, как при выходе сетки 1 мм за радиус трубы
+        return allowed.isEmpty();
+    }
 
-        // === ЦИКЛ ПОДБОРА ТОЛЩИНЫ СТЕНКИ ДЛЯ ТЕКУЩЕГО ДИАМЕТРА ===
-        while (true) {
-            // Проверка толщины стенки на физическую реализуемость
-            if (delta <= 0) {
-                break; // Некорректная толщина - прерываем цикл по толщине
+    ThicknessEvaluation lowEval;
+    if (inBatch) {
+        lowEval = laneEvaluation(batch, i);
+    } else {
+        // Вне диапазона скорости потока расчет прерывается сразу после ϑ, без
+        // напряжений. Считается по фактическому исходу: с каталогом начальная
+        // толщина не δ_0, и окно (setFlowWindow()) для нее неточно
+        lowEval = evaluateThickness(material, params, R1, R2, allowEquiv, Di_m, delta);
+        if (lowEval.outcome == ThicknessOutcome::FlowSpeedFailed) {
+            ++stats.prunedDiameters;
+        } else {
+            ++stats.evaluations;
+        }
+    }
+
+    // === СЕТКА ТОЛЩИН ===
+
+    // Без каталога - шаг 1 мм (SteppedThicknessGrid), сетка нужна только если
+    // δ_0 не подошла; ее размер уточняется, когда поиск доходит до конца.
+    // С каталогом сетка - допустимые толщины диаметра начиная с начальной.
+    SteppedThicknessGrid steppedGrid(initialDelta, Di_m / 2.0);
+    const double* grid = nullptr;
+    int gridSize = 0;
+    if (lowEval.outcome == ThicknessOutcome::Rejected) {
+        if (ctx.thicknessCatalog) {
+            grid = allowed.data + firstAllowed;
+            gridSize = allowed.count - firstAllowed;
+        } else {
+            gridSize = steppedGrid.sizeBound();
+        }
+    }
+
+    // Толщина δ_k; false, если k за концом сетки (тогда gridSize - точный размер)
+    auto thicknessAt = [&](int k, double& thickness) {
+        if (grid) {
+            thickness = grid[k];
+            return true;
+        }
+        return steppedGrid.at(k, thickness, gridSize);
+    };
+
+    auto evaluateAt = [&](double thickness) {
+        ++stats.evaluations;
+        return evaluateThickness(material, params, R1, R2, allowEquiv, Di_m, thickness);
+    };
+
+    // === ПОИСК МИНИМАЛЬНОЙ ДОПУСТИМОЙ ТОЛЩИНЫ ===
+
+    // Ищем первый «конечный» исход (Accepted, FlowSpeedFailed или Aborted) на
+    // отрезке [0, gridSize], где k = gridSize - выход за радиус трубы.
+    ThicknessEvaluation highEval;
+    double highThickness = initialDelta;
+    int low = 0;
+    int high = 0;
+    bool hasPrevious = false; // Есть ли последний отвергнутый шаг (low) перед найденным
+
+    if (lowEval.outcome != ThicknessOutcome::Rejected) {
+        highEval = lowEval;
+    } else if (ctx.monotoneMargins) {
+        // Бисекция: исход монотонен по k - сначала Rejected, затем конечный
+        high = gridSize;
+        while (high - low > 1) {
+            int mid = low + (high - low) / 2;
+            double thickness;
+            if (!thicknessAt(mid, thickness)) {
+                high = gridSize; // Сетка кончается раньше mid
+                continue;
+            }
+            ThicknessEvaluation midEval = evaluateAt(thickness);
+            if (midEval.outcome == ThicknessOutcome::Rejected) {
+                low = mid;
+                lowEval = midEval;
+                steppedGrid.advance(mid, thickness);
+            } else {
+                high = mid;
+                highEval = midEval;
+                highThickness = thickness;
             }
-            if (delta >= Di_m / 2.0) {
-                break; // Толщина превышает радиус трубы - физически невозможно
+        }
+        hasPrevious = true;
+    } else {
+        // Пошаговый перебор через 1 мм
+        high = 1;
+        double thickness;
+        while (high < gridSize && thicknessAt(high, thickness)) {
+            highEval = evaluateAt(thickness);
+            if (highEval.outcome != ThicknessOutcome::Rejected) {
+                highThickness = thickness;
+                break;
             }
+            lowEval = highEval;
+            steppedGrid.advance(high, thickness);
+            ++high;
+        }
+        low = high - 1;
+        hasPrevious = true;
+    }
 
-            // === РАСЧЕТ ВНУТРЕННЕГО ДИАМЕТРА (ФОРМУЛА 8) ===
+    // Пошаговый перебор выполнил бы расчет для каждого k до найденного включительно
+    stats.steppedEvaluations += (high < gridSize || gridSize == 0) ? high + 1 : gridSize;
 
-            // d = D - 2δ (где D - наружный диаметр, δ - толщина стенки)
-            double di = Di_m - 2.0 * delta;
-            if (di <= 0) {
-                break; // Внутренний диаметр отрицательный - физически невозможно
-            }
+    if ((gridSize > 0 && high == gridSize) || highEval.outcome == ThicknessOutcome::Aborted) {
+        return false; // Подходящая толщина не найдена - пропускаем этот диаметр
+    }
 
-            // === РАСЧЕТ СКОРОСТИ ПОТОКА (ФОРМУЛА 1) ===
+    res.flowSpeed = highEval.flowSpeed;
 
-            // ϑ = 4G / (ρ * π * d²)
-            // G - массовый расход, ρ - плотность, d - внутренний диаметр
-            double theta = (4.0 * params.massFlow) /
-                           (params.density * M_PI * di * di);
+    if (highEval.outcome == ThicknessOutcome::FlowSpeedFailed) {
+        // Флаги напряжений остаются от последней отвергнутой толщины,
+        // как и при пошаговом переборе
+        res.satisfiesFlowSpeed = false;
+        if (hasPrevious) {
+            res.satisfiesHoopStress = lowEval.satisfiesHoopStress;
+            res.satisfiesAxialStress = lowEval.satisfiesAxialStress;
+            res.satisfiesEquivalentStress = lowEval.satisfiesEquivalentStress;
+        }
+        return true;  // Результат с пометкой невалидный
+    }
 
-            // Проверка на числовую корректность
-            if (std::isnan(theta) || std::isinf(theta)) {
-                break; // Числовая ошибка - прерываем цикл
-            }
+    // === ВСЕ УСЛОВИЯ ПРОЧНОСТИ ВЫПОЛНЕНЫ ===
+    res.satisfiesFlowSpeed = true;
+    res.satisfiesHoopStress = true;
+    res.satisfiesAxialStress = true;
+    res.satisfiesEquivalentStress = true;
+
+    // РАСЧЕТ КОЭФФИЦИЕНТОВ ЗАПАСА ПРОЧНОСТИ
+    // Коэффициент запаса = допускаемое напряжение / фактическое напряжение
+    res.safetyHoop = (highEval.hoop > 0.0) ? R1 / highEval.hoop : 0.0;
+    res.safetyAxial = (highEval.axial > 0.0) ? R2 / highEval.axial : 0.0;
+    res.safetyEquivalent = (highEval.equiv > 0.0) ? allowEquiv / highEval.equiv : 0.0;
+
+    // Сохраняем найденную толщину стенки (в метрах)
+    res.finalThickness = highThickness;
+
+    // Помечаем как оптимальный (пока локально для этого диаметра)
+    res.isOptimal = true;
+    res.isValid = true;
+    return true;
+}
 
-            // Сохраняем скорость потока и проверяем допустимый диапазон (1-3 м/с)
-            res.flowSpeed = theta;
-            res.satisfiesFlowSpeed = (theta >= 1.0 && theta <= 3.0);
+// Общие массивы расчета, заранее выделенные под все диаметры
+struct SweepBuffers {
+    StressBatch* batch;
+    ValidationResult* slots;  // Результат для каждого диаметра
+    quint8* slotFilled;       // Сформирован ли результат для диаметра
+    int* chunkBest;           // Индекс лучшего диаметра в каждом блоке (-1 - нет)
+};
+
+// Обработка блока диаметров: векторный расчет δ_0, подбор толщины
+// и выбор лучшего диаметра внутри блока
+template <class Material>
+void sweepChunk(const SweepContext& ctx, const SweepBuffers& buffers, int chunk,
+                ThicknessSolverStats& stats)
+{
+    const PipelineParameters& params = *ctx.params;
+    const Material material(params);
+    const int begin = chunk * kSweepChunk;
+    const int end = qMin(begin + kSweepChunk, ctx.diameterCount);
+    StressBatch& batch = *buffers.batch;
+
+    // === ПАКЕТНЫЙ РАСЧЕТ НАЧАЛЬНОЙ ТОЛЩИНЫ (ФОРМУЛА 9) ===
+
+    // δ_0 = (y_fp * p * D) / (2 * min(R1, R2)) для диаметров блока считается
+    // векторно (SoA), и большинство диаметров завершается уже на δ_0 - по
+    // скорости потока или сразу с допустимыми напряжениями. Без поддержки
+    // SIMD используется скалярный расчет.
+    //
+    // Для упорядоченного списка (сортамента) в пакет попадают только диаметры
+    // окна скорости потока, найденные двоичным поиском (начало - с точностью
+    // до вектора); остальные решаются скалярно и, как правило, отбраковываются
+    // сразу после расчета ϑ.
+    //
+    // При отбраковке (ctx.screening) δ_0, которые заведомо отвергаются, решаются
+    // в float; в double рассчитываются только группы дорожек с неясным
+    // исходом, а также принятые δ_0 и δ_0 вне диапазона скорости потока - их
+    // значения входят в результат. Напряжения отвергнутой δ_0 дальше не
+    // используются, нужны только ее флаги, поэтому результаты не меняются.
+    int batchBegin = begin;
+    int batchEnd = end;
+    if (ctx.sortedDiameters) {
+        const double* first = std::lower_bound(ctx.diameters + begin, ctx.diameters + end,
+                                               ctx.flowWindowMin);
+        const double* last = std::upper_bound(first, ctx.diameters + end, ctx.flowWindowMax);
+        batchBegin = begin + int(first - (ctx.diameters + begin)) / StressBatch::LaneAlignment *
+                                 StressBatch::LaneAlignment;
+        batchEnd = int(last - ctx.diameters);
+        if (batchEnd <= batchBegin) {
+            batchBegin = batchEnd = begin;
+        }
+    }
 
-            // Если скорость не попадает в допустимый диапазон
-            if (!res.satisfiesFlowSpeed) {
-                results.append(res);  // Добавляем результат (с пометкой невалидный)
-                break; // Прерываем цикл по толщине - нет смысла проверять другие толщины
-            }
+    const bool useBatch = ctx.isa != SimdIsa::None;
+    if (useBatch && batchBegin < batchEnd) {
+        for (int i = batchBegin; i < batchEnd; ++i) {
+            double Di_m = ctx.diameters[i] / 1000.0;
+            batch.outerDiameter[i] = Di_m;
+            batch.thickness[i] = initialThickness(ctx, ctx.diameters[i], Di_m);
+        }
+        if (ctx.screening) {
+            screenStressBatch(ctx.constants, batch, batchBegin, batchEnd, ctx.isa);
+            const int confirmed = confirmStressBatch(ctx.constants, batch, batchBegin, batchEnd, ctx.isa);
+            stats.evaluations += confirmed;
+            stats.screenedDiameters += batchEnd - batchBegin - confirmed;
+        } else {
+            evaluateStressBatch(ctx.constants, batch, batchBegin, batchEnd, ctx.isa);
+            stats.evaluations += batchEnd - batchBegin;
+        }
+    }
 
-            // === РАСЧЕТ ПАРАМЕТРОВ ГИДРОУДАРА (ГУ) ===
+    // === ПОДБОР ТОЛЩИНЫ ДЛЯ КАЖДОГО ДИАМЕТРА БЛОКА ===
 
-            // Скорость распространения ударной волны (формула 4):
-            // c = 1 / √(ρ/E₀ + d/(E*δ))
-            double waveSpeed_val = 1.0 / std::sqrt(
-                                       params.density / params.fluidBulkModulus +
-                                       di / (params.steelYoungModulus * delta)
-                                       );
+    // Каждый диаметр пишет только в свою ячейку заранее выделенных массивов,
+    // поэтому блокировки не нужны
+    int best = -1;
+    for (int i = begin; i < end; ++i) {
+        ValidationResult& res = buffers.slots[i];
+        const bool inBatch = useBatch && i >= batchBegin && i < batchEnd;
+        buffers.slotFilled[i] = solveDiameter(ctx, material, batch, i, inBatch, stats, res);
 
-            if (std::isnan(waveSpeed_val) || std::isinf(waveSpeed_val)) {
-                break; // Числовая ошибка
-            }
+        // Первый диаметр с максимальным минимальным запасом (как std::max_element)
+        if (buffers.slotFilled[i] && res.isOptimal &&
+            (best < 0 || minSafety(buffers.slots[best]) < minSafety(res))) {
+            best = i;
+        }
+    }
+    buffers.chunkBest[chunk] = best;
+}
 
-            // Приращение давления при гидроударе (формула 3):
-            // Δp = ρ * c * ϑ (в Па, затем конвертируем в МПа)
-            double pressureSurge_val = params.density * waveSpeed_val * theta / 1000000.0;
+// Инстанциация sweepChunk для политики материала
+SweepChunkFunction sweepChunkFor(MaterialPolicy material)
+{
+    switch (material) {
+    case MaterialPolicy::Mode1:
+        return &sweepChunk<Mode1Material>;
+    case MaterialPolicy::PipelineSteel:
+        return &sweepChunk<SteelMaterial<PipelineSteel>>;
+    case MaterialPolicy::TypicalSteel:
+        return &sweepChunk<SteelMaterial<TypicalSteel>>;
+    case MaterialPolicy::Runtime:
+        break;
+    }
+    return &sweepChunk<RuntimeMaterial>;
+}
 
-            if (std::isnan(pressureSurge_val) || std::isinf(pressureSurge_val)) {
-                qDebug() << "  ОШИБКА: Давление ГУ - NaN или Inf, pressureSurge_val =" << pressureSurge_val;
-                break;
-            }
+// Контекст расчета диаметров diameters при скалярных параметрах load
+SweepContext makeContext(const SolverInvariants& invariants, const PipelineParameters& load,
+                         const double* diameters, int diameterCount,
+                         const ThicknessCatalog* thicknessCatalog, bool screening)
+{
+    SweepContext ctx;
+    ctx.params = &load;
+    ctx.diameters = diameters;
+    ctx.diameterCount = diameterCount;
+    ctx.R1 = invariants.resistance.R1;
+    ctx.R2 = invariants.resistance.R2;
+    ctx.allowEquiv = invariants.resistance.allowEquiv;
+    ctx.monotoneMargins = invariants.monotoneMargins;
+    ctx.isa = invariants.isa;
+    ctx.constants = invariants.constants;
+    ctx.constants.pressure = load.pressure;
+    ctx.sweepChunk = sweepChunkFor(invariants.material);
+    setFlowWindow(ctx, load);
+    ctx.sortedDiameters = std::is_sorted(diameters, diameters + diameterCount);
+    ctx.thicknessCatalog = thicknessCatalog;
+    ctx.screening = screening;
+    return ctx;
+}
 
-            // Полное давление при гидроударе (рабочее + приращение)
-            double pressureAtSurge_val = params.pressure + pressureSurge_val;
+// Сбор результатов в исходном порядке диаметров и выбор оптимального
+void collectResults(const SweepBuffers& buffers, int diameterCount, int chunkCount,
+                    QVector<ValidationResult>& results)
+{
+    results.clear();
+    results.reserve(diameterCount);             // Резервирование памяти для эффективности
+    for (int i = 0; i < diameterCount; ++i) {
+        if (buffers.slotFilled[i]) {
+            results.append(buffers.slots[i]);
+        }
+    }
 
-            if (std::isnan(pressureAtSurge_val) || std::isinf(pressureAtSurge_val)) {
-                break;
-            }
+    // === ВЫБОР ОПТИМАЛЬНОГО ДИАМЕТРА СРЕДИ ВСЕХ ПОДХОДЯЩИХ ===
 
-            // === РАСЧЕТ КОЛЬЦЕВЫХ НАПРЯЖЕНИЙ (ФОРМУЛА 10) ===
+    // Лучшие диаметры блоков сводятся в порядке блоков; при равных запасах
+    // побеждает более ранний, как у std::max_element в последовательном расчете
+    int best = -1;
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        int candidate = buffers.chunkBest[chunk];
+        if (candidate >= 0 &&
+            (best < 0 || minSafety(buffers.slots[best]) < minSafety(buffers.slots[candidate]))) {
+            best = candidate;
+        }
+    }
 
-            // σ_кц = (y_fp * p_гуд * D) / (2δ)
-            // Напряжение от давления с учетом гидроудара
-            double hoop = (params.pressureReliability * pressureAtSurge_val * Di_m) /
-                          (2.0 * delta);
+    if (best >= 0) {
+        // Находим диаметр с МАКСИМАЛЬНЫМ минимальным коэффициентом запаса
+        // (наиболее надежный вариант)
+        const ValidationResult& bestResult = buffers.slots[best];
 
-            if (std::isnan(hoop) || std::isinf(hoop)) {
-                break;
-            }
+        // Помечаем только найденный оптимальный диаметр
+        for (auto& res : results) {
+            // Сравнение с плавающей точкой с заданной точностью
+            res.isOptimal = (qFuzzyCompare(res.diameter, bestResult.diameter));
+        }
+    } else {
+        // Если ни один диаметр не подошел - сбрасываем флаги оптимальности
+        for (auto& res : results) {
+            res.isOptimal = false;
+        }
+    }
+}
 
-            // === РАСЧЕТ ОСЕВЫХ НАПРЯЖЕНИЙ (ФОРМУЛА 14) ===
+} // namespace
 
-            // Составляющие осевого напряжения:
-            double thermalTerm = -params.steelYoungModulus *
-                                 params.thermalExpansionCoeff *
-                                 params.temperatureDelta; // Термическая составляющая
+// Расчетные сопротивления по текучести и прочности (формулы из СНиП/СП)
+// и допускаемое эквивалентное напряжение (f_eq = 0.9 по СП 36.13330)
+DesignResistance DesignResistance::fromParameters(const PipelineParameters& params)
+{
+    DesignResistance r;
+    designResistance(params, r.R1, r.R2, r.allowEquiv);
+    return r;
+}
 
-            double bendTerm = 0.0; // Изгибная составляющая
-            if (params.bendRadius > 0) {
-                // Влияние изгиба трубы: σ_изг = E * D / (2r)
-                bendTerm = (params.steelYoungModulus * Di_m) / (2.0 * params.bendRadius);
-            }
+SolverInvariants SolverInvariants::fromParameters(const PipelineParameters& params)
+{
+    // R1 - по текучести, R2 - по прочности, allowEquiv - допускаемое эквивалентное напряжение
+    SolverInvariants invariants;
+    invariants.resistance = DesignResistance::fromParameters(params);
+    invariants.constants = StressConstants::fromParameters(params, invariants.resistance.R1,
+                                                           invariants.resistance.R2,
+                                                           invariants.resistance.allowEquiv);
+
+    // === ПРОВЕРКА МОНОТОННОСТИ ЗАПАСОВ ПО ТОЛЩИНЕ ===
+
+    // С ростом δ кольцевое напряжение σ_кц убывает, а скорость потока растет.
+    // Без изгиба σ_пр = μσ_кц + σ_t убывает вместе с σ_кц, а σ_экв² =
+    // (1 - μ + μ²)σ_кц² + (2μ - 1)σ_t·σ_кц + σ_t² убывает при (2μ - 1)σ_t ≥ 0.
+    // Тогда после первой подходящей толщины все следующие тоже подходят и
+    // минимальную толщину можно искать бисекцией. При изгибе (r > 0) знак σ_пр
+    // переключается между ветвями «+» и «-», σ_экв скачком растет, и остается
+    // пошаговый перебор.
+    invariants.monotoneMargins = !(params.bendRadius > 0) &&
+                                 (2.0 * params.poissonRatio - 1.0) * invariants.constants.thermalTerm >= 0.0;
+    invariants.isa = detectSimdIsa();
+
+    // Типовые параметры режима 1 и трубные стали (прямая труба) считаются
+    // специализированным кодом со свернутыми константами, остальные - общим
+    invariants.material = selectMaterialPolicy(params);
+    return invariants;
+}
 
-            // Два варианта: "+" и "-" (наиболее опасный случай)
-            double axialPlus = params.poissonRatio * hoop + thermalTerm + bendTerm;
-            double axialMinus = params.poissonRatio * hoop + thermalTerm - bendTerm;
+// Проверка трубы с наружным диаметром outerDiameter (мм) и толщиной стенки
+// thickness (м) по всем условиям calculate(); напряжения считаются и при
+// недопустимой скорости потока
+ThicknessCheck PipelineOptimizer::checkThickness(const PipelineParameters& params,
+                                                 const DesignResistance& resistance,
+                                                 double outerDiameter, double thickness)
+{
+    ThicknessCheck check;
+    ThicknessEvaluation ev = evaluateThickness(RuntimeMaterial(params), params, resistance.R1, resistance.R2,
+                                               resistance.allowEquiv,
+                                               outerDiameter / 1000.0, thickness, false);
+    if (ev.outcome == ThicknessOutcome::Aborted) {
+        return check;
+    }
 
-            // Берем максимальное по абсолютной величине (наиболее опасное)
-            double axial = std::abs(axialPlus) > std::abs(axialMinus) ? axialPlus : axialMinus;
+    check.isValid = true;
+    check.flowSpeed = ev.flowSpeed;
+    check.hoop = ev.hoop;
+    check.axial = ev.axial;
+    check.equivalent = ev.equiv;
+    check.satisfiesFlowSpeed = ev.outcome != ThicknessOutcome::FlowSpeedFailed;
+    check.satisfiesHoopStress = ev.satisfiesHoopStress;
+    check.satisfiesAxialStress = ev.satisfiesAxialStress;
+    check.satisfiesEquivalentStress = ev.satisfiesEquivalentStress;
+    return check;
+}
 
-            if (std::isnan(axial) || std::isinf(axial)) {
-                break;
+double PipelineOptimizer::catalogThickness(const PipelineParameters& params,
+                                           const DesignResistance& resistance,
+                                           const ThicknessCatalog& catalog, double outerDiameter,
+                                           ThicknessCheck* check, int* checks)
+{
+    // Как в solveDiameter(): толщины от δ_0 до первого исхода, кроме
+    // «отвергнута» (все условия выполнены, скорость потока вне диапазона или
+    // ошибка расчета); с ростом δ скорость потока только растет
+    const ThicknessCatalog::Thicknesses allowed = catalog.thicknesses(outerDiameter);
+    const double Di_m = outerDiameter / 1000.0;
+    for (int k = allowed.lowerBound(formulaThickness(params, resistance.R1, resistance.R2, Di_m));
+         k < allowed.count; ++k) {
+        const ThicknessCheck current = checkThickness(params, resistance, outerDiameter, allowed[k]);
+        if (checks) {
+            ++*checks;
+        }
+        if (current.passes()) {
+            if (check) {
+                *check = current;
             }
+            return allowed[k];
+        }
+        if (!current.isValid || !current.satisfiesFlowSpeed) {
+            break;
+        }
+    }
+    return 0.0;
+}
 
-            // === РАСЧЕТ ЭКВИВАЛЕНТНЫХ НАПРЯЖЕНИЙ (ФОРМУЛА 15) ===
+PipelineOptimizer::PipelineOptimizer()
+    : m_threadCount(1)
+    , m_cache(nullptr)
+    , m_thicknessCatalog(nullptr)
+    , m_screening(true)
+{
+}
 
-            // σ_экв = √(σ_кц² - σ_кц * σ_пр + σ_пр²) (по теории Мизеса-Генки)
-            double equiv = std::sqrt(hoop * hoop - hoop * axial + axial * axial);
+void PipelineOptimizer::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
 
-            if (std::isnan(equiv) || std::isinf(equiv)) {
-                break;
-            }
+int PipelineOptimizer::threadCount() const
+{
+    return m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+}
 
-            // === ПРОВЕРКА УСЛОВИЙ ПРОЧНОСТИ ===
+// Основной метод расчета оптимальных параметров трубопровода
+QVector<ValidationResult> PipelineOptimizer::calculate(const PipelineParameters& params)
+{
+    QVector<ValidationResult> results;          // Вектор для хранения результатов расчета
+    calculate(params, results);
+    return results; // Возвращаем все результаты расчета
+}
 
-            // Проверка по кольцевым напряжениям
-            res.satisfiesHoopStress = hoop <= R1;
+// Расчет с записью в переданный вектор: его память переиспользуется
+// между вызовами (развертки по параметрам, пакетная обработка)
+void PipelineOptimizer::calculate(const PipelineParameters& params, QVector<ValidationResult>& results)
+{
+    m_stats = ThicknessSolverStats();
 
-            // Проверка по осевым напряжениям
-            res.satisfiesAxialStress = axial <= R2;
+    // С каталогом толщин результаты зависят и от его содержимого
+    const QByteArray cacheVariant = m_thicknessCatalog ? m_thicknessCatalog->fingerprint() : QByteArray();
+    if (m_cache && m_cache->find(params, results, cacheVariant)) {
+        return;
+    }
 
-            // Проверка по эквивалентным напряжениям
-            res.satisfiesEquivalentStress = equiv <= allowEquiv;
+    // === РАСЧЕТ ИНВАРИАНТОВ (R1, R2, allowEquiv, ПОЛИТИКА МАТЕРИАЛА) ===
 
-            // === ПРОВЕРКА ВСЕХ УСЛОВИЙ ПРОЧНОСТИ ОДНОВРЕМЕННО ===
-            if (res.satisfiesHoopStress &&
-                res.satisfiesAxialStress &&
-                res.satisfiesEquivalentStress) {
+    const SolverInvariants invariants = SolverInvariants::fromParameters(params);
+    const DesignResistance& resistance = invariants.resistance;
 
-                // РАСЧЕТ КОЭФФИЦИЕНТОВ ЗАПАСА ПРОЧНОСТИ
-                // Коэффициент запаса = допускаемое напряжение / фактическое напряжение
-                res.safetyHoop = (hoop > 0.0) ? R1 / hoop : 0.0;
-                res.safetyAxial = (axial > 0.0) ? R2 / axial : 0.0;
-                res.safetyEquivalent = (equiv > 0.0) ? allowEquiv / equiv : 0.0;
+    qDebug() << "calculate: R1 =" << resistance.R1 << ", R2 =" << resistance.R2
+             << ", allowEquiv =" << resistance.allowEquiv;
 
-                // Сохраняем найденную толщину стенки (в метрах)
-                res.finalThickness = delta;
+    const int diameterCount = params.outerDiameters.size();
+    const SweepContext ctx = makeContext(invariants, params, params.outerDiameters.constData(),
+                                         diameterCount, m_thicknessCatalog, m_screening);
 
-                // Помечаем как оптимальный (пока локально для этого диаметра)
-                res.isOptimal = true;
-                res.isValid = true;
-                foundValid = true; // Флаг, что для этого диаметра найден подходящий вариант
+    // === ПОДГОТОВКА МАССИВОВ ПОД ВСЕ ДИАМЕТРЫ ===
 
-                results.append(res); // Добавляем успешный результат
+    const int chunkCount = (diameterCount + kSweepChunk - 1) / kSweepChunk;
+    m_batch.resize(diameterCount);
+    m_slots.resize(diameterCount);
+    m_slotFilled.resize(diameterCount);
+    m_chunkBest.resize(chunkCount);
 
-                // Выходим из цикла по толщине - нашли первую подходящую толщину
-                // (алгоритм использует минимально допустимую толщину)
-                break;
-            } else {
-                // Условия прочности не выполнены - УВЕЛИЧИВАЕМ ТОЛЩИНУ СТЕНКИ
-                qDebug() << "  Напряжения не подходят. Увеличиваем толщину на 1 мм.";
-                delta += 0.001; // Увеличение на 1 мм (0.001 м)
-
-                // Проверяем, не превышает ли толщина физический предел
-                if (delta >= Di_m / 2.0) {
-                    break; // Толщина превысила радиус - прерываем цикл
-                }
-                // Продолжаем цикл с увеличенной толщиной
-            }
-        } // Конец цикла по толщине
+    SweepBuffers buffers;
+    buffers.batch = &m_batch;
+    buffers.slots = m_slots.data();
+    buffers.slotFilled = m_slotFilled.data();
+    buffers.chunkBest = m_chunkBest.data();
 
-        // Если для текущего диаметра не найден подходящий вариант
-        if (!foundValid) {
-            // Не добавляем результат - пропускаем этот диаметр
-        }
-    } // Конец цикла по диаметрам
+    const int workers = parallelWorkerCount(chunkCount, m_threadCount);
+    if (m_workspaces.size() < workers) {
+        m_workspaces.resize(workers);
+    }
+    for (Workspace& workspace : m_workspaces) {
+        workspace.stats = ThicknessSolverStats();
+    }
 
-    // === ВЫБОР ОПТИМАЛЬНОГО ДИАМЕТРА СРЕДИ ВСЕХ ПОДХОДЯЩИХ ===
+    // === ЦИКЛ ПЕРЕБОРА ДИАМЕТРОВ ИЗ СОРТАМЕНТА ===
 
-    // Собираем все успешные результаты
-    QVector<ValidationResult> validResults;
-    for (const auto& res : results) {
-        if (res.isOptimal) {
-            validResults.append(res);
-        }
+    Workspace* workspaces = m_workspaces.data();
+    parallelForBlocks(chunkCount, m_threadCount, [&ctx, &buffers, workspaces](qint64 chunk, int worker) {
+        Workspace& workspace = workspaces[worker];
+        ctx.sweepChunk(ctx, buffers, int(chunk), workspace.stats);
+    });
+
+    // === СБОР РЕЗУЛЬТАТОВ И ВЫБОР ОПТИМАЛЬНОГО ДИАМЕТРА ===
+
+    collectResults(buffers, diameterCount, chunkCount, results);
+
+    for (const Workspace& workspace : m_workspaces) {
+        m_stats.evaluations += workspace.stats.evaluations;
+        m_stats.steppedEvaluations += workspace.stats.steppedEvaluations;
+        m_stats.prunedDiameters += workspace.stats.prunedDiameters;
+        m_stats.screenedDiameters += workspace.stats.screenedDiameters;
     }
 
-    if (!validResults.isEmpty()) {
-        // Находим диаметр с МАКСИМАЛЬНЫМ минимальным коэффициентом запаса
-        // (наиболее надежный вариант)
-        auto bestIt = std::max_element(validResults.begin(), validResults.end(),
-                                       [](const ValidationResult& a, const ValidationResult& b) {
-                                           // Находим минимальный коэффициент запаса для каждого варианта
-                                           double minSafetyA = std::min({a.safetyHoop,
-                                                                         a.safetyAxial,
-                                                                         a.safetyEquivalent});
-                                           double minSafetyB = std::min({b.safetyHoop,
-                                                                         b.safetyAxial,
-                                                                         b.safetyEquivalent});
-                                           // Ищем максимальный из минимальных запасов
-                                           return minSafetyA < minSafetyB;
-                                       });
+    qDebug() << "calculate: расчетов напряжений" << m_stats.evaluations
+             << "вместо" << m_stats.steppedEvaluations
+             << ", сэкономлено" << m_stats.savedEvaluations()
+             << ", вне окна скорости потока" << m_stats.prunedDiameters
+             << ", отбраковано в float" << m_stats.screenedDiameters;
 
-        // Помечаем только найденный оптимальный диаметр
-        for (auto& res : results) {
-            // Сравнение с плавающей точкой с заданной точностью
-            res.isOptimal = (qFuzzyCompare(res.diameter, bestIt->diameter));
-        }
+    if (m_cache) {
+        m_cache->insert(params, results, cacheVariant);
+    }
+}
 
-        // Дополнительная информация об оптимальном варианте
-        double minSafety = std::min({bestIt->safetyHoop,
-                                     bestIt->safetyAxial,
-                                     bestIt->safetyEquivalent});
-    } else {
-        // Если ни один диаметр не подошел - сбрасываем флаги оптимальности
-        for (auto& res : results) {
-            res.isOptimal = false;
+// === ПОДГОТОВЛЕННЫЙ РАСЧЕТ ===
+
+PreparedPlan::PreparedPlan(const PipelineParameters& params, const ThicknessCatalog* thicknessCatalog)
+    : m_params(params)
+    , m_thicknessCatalog(thicknessCatalog)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (!std::isfinite(params.*f.field)) {
+            throw std::invalid_argument(
+                QString("Поле \"%1\" не является конечным числом.").arg(f.name).toStdString());
         }
     }
+    if (params.massFlow <= 0 || params.density <= 0) {
+        throw std::invalid_argument("Массовый расход и плотность должны быть положительными.");
+    }
+    validateOuterDiameters(params.outerDiameters);
 
-    return results; // Возвращаем все результаты расчета
+    m_invariants = SolverInvariants::fromParameters(params);
+}
+
+void PreparedPlan::execute(Workspace& workspace, QVector<ValidationResult>& results) const
+{
+    execute(workspace, m_params.outerDiameters, m_params.pressure, results);
+}
+
+void PreparedPlan::execute(Workspace& workspace, double pressure, QVector<ValidationResult>& results) const
+{
+    execute(workspace, m_params.outerDiameters, pressure, results);
+}
+
+// Расчет в одном потоке: блоки диаметров обрабатываются по порядку в буферах workspace
+void PreparedPlan::execute(Workspace& workspace, const QVector<double>& diameters, double pressure,
+                           QVector<ValidationResult>& results) const
+{
+    if (&diameters != &m_params.outerDiameters) {
+        validateOuterDiameters(diameters);
+    }
+    if (!std::isfinite(pressure)) {
+        throw std::invalid_argument("Давление не является конечным числом.");
+    }
+
+    // Скалярные параметры копируются без списка диаметров: он передается отдельно
+    PipelineParameters& load = workspace.m_load;
+    for (const ParameterField& f : parameterFields()) {
+        load.*f.field = m_params.*f.field;
+    }
+    load.mode = m_params.mode;
+    load.pressure = pressure;
+
+    const int diameterCount = diameters.size();
+    const SweepContext ctx = makeContext(m_invariants, load, diameters.constData(), diameterCount,
+                                         m_thicknessCatalog, true);
+
+    // Буферы растут только при первом выполнении с таким числом диаметров
+    const int chunkCount = (diameterCount + kSweepChunk - 1) / kSweepChunk;
+    workspace.m_batch.resize(diameterCount);
+    workspace.m_slots.resize(diameterCount);
+    workspace.m_slotFilled.resize(diameterCount);
+    workspace.m_chunkBest.resize(chunkCount);
+
+    SweepBuffers buffers;
+    buffers.batch = &workspace.m_batch;
+    buffers.slots = workspace.m_slots.data();
+    buffers.slotFilled = workspace.m_slotFilled.data();
+    buffers.chunkBest = workspace.m_chunkBest.data();
+
+    workspace.m_stats = ThicknessSolverStats();
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        ctx.sweepChunk(ctx, buffers, chunk, workspace.m_stats);
+    }
+
+    collectResults(buffers, diameterCount, chunkCount, results);
 }
@@ -3,13 +3,193 @@
 
 #include "pipelineparameters.h"
 #include "pipelinecommon.h"
+#include "materialpolicy.h"
+#include "pipelinebatchkernel.h"
+#include "sortament.h"
+#include "thicknesscatalog.h"
 #include <QVector>
 #include <QtGlobal> // For M_PI
 
+class ResultCache;
+
+// Статистика подбора толщины стенки за последний вызов calculate()
+struct ThicknessSolverStats {
+    int evaluations = 0;         // Фактически выполнено расчетов напряжений
+    int steppedEvaluations = 0;  // Сколько расчетов потребовал бы перебор с шагом 1 мм
+    int prunedDiameters = 0;     // Диаметры вне пакета, отвергнутые по скорости потока без расчета напряжений
+    int screenedDiameters = 0;   // δ_0, отвергнутые отбраковкой в float без расчета в double
+
+    // Количество сэкономленных расчетов по сравнению с пошаговым перебором
+    int savedEvaluations() const { return steppedEvaluations - evaluations; }
+};
+
+// Расчетные сопротивления стали и допускаемое эквивалентное напряжение
+struct DesignResistance {
+    double R1;          // Расчетное сопротивление по текучести, МПа
+    double R2;          // Расчетное сопротивление по прочности, МПа
+    double allowEquiv;  // Допускаемое эквивалентное напряжение, МПа
+
+    static DesignResistance fromParameters(const PipelineParameters& params);
+};
+
+// Величины расчета, не зависящие от диаметров и давления
+struct SolverInvariants {
+    DesignResistance resistance;
+    StressConstants constants;  // Для пакетного расчета (давление - из параметров)
+    bool monotoneMargins;       // Можно ли искать толщину бисекцией
+    SimdIsa isa;
+    MaterialPolicy material;
+
+    static SolverInvariants fromParameters(const PipelineParameters& params);
+};
+
+// Проверка трубы с заданной толщиной стенки по условиям calculate()
+struct ThicknessCheck {
+    bool isValid = false;                   // Расчет выполнен без геометрических и числовых ошибок
+    double flowSpeed = 0.0;                 // ϑ, м/с
+    double hoop = 0.0;                      // σ_кц, МПа
+    double axial = 0.0;                     // σ_пр, МПа
+    double equivalent = 0.0;                // σ_экв, МПа
+    bool satisfiesFlowSpeed = false;
+    bool satisfiesHoopStress = false;
+    bool satisfiesAxialStress = false;
+    bool satisfiesEquivalentStress = false;
+
+    // Выполнены ли все условия
+    bool passes() const {
+        return isValid && satisfiesFlowSpeed && satisfiesHoopStress &&
+               satisfiesAxialStress && satisfiesEquivalentStress;
+    }
+};
 
 class PipelineOptimizer {
 public:
+    // Версия расчетных формул: входит в ключ ResultCache и увеличивается при
+    // любом изменении, влияющем на результаты calculate()
+    static constexpr quint32 SolverVersion = 2;
+
+    PipelineOptimizer();
+
     QVector<ValidationResult> calculate(const PipelineParameters& params);
+    void calculate(const PipelineParameters& params, QVector<ValidationResult>& results);
+
+    const ThicknessSolverStats& lastStats() const { return m_stats; }
+
+    // Проверка трубы с наружным диаметром outerDiameter (мм) и толщиной
+    // стенки thickness (м) при заданных параметрах
+    static ThicknessCheck checkThickness(const PipelineParameters& params,
+                                         const DesignResistance& resistance,
+                                         double outerDiameter, double thickness);
+
+    // Толщина стенки (м), которую calculate() с каталогом catalog выбирает для
+    // трубы с наружным диаметром outerDiameter (мм): наименьшая толщина
+    // диаметра не меньше δ_0, при которой выполнены все условия; 0 - диаметра
+    // нет в каталоге или подходящей толщины нет. check - проверка выбранной
+    // толщины, checks увеличивается на число проверок (checkThickness()).
+    static double catalogThickness(const PipelineParameters& params, const DesignResistance& resistance,
+                                   const ThicknessCatalog& catalog, double outerDiameter,
+                                   ThicknessCheck* check = nullptr, int* checks = nullptr);
+
+    // Ближайшая стандартная толщина стенки (м) не меньше thickness (м) для
+    // трубы с наружным диаметром outerDiameter (мм) по сортаменту; 0 - диаметр
+    // нестандартный или такой толщины в сортаменте нет
+    static constexpr double standardThickness(double outerDiameter, double thickness) {
+        return Sortament::nextStandardThickness(outerDiameter, thickness * 1000.0) / 1000.0;
+    }
+
+    // Количество потоков расчета, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+    int threadCount() const;
+
+    // Кэш результатов (не принадлежит оптимизатору; nullptr - без кэша).
+    // При попадании в кэш lastStats() обнуляется.
+    void setCache(ResultCache* cache) { m_cache = cache; }
+
+    // Каталог допустимых толщин (не принадлежит оптимизатору; nullptr - подбор
+    // с шагом 1 мм, по умолчанию). С каталогом толщина - наименьшая допустимая
+    // толщина диаметра, при которой выполнены все условия; диаметр, которого
+    // нет в каталоге, дает невалидный результат (isValid = false).
+    void setThicknessCatalog(const ThicknessCatalog* catalog) { m_thicknessCatalog = catalog; }
+    const ThicknessCatalog* thicknessCatalog() const { return m_thicknessCatalog; }
+
+    // Двухэтапный пакетный расчет δ_0 (по умолчанию включен): отбраковка в
+    // одинарной точности и расчет в double только неясных случаев, см.
+    // screenStressBatch(). Результаты побитово совпадают с расчетом только в double.
+    void setScreening(bool enabled) { m_screening = enabled; }
+    bool screening() const { return m_screening; }
+
+private:
+    // Рабочие буферы одного потока расчета
+    struct Workspace {
+        ThicknessSolverStats stats;
+    };
+
+    int m_threadCount;
+    ResultCache* m_cache;
+    const ThicknessCatalog* m_thicknessCatalog;
+    bool m_screening;
+    ThicknessSolverStats m_stats;
+    StressBatch m_batch;                 // Пакет диаметров для векторного расчета δ_0
+    QVector<ValidationResult> m_slots;   // Результат для каждого диаметра
+    QVector<quint8> m_slotFilled;        // Сформирован ли результат для диаметра
+    QVector<int> m_chunkBest;            // Лучший диаметр каждого блока
+    QVector<Workspace> m_workspaces;     // Буферы потоков
+};
+
+// Подготовленный расчет для многократного выполнения.
+//
+// Параметры один раз проверяются и переводятся в инварианты (R1, R2,
+// допускаемое напряжение, константы формул, политика материала), после чего
+// план выполняется для своего списка диаметров, для других списков и при
+// других давлениях. Результаты совпадают с PipelineOptimizer::calculate() для
+// тех же параметров.
+//
+// План не изменяется при выполнении, поэтому его можно выполнять из многих
+// потоков одновременно - у каждого потока свой Workspace. Буферы Workspace
+// растут только до наибольшего списка диаметров и затем переиспользуются.
+class PreparedPlan {
+public:
+    // Рабочие буферы выполнения (по одному на поток)
+    class Workspace {
+    public:
+        // Статистика подбора толщины за последнее выполнение
+        const ThicknessSolverStats& lastStats() const { return m_stats; }
+
+    private:
+        friend class PreparedPlan;
+
+        PipelineParameters m_load;           // Скалярные параметры выполнения
+        StressBatch m_batch;
+        QVector<ValidationResult> m_slots;
+        QVector<quint8> m_slotFilled;
+        QVector<int> m_chunkBest;
+        ThicknessSolverStats m_stats;
+    };
+
+    // Проверка и подготовка параметров. Некорректные параметры (нечисловые
+    // значения, G ≤ 0, ρ ≤ 0, диаметры вне 100-1400 мм) - std::invalid_argument.
+    // thicknessCatalog - как PipelineOptimizer::setThicknessCatalog() (должен
+    // существовать, пока используется план).
+    explicit PreparedPlan(const PipelineParameters& params,
+                          const ThicknessCatalog* thicknessCatalog = nullptr);
+
+    const PipelineParameters& parameters() const { return m_params; }
+    const SolverInvariants& invariants() const { return m_invariants; }
+
+    // Расчет для диаметров и давления из параметров плана
+    void execute(Workspace& workspace, QVector<ValidationResult>& results) const;
+
+    // Расчет при другом эксплуатационном давлении, МПа
+    void execute(Workspace& workspace, double pressure, QVector<ValidationResult>& results) const;
+
+    // Расчет для другого списка диаметров (мм, проверяется так же) и давления
+    void execute(Workspace& workspace, const QVector<double>& diameters, double pressure,
+                 QVector<ValidationResult>& results) const;
+
+private:
+    PipelineParameters m_params;
+    SolverInvariants m_invariants;
+    const ThicknessCatalog* m_thicknessCatalog;
 };
 
 #endif // PIPELINEOPTIMIZER_H
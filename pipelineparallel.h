@@ -0,0 +1,66 @@
+#ifndef PIPELINEPARALLEL_H
+#define PIPELINEPARALLEL_H
+
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+
+// Параллельная обработка блоков, общая для расчетных модулей.
+//
+// Число потоков threads задается во всех модулях одинаково (их
+// setThreadCount()): 1 - последовательный расчет, 0 - по числу ядер
+// процессора (QThread::idealThreadCount()).
+
+// Число исполнителей для blockCount блоков: не больше числа потоков и
+// числа блоков, не меньше 1
+inline int parallelWorkerCount(qint64 blockCount, int threads)
+{
+    const int available = threads > 0 ? threads : qMax(1, QThread::idealThreadCount());
+    return int(qBound<qint64>(1, blockCount, available));
+}
+
+// Вызов fn(block, worker) для каждого блока 0..blockCount-1, где worker -
+// номер исполнителя 0..parallelWorkerCount() - 1. Блоки одного исполнителя
+// обрабатываются последовательно, поэтому рабочие массивы можно держать по
+// одному на исполнителя.
+//
+// Блоки раздаются через общий атомарный счетчик - по возрастанию номеров, но
+// какой исполнитель получит блок, зависит от времени расчета. Поэтому
+// результат, который не должен зависеть от числа потоков, записывается по
+// номеру блока и сводится после возврата в порядке блоков.
+//
+// Исполнитель 0 - вызывающий поток, остальные - задачи глобального
+// QThreadPool: расчет не зависит от загрузки пула и завершается до возврата.
+// С одним исполнителем блоки обрабатываются по порядку без пула.
+template <typename Function>
+void parallelForBlocks(qint64 blockCount, int threads, const Function& fn)
+{
+    const int workers = parallelWorkerCount(blockCount, threads);
+    if (workers <= 1) {
+        for (qint64 block = 0; block < blockCount; ++block) {
+            fn(block, 0);
+        }
+        return;
+    }
+
+    std::atomic<qint64> nextBlock(0);
+    auto work = [&fn, &nextBlock, blockCount](int worker) {
+        for (qint64 block = nextBlock++; block < blockCount; block = nextBlock++) {
+            fn(block, worker);
+        }
+    };
+
+    QSemaphore finished;
+    QThreadPool* pool = QThreadPool::globalInstance();
+    for (int w = 1; w < workers; ++w) {
+        pool->start([&work, &finished, w]() {
+            work(w);
+            finished.release();
+        });
+    }
+    work(0);
+    finished.acquire(workers - 1);
+}
+
+#endif // PIPELINEPARALLEL_H
@@ -27,6 +27,12 @@ struct ValidationResult {
     bool isValid = false;          // Общая валидность результата
 };
 
+// Участок трубы с заданными диаметром и толщиной стенки
+struct PipeSection {
+    double outerDiameter = 0.0;  // Наружный диаметр, мм
+    double thickness = 0.0;      // Толщина стенки, м
+};
+
 // Информация о сегменте трубопровода для графического отображения
 struct PipeSegmentInfo {
     int segmentIndex;              // Индекс сегмента трубопровода
@@ -59,8 +65,13 @@ struct PipelineParameters {
     double poissonRatio;           // μ - Коэффициент Пуассона (безразмерный)
     double thermalExpansionCoeff;  // α - Коэффициент линейного температурного расширения, 1/°C
     double bendRadius;             // r - Радиус упругого изгиба трубопровода, м
+    double viscosity;              // ν - Кинематическая вязкость перекачиваемой среды, мм²/с (сСт)
 
     Mode mode;
 };
 
+// Количество скалярных полей PipelineParameters (все поля, кроме
+// outerDiameters и mode; список - parameterFields() в parameterfields.h)
+constexpr int ParameterFieldCount = 17;
+
 #endif // PIPELINEPARAMETERS_H
@@ -0,0 +1,264 @@
+#include "pressurelimit.h"
+#include "materialpolicy.h"
+#include "pipelineformulas.h"
+#include "parameterfields.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Давление - единственная переменная дифференцирования
+using PressureDual = Dual<1>;
+
+// Размер блока участков пакетного расчета
+const int kSectionBlock = 256;
+
+// Точек просмотра отрезка [0, p(σ_кц = R1)] перед уточнением
+const int kScanPoints = 16;
+
+// Исход проверки при одном давлении
+struct PressureProbe {
+    bool isValid = false;   // Расчет выполнен без геометрических и числовых ошибок
+    bool flowSpeedFailed = false; // Скорость потока вне 1-3 м/с - напряжения не рассчитаны
+    bool passes = false;    // Выполнены все условия (как в calculate())
+    double margin = 0.0;    // Наименьший относительный запас (R - σ)/R
+    double slope = 0.0;     // d(margin)/dp
+    PressureCriterion criterion = PressureCriterion::Hoop; // Условие с наименьшим запасом
+    double hoop = 0.0;      // σ_кц, МПа
+    double hoopSlope = 0.0; // dσ_кц/dp
+    double surge = 0.0;     // Δp, МПа
+};
+
+// Расчет напряжений участка при заданном давлении с производной по нему
+class PressureEvaluator {
+public:
+    PressureEvaluator(const BasicScalarParameters<PressureDual>& scalars, double Di_m, double delta)
+        : m_scalars(scalars)
+        , m_material(scalars)
+        , m_Di_m(Di_m)
+        , m_delta(delta)
+    {
+        designResistance(m_scalars, m_R1, m_R2, m_allowEquiv);
+    }
+
+    PressureProbe probe(double pressure)
+    {
+        m_scalars.pressure = PressureDual::variable(pressure, 0);
+        const BasicThicknessEvaluation<PressureDual> ev =
+            evaluateThickness(m_material, m_scalars, m_R1, m_R2, m_allowEquiv, m_Di_m, m_delta);
+        ++m_evaluations;
+
+        PressureProbe probe;
+        if (ev.outcome == ThicknessOutcome::Aborted) {
+            return probe;
+        }
+        probe.isValid = true;
+        if (ev.outcome == ThicknessOutcome::FlowSpeedFailed) {
+            probe.flowSpeedFailed = true;
+            return probe;
+        }
+        probe.passes = ev.outcome == ThicknessOutcome::Accepted;
+        probe.hoop = ev.hoop.value;
+        probe.hoopSlope = ev.hoop.gradient[0];
+
+        // Δp = σ_кц·2δ/(y_fp·D) - p (формула 10)
+        probe.surge = ev.hoop.value * 2.0 * valueOf(m_delta) /
+                      (valueOf(m_scalars.pressureReliability) * valueOf(m_Di_m)) - pressure;
+
+        const PressureDual margins[3] = {
+            (m_R1 - ev.hoop) / m_R1,
+            (m_R2 - ev.axial) / m_R2,
+            (m_allowEquiv - ev.equiv) / m_allowEquiv
+        };
+        int smallest = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (margins[i] < margins[smallest]) {
+                smallest = i;
+            }
+        }
+        probe.margin = margins[smallest].value;
+        probe.slope = margins[smallest].gradient[0];
+        probe.criterion = PressureCriterion(smallest);
+        return probe;
+    }
+
+    double R1() const { return m_R1.value; }
+    int evaluations() const { return m_evaluations; }
+
+private:
+    BasicScalarParameters<PressureDual> m_scalars;
+    BasicRuntimeMaterial<PressureDual> m_material;
+    PressureDual m_Di_m;
+    PressureDual m_delta;
+    PressureDual m_R1;
+    PressureDual m_R2;
+    PressureDual m_allowEquiv;
+    int m_evaluations = 0;
+};
+
+// Поиск p_max для одного участка
+PressureLimit solveSection(const BasicScalarParameters<PressureDual>& scalars,
+                           double outerDiameter, double thickness, double tolerance)
+{
+    PressureLimit limit;
+    if (!(outerDiameter > 0.0) || !(thickness > 0.0) ||
+        !std::isfinite(outerDiameter) || !std::isfinite(thickness)) {
+        return limit;
+    }
+
+    PressureEvaluator evaluator(scalars, outerDiameter / 1000.0, thickness);
+
+    // === ВЕРХНЯЯ ГРАНИЦА ПО σ_кц ===
+
+    // σ_кц линейна по p: один шаг Ньютона от p = 0 дает давление с σ_кц = R1
+    const PressureProbe atZero = evaluator.probe(0.0);
+    limit.evaluations = evaluator.evaluations();
+    if (!atZero.isValid) {
+        return limit;
+    }
+    if (atZero.flowSpeedFailed) {
+        limit.status = PressureLimit::Status::FlowSpeedFailed;
+        return limit;
+    }
+    limit.surge = atZero.surge;
+    if (!(atZero.hoopSlope > 0.0)) {
+        limit.status = PressureLimit::Status::Unbounded;
+        return limit;
+    }
+
+    double high = std::max((evaluator.R1() - atZero.hoop) / atZero.hoopSlope, 0.0);
+
+    // Выше найденной границы σ_кц > R1; из-за округления граница может еще
+    // проходить проверку - тогда она сдвигается вверх
+    PressureProbe highProbe = evaluator.probe(high);
+    for (double step = std::max(tolerance, 1e-12 * high); highProbe.passes; step *= 2.0) {
+        high += step;
+        highProbe = evaluator.probe(high);
+    }
+
+    // === ПРОСМОТР СВЕРХУ ВНИЗ ===
+
+    // Нижний конец отрезка - наибольшая из точек просмотра, проходящая проверку
+    double low = 0.0;
+    PressureProbe lowProbe;
+    bool found = false;
+    const double top = high;
+    for (int j = 1; j <= kScanPoints; ++j) {
+        const double p = j < kScanPoints ? top * double(kScanPoints - j) / kScanPoints : 0.0;
+        const PressureProbe probe = j < kScanPoints ? evaluator.probe(p) : atZero;
+        if (probe.passes) {
+            low = p;
+            lowProbe = probe;
+            found = true;
+            break;
+        }
+        high = p;
+        highProbe = probe;
+    }
+    if (!found) {
+        limit.evaluations = evaluator.evaluations();
+        limit.status = PressureLimit::Status::NotFeasible;
+        return limit;
+    }
+
+    // === УТОЧНЕНИЕ МЕТОДОМ НЬЮТОНА С ЗАЩИТОЙ ===
+
+    // Шаг Ньютона делается из последней рассчитанной точки. Если он выходит
+    // за отрезок или прошлый шаг Ньютона, не попав в границу, сократил отрезок
+    // меньше чем вдвое (запас меняется скачком при смене знака σ_пр), отрезок
+    // делится пополам.
+    // Точка Ньютона отодвигается от концов отрезка на tolerance/2: если
+    // граница найдена точно, следующий расчет сразу закрывает отрезок.
+    PressureProbe last = lowProbe;
+    double lastPoint = low;
+    bool bisect = false;
+    while (high - low > tolerance) {
+        const double width = high - low;
+        double p = 0.5 * (low + high);
+        bool newtonStep = false;
+        if (!bisect && last.isValid && last.slope < 0.0) {
+            const double newton = lastPoint - last.margin / last.slope;
+            if (newton >= low && newton <= high) {
+                p = std::min(std::max(newton, low + 0.5 * tolerance), high - 0.5 * tolerance);
+                newtonStep = true;
+            }
+        }
+
+        const PressureProbe probe = evaluator.probe(p);
+        if (probe.passes) {
+            low = p;
+            lowProbe = probe;
+        } else {
+            high = p;
+            highProbe = probe;
+        }
+        last = probe;
+        lastPoint = p;
+        const bool nearRoot = probe.isValid && std::abs(probe.margin) <= -probe.slope * tolerance;
+        bisect = newtonStep && high - low > 0.5 * width && !nearRoot;
+    }
+
+    limit.status = PressureLimit::Status::Found;
+    limit.pressure = low;
+    limit.evaluations = evaluator.evaluations();
+    limit.limitingCriterion = highProbe.isValid ? highProbe.criterion : lowProbe.criterion;
+    return limit;
+}
+
+} // namespace
+
+PressureLimitSolver::PressureLimitSolver(const PipelineParameters& params)
+    : m_params(params)
+    , m_tolerance(1e-6)
+    , m_threadCount(1)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (f.field == &PipelineParameters::pressure) {
+            continue;
+        }
+        if (!std::isfinite(params.*f.field)) {
+            throw std::invalid_argument(
+                QString("Поле \"%1\" не является конечным числом.").arg(f.name).toStdString());
+        }
+    }
+    if (params.massFlow <= 0 || params.density <= 0) {
+        throw std::invalid_argument("Массовый расход и плотность должны быть положительными.");
+    }
+    const DesignResistance resistance = DesignResistance::fromParameters(params);
+    if (!(resistance.R1 > 0.0 && resistance.R2 > 0.0 && resistance.allowEquiv > 0.0)) {
+        throw std::invalid_argument("Расчетные сопротивления стали должны быть положительными.");
+    }
+    m_params.pressure = 0.0;
+}
+
+void PressureLimitSolver::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+PressureLimit PressureLimitSolver::solve(double outerDiameter, double thickness) const
+{
+    const BasicScalarParameters<PressureDual> scalars(m_params);
+    return solveSection(scalars, outerDiameter, thickness, m_tolerance);
+}
+
+void PressureLimitSolver::solve(const QVector<PipeSection>& sections, QVector<PressureLimit>& results) const
+{
+    const int count = sections.size();
+    results.resize(count);
+    const BasicScalarParameters<PressureDual> scalars(m_params);
+    const int blockCount = (count + kSectionBlock - 1) / kSectionBlock;
+
+    // Каждый участок записывает только свой результат
+    PressureLimit* out = results.data();
+    const double tolerance = m_tolerance;
+    parallelForBlocks(blockCount, m_threadCount, [&](qint64 block, int) {
+        const int end = qMin(int(block + 1) * kSectionBlock, count);
+        for (int i = int(block) * kSectionBlock; i < end; ++i) {
+            out[i] = solveSection(scalars, sections[i].outerDiameter, sections[i].thickness, tolerance);
+        }
+    });
+}
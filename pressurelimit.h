@@ -0,0 +1,77 @@
+#ifndef PRESSURELIMIT_H
+#define PRESSURELIMIT_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+
+// Условие прочности, ограничивающее давление
+enum class PressureCriterion {
+    Hoop,       // σ_кц ≤ R1
+    Axial,      // σ_пр ≤ R2
+    Equivalent  // σ_экв ≤ 0.9σ_т
+};
+
+// Наибольшее допустимое рабочее давление участка
+struct PressureLimit {
+    enum class Status {
+        Found,            // Давление найдено
+        FlowSpeedFailed,  // Скорость потока вне 1-3 м/с (от давления не зависит)
+        NotFeasible,      // Условия прочности не выполняются ни при каком p ≥ 0
+        Unbounded,        // σ_кц не растет с давлением (y_fp ≤ 0) - предела нет
+        Invalid           // Геометрическая или числовая ошибка
+    };
+
+    Status status = Status::Invalid;
+    double pressure = 0.0;     // p_max, МПа: при нем выполнены все условия calculate()
+    double surge = 0.0;        // Δp гидроудара, МПа (от давления не зависит)
+    PressureCriterion limitingCriterion = PressureCriterion::Hoop; // Условие, нарушаемое выше p_max
+    int evaluations = 0;       // Расчетов напряжений
+
+    bool isFound() const { return status == Status::Found; }
+};
+
+// Обратная задача: наибольшее эксплуатационное давление p, при котором труба
+// с заданными диаметром и толщиной стенки проходит все проверки calculate()
+// (с гидроударом Δp = ρcϑ, который от p не зависит).
+//
+// Напряжения считаются по тем же формулам, что и в calculate()
+// (pipelineformulas.h), с дуальными числами - вместе с производной по p.
+// Граница ищется методом Ньютона с защитой: отрезок [p_ok, p_fail], где
+// нижний конец проходит проверку, а верхний нет, сужается шагом Ньютона по
+// наименьшему относительному запасу, а если шаг выходит за отрезок - делением
+// пополам. σ_кц линейно зависит от p, поэтому верхняя граница поиска - давление
+// с σ_кц = R1, а при ограничении по σ_кц ответ получается за один-два шага.
+// Перед уточнением отрезок [0, p(σ_кц = R1)] просматривается сверху вниз в 16
+// точках, чтобы найти верхний из интервалов допустимых давлений (при
+// температурном напряжении σ_экв может быть допустимым не при малых p).
+//
+// Результат - нижний конец отрезка: при найденном p_max все условия
+// выполнены точно так же, как при проверке calculate(), а p_max + tolerance
+// уже не проходит.
+class PressureLimitSolver {
+public:
+    // Проверка параметров: нечисловые значения, G ≤ 0, ρ ≤ 0 или
+    // неположительные расчетные сопротивления - std::invalid_argument.
+    // Давление и список диаметров параметров не используются.
+    explicit PressureLimitSolver(const PipelineParameters& params);
+
+    // Точность давления, МПа (по умолчанию 1e-6)
+    void setTolerance(double tolerance) { m_tolerance = tolerance; }
+
+    // Количество потоков пакетного расчета, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+
+    // Участок с наружным диаметром outerDiameter (мм) и толщиной thickness (м)
+    PressureLimit solve(double outerDiameter, double thickness) const;
+
+    // Пакетный расчет: участки делятся на блоки, которые обрабатываются
+    // параллельно; результат каждого участка не зависит от числа потоков
+    void solve(const QVector<PipeSection>& sections, QVector<PressureLimit>& results) const;
+
+private:
+    PipelineParameters m_params;
+    double m_tolerance;
+    int m_threadCount;
+};
+
+#endif // PRESSURELIMIT_H
@@ -0,0 +1,169 @@
+#include "propertyspline.h"
+#include "pipelineio.h"
+#include <QFile>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Ячеек поиска на интервал таблицы
+const int kCellsPerInterval = 4;
+
+inline double sign(double x)
+{
+    return x > 0.0 ? 1.0 : (x < 0.0 ? -1.0 : 0.0);
+}
+
+} // namespace
+
+PropertySpline::PropertySpline(const QVector<double>& temperatures, const QVector<double>& values)
+{
+    const int n = temperatures.size();
+    if (n < 2 || values.size() != n) {
+        throw std::invalid_argument("Табличная кривая должна содержать не меньше двух точек "
+                                    "с одинаковым числом температур и значений.");
+    }
+    for (int k = 0; k < n; ++k) {
+        if (!std::isfinite(temperatures[k]) || !std::isfinite(values[k]) ||
+            (k > 0 && !(temperatures[k] > temperatures[k - 1]))) {
+            throw std::invalid_argument(QString("Табличная кривая, точка %1: нечисловое значение "
+                                                "или температура не возрастает.").arg(k + 1).toStdString());
+        }
+    }
+
+    // === НАКЛОНЫ (ФРИЧ - КАРЛСОН) ===
+
+    const int intervals = n - 1;
+    QVector<double> h(intervals);
+    QVector<double> secant(intervals);
+    for (int k = 0; k < intervals; ++k) {
+        h[k] = temperatures[k + 1] - temperatures[k];
+        secant[k] = (values[k + 1] - values[k]) / h[k];
+    }
+
+    QVector<double> slope(n);
+    if (intervals == 1) {
+        slope[0] = slope[1] = secant[0];
+    } else {
+        // Внутренние узлы: взвешенное гармоническое среднее соседних наклонов,
+        // 0 в локальном экстремуме таблицы
+        for (int k = 1; k < intervals; ++k) {
+            if (secant[k - 1] * secant[k] <= 0.0) {
+                slope[k] = 0.0;
+            } else {
+                const double w1 = 2.0 * h[k] + h[k - 1];
+                const double w2 = h[k] + 2.0 * h[k - 1];
+                slope[k] = (w1 + w2) / (w1 / secant[k - 1] + w2 / secant[k]);
+            }
+        }
+        // Концы: трехточечная формула с ограничением, сохраняющим монотонность
+        auto endSlope = [](double h0, double h1, double s0, double s1) {
+            double m = ((2.0 * h0 + h1) * s0 - h0 * s1) / (h0 + h1);
+            if (sign(m) != sign(s0)) {
+                m = 0.0;
+            } else if (sign(s0) != sign(s1) && std::abs(m) > 3.0 * std::abs(s0)) {
+                m = 3.0 * s0;
+            }
+            return m;
+        };
+        slope[0] = endSlope(h[0], h[1], secant[0], secant[1]);
+        slope[n - 1] = endSlope(h[intervals - 1], h[intervals - 2], secant[intervals - 1], secant[intervals - 2]);
+    }
+
+    m_temperatures = temperatures;
+    m_lastValue = values.last();
+    m_coefficients.resize(4 * intervals);
+    for (int k = 0; k < intervals; ++k) {
+        double* c = m_coefficients.data() + 4 * k;
+        c[0] = values[k];
+        c[1] = slope[k];
+        c[2] = (3.0 * secant[k] - 2.0 * slope[k] - slope[k + 1]) / h[k];
+        c[3] = (slope[k] + slope[k + 1] - 2.0 * secant[k]) / (h[k] * h[k]);
+    }
+
+    // === ЯЧЕЙКИ ПОИСКА ===
+
+    const int cells = kCellsPerInterval * intervals;
+    m_cellScale = cells / (temperatures.last() - temperatures.first());
+    m_cellInterval.resize(cells);
+    int k = 0;
+    for (int j = 0; j < cells; ++j) {
+        const double left = temperatures.first() + j / m_cellScale;
+        while (k + 1 < intervals && temperatures[k + 1] <= left) {
+            ++k;
+        }
+        m_cellInterval[j] = k;
+    }
+}
+
+double PropertySpline::value(double temperature) const
+{
+    const int intervals = m_temperatures.size() - 1;
+    if (!(temperature > m_temperatures.first())) {
+        return m_coefficients[0];
+    }
+    if (temperature >= m_temperatures.last()) {
+        return m_lastValue;
+    }
+
+    const int cell = qMin(int((temperature - m_temperatures.first()) * m_cellScale), int(m_cellInterval.size()) - 1);
+    int k = m_cellInterval[cell];
+    if (k > 0 && temperature < m_temperatures[k]) {
+        --k;  // Округление на границе ячейки
+    }
+    while (k + 1 < intervals && temperature >= m_temperatures[k + 1]) {
+        ++k;
+    }
+    const double* c = m_coefficients.constData() + 4 * k;
+    const double s = temperature - m_temperatures[k];
+    return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+}
+
+void PropertySpline::evaluate(const double* temperatures, double* values, int count) const
+{
+    for (int i = 0; i < count; ++i) {
+        values[i] = value(temperatures[i]);
+    }
+}
+
+PropertySpline PropertySpline::fromFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть кривую свойства %1: %2")
+                                     .arg(path, file.errorString()).toStdString());
+    }
+    const QByteArray data = file.readAll();
+
+    QVector<double> temperatures;
+    QVector<double> values;
+    TextTableReader table(data.constData(), data.size());
+    while (table.nextLine()) {
+        double numbers[2];
+        int count = 0;
+        const char* token;
+        const char* tokenEnd;
+        while (table.nextToken(token, tokenEnd)) {
+            if (count == 2 || !TextTableReader::toNumber(token, tokenEnd, numbers[count])) {
+                count = -1;
+                break;
+            }
+            ++count;
+        }
+        if (count == 0) {
+            continue;
+        }
+        if (count != 2) {
+            throw std::invalid_argument(QString("Кривая свойства, строка %1: ожидается \"ТЕМПЕРАТУРА ЗНАЧЕНИЕ\".")
+                                            .arg(table.lineNumber()).toStdString());
+        }
+        temperatures.append(numbers[0]);
+        values.append(numbers[1]);
+    }
+
+    try {
+        return PropertySpline(temperatures, values);
+    } catch (const std::invalid_argument& e) {
+        throw std::invalid_argument(QString("Кривая свойства %1: %2").arg(path).arg(e.what()).toStdString());
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef PROPERTYSPLINE_H
+#define PROPERTYSPLINE_H
+
+#include <QString>
+#include <QVector>
+
+// Свойство среды (плотность, вязкость и т.п.) в зависимости от температуры
+// по табличной кривой.
+//
+// Между узлами таблицы - монотонный кубический сплайн Эрмита (Фрич - Карлсон):
+// он проходит через все точки таблицы и не дает ложных экстремумов, поэтому
+// убывающая с температурой вязкость остается убывающей и положительной.
+// Вне таблицы значение постоянно и равно крайнему.
+//
+// Коэффициенты кубических многочленов считаются один раз при построении.
+// Для поиска интервала диапазон температур делится на равные ячейки, каждая
+// из которых знает первый пересекающий ее интервал, так что значение
+// находится за O(1) без двоичного поиска.
+class PropertySpline {
+public:
+    // Пустая кривая (isEmpty() = true)
+    PropertySpline() = default;
+
+    // Таблица температур (°C, строго возрастают) и значений. Меньше двух
+    // точек, разные размеры, нечисловые значения или невозрастающие
+    // температуры - std::invalid_argument
+    PropertySpline(const QVector<double>& temperatures, const QVector<double>& values);
+
+    // Текстовый файл: строка "ТЕМПЕРАТУРА ЗНАЧЕНИЕ" (разделители - пробелы,
+    // ',' или ';'), пустые строки и строки с '#' пропускаются. Ошибка чтения -
+    // std::runtime_error, ошибка в данных - std::invalid_argument (с номером
+    // строки, если ошибка в одной строке).
+    static PropertySpline fromFile(const QString& path);
+
+    bool isEmpty() const { return m_temperatures.isEmpty(); }
+    const QVector<double>& temperatures() const { return m_temperatures; }  // Узлы таблицы
+
+    // Значение при температуре temperature, °C (кривая не должна быть пустой)
+    double value(double temperature) const;
+
+    // Пакетный расчет: values[i] = value(temperatures[i])
+    void evaluate(const double* temperatures, double* values, int count) const;
+
+private:
+    QVector<double> m_temperatures;  // Узлы t_k
+    QVector<double> m_coefficients;  // 4 на интервал: y = a + s·(b + s·(c + s·d)), s = t - t_k
+    QVector<int> m_cellInterval;     // Первый интервал каждой ячейки
+    double m_cellScale = 0.0;        // Ячеек на градус
+    double m_lastValue = 0.0;        // Значение в последнем узле
+};
+
+#endif // PROPERTYSPLINE_H
@@ -0,0 +1,345 @@
+#include "reliabilityanalysis.h"
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparallel.h"
+#include <cmath>
+#include <stdexcept>
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace {
+
+// Размер блока испытаний: суммы блоков складываются в фиксированном порядке
+const int kBlockSamples = 4096;
+
+// Накапливаемые суммы по одному диаметру
+enum Tally {
+    TallyFailure,        // Σ w·I(отказ)
+    TallyFailureSquare,  // Σ (w·I(отказ))² - для стандартной ошибки
+    TallyFlowSpeed,
+    TallyHoop,
+    TallyAxial,
+    TallyEquivalent,
+    TallyCount
+};
+
+// === СЧЕТНЫЙ ГЕНЕРАТОР PHILOX4x32-10 ===
+
+// Salmon et al., «Parallel random numbers: as easy as 1, 2, 3» (SC'11).
+// Результат - чистая функция счетчика и ключа, поэтому испытание n получает
+// одни и те же числа в любом потоке и при любом порядке обработки.
+struct Philox4x32 {
+    quint32 v[4];
+};
+
+inline void philoxMultiply(quint32 a, quint32 b, quint32& hi, quint32& lo)
+{
+    const quint64 product = quint64(a) * quint64(b);
+    hi = quint32(product >> 32);
+    lo = quint32(product);
+}
+
+Philox4x32 philox(Philox4x32 counter, quint32 key0, quint32 key1)
+{
+    for (int round = 0; round < 10; ++round) {
+        quint32 hi0, lo0, hi1, lo1;
+        philoxMultiply(0xD2511F53u, counter.v[0], hi0, lo0);
+        philoxMultiply(0xCD9E8D57u, counter.v[2], hi1, lo1);
+        counter.v[0] = hi1 ^ counter.v[1] ^ key0;
+        counter.v[1] = lo1;
+        counter.v[2] = hi0 ^ counter.v[3] ^ key1;
+        counter.v[3] = lo0;
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+    return counter;
+}
+
+// Равномерная величина на (0, 1] из 53 старших бит 64-битного слова
+inline double uniformFromBits(quint32 hi, quint32 lo)
+{
+    const quint64 bits = (quint64(hi) << 32) | lo;
+    return (double(bits >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+}
+
+// Четыре стандартные нормальные величины для испытания sampleIndex (Бокс - Мюллер)
+void standardNormals(quint64 seed, quint64 sampleIndex, double z[4])
+{
+    const quint32 key0 = quint32(seed);
+    const quint32 key1 = quint32(seed >> 32);
+    for (quint32 draw = 0; draw < 2; ++draw) {
+        Philox4x32 counter = { { quint32(sampleIndex), quint32(sampleIndex >> 32), draw, 0u } };
+        const Philox4x32 bits = philox(counter, key0, key1);
+        const double u1 = uniformFromBits(bits.v[0], bits.v[1]);
+        const double u2 = uniformFromBits(bits.v[2], bits.v[3]);
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        z[2 * draw] = radius * std::cos(2.0 * M_PI * u2);
+        z[2 * draw + 1] = radius * std::sin(2.0 * M_PI * u2);
+    }
+}
+
+} // namespace
+
+RandomVariable RandomVariable::fixed()
+{
+    return RandomVariable();
+}
+
+RandomVariable RandomVariable::normal(double mean, double sigma)
+{
+    if (!(sigma >= 0.0)) {
+        throw std::invalid_argument("Стандартное отклонение не может быть отрицательным.");
+    }
+    RandomVariable v;
+    v.kind = Kind::Normal;
+    v.mean = mean;
+    v.spread = sigma;
+    return v;
+}
+
+RandomVariable RandomVariable::logNormal(double mean, double sigma)
+{
+    if (!(mean > 0.0) || !(sigma >= 0.0)) {
+        throw std::invalid_argument("Логнормальная величина требует mean > 0 и σ ≥ 0.");
+    }
+    RandomVariable v;
+    v.kind = Kind::LogNormal;
+    v.mean = mean;
+    v.spread = sigma;
+    return v;
+}
+
+RandomVariable RandomVariable::uniform(double low, double high)
+{
+    if (!(high >= low)) {
+        throw std::invalid_argument("Границы равномерного распределения заданы неверно: нужно low ≤ high.");
+    }
+    RandomVariable v;
+    v.kind = Kind::Uniform;
+    v.mean = 0.5 * (low + high);
+    v.spread = 0.5 * (high - low);
+    return v;
+}
+
+double RandomVariable::sample(double nominal, double z) const
+{
+    switch (kind) {
+    case Kind::Fixed:
+        return nominal;
+    case Kind::Normal:
+        return mean + spread * z;
+    case Kind::LogNormal: {
+        // Параметры ln X по среднему и стандартному отклонению X
+        const double s2 = std::log(1.0 + (spread / mean) * (spread / mean));
+        return std::exp(std::log(mean) - 0.5 * s2 + std::sqrt(s2) * z);
+    }
+    case Kind::Uniform: {
+        // Φ(z) = erfc(-z/√2) / 2 переводит z в равномерную на (0, 1)
+        const double u = 0.5 * std::erfc(-z / std::sqrt(2.0));
+        return mean + spread * (2.0 * u - 1.0);
+    }
+    }
+    return nominal;
+}
+
+ReliabilityAnalysis::ReliabilityAnalysis(const PipelineParameters& nominal,
+                                         const ReliabilitySettings& settings)
+    : m_nominal(nominal)
+    , m_settings(settings)
+    , m_threadCount(1)
+{
+    if (m_settings.samples <= 0) {
+        throw std::invalid_argument("Количество испытаний должно быть положительным.");
+    }
+}
+
+void ReliabilityAnalysis::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+QVector<DiameterReliability> ReliabilityAnalysis::run()
+{
+    const int diameterCount = m_nominal.outerDiameters.size();
+    QVector<DiameterReliability> report(diameterCount);
+
+    // === ТОЛЩИНЫ СТЕНОК ИЗ ДЕТЕРМИНИРОВАННОГО РАСЧЕТА ===
+
+    // Результаты calculate() идут в порядке диаметров, но без пропущенных
+    PipelineOptimizer optimizer;
+    const QVector<ValidationResult> nominalResults = optimizer.calculate(m_nominal);
+    int next = 0;
+    for (int i = 0; i < diameterCount; ++i) {
+        report[i].diameter = m_nominal.outerDiameters[i];
+        if (next < nominalResults.size() && nominalResults[next].diameter == report[i].diameter) {
+            const ValidationResult& res = nominalResults[next++];
+            report[i].designed = res.isValid;
+            report[i].thickness = res.isValid ? res.finalThickness : 0.0;
+        }
+    }
+
+    // === РОЗЫГРЫШ ИСПЫТАНИЙ ПО БЛОКАМ ===
+
+    const RandomVariable* variables[4] = {
+        &m_settings.yieldStrength, &m_settings.tensileStrength,
+        &m_settings.pressure, &m_settings.temperatureDelta
+    };
+    double shiftEnergy = 0.0; // Σ s²/2 для весового множителя
+    for (const RandomVariable* variable : variables) {
+        if (variable->isRandom()) {
+            shiftEnergy += 0.5 * variable->importanceShift * variable->importanceShift;
+        }
+    }
+
+    const qint64 samples = m_settings.samples;
+    const qint64 blockCount = (samples + kBlockSamples - 1) / kBlockSamples;
+    const int workerCount = parallelWorkerCount(blockCount, m_threadCount);
+    const SimdIsa isa = detectSimdIsa();
+
+    // Суммы блоков сводятся в итог строго в порядке блоков, по мере их
+    // завершения: блок b пишет в ячейку кольца b % ringSize, которая
+    // освобождается после сведения блока b - ringSize. Поэтому память не
+    // зависит от числа испытаний, а итог - от числа потоков.
+    const int ringSize = 2 * workerCount;
+    const int stride = diameterCount * TallyCount;
+    QVector<double> ring(ringSize * stride, 0.0);
+    QVector<quint8> ringFinished(ringSize, 0);
+    QVector<double> totals(stride, 0.0);
+    qint64 nextFold = 0;
+    QMutex foldMutex;
+    QWaitCondition folded;
+
+    // Толщины не меняются между испытаниями - пакеты заполняются один раз
+    struct Worker {
+        StressBatch batch;
+        PipelineParameters sample;
+    };
+    QVector<Worker> workers(workerCount);
+    for (Worker& worker : workers) {
+        worker.batch.resize(diameterCount);
+        for (int i = 0; i < diameterCount; ++i) {
+            worker.batch.outerDiameter[i] = report[i].diameter / 1000.0;
+            worker.batch.thickness[i] = report[i].thickness;
+        }
+        worker.sample = m_nominal;
+    }
+
+    // Потоки только читают проекты; кольцо и итог меняются под foldMutex,
+    // кроме ячейки, занятой своим блоком
+    const DiameterReliability* designs = report.constData();
+    Worker* const worker = workers.data();
+    double* const ringBase = ring.data();
+    quint8* const finished = ringFinished.data();
+    double* const total = totals.data();
+
+    parallelForBlocks(blockCount, m_threadCount, [&](qint64 block, int w) {
+        const int slot = int(block % ringSize);
+        {
+            QMutexLocker locker(&foldMutex);
+            while (block - nextFold >= ringSize) {
+                folded.wait(&foldMutex);
+            }
+        }
+
+        StressBatch& batch = worker[w].batch;
+        PipelineParameters& sample = worker[w].sample;
+        double* sums = ringBase + slot * stride;
+        const qint64 first = block * kBlockSamples;
+        const qint64 last = qMin(samples, first + kBlockSamples);
+
+        for (qint64 n = first; n < last; ++n) {
+            double z[4];
+            standardNormals(m_settings.seed, n, z);
+
+            // Сдвинутая выборка x = z + s с весом φ(x)/φ(x - s) = exp(s²/2 - s·x)
+            double logWeight = shiftEnergy;
+            for (int k = 0; k < 4; ++k) {
+                if (variables[k]->isRandom()) {
+                    z[k] += variables[k]->importanceShift;
+                    logWeight -= variables[k]->importanceShift * z[k];
+                }
+            }
+            const double weight = std::exp(logWeight);
+
+            sample.yieldStrength = variables[0]->sample(m_nominal.yieldStrength, z[0]);
+            sample.tensileStrength = variables[1]->sample(m_nominal.tensileStrength, z[1]);
+            sample.pressure = variables[2]->sample(m_nominal.pressure, z[2]);
+            sample.temperatureDelta = variables[3]->sample(m_nominal.temperatureDelta, z[3]);
+
+            const DesignResistance resistance = DesignResistance::fromParameters(sample);
+            const StressConstants constants = StressConstants::fromParameters(
+                sample, resistance.R1, resistance.R2, resistance.allowEquiv);
+            evaluateStressBatch(constants, batch, isa);
+
+            for (int i = 0; i < diameterCount; ++i) {
+                if (!designs[i].designed) {
+                    continue;
+                }
+
+                // Пакетный расчет не дает флагов напряжений при недопустимой
+                // скорости потока - тогда дорожка пересчитывается скалярно
+                bool flowOk, hoopOk, axialOk, equivOk;
+                const quint8 flags = batch.flags[i];
+                if (flags & LaneFlowSpeed) {
+                    flowOk = true;
+                    hoopOk = flags & LaneHoopStress;
+                    axialOk = flags & LaneAxialStress;
+                    equivOk = flags & LaneEquivalentStress;
+                } else {
+                    const ThicknessCheck check = PipelineOptimizer::checkThickness(
+                        sample, resistance, designs[i].diameter, designs[i].thickness);
+                    flowOk = check.isValid && check.satisfiesFlowSpeed;
+                    hoopOk = check.isValid && check.satisfiesHoopStress;
+                    axialOk = check.isValid && check.satisfiesAxialStress;
+                    equivOk = check.isValid && check.satisfiesEquivalentStress;
+                }
+
+                double* tally = sums + i * TallyCount;
+                if (!(flowOk && hoopOk && axialOk && equivOk)) {
+                    tally[TallyFailure] += weight;
+                    tally[TallyFailureSquare] += weight * weight;
+                }
+                if (!flowOk) tally[TallyFlowSpeed] += weight;
+                if (!hoopOk) tally[TallyHoop] += weight;
+                if (!axialOk) tally[TallyAxial] += weight;
+                if (!equivOk) tally[TallyEquivalent] += weight;
+            }
+        }
+
+        // Сведение готовых блоков по порядку
+
+        QMutexLocker locker(&foldMutex);
+        finished[slot] = 1;
+        while (nextFold < blockCount && finished[nextFold % ringSize]) {
+            const int ready = int(nextFold % ringSize);
+            double* tally = ringBase + ready * stride;
+            for (int k = 0; k < stride; ++k) {
+                total[k] += tally[k];
+                tally[k] = 0.0;
+            }
+            finished[ready] = 0;
+            ++nextFold;
+        }
+        folded.wakeAll();
+    });
+
+    for (int i = 0; i < diameterCount; ++i) {
+        DiameterReliability& r = report[i];
+        if (!r.designed) {
+            continue; // Толщина не найдена - отказ при любых параметрах
+        }
+
+        const double* sum = totals.constData() + i * TallyCount;
+        const double n = double(samples);
+        r.failureProbability = sum[TallyFailure] / n;
+        const double variance = sum[TallyFailureSquare] / n -
+                                r.failureProbability * r.failureProbability;
+        r.standardError = std::sqrt(qMax(0.0, variance) / n);
+        r.flowSpeedFailure = sum[TallyFlowSpeed] / n;
+        r.hoopFailure = sum[TallyHoop] / n;
+        r.axialFailure = sum[TallyAxial] / n;
+        r.equivalentFailure = sum[TallyEquivalent] / n;
+    }
+
+    return report;
+}
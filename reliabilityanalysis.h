@@ -0,0 +1,88 @@
+#ifndef RELIABILITYANALYSIS_H
+#define RELIABILITYANALYSIS_H
+
+#include "pipelineparameters.h"
+#include <QVector>
+#include <QtGlobal>
+
+// Случайная величина, задаваемая через стандартную нормальную величину z
+struct RandomVariable {
+    enum class Kind {
+        Fixed,      // Не разбрасывается - берется номинальное значение параметра
+        Normal,     // Нормальное распределение (mean, spread = σ)
+        LogNormal,  // Логнормальное распределение с заданными mean и spread = σ
+        Uniform     // Равномерное на [mean - spread, mean + spread]
+    };
+
+    Kind kind = Kind::Fixed;
+    double mean = 0.0;
+    double spread = 0.0;
+    double importanceShift = 0.0; // Сдвиг выборки в пространстве z (выборка по значимости)
+
+    static RandomVariable fixed();
+    static RandomVariable normal(double mean, double sigma);
+    static RandomVariable logNormal(double mean, double sigma);
+    static RandomVariable uniform(double low, double high);
+
+    bool isRandom() const { return kind != Kind::Fixed; }
+
+    // Значение величины для стандартной нормальной z
+    double sample(double nominal, double z) const;
+};
+
+// Настройки вероятностного расчета
+struct ReliabilitySettings {
+    RandomVariable yieldStrength;    // σ_т, МПа
+    RandomVariable tensileStrength;  // σ_п, МПа
+    RandomVariable pressure;         // p, МПа
+    RandomVariable temperatureDelta; // Δt, °C
+
+    qint64 samples = 1000000;        // Количество испытаний
+    quint64 seed = 0;                // Ключ генератора: одинаковый seed - одинаковый результат
+};
+
+// Вероятность отказа трубы одного диаметра
+struct DiameterReliability {
+    double diameter = 0.0;           // Наружный диаметр, мм
+    double thickness = 0.0;          // Толщина стенки из детерминированного расчета, м
+    bool designed = false;           // Найдена ли толщина (иначе вероятность отказа равна 1)
+    double failureProbability = 1.0; // Вероятность невыполнения хотя бы одного условия
+    double standardError = 0.0;      // Стандартная ошибка оценки вероятности
+    double flowSpeedFailure = 1.0;   // Вероятности невыполнения отдельных условий
+    double hoopFailure = 1.0;
+    double axialFailure = 1.0;
+    double equivalentFailure = 1.0;
+};
+
+// Вероятностный расчет методом Монте-Карло.
+//
+// Толщина стенки каждого диаметра берется из детерминированного расчета при
+// номинальных параметрах; затем σ_т, σ_п, p и Δt разыгрываются по заданным
+// распределениям и для каждого испытания проверяются все условия calculate().
+//
+// Случайные числа берутся из счетного генератора Philox4x32-10: испытание с
+// номером n всегда получает одни и те же числа, а суммы накапливаются блоками
+// фиксированного размера и складываются по порядку блоков, поэтому результат
+// не зависит от количества потоков. Блоки сводятся по мере готовности, и
+// память под суммы не зависит от числа испытаний.
+//
+// Ненулевой importanceShift сдвигает выборку к области отказа (например,
+// отрицательный для σ_т, положительный для p); каждое испытание получает
+// весовой множитель φ(z)/φ(z - s), поэтому оценка остается несмещенной, а малые
+// вероятности отказа сходятся за гораздо меньшее число испытаний.
+class ReliabilityAnalysis {
+public:
+    ReliabilityAnalysis(const PipelineParameters& nominal, const ReliabilitySettings& settings);
+
+    // Количество потоков, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+
+    QVector<DiameterReliability> run();
+
+private:
+    PipelineParameters m_nominal;
+    ReliabilitySettings m_settings;
+    int m_threadCount;
+};
+
+#endif // RELIABILITYANALYSIS_H
@@ -0,0 +1,381 @@
+#include "resultcache.h"
+#include "parameterfields.h"
+#include "pipelineoptimizer.h"
+#include <QDebug>
+#include <QDir>
+#include <QLockFile>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// === ФОРМАТ ФАЙЛА ХРАНИЛИЩА ===
+//
+// Заголовок: magic, версия формата, версия решателя, резерв (4 × quint32).
+// Запись:    magic, размер ключа, размер значения, контрольная сумма
+//            (4 × quint32), хэш ключа (quint64), ключ, значение; запись
+//            выравнивается до 8 байт. Порядок байтов - родной для машины.
+// Значение:  количество результатов (quint64), затем по 64 байта на результат:
+//            7 double и слово флагов.
+
+const quint32 kFileMagic = 0x43525743;   // "CWRC"
+const quint32 kFormatVersion = 1;
+const quint32 kRecordMagic = 0x43455243; // "CREC"
+const int kFileHeaderSize = 16;
+const int kResultSize = 64;
+
+struct RecordHeader {
+    quint32 magic;
+    quint32 keySize;
+    quint32 valueSize;
+    quint32 checksum;
+    quint64 hash;
+};
+
+inline qint64 alignRecord(qint64 size)
+{
+    return (size + 7) & ~qint64(7);
+}
+
+// FNV-1a (64 бита)
+quint64 fnv1a(const char* data, qint64 size, quint64 hash = 14695981039346656037ULL)
+{
+    for (qint64 i = 0; i < size; ++i) {
+        hash ^= uchar(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+inline void appendRaw(QByteArray& out, const T& value)
+{
+    out.append(reinterpret_cast<const char*>(&value), int(sizeof(T)));
+}
+
+// -0.0 и 0.0, а также разные NaN дают одинаковый ключ
+inline double canonicalDouble(double value)
+{
+    if (value == 0.0) {
+        return 0.0;
+    }
+    if (std::isnan(value)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return value;
+}
+
+QByteArray encodeResults(const QVector<ValidationResult>& results)
+{
+    QByteArray value;
+    value.reserve(8 + results.size() * kResultSize);
+    appendRaw(value, quint64(results.size()));
+    for (const ValidationResult& r : results) {
+        const double numbers[7] = {
+            r.diameter, r.finalThickness, r.safetyHoop, r.safetyAxial,
+            r.minSafery, r.safetyEquivalent, r.flowSpeed
+        };
+        value.append(reinterpret_cast<const char*>(numbers), int(sizeof(numbers)));
+        const quint64 flags = (r.satisfiesFlowSpeed ? 0x01 : 0) |
+                              (r.satisfiesHoopStress ? 0x02 : 0) |
+                              (r.satisfiesAxialStress ? 0x04 : 0) |
+                              (r.satisfiesEquivalentStress ? 0x08 : 0) |
+                              (r.isOptimal ? 0x10 : 0) |
+                              (r.isValid ? 0x20 : 0);
+        appendRaw(value, flags);
+    }
+    return value;
+}
+
+bool decodeResults(const uchar* data, qint64 size, QVector<ValidationResult>& results)
+{
+    quint64 count;
+    if (size < 8) {
+        return false;
+    }
+    std::memcpy(&count, data, sizeof(count));
+    if (quint64(size) != 8 + count * kResultSize) {
+        return false;
+    }
+
+    results.resize(int(count));
+    const uchar* p = data + 8;
+    for (ValidationResult& r : results) {
+        double numbers[7];
+        quint64 flags;
+        std::memcpy(numbers, p, sizeof(numbers));
+        std::memcpy(&flags, p + sizeof(numbers), sizeof(flags));
+        p += kResultSize;
+
+        r.diameter = numbers[0];
+        r.finalThickness = numbers[1];
+        r.safetyHoop = numbers[2];
+        r.safetyAxial = numbers[3];
+        r.minSafery = numbers[4];
+        r.safetyEquivalent = numbers[5];
+        r.flowSpeed = numbers[6];
+        r.satisfiesFlowSpeed = flags & 0x01;
+        r.satisfiesHoopStress = flags & 0x02;
+        r.satisfiesAxialStress = flags & 0x04;
+        r.satisfiesEquivalentStress = flags & 0x08;
+        r.isOptimal = flags & 0x10;
+        r.isValid = flags & 0x20;
+    }
+    return true;
+}
+
+enum class RecordState {
+    Complete,    // Целая запись
+    Incomplete,  // Не умещается в файл: еще дописывается или оборвана
+    Broken       // Нет magic или неверная контрольная сумма
+};
+
+// Проверка записи по смещению offset в отображении файла размера size
+RecordState inspectRecord(const uchar* map, qint64 size, qint64 offset, RecordHeader& header, qint64& recordSize)
+{
+    std::memcpy(&header, map + offset, sizeof(header));
+    if (header.magic != kRecordMagic) {
+        return RecordState::Broken;
+    }
+    recordSize = alignRecord(qint64(sizeof(RecordHeader)) + header.keySize + header.valueSize);
+    if (offset + recordSize > size) {
+        return RecordState::Incomplete;
+    }
+    const char* body = reinterpret_cast<const char*>(map + offset + sizeof(RecordHeader));
+    if (quint32(fnv1a(body, qint64(header.keySize) + header.valueSize)) != header.checksum) {
+        return RecordState::Broken;
+    }
+    return RecordState::Complete;
+}
+
+} // namespace
+
+ResultCache::ResultCache(int memoryResults)
+    : m_memory(qMax(1, memoryResults))
+    , m_hits(0)
+    , m_misses(0)
+    , m_map(nullptr)
+    , m_mappedSize(0)
+    , m_indexedEnd(kFileHeaderSize)
+    , m_maxStoreBytes(256LL * 1024 * 1024)
+{
+}
+
+ResultCache::~ResultCache()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+    m_file.close();
+}
+
+QByteArray ResultCache::canonicalKey(const PipelineParameters& params, const QByteArray& variant)
+{
+    QByteArray key;
+    key.reserve(16 + 8 * (parameterFields().size() + params.outerDiameters.size()));
+    appendRaw(key, quint32(PipelineOptimizer::SolverVersion));
+    appendRaw(key, quint32(params.mode == Mode::Mode2 ? 2 : 1));
+    for (const ParameterField& f : parameterFields()) {
+        appendRaw(key, canonicalDouble(params.*f.field));
+    }
+    appendRaw(key, quint64(params.outerDiameters.size()));
+    for (double d : params.outerDiameters) {
+        appendRaw(key, canonicalDouble(d));
+    }
+    if (!variant.isEmpty()) {
+        appendRaw(key, quint32(variant.size()));
+        key.append(variant);
+    }
+    return key;
+}
+
+bool ResultCache::openStore(const QString& directory)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_file.isOpen()) {
+        return true;
+    }
+
+    // Отдельный файл на каждую версию решателя: старые файлы не переписываются,
+    // поэтому процессы со старой версией могут продолжать их читать
+    if (!QDir().mkpath(directory)) {
+        return false;
+    }
+    const QString path = QDir(directory).filePath(
+        QString("results-v%1.cwcache").arg(PipelineOptimizer::SolverVersion));
+    m_lockPath = path + ".lock";
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        qWarning() << "ResultCache: не удалось открыть" << path << ":" << m_file.errorString();
+        return false;
+    }
+
+    QLockFile lock(m_lockPath);
+    if (!lock.lock()) {
+        m_file.close();
+        return false;
+    }
+
+    const quint32 expected[4] = { kFileMagic, kFormatVersion, PipelineOptimizer::SolverVersion, 0 };
+    if (m_file.size() == 0) {
+        m_file.write(reinterpret_cast<const char*>(expected), kFileHeaderSize);
+    } else {
+        quint32 header[4] = {};
+        if (m_file.read(reinterpret_cast<char*>(header), kFileHeaderSize) != kFileHeaderSize ||
+            std::memcmp(header, expected, kFileHeaderSize) != 0) {
+            qWarning() << "ResultCache: файл" << path << "имеет другой формат и не используется";
+            m_file.close();
+            return false;
+        }
+    }
+    lock.unlock();
+
+    refreshStore();
+    return true;
+}
+
+void ResultCache::setMaxStoreBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxStoreBytes = bytes;
+}
+
+bool ResultCache::find(const PipelineParameters& params, QVector<ValidationResult>& results,
+                       const QByteArray& variant)
+{
+    const QByteArray key = canonicalKey(params, variant);
+    QMutexLocker locker(&m_mutex);
+
+    if (const QVector<ValidationResult>* cached = m_memory.object(key)) {
+        results = *cached;
+        ++m_hits;
+        return true;
+    }
+
+    const quint64 hash = fnv1a(key.constData(), key.size());
+    if (findInStore(key, hash, results)) {
+        m_memory.insert(key, new QVector<ValidationResult>(results), qMax(1, int(results.size())));
+        ++m_hits;
+        return true;
+    }
+
+    ++m_misses;
+    return false;
+}
+
+void ResultCache::insert(const PipelineParameters& params, const QVector<ValidationResult>& results,
+                         const QByteArray& variant)
+{
+    const QByteArray key = canonicalKey(params, variant);
+    QMutexLocker locker(&m_mutex);
+
+    m_memory.insert(key, new QVector<ValidationResult>(results), qMax(1, int(results.size())));
+    appendToStore(key, fnv1a(key.constData(), key.size()), results);
+}
+
+// Индексация записей, добавленных с прошлого вызова (в том числе другими процессами)
+void ResultCache::refreshStore()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    const qint64 size = m_file.size();
+    if (size <= m_mappedSize) {
+        return;
+    }
+
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+    m_map = m_file.map(0, size);
+    m_mappedSize = m_map ? size : 0;
+    if (!m_map) {
+        return;
+    }
+
+    const qint64 last = size - qint64(sizeof(RecordHeader));
+    while (m_indexedEnd <= last) {
+        RecordHeader header;
+        qint64 recordSize = 0;
+        if (inspectRecord(m_map, size, m_indexedEnd, header, recordSize) == RecordState::Complete) {
+            m_index.insert(header.hash, m_indexedEnd);
+            m_indexedEnd += recordSize;
+            continue;
+        }
+
+        // Оборванная запись (процесс завершился посреди write()) не должна
+        // останавливать индексацию навсегда: следующая целая запись ищется по
+        // magic с шагом выравнивания. Если ее нет, запись в конце файла,
+        // возможно, еще дописывается - индексация продолжится с нее при
+        // следующем вызове.
+        qint64 next = m_indexedEnd + 8;
+        while (next <= last && inspectRecord(m_map, size, next, header, recordSize) != RecordState::Complete) {
+            next += 8;
+        }
+        if (next > last) {
+            break;
+        }
+        m_indexedEnd = next;
+    }
+}
+
+bool ResultCache::findInStore(const QByteArray& key, quint64 hash, QVector<ValidationResult>& results)
+{
+    refreshStore();
+    if (!m_map) {
+        return false;
+    }
+
+    for (auto it = m_index.constFind(hash); it != m_index.constEnd() && it.key() == hash; ++it) {
+        RecordHeader header;
+        std::memcpy(&header, m_map + it.value(), sizeof(header));
+        const uchar* body = m_map + it.value() + sizeof(RecordHeader);
+        if (header.keySize == quint32(key.size()) &&
+            std::memcmp(body, key.constData(), size_t(key.size())) == 0) {
+            return decodeResults(body + header.keySize, header.valueSize, results);
+        }
+    }
+    return false;
+}
+
+void ResultCache::appendToStore(const QByteArray& key, quint64 hash, const QVector<ValidationResult>& results)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    const QByteArray value = encodeResults(results);
+    RecordHeader header;
+    header.magic = kRecordMagic;
+    header.keySize = quint32(key.size());
+    header.valueSize = quint32(value.size());
+    header.checksum = quint32(fnv1a(value.constData(), value.size(),
+                                    fnv1a(key.constData(), key.size())));
+    header.hash = hash;
+
+    QByteArray record;
+    record.reserve(int(alignRecord(qint64(sizeof(header)) + key.size() + value.size())));
+    appendRaw(record, header);
+    record.append(key);
+    record.append(value);
+    record.append(int(alignRecord(record.size()) - record.size()), '\0');
+
+    // Запись одним вызовом write() под межпроцессной блокировкой
+    QLockFile lock(m_lockPath);
+    if (!lock.lock()) {
+        return;
+    }
+    // Оборванная запись могла оставить конец файла невыровненным, а поиск
+    // записей после нее идет с шагом 8 байт
+    const qint64 offset = alignRecord(m_file.size());
+    if (offset + record.size() > m_maxStoreBytes) {
+        return;
+    }
+    if (m_file.seek(offset)) {
+        m_file.write(record);
+    }
+    lock.unlock();
+
+    refreshStore();
+}
@@ -0,0 +1,83 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "pipelineparameters.h"
+#include <QByteArray>
+#include <QCache>
+#include <QFile>
+#include <QMultiHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Кэш результатов calculate() по содержимому параметров.
+//
+// Ключ - каноническая запись всех полей PipelineParameters (включая режим и
+// список диаметров) вместе с PipelineOptimizer::SolverVersion, поэтому после
+// изменения формул старые результаты не используются.
+//
+// Два уровня:
+//   - в памяти: QCache на заданное число результатов (стоимость сценария -
+//     число его результатов, вытеснение LRU);
+//   - на диске (необязательно): файл results-v<версия>.cwcache, в который записи
+//     только дописываются. Файл отображается в память (QFile::map) и читается
+//     без блокировок; запись защищена QLockFile, поэтому файл могут
+//     одновременно использовать несколько процессов. Новые записи других
+//     процессов подхватываются при следующем поиске. Оборванная запись
+//     (процесс завершился посреди записи) пропускается: индексация
+//     продолжается со следующей целой записи.
+//
+// Методы потокобезопасны.
+class ResultCache {
+public:
+    // memoryResults - сколько результатов (строк таблицы) держать в памяти
+    explicit ResultCache(int memoryResults = 128 * 1024);
+    ~ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Подключение дискового хранилища в каталоге directory (создается при
+    // необходимости). Возвращает false, если хранилище недоступно - тогда
+    // работает только кэш в памяти.
+    bool openStore(const QString& directory);
+
+    // Ограничение размера файла: после его достижения новые записи на диск
+    // не добавляются (по умолчанию 256 МБ)
+    void setMaxStoreBytes(qint64 bytes);
+
+    // variant - то, что кроме параметров влияет на результаты (например,
+    // отпечаток каталога толщин); пустой variant не меняет ключ
+    bool find(const PipelineParameters& params, QVector<ValidationResult>& results,
+              const QByteArray& variant = QByteArray());
+    void insert(const PipelineParameters& params, const QVector<ValidationResult>& results,
+                const QByteArray& variant = QByteArray());
+
+    qint64 hits() const { return m_hits; }
+    qint64 misses() const { return m_misses; }
+
+    // Каноническое представление параметров - ключ кэша
+    static QByteArray canonicalKey(const PipelineParameters& params,
+                                   const QByteArray& variant = QByteArray());
+
+private:
+    void refreshStore();
+    bool findInStore(const QByteArray& key, quint64 hash, QVector<ValidationResult>& results);
+    void appendToStore(const QByteArray& key, quint64 hash, const QVector<ValidationResult>& results);
+
+    QMutex m_mutex;
+    QCache<QByteArray, QVector<ValidationResult>> m_memory;
+    qint64 m_hits;
+    qint64 m_misses;
+
+    // === ДИСКОВОЕ ХРАНИЛИЩЕ ===
+    QFile m_file;
+    QString m_lockPath;
+    uchar* m_map;                     // Отображение файла (только чтение)
+    qint64 m_mappedSize;
+    qint64 m_indexedEnd;              // Конец последней проиндексированной записи
+    qint64 m_maxStoreBytes;
+    QMultiHash<quint64, qint64> m_index; // Хэш ключа → смещение записи
+};
+
+#endif // RESULTCACHE_H
@@ -1,6 +1,7 @@
 #include "resultpage.h"
 #include "pipelineparameters.h"
 #include "interaction.h"
+#include "frictionloss.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QVBoxLayout>
@@ -27,12 +28,15 @@
 #include <QTextStream>
 #include <QDateTime>
 #include <QMenu>
+#include <QHeaderView>
+#include <stdexcept>
 
 // Конструктор класса ResultPage
 ResultPage::ResultPage(QWidget *parent)
     : QWidget(parent)
     , m_resultLabel(nullptr)
     , m_graphicsView(nullptr)
+    , m_paretoTable(nullptr)
     , m_restartBtn(nullptr)
     , m_exitBtn(nullptr)
     , m_scene(nullptr)
@@ -104,6 +108,19 @@ void ResultPage::setupUI()
     m_scene = new QGraphicsScene(this);
     m_graphicsView->setScene(m_scene);
 
+    // Таблица Парето-оптимальных вариантов (скрыта, пока фронт не задан);
+    // щелчок по заголовку сортирует по столбцу
+    m_paretoTable = new QTableWidget(0, 5, this);
+    m_paretoTable->setHorizontalHeaderLabels({ "Диаметр, мм", "Толщина, мм", "Масса, кг/м",
+                                               "Мин. запас", "Запас по скорости, м/с" });
+    m_paretoTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_paretoTable->verticalHeader()->setVisible(false);
+    m_paretoTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_paretoTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_paretoTable->setMaximumHeight(180);
+    m_paretoTable->hide();
+    mainLayout->addWidget(m_paretoTable);
+
     // Кнопки управления
     m_restartBtn = new QPushButton("Начать заново");
     m_exitBtn = new QPushButton("Выход");
@@ -168,6 +185,12 @@ void ResultPage::clearPage()
     m_diameters.clear();
     m_pipeSegments.clear();
     m_validationResults.clear();
+    m_paretoFront.clear();
+
+    if (m_paretoTable) {
+        m_paretoTable->setRowCount(0);
+        m_paretoTable->hide();
+    }
 
     if (m_resultLabel) {
         m_resultLabel->clear();
@@ -319,7 +342,8 @@ void ResultPage::saveCalculationsToTxt()
         out << "Температурный перепад: " << m_params.temperatureDelta << " °C\n";
         out << "Коэффициент Пуассона: " << m_params.poissonRatio << "\n";
         out << "Коэффициент линейного расширения: " << m_params.thermalExpansionCoeff << " 1/°C\n";
-        out << "Радиус изгиба: " << m_params.bendRadius << " м\n\n";
+        out << "Радиус изгиба: " << m_params.bendRadius << " м\n";
+        out << "Кинематическая вязкость: " << m_params.viscosity << " мм²/с\n\n";
     } else {
         out << "ПОЛЬЗОВАТЕЛЬСКИЕ ПАРАМЕТРЫ (РЕЖИМ 2):\n";
         // Те же параметры, но с пользовательскими значениями
@@ -331,7 +355,8 @@ void ResultPage::saveCalculationsToTxt()
         out << "Температурный перепад: " << m_params.temperatureDelta << " °C\n";
         out << "Коэффициент Пуассона: " << m_params.poissonRatio << "\n";
         out << "Коэффициент линейного расширения: " << m_params.thermalExpansionCoeff << " 1/°C\n";
-        out << "Радиус изгиба: " << m_params.bendRadius << " м\n\n";
+        out << "Радиус изгиба: " << m_params.bendRadius << " м\n";
+        out << "Кинематическая вязкость: " << m_params.viscosity << " мм²/с\n\n";
     }
 
     // Раздел результатов для каждого диаметра
@@ -339,8 +364,21 @@ void ResultPage::saveCalculationsToTxt()
     out << "РЕЗУЛЬТАТЫ ДЛЯ КАЖДОГО ДИАМЕТРА\n";
     out << createSeparator(lineWidth, "-") << "\n\n";
 
+    // Потери давления на трение для подобранных толщин. Если параметры для
+    // них не подходят (FrictionLossModel бросает исключение), отчет
+    // сохраняется без потерь
+    QVector<FrictionLoss> frictionLosses;
+    if (m_params.viscosity > 0.0) {
+        try {
+            FrictionLossModel(m_params).evaluate(m_validationResults, frictionLosses);
+        } catch (const std::invalid_argument&) {
+            frictionLosses.clear();
+        }
+    }
+
     // Цикл по всем результатам валидации для каждого диаметра
-    for (const ValidationResult& res : m_validationResults) {
+    for (int i = 0; i < m_validationResults.size(); ++i) {
+        const ValidationResult& res = m_validationResults[i];
         out << "Диаметр: " << res.diameter << " мм\n";  // Вывод диаметра
         out << "Статус: ";  // Вывод статуса диаметра
 
@@ -372,6 +410,12 @@ void ResultPage::saveCalculationsToTxt()
 
             double minSafety = std::min({res.safetyHoop, res.safetyAxial, res.safetyEquivalent});  // Нахождение минимального коэффициента запаса
             out << "Минимальный коэффициент запаса: " << minSafety << "\n";
+
+            if (i < frictionLosses.size() && frictionLosses[i].isValid) {
+                out << "Потери давления на трение: " << frictionLosses[i].pressureLoss << " МПа/км"
+                    << " (Re = " << frictionLosses[i].reynolds
+                    << ", λ = " << frictionLosses[i].frictionFactor << ")\n";
+            }
         } else {
             // Для неподходящих диаметров - информация не рассчитывалась
             out << "Толщина стенки: не рассчитана\n";
@@ -382,6 +426,21 @@ void ResultPage::saveCalculationsToTxt()
         out << "\n" << createSeparator(60, "~") << "\n\n";  // Разделитель между разными диаметрами
     }
 
+    // Раздел Парето-фронта: варианты, не уступающие другим сразу по массе,
+    // запасу прочности и запасу по скорости потока
+    if (!m_paretoFront.isEmpty()) {
+        out << createSeparator(lineWidth, "-") << "\n";
+        out << "ПАРЕТО-ОПТИМАЛЬНЫЕ ВАРИАНТЫ\n";
+        out << createSeparator(lineWidth, "-") << "\n\n";
+        out << "Диаметр, мм | Толщина, мм | Масса, кг/м | Мин. запас | Запас по скорости, м/с\n";
+        for (const ParetoPoint& point : m_paretoFront) {
+            const ValidationResult& res = m_validationResults[point.index];
+            out << res.diameter << " | " << res.finalThickness * 1000 << " | "
+                << point.mass << " | " << point.minSafety << " | " << point.flowSpeedMargin << "\n";
+        }
+        out << "\n";
+    }
+
     // Раздел итогового результата
     out << createSeparator(lineWidth, "-") << "\n";
     out << "ИТОГОВЫЙ РЕЗУЛЬТАТ\n";
@@ -509,6 +568,38 @@ void ResultPage::setResults(const QString &optimalDiameter, const QString &optim
     setFocus();  // Устанавливаем фокус на виджет для обработки горячих клавиш
 }
 
+// Метод установки Парето-фронта (индексы точек - номера в m_validationResults)
+void ResultPage::setParetoFront(const QVector<ParetoPoint>& front)
+{
+    m_paretoFront = front;
+
+    if (!front.isEmpty()) {
+        m_resultLabel->setText(m_resultLabel->text() +
+                               QString("Парето-оптимальных вариантов: %1\n").arg(front.size()));
+    }
+
+    // Значения хранятся числами (Qt::DisplayRole), поэтому сортировка по
+    // столбцу числовая, а не по тексту. На время заполнения сортировка
+    // отключается, иначе строки переставлялись бы при вставке каждой ячейки
+    m_paretoTable->setSortingEnabled(false);
+    m_paretoTable->setRowCount(front.size());
+    for (int row = 0; row < front.size(); ++row) {
+        const ParetoPoint& point = front[row];
+        const ValidationResult& res = m_validationResults[point.index];
+        const double values[] = { res.diameter, res.finalThickness * 1000.0, point.mass,
+                                  point.minSafety, point.flowSpeedMargin };
+        for (int column = 0; column < 5; ++column) {
+            auto* item = new QTableWidgetItem();
+            item->setData(Qt::DisplayRole, values[column]);
+            item->setTextAlignment(Qt::AlignCenter);
+            m_paretoTable->setItem(row, column, item);
+        }
+    }
+    m_paretoTable->setSortingEnabled(true);
+    m_paretoTable->sortByColumn(2, Qt::AscendingOrder);  // По массе, как во фронте
+    m_paretoTable->setVisible(!front.isEmpty());
+}
+
 // Метод сохранения пользовательских данных (используется при сохранении отчета)
 void ResultPage::setUserData(const QString& userName, Mode mode, const PipelineParameters& params)
 {
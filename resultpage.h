@@ -10,11 +10,13 @@
 #include <QGraphicsScene>
 #include <QTimer>
 #include "pipelineparameters.h"
+#include "paretofront.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QMenu>
 #include <QMenuBar>
 #include <QElapsedTimer>
+#include <QTableWidget>
 
 class Interaction;
 
@@ -32,6 +34,11 @@ public:
                     const QVector<double>& diameters, const QPixmap &backgroundImage,
                     const QVector<ValidationResult>& validationResults);
 
+    // Парето-фронт вариантов (масса, запас прочности, запас по скорости):
+    // таблица с сортировкой по любому столбцу и раздел отчета; задается после
+    // setResults()
+    void setParetoFront(const QVector<ParetoPoint>& front);
+
     void clearPage();
 
     void saveCalculationsToTxt();
@@ -43,6 +50,7 @@ public:
     Mode getMode() const { return m_mode; }
     PipelineParameters getParams() const { return m_params; }
     QVector<ValidationResult> getValidationResults() const { return m_validationResults; }
+    QVector<ParetoPoint> getParetoFront() const { return m_paretoFront; }
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
@@ -75,6 +83,7 @@ private:
     // UI элементы
     QLabel *m_resultLabel;
     QGraphicsView *m_graphicsView;
+    QTableWidget *m_paretoTable;
     QPushButton *m_restartBtn;
     QPushButton *m_exitBtn;
     QMenuBar *m_menuBar;
@@ -93,6 +102,7 @@ private:
     // Данные
     QVector<double> m_diameters;
     QVector<ValidationResult> m_validationResults;
+    QVector<ParetoPoint> m_paretoFront;
 
     // Для сохранения
     QString m_userName;
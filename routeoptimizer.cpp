@@ -0,0 +1,309 @@
+#include "routeoptimizer.h"
+#include "continuousoptimizer.h"
+#include "parameterfields.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparallel.h"
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Размер блока нагрузок при параллельном расчете толщин
+const int kLoadBlock = 16;
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Наибольшее число состояний n·(C + 1)·k: бит смены на состояние - 128 МБ
+const qint64 kMaxPathStates = qint64(1) << 30;
+
+inline void setBit(QVector<quint64>& bits, qint64 index)
+{
+    bits[int(index >> 6)] |= quint64(1) << (index & 63);
+}
+
+inline bool testBit(const QVector<quint64>& bits, qint64 index)
+{
+    return (bits[int(index >> 6)] >> (index & 63)) & 1;
+}
+
+// Толщины (м) всех диаметров каталога при давлении и радиусе изгиба params,
+// как в calculate() (PipelineOptimizer::catalogThickness()); 0 - у диаметра
+// подходящей толщины нет. Возвращает количество проверок.
+int fillThicknesses(const PipelineParameters& params, const DesignResistance& resistance,
+                    const ThicknessCatalog& catalog, double* thickness)
+{
+    int checks = 0;
+    const QVector<double>& diameters = catalog.diameters();
+    for (int j = 0; j < diameters.size(); ++j) {
+        thickness[j] = PipelineOptimizer::catalogThickness(params, resistance, catalog, diameters[j],
+                                                           nullptr, &checks);
+    }
+    return checks;
+}
+
+// Два диаметра с наименьшей массой трассы на одном уровне смен (-1 - нет)
+struct BestPair {
+    int first = -1;
+    int second = -1;
+};
+
+BestPair bestPair(const double* cost, int count)
+{
+    BestPair best;
+    for (int j = 0; j < count; ++j) {
+        if (!(cost[j] < kInfinity)) {
+            continue;
+        }
+        if (best.first < 0 || cost[j] < cost[best.first]) {
+            best.second = best.first;
+            best.first = j;
+        } else if (best.second < 0 || cost[j] < cost[best.second]) {
+            best.second = j;
+        }
+    }
+    return best;
+}
+
+// Лучший диаметр пары, отличный от diameter
+inline int bestOther(const BestPair& best, int diameter)
+{
+    return best.first != diameter ? best.first : best.second;
+}
+
+} // namespace
+
+QVector<RouteSegment> readRouteSegments(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть трассу %1: %2")
+                                     .arg(path, file.errorString()).toStdString());
+    }
+    const QByteArray data = file.readAll();
+
+    QVector<RouteSegment> segments;
+    TextTableReader table(data.constData(), data.size());
+    while (table.nextLine()) {
+        // Числа строки: длина, давление и необязательный радиус изгиба
+        QVector<double> numbers;
+        const char* token;
+        const char* tokenEnd;
+        while (table.nextToken(token, tokenEnd)) {
+            double value = 0.0;
+            if (!TextTableReader::toNumber(token, tokenEnd, value)) {
+                throw std::invalid_argument(QString("Трасса, строка %1: ожидается число.")
+                                                .arg(table.lineNumber()).toStdString());
+            }
+            numbers.append(value);
+        }
+
+        if (!numbers.isEmpty()) {
+            RouteSegment segment;
+            segment.length = numbers[0];
+            segment.pressure = numbers.value(1, 0.0);
+            segment.bendRadius = numbers.value(2, 0.0);
+            if (numbers.size() < 2 || numbers.size() > 3 || !(segment.length > 0.0) ||
+                !std::isfinite(segment.length) || !std::isfinite(segment.pressure) ||
+                !(segment.bendRadius >= 0.0) || !std::isfinite(segment.bendRadius)) {
+                throw std::invalid_argument(QString("Трасса, строка %1: ожидается \"ДЛИНА ДАВЛЕНИЕ [РАДИУС]\" "
+                                                    "с длиной > 0 и радиусом ≥ 0.")
+                                                .arg(table.lineNumber()).toStdString());
+            }
+            segments.append(segment);
+        }
+    }
+    return segments;
+}
+
+RouteOptimizer::RouteOptimizer(const PipelineParameters& params)
+    : m_params(params)
+    , m_thicknessCatalog(nullptr)
+    , m_maxDiameterChanges(-1)
+    , m_threadCount(1)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (f.field == &PipelineParameters::pressure || f.field == &PipelineParameters::bendRadius) {
+            continue;
+        }
+        if (!std::isfinite(params.*f.field)) {
+            throw std::invalid_argument(
+                QString("Поле \"%1\" не является конечным числом.").arg(f.name).toStdString());
+        }
+    }
+    if (params.massFlow <= 0 || params.density <= 0) {
+        throw std::invalid_argument("Массовый расход и плотность должны быть положительными.");
+    }
+    const DesignResistance resistance = DesignResistance::fromParameters(params);
+    if (!(resistance.R1 > 0.0 && resistance.R2 > 0.0 && resistance.allowEquiv > 0.0)) {
+        throw std::invalid_argument("Расчетные сопротивления стали должны быть положительными.");
+    }
+}
+
+void RouteOptimizer::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+RouteDesign RouteOptimizer::run(const QVector<RouteSegment>& segments) const
+{
+    const int n = segments.size();
+    for (int i = 0; i < n; ++i) {
+        const RouteSegment& s = segments[i];
+        if (!(s.length > 0.0) || !std::isfinite(s.length) || !std::isfinite(s.pressure) ||
+            !(s.bendRadius >= 0.0) || !std::isfinite(s.bendRadius)) {
+            throw std::invalid_argument(QString("Участок трассы %1: недопустимые длина, давление "
+                                                "или радиус изгиба.").arg(i + 1).toStdString());
+        }
+    }
+
+    RouteDesign design;
+    const ThicknessCatalog& catalog = m_thicknessCatalog ? *m_thicknessCatalog : ThicknessCatalog::sortament();
+    const QVector<double>& diameters = catalog.diameters();
+    const int k = diameters.size();
+    if (n == 0) {
+        design.isFeasible = true;
+        return design;
+    }
+
+    // Состояния динамического программирования: участок, уровень смен, диаметр
+    const bool limited = m_maxDiameterChanges >= 0;
+    const int levels = limited ? qMin(m_maxDiameterChanges, n - 1) + 1 : 1;
+    const qint64 states = qint64(n) * levels * k;
+    if (states > kMaxPathStates) {
+        throw std::invalid_argument(QString("Трасса слишком велика: %1 участков × %2 уровней смен × %3 "
+                                            "диаметров больше %4 состояний.")
+                                        .arg(n).arg(levels).arg(k).arg(kMaxPathStates).toStdString());
+    }
+
+    // === ТОЛЩИНЫ ДЛЯ КАЖДОЙ НАГРУЗКИ ===
+
+    // Участки упорядочиваются по (давление, радиус изгиба); одинаковые пары
+    // получают одну нагрузку
+    QVector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&segments](int a, int b) {
+        if (segments[a].pressure != segments[b].pressure) {
+            return segments[a].pressure < segments[b].pressure;
+        }
+        return segments[a].bendRadius < segments[b].bendRadius;
+    });
+    QVector<int> loadOf(n);
+    QVector<int> loadSegment;  // Участок, представляющий нагрузку
+    for (int i = 0; i < n; ++i) {
+        const RouteSegment& s = segments[order[i]];
+        if (loadSegment.isEmpty() || segments[loadSegment.last()].pressure != s.pressure ||
+            segments[loadSegment.last()].bendRadius != s.bendRadius) {
+            loadSegment.append(order[i]);
+        }
+        loadOf[order[i]] = loadSegment.size() - 1;
+    }
+    const int loadCount = loadSegment.size();
+    design.distinctLoads = loadCount;
+
+    // Каждая нагрузка записывает только свою строку толщин
+    QVector<double> thicknesses(loadCount * k);
+    QVector<int> loadChecks(loadCount);
+    const DesignResistance resistance = DesignResistance::fromParameters(m_params);
+    const int blockCount = (loadCount + kLoadBlock - 1) / kLoadBlock;
+    double* thicknessRows = thicknesses.data();
+    int* checksOut = loadChecks.data();
+    parallelForBlocks(blockCount, m_threadCount, [&](qint64 block, int) {
+        PipelineParameters params = m_params;
+        const int end = qMin(int(block + 1) * kLoadBlock, loadCount);
+        for (int load = int(block) * kLoadBlock; load < end; ++load) {
+            params.pressure = segments[loadSegment[load]].pressure;
+            params.bendRadius = segments[loadSegment[load]].bendRadius;
+            checksOut[load] = fillThicknesses(params, resistance, catalog, thicknessRows + load * k);
+        }
+    });
+    for (int checks : loadChecks) {
+        design.checks += checks;
+    }
+
+    // Масса стали участка i с диаметром j (бесконечность - диаметр не подходит)
+    auto segmentMass = [&](int i, int j) {
+        const double delta = thicknesses[loadOf[i] * k + j];
+        return delta > 0.0 ? ContinuousOptimizer::steelMass(diameters[j], delta) * segments[i].length : kInfinity;
+    };
+
+    // === ДИНАМИЧЕСКОЕ ПРОГРАММИРОВАНИЕ ПО УЧАСТКАМ ===
+
+    // cost[c·k + j] - наименьшая масса трассы до текущего участка, который
+    // имеет диаметр j, при c сменах. Без ограничения смены не считаются и
+    // уровень один.
+    QVector<double> cost(levels * k, kInfinity);
+    QVector<double> nextCost(levels * k);
+    QVector<quint64> switched(int((states + 63) / 64), 0);  // Бит на состояние: пришел ли участок со сменой диаметра
+    QVector<BestPair> best(n * levels);                     // Лучшие диаметры предыдущего участка
+
+    for (int j = 0; j < k; ++j) {
+        cost[j] = segmentMass(0, j);
+    }
+    for (int i = 1; i < n; ++i) {
+        BestPair* pairs = best.data() + i * levels;
+        for (int c = 0; c < levels; ++c) {
+            pairs[c] = bestPair(cost.constData() + c * k, k);
+        }
+        const qint64 row = qint64(i) * levels * k;
+        for (int j = 0; j < k; ++j) {
+            const double mass = segmentMass(i, j);
+            for (int c = 0; c < levels; ++c) {
+                double previous = cost[c * k + j];
+                bool change = false;
+                const int from = limited ? c - 1 : c;
+                if (from >= 0) {
+                    const int other = bestOther(pairs[from], j);
+                    if (other >= 0 && cost[from * k + other] < previous) {
+                        previous = cost[from * k + other];
+                        change = true;
+                    }
+                }
+                nextCost[c * k + j] = mass < kInfinity ? mass + previous : kInfinity;
+                if (change) {
+                    setBit(switched, row + c * k + j);
+                }
+            }
+        }
+        cost.swap(nextCost);
+    }
+
+    // Лучший конец трассы; при равной массе - меньше смен и меньший диаметр
+    int endLevel = -1;
+    int endDiameter = -1;
+    for (int c = 0; c < levels; ++c) {
+        for (int j = 0; j < k; ++j) {
+            if (cost[c * k + j] < kInfinity &&
+                (endLevel < 0 || cost[c * k + j] < cost[endLevel * k + endDiameter])) {
+                endLevel = c;
+                endDiameter = j;
+            }
+        }
+    }
+    if (endLevel < 0) {
+        return design;
+    }
+
+    // === ВОССТАНОВЛЕНИЕ ПУТИ ===
+
+    design.isFeasible = true;
+    design.mass = cost[endLevel * k + endDiameter];
+    design.sections.resize(n);
+    int level = endLevel;
+    int diameter = endDiameter;
+    for (int i = n - 1; i >= 0; --i) {
+        design.sections[i].outerDiameter = diameters[diameter];
+        design.sections[i].thickness = thicknesses[loadOf[i] * k + diameter];
+        if (i > 0 && testBit(switched, (qint64(i) * levels + level) * k + diameter)) {
+            const int from = limited ? level - 1 : level;
+            diameter = bestOther(best[i * levels + from], diameter);
+            level = from;
+            ++design.diameterChanges;
+        }
+    }
+    return design;
+}
@@ -0,0 +1,78 @@
+#ifndef ROUTEOPTIMIZER_H
+#define ROUTEOPTIMIZER_H
+
+#include "pipelineparameters.h"
+#include "thicknesscatalog.h"
+#include <QString>
+#include <QVector>
+
+// Участок трассы со своими условиями нагружения
+struct RouteSegment {
+    double length = 0.0;      // Длина участка, м
+    double pressure = 0.0;    // Эксплуатационное давление на участке, МПа
+    double bendRadius = 0.0;  // Радиус упругого изгиба, м (0 - прямой участок)
+};
+
+// Участки трассы из текстового файла: строка "ДЛИНА ДАВЛЕНИЕ [РАДИУС]" (м, МПа,
+// м; разделители - пробелы, ',' или ';'), пустые строки и строки с '#'
+// пропускаются. Ошибка чтения - std::runtime_error, ошибка в данных (не
+// число, длина ≤ 0, радиус < 0) - std::invalid_argument с номером строки.
+QVector<RouteSegment> readRouteSegments(const QString& path);
+
+// Подобранные по трассе размеры труб
+struct RouteDesign {
+    bool isFeasible = false;        // Для всех участков найдены размеры в пределах смен диаметра
+    QVector<PipeSection> sections;  // Диаметр (мм) и толщина (м) каждого участка
+    double mass = 0.0;              // Масса стали всей трассы, кг
+    int diameterChanges = 0;        // Смен диаметра между соседними участками
+    int checks = 0;                 // Проверок толщин PipelineOptimizer::checkThickness()
+    int distinctLoads = 0;          // Различных пар (давление, радиус изгиба)
+};
+
+// Телескопическая трасса: диаметр и толщина стенки подбираются для каждого
+// участка так, чтобы суммарная масса стали была наименьшей, а диаметр
+// менялся не больше заданного числа раз.
+//
+// Для каждого участка и диаметра каталога берется толщина, которую выбрал бы
+// calculate() с этим каталогом при давлении и радиусе изгиба участка
+// (PipelineOptimizer::catalogThickness()). Участки с одинаковыми
+// давлением и радиусом изгиба считаются один раз, разные нагрузки
+// рассчитываются параллельно.
+//
+// Затем динамическое программирование по участкам: состояние - диаметр
+// текущего участка и число уже сделанных смен. Переход без смены - из того
+// же диаметра, со сменой - из лучшего другого диаметра на предыдущем уровне
+// смен; для этого на каждом уровне хранятся два лучших диаметра. Расчет -
+// O(n·k·(C + 1)) для n участков, k диаметров и C допустимых смен, память под
+// восстановление пути - бит на состояние. Число состояний n·(C + 1)·k
+// ограничено 2^30 (например, 10 000 участков, 1000 смен и 100 диаметров).
+class RouteOptimizer {
+public:
+    // Проверка параметров: нечисловые значения, G ≤ 0, ρ ≤ 0 или
+    // неположительные расчетные сопротивления - std::invalid_argument.
+    // Давление и радиус изгиба параметров не используются - они берутся из
+    // участков, список диаметров - из каталога.
+    explicit RouteOptimizer(const PipelineParameters& params);
+
+    // Каталог диаметров и толщин (не принадлежит оптимизатору; nullptr -
+    // сортамент ГОСТ 10704-91 в диапазоне 100-1400 мм, по умолчанию)
+    void setThicknessCatalog(const ThicknessCatalog* catalog) { m_thicknessCatalog = catalog; }
+
+    // Наибольшее число смен диаметра вдоль трассы (по умолчанию -1 - без ограничения)
+    void setMaxDiameterChanges(int count) { m_maxDiameterChanges = count; }
+
+    // Количество потоков расчета толщин, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+
+    // Участки с длиной ≤ 0 или нечисловыми данными, а также больше 2^30
+    // состояний (см. выше) - std::invalid_argument
+    RouteDesign run(const QVector<RouteSegment>& segments) const;
+
+private:
+    PipelineParameters m_params;
+    const ThicknessCatalog* m_thicknessCatalog;
+    int m_maxDiameterChanges;
+    int m_threadCount;
+};
+
+#endif // ROUTEOPTIMIZER_H
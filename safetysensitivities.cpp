@@ -0,0 +1,50 @@
+#include "safetysensitivities.h"
+#include "materialpolicy.h"
+#include "pipelineformulas.h"
+
+namespace {
+
+// Скалярные параметры как переменные дифференцирования: поле с номером k в
+// parameterFields() - независимая переменная k
+using ParameterDual = Dual<ParameterFieldCount>;
+using DualParameters = BasicScalarParameters<ParameterDual>;
+
+// Запас n = R / σ (0 при σ ≤ 0, как в calculate()) с производными
+void setSafety(SafetyGradient& safety, const ParameterDual& resistance, const ParameterDual& stress)
+{
+    if (!(stress > 0.0)) {
+        return;
+    }
+    const ParameterDual n = resistance / stress;
+    safety.value = n.value;
+    for (int k = 0; k < ParameterFieldCount; ++k) {
+        safety.gradient[k] = n.gradient[k];
+    }
+}
+
+} // namespace
+
+SafetySensitivities safetySensitivities(const PipelineParameters& params,
+                                        double outerDiameter, double thickness)
+{
+    SafetySensitivities result;
+    DualParameters dual(params);
+    for (int k = 0; k < ParameterFieldCount; ++k) {
+        dual.field(k).gradient[k] = 1.0;
+    }
+    ParameterDual R1, R2, allowEquiv;
+    designResistance(dual, R1, R2, allowEquiv);
+
+    const BasicThicknessEvaluation<ParameterDual> ev =
+        evaluateThickness(BasicRuntimeMaterial<ParameterDual>(dual), dual, R1, R2, allowEquiv,
+                          outerDiameter / 1000.0, thickness, false);
+    if (ev.outcome == ThicknessOutcome::Aborted) {
+        return result;
+    }
+
+    result.isValid = true;
+    setSafety(result.hoop, R1, ev.hoop);
+    setSafety(result.axial, R2, ev.axial);
+    setSafety(result.equivalent, allowEquiv, ev.equiv);
+    return result;
+}
@@ -0,0 +1,29 @@
+#ifndef SAFETYSENSITIVITIES_H
+#define SAFETYSENSITIVITIES_H
+
+#include "parameterfields.h"
+#include "pipelineparameters.h"
+
+// Коэффициент запаса и его производные по скалярным параметрам
+struct SafetyGradient {
+    double value = 0.0;
+    double gradient[ParameterFieldCount] = {};  // ∂n/∂x в порядке parameterFields()
+};
+
+// Коэффициенты запаса с производными (см. safetySensitivities())
+struct SafetySensitivities {
+    bool isValid = false;  // Расчет выполнен без геометрических и числовых ошибок
+    SafetyGradient hoop;        // n^{кц}
+    SafetyGradient axial;       // n^{пр}
+    SafetyGradient equivalent;  // n^{экв}
+};
+
+// Коэффициенты запаса трубы (как в calculate()) и их производные по всем
+// скалярным параметрам при фиксированных диаметре (мм) и толщине стенки (м)
+// за один расчет с дуальными числами, вместо N + 1 расчетов с конечными
+// разностями. Толщина, подобранная calculate(), от параметров зависит
+// ступенчато, поэтому производные берутся при найденной толщине.
+SafetySensitivities safetySensitivities(const PipelineParameters& params,
+                                        double outerDiameter, double thickness);
+
+#endif // SAFETYSENSITIVITIES_H
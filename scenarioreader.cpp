@@ -0,0 +1,417 @@
+#include "scenarioreader.h"
+#include "parameterfields.h"
+#include "pipelineio.h"
+#include <QString>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline void skipSpace(const char*& p, const char* end)
+{
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+}
+
+inline bool equals(const char* begin, const char* end, const char* text)
+{
+    const size_t length = std::strlen(text);
+    return size_t(end - begin) == length && std::memcmp(begin, text, length) == 0;
+}
+
+[[noreturn]] void recordError(const QString& message)
+{
+    throw std::invalid_argument(message.toStdString());
+}
+
+// Индекс поля в parameterFields() по имени или -1
+int fieldIndex(const char* begin, const char* end)
+{
+    const ParameterFieldList& fields = parameterFields();
+    for (int i = 0; i < ParameterFieldCount; ++i) {
+        if (equals(begin, end, fields[i].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Конечное число в формате JSON/CSV (без учета локали); p переходит за число
+double takeNumber(const char*& p, const char* end)
+{
+    double value = 0.0;
+    const char* stop = parseNumber(p, end, value);
+    if (!stop) {
+        recordError(QString("Ожидается конечное число: \"%1\".")
+                        .arg(QString::fromUtf8(p, int(qMin<qint64>(end - p, 32)))));
+    }
+    p = stop;
+    return value;
+}
+
+Mode parseMode(const char* begin, const char* end)
+{
+    if (begin == end || equals(begin, end, "Mode1")) {
+        return Mode::Mode1;
+    }
+    if (equals(begin, end, "Mode2")) {
+        return Mode::Mode2;
+    }
+    recordError(QString("Неизвестный режим \"%1\" (ожидается Mode1 или Mode2).")
+                    .arg(QString::fromUtf8(begin, int(end - begin))));
+}
+
+// Строка JSON в кавычках: возвращает границы содержимого без раскодирования
+void parseJsonString(const char*& p, const char* end, const char*& begin, const char*& stop)
+{
+    if (p == end || *p != '"') {
+        recordError("Ожидается строка в кавычках.");
+    }
+    begin = ++p;
+    while (p < end && *p != '"') {
+        p += (*p == '\\') ? 2 : 1;
+    }
+    if (p >= end) {
+        recordError("Незакрытая строка.");
+    }
+    stop = p++;
+}
+
+// Пропуск значения неизвестного поля (в том числе вложенных объектов и массивов)
+void skipJsonValue(const char*& p, const char* end)
+{
+    int depth = 0;
+    while (p < end) {
+        const char c = *p;
+        if (c == '"') {
+            const char* b;
+            const char* e;
+            parseJsonString(p, end, b, e);
+        } else if (c == '{' || c == '[') {
+            ++depth;
+            ++p;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                return;
+            }
+            --depth;
+            ++p;
+        } else if (c == ',' && depth == 0) {
+            return;
+        } else {
+            ++p;
+        }
+    }
+}
+
+// Следующая ячейка CSV без пробелов и кавычек по краям; p переходит за
+// разделитель. Запятая внутри кавычек ячейку не разделяет. Возвращает false
+// для последней ячейки строки.
+bool takeCsvCell(const char*& p, const char* end, const char*& cell, const char*& cellEnd)
+{
+    cell = p;
+    bool quoted = false;
+    while (p < end && (quoted || *p != ',')) {
+        quoted = (*p == '"') != quoted;
+        ++p;
+    }
+    cellEnd = p;
+    const bool more = p < end;
+    if (more) {
+        ++p;
+    }
+
+    skipSpace(cell, cellEnd);
+    while (cellEnd > cell && isSpace(cellEnd[-1])) {
+        --cellEnd;
+    }
+    if (cellEnd - cell >= 2 && *cell == '"' && cellEnd[-1] == '"') {
+        ++cell;
+        --cellEnd;
+    }
+    return more;
+}
+
+// Подготовка params к новой записи
+void beginRecord(PipelineParameters& params)
+{
+    params.mode = Mode::Mode1;
+    params.outerDiameters.clear();
+}
+
+// Проверка полноты записи и подстановка типовых значений режима 1 (в режиме 2 -
+// для отсутствующих необязательных полей)
+void finishRecord(PipelineParameters& params, quint32 seenFields)
+{
+    PipelineParameters typical;
+    setTypicalMode1Values(typical);
+    if (params.mode == Mode::Mode1) {
+        setTypicalMode1Values(params);
+    }
+    const ParameterFieldList& fields = parameterFields();
+    for (int i = 0; i < ParameterFieldCount; ++i) {
+        const ParameterField& f = fields[i];
+        if ((!f.mode2Only || params.mode == Mode::Mode2) && !(seenFields & (1u << i))) {
+            if (!f.optional) {
+                recordError(QString("Поле \"%1\" отсутствует или не является числом.").arg(f.name));
+            }
+            params.*f.field = typical.*f.field;
+        }
+    }
+    validateOuterDiameters(params.outerDiameters);
+}
+
+} // namespace
+
+ScenarioReader::ScenarioReader(QIODevice* device, Format format, int chunkSize)
+    : m_device(device)
+    , m_format(format)
+    , m_begin(0)
+    , m_end(0)
+    , m_atEnd(false)
+    , m_lineNumber(0)
+{
+    m_buffer.resize(qMax(chunkSize, 4096));
+}
+
+// Следующая строка без '\n' и '\r' в виде границ внутри буфера
+bool ScenarioReader::readLine(const char*& begin, const char*& end)
+{
+    for (;;) {
+        const char* data = m_buffer.constData();
+        const char* newline = static_cast<const char*>(
+            std::memchr(data + m_begin, '\n', size_t(m_end - m_begin)));
+        if (newline || (m_atEnd && m_begin < m_end)) {
+            begin = data + m_begin;
+            end = newline ? newline : data + m_end;
+            m_begin = int(end - data) + (newline ? 1 : 0);
+            if (end > begin && end[-1] == '\r') {
+                --end;
+            }
+            ++m_lineNumber;
+            return true;
+        }
+        if (m_atEnd) {
+            return false;
+        }
+
+        // Остаток строки переносится в начало буфера и дочитывается следующий блок;
+        // буфер растет, только если одна строка не помещается в него целиком
+        if (m_begin > 0) {
+            std::memmove(m_buffer.data(), m_buffer.constData() + m_begin, size_t(m_end - m_begin));
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        if (m_end == m_buffer.size()) {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+        const qint64 count = m_device->read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+        if (count < 0) {
+            throw std::runtime_error("Ошибка чтения: " + m_device->errorString().toStdString());
+        }
+        if (count == 0 && (m_device->atEnd() || !m_device->waitForReadyRead(-1))) {
+            m_atEnd = true;
+        }
+        m_end += int(count);
+    }
+}
+
+bool ScenarioReader::next(PipelineParameters& params)
+{
+    const char* begin;
+    const char* end;
+    for (;;) {
+        if (!readLine(begin, end)) {
+            return false;
+        }
+        skipSpace(begin, end);
+        if (begin == end || *begin == '#') {
+            continue;
+        }
+
+        if (m_format == Format::Auto) {
+            m_format = (*begin == '{') ? Format::JsonLines : Format::Csv;
+        }
+        if (m_format == Format::Csv && m_columns.isEmpty()) {
+            parseCsvHeader(begin, end);
+            continue;
+        }
+        break;
+    }
+
+    beginRecord(params);
+    if (m_format == Format::JsonLines) {
+        parseJsonRecord(begin, end, params);
+    } else {
+        parseCsvRecord(begin, end, params);
+    }
+    return true;
+}
+
+void ScenarioReader::parseCsvHeader(const char* begin, const char* end)
+{
+    bool hasDiameters = false;
+    const char* p = begin;
+    for (bool more = true; more;) {
+        const char* cell;
+        const char* cellEnd;
+        more = takeCsvCell(p, end, cell, cellEnd);
+
+        if (equals(cell, cellEnd, "mode")) {
+            m_columns.append(ColumnMode);
+        } else if (equals(cell, cellEnd, "outerDiameters")) {
+            m_columns.append(ColumnDiameters);
+            hasDiameters = true;
+        } else {
+            const int index = fieldIndex(cell, cellEnd);
+            m_columns.append(index >= 0 ? index : int(ColumnIgnored));
+        }
+    }
+
+    if (!hasDiameters) {
+        m_columns.clear();
+        throw std::runtime_error("В заголовке CSV нет столбца outerDiameters.");
+    }
+}
+
+void ScenarioReader::parseJsonRecord(const char* begin, const char* end, PipelineParameters& params)
+{
+    const ParameterFieldList& fields = parameterFields();
+    quint32 seenFields = 0;
+    const char* p = begin;
+
+    if (*p != '{') {
+        recordError("Ожидается JSON-объект.");
+    }
+    ++p;
+    skipSpace(p, end);
+    bool closed = (p < end && *p == '}');
+    if (closed) {
+        ++p;
+    }
+
+    while (!closed) {
+        const char* key;
+        const char* keyEnd;
+        skipSpace(p, end);
+        parseJsonString(p, end, key, keyEnd);
+        skipSpace(p, end);
+        if (p == end || *p != ':') {
+            recordError("Ожидается ':' после имени поля.");
+        }
+        ++p;
+        skipSpace(p, end);
+
+        if (equals(key, keyEnd, "mode")) {
+            const char* value;
+            const char* valueEnd;
+            parseJsonString(p, end, value, valueEnd);
+            params.mode = parseMode(value, valueEnd);
+        } else if (equals(key, keyEnd, "outerDiameters") && p < end && *p == '"') {
+            const char* value;
+            const char* valueEnd;
+            parseJsonString(p, end, value, valueEnd);
+            if (!equals(value, valueEnd, "catalog")) {
+                recordError("Поле \"outerDiameters\" должно быть массивом чисел или \"catalog\".");
+            }
+            setCatalogDiameters(params.outerDiameters);
+        } else if (equals(key, keyEnd, "outerDiameters")) {
+            if (p == end || *p != '[') {
+                recordError("Поле \"outerDiameters\" должно быть массивом чисел.");
+            }
+            ++p;
+            skipSpace(p, end);
+            if (p < end && *p == ']') {
+                ++p;
+            } else {
+                for (;;) {
+                    skipSpace(p, end);
+                    params.outerDiameters.append(takeNumber(p, end));
+                    skipSpace(p, end);
+                    if (p < end && *p == ',') {
+                        ++p;
+                    } else if (p < end && *p == ']') {
+                        ++p;
+                        break;
+                    } else {
+                        recordError("Поле \"outerDiameters\" должно содержать только числа.");
+                    }
+                }
+            }
+        } else {
+            const int index = fieldIndex(key, keyEnd);
+            if (index >= 0) {
+                params.*fields[index].field = takeNumber(p, end);
+                seenFields |= 1u << index;
+            } else {
+                skipJsonValue(p, end);
+            }
+        }
+
+        skipSpace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+        } else if (p < end && *p == '}') {
+            ++p;
+            closed = true;
+        } else {
+            recordError("Ожидается ',' или '}'.");
+        }
+    }
+
+    skipSpace(p, end);
+    if (p != end) {
+        recordError("Лишние символы после JSON-объекта.");
+    }
+    finishRecord(params, seenFields);
+}
+
+void ScenarioReader::parseCsvRecord(const char* begin, const char* end, PipelineParameters& params)
+{
+    const ParameterFieldList& fields = parameterFields();
+    quint32 seenFields = 0;
+    const char* p = begin;
+
+    bool more = true;
+    for (int column = 0; column < m_columns.size() && more; ++column) {
+        const char* cell;
+        const char* cellEnd;
+        more = takeCsvCell(p, end, cell, cellEnd);
+
+        const int kind = m_columns[column];
+        if (kind == ColumnMode) {
+            params.mode = parseMode(cell, cellEnd);
+        } else if (kind == ColumnDiameters && equals(cell, cellEnd, "catalog")) {
+            setCatalogDiameters(params.outerDiameters);
+        } else if (kind == ColumnDiameters) {
+            // Диаметры внутри ячейки разделяются ';', ',' (ячейка в кавычках) или пробелами
+            const char* d = cell;
+            for (;;) {
+                while (d < cellEnd && (*d == ';' || *d == ',' || isSpace(*d))) {
+                    ++d;
+                }
+                if (d == cellEnd) {
+                    break;
+                }
+                params.outerDiameters.append(takeNumber(d, cellEnd));
+                if (d < cellEnd && *d != ';' && *d != ',' && !isSpace(*d)) {
+                    recordError("Диаметры в столбце outerDiameters разделяются ';' или пробелом.");
+                }
+            }
+        } else if (kind >= 0 && cell < cellEnd) {
+            params.*fields[kind].field = takeNumber(cell, cellEnd);
+            if (cell != cellEnd) {
+                recordError(QString("Лишние символы в поле \"%1\".").arg(fields[kind].name));
+            }
+            seenFields |= 1u << kind;
+        }
+    }
+
+    finishRecord(params, seenFields);
+}
@@ -0,0 +1,75 @@
+#ifndef SCENARIOREADER_H
+#define SCENARIOREADER_H
+
+#include "pipelineparameters.h"
+#include <QByteArray>
+#include <QIODevice>
+#include <QVector>
+
+// Потоковое чтение сценариев расчета из JSONL или CSV.
+//
+// Данные читаются блоками фиксированного размера в один буфер; строки
+// разбираются прямо в буфере, без копирования, числа - через parseNumber()
+// (pipelineio.h). Буфер растет только если одна строка длиннее блока,
+// поэтому расход памяти не зависит от размера файла.
+//
+// JSONL: по объекту на строку. Ключи - имена скалярных полей
+// PipelineParameters (parameterFields(), parameterfields.h) с числовыми
+// значениями, "mode" - строка "Mode1" или "Mode2" (по умолчанию Mode1),
+// "outerDiameters" - массив диаметров в мм.
+// CSV: первая строка - заголовок с теми же именами; ячейки могут быть в
+// кавычках, "outerDiameters" - диаметры через ';' или пробел (в кавычках -
+// и через ',').
+// Вместо списка диаметров можно указать catalog (в JSONL - строкой
+// "catalog"): все стандартные диаметры сортамента, без разбора чисел.
+// В режиме 1 параметры стали и среды (поля mode2Only) игнорируются и берутся
+// типовыми, как на странице ввода; в режиме 2 они обязательны, кроме
+// "viscosity" (без нее - типовая 10 мм²/с). Числа - конечные, с десятичной
+// точкой; диаметры - 100-1400 мм. Неизвестные поля и столбцы пропускаются.
+// Пустые строки и строки, начинающиеся с '#', пропускаются.
+class ScenarioReader {
+public:
+    enum class Format {
+        Auto,       // По первому значащему символу: '{' - JSONL, иначе CSV
+        JsonLines,
+        Csv
+    };
+
+    explicit ScenarioReader(QIODevice* device, Format format = Format::Auto,
+                            int chunkSize = 1 << 20);
+
+    // Чтение следующего сценария в params (память списка диаметров
+    // переиспользуется). Возвращает false в конце данных.
+    // Ошибка в записи - std::invalid_argument: строка уже пропущена, и чтение
+    // можно продолжить. Ошибка чтения или заголовка CSV - std::runtime_error.
+    bool next(PipelineParameters& params);
+
+    // Номер последней прочитанной строки (с 1)
+    qint64 lineNumber() const { return m_lineNumber; }
+
+    Format format() const { return m_format; }
+
+private:
+    // Колонка CSV: индекс в parameterFields() или особое значение
+    enum Column {
+        ColumnIgnored = -1,
+        ColumnMode = -2,
+        ColumnDiameters = -3
+    };
+
+    bool readLine(const char*& begin, const char*& end);
+    void parseCsvHeader(const char* begin, const char* end);
+    void parseJsonRecord(const char* begin, const char* end, PipelineParameters& params);
+    void parseCsvRecord(const char* begin, const char* end, PipelineParameters& params);
+
+    QIODevice* m_device;
+    Format m_format;
+    QByteArray m_buffer;
+    int m_begin;    // Начало непрочитанных данных в буфере
+    int m_end;      // Конец данных в буфере
+    bool m_atEnd;
+    qint64 m_lineNumber;
+    QVector<int> m_columns; // Назначение колонок CSV
+};
+
+#endif // SCENARIOREADER_H
@@ -0,0 +1,39 @@
+# Расчетное ядро без зависимостей от виджетов и GUI: подключается
+# в CurWork.pro (приложение) и curwork-cli.pro (консольный расчет).
+# Расчетные модули, которые приложение не использует, - в engines.pri
+
+# Запрет слияния умножения и сложения в FMA: пакетный (SIMD) расчет
+# должен побитово совпадать со скалярным
+*-g++*|*-clang*: QMAKE_CXXFLAGS += -ffp-contract=off
+
+SOURCES += \
+    continuousoptimizer.cpp \
+    frictionloss.cpp \
+    incrementaloptimizer.cpp \
+    paretofront.cpp \
+    pipelinebatchkernel.cpp \
+    pipelineio.cpp \
+    pipelineoptimizer.cpp \
+    resultcache.cpp \
+    scenarioreader.cpp \
+    thicknesscatalog.cpp
+
+HEADERS += \
+    continuousoptimizer.h \
+    dualnumber.h \
+    frictionloss.h \
+    incrementaloptimizer.h \
+    materialpolicy.h \
+    parameterfields.h \
+    paretofront.h \
+    pipelinebatchkernel.h \
+    pipelinebatchkernelimpl.h \
+    pipelineformulas.h \
+    pipelineio.h \
+    pipelineoptimizer.h \
+    pipelineparallel.h \
+    pipelineparameters.h \
+    resultcache.h \
+    scenarioreader.h \
+    sortament.h \
+    thicknesscatalog.h
@@ -0,0 +1,173 @@
+#ifndef SORTAMENT_H
+#define SORTAMENT_H
+
+#include <QtGlobal>
+
+// Сортамент стальных электросварных прямошовных труб (ГОСТ 10704-91,
+// диаметры 102-1420 мм): стандартные наружные диаметры и диапазоны толщин
+// стенок из общего ряда толщин.
+//
+// Таблицы строятся на этапе компиляции (constexpr), поиск - двоичный, без
+// разбора и построения таблиц во время работы. Диаметры и толщины - в мм.
+namespace Sortament {
+
+// Ряд стандартных толщин стенок, мм (по возрастанию)
+constexpr double kWallSeries[] = {
+    1.0, 1.2, 1.4, 1.5, 1.6, 1.8, 2.0, 2.2, 2.5, 2.8, 3.0, 3.2, 3.5, 3.8,
+    4.0, 4.5, 5.0, 5.5, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 14.0, 16.0,
+    17.0, 18.0, 19.0, 20.0, 22.0, 24.0, 25.0, 26.0, 28.0, 30.0, 32.0
+};
+constexpr int kWallCount = int(sizeof(kWallSeries) / sizeof(kWallSeries[0]));
+
+// Индекс толщины в ряду kWallSeries (-1, если ее нет в ряду)
+constexpr int wallIndex(double thickness)
+{
+    for (int i = 0; i < kWallCount; ++i) {
+        if (kWallSeries[i] == thickness) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Типоразмер: наружный диаметр и диапазон толщин [firstWall, lastWall] в ряду
+struct PipeSize {
+    double outerDiameter;  // D, мм
+    int firstWall;         // Индекс наименьшей толщины в kWallSeries
+    int lastWall;          // Индекс наибольшей толщины в kWallSeries
+
+    constexpr double minThickness() const { return kWallSeries[firstWall]; }
+    constexpr double maxThickness() const { return kWallSeries[lastWall]; }
+    constexpr int thicknessCount() const { return lastWall - firstWall + 1; }
+    constexpr double thickness(int i) const { return kWallSeries[firstWall + i]; }
+};
+
+constexpr PipeSize pipeSize(double outerDiameter, double minThickness, double maxThickness)
+{
+    return { outerDiameter, wallIndex(minThickness), wallIndex(maxThickness) };
+}
+
+// Типоразмеры по возрастанию диаметра
+constexpr PipeSize kPipeSizes[] = {
+    pipeSize(102.0, 1.0, 5.5),  pipeSize(108.0, 1.0, 5.5),  pipeSize(114.0, 1.0, 5.5),
+    pipeSize(127.0, 1.0, 5.5),  pipeSize(133.0, 1.0, 6.0),  pipeSize(140.0, 1.6, 6.0),
+    pipeSize(146.0, 2.0, 6.0),  pipeSize(152.0, 2.0, 6.0),  pipeSize(159.0, 2.0, 8.0),
+    pipeSize(168.0, 2.0, 8.0),  pipeSize(177.8, 2.5, 8.0),  pipeSize(180.0, 2.5, 8.0),
+    pipeSize(193.7, 2.5, 8.0),  pipeSize(203.0, 2.5, 8.0),  pipeSize(219.0, 3.0, 10.0),
+    pipeSize(244.5, 3.0, 10.0), pipeSize(273.0, 3.0, 10.0), pipeSize(325.0, 3.2, 10.0),
+    pipeSize(355.6, 3.5, 10.0), pipeSize(377.0, 3.5, 12.0), pipeSize(406.4, 4.0, 12.0),
+    pipeSize(426.0, 4.0, 12.0), pipeSize(457.0, 4.0, 12.0), pipeSize(478.0, 4.0, 12.0),
+    pipeSize(508.0, 4.0, 14.0), pipeSize(530.0, 4.0, 24.0), pipeSize(630.0, 5.0, 24.0),
+    pipeSize(720.0, 5.0, 32.0), pipeSize(820.0, 6.0, 32.0), pipeSize(920.0, 7.0, 32.0),
+    pipeSize(1020.0, 8.0, 32.0), pipeSize(1120.0, 9.0, 32.0), pipeSize(1220.0, 10.0, 32.0),
+    pipeSize(1420.0, 12.0, 32.0)
+};
+constexpr int kPipeSizeCount = int(sizeof(kPipeSizes) / sizeof(kPipeSizes[0]));
+
+// Проверка таблиц при компиляции: ряды возрастают, все толщины из ряда
+constexpr bool catalogIsValid()
+{
+    for (int i = 1; i < kWallCount; ++i) {
+        if (!(kWallSeries[i - 1] < kWallSeries[i])) {
+            return false;
+        }
+    }
+    for (int i = 0; i < kPipeSizeCount; ++i) {
+        const PipeSize& s = kPipeSizes[i];
+        if (s.firstWall < 0 || s.lastWall < s.firstWall ||
+            (i > 0 && !(kPipeSizes[i - 1].outerDiameter < s.outerDiameter)) ||
+            !(2.0 * s.maxThickness() < s.outerDiameter)) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(catalogIsValid(), "Сортамент труб: таблицы должны быть упорядочены, толщины - из ряда");
+
+// Индекс первого типоразмера с диаметром ≥ outerDiameter (kPipeSizeCount, если нет)
+constexpr int lowerBound(double outerDiameter)
+{
+    int low = 0;
+    int high = kPipeSizeCount;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (kPipeSizes[mid].outerDiameter < outerDiameter) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Типоразмер с точно таким диаметром или nullptr
+constexpr const PipeSize* findDiameter(double outerDiameter)
+{
+    const int i = lowerBound(outerDiameter);
+    return (i < kPipeSizeCount && kPipeSizes[i].outerDiameter == outerDiameter) ? &kPipeSizes[i] : nullptr;
+}
+
+constexpr bool isStandardDiameter(double outerDiameter)
+{
+    return findDiameter(outerDiameter) != nullptr;
+}
+
+// Наименьшая толщина ряда ≥ thickness (0 - больше наибольшей в ряду)
+constexpr double nextSeriesThickness(double thickness)
+{
+    int low = 0;
+    int high = kWallCount;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (kWallSeries[mid] < thickness) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < kWallCount ? kWallSeries[low] : 0.0;
+}
+
+// Наименьшая стандартная толщина ≥ thickness для диаметра outerDiameter
+// (0 - диаметр нестандартный или все его толщины меньше thickness)
+constexpr double nextStandardThickness(double outerDiameter, double thickness)
+{
+    const PipeSize* size = findDiameter(outerDiameter);
+    if (!size) {
+        return 0.0;
+    }
+    for (int i = size->firstWall; i <= size->lastWall; ++i) {
+        if (kWallSeries[i] >= thickness) {
+            return kWallSeries[i];
+        }
+    }
+    return 0.0;
+}
+
+// Типоразмеры с диаметрами в [minDiameter, maxDiameter]
+struct DiameterRange {
+    const PipeSize* first;
+    const PipeSize* last;  // За последним
+
+    constexpr const PipeSize* begin() const { return first; }
+    constexpr const PipeSize* end() const { return last; }
+    constexpr int size() const { return int(last - first); }
+};
+
+constexpr DiameterRange diametersInRange(double minDiameter, double maxDiameter)
+{
+    const int first = lowerBound(minDiameter);
+    int last = first;
+    while (last < kPipeSizeCount && kPipeSizes[last].outerDiameter <= maxDiameter) {
+        ++last;
+    }
+    return { kPipeSizes + first, kPipeSizes + last };
+}
+
+static_assert(isStandardDiameter(530.0) && !isStandardDiameter(531.0), "Поиск диаметра");
+static_assert(nextStandardThickness(530.0, 7.3) == 8.0, "Поиск толщины");
+static_assert(diametersInRange(500.0, 1000.0).size() == 6, "Поиск диапазона");
+
+} // namespace Sortament
+
+#endif // SORTAMENT_H
@@ -0,0 +1,219 @@
+#include "steelgradecatalog.h"
+#include "materialpolicy.h"
+#include "pipelineformulas.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Расчетные сопротивления каждой марки при параметрах params (по той же
+// формуле, что и в calculate(), поэтому сравнения побитово совпадают с
+// PipelineOptimizer::checkThickness())
+QVector<DesignResistance> gradeResistances(const PipelineParameters& params, const QVector<SteelGrade>& grades)
+{
+    // R1 и R2 растут с σ_т и σ_п, только если коэффициенты при них положительны
+    PipelineParameters unit = params;
+    unit.yieldStrength = 1.0;
+    unit.tensileStrength = 1.0;
+    const DesignResistance scale = DesignResistance::fromParameters(unit);
+    if (!(scale.R1 > 0.0 && scale.R2 > 0.0) || !std::isfinite(scale.R1) || !std::isfinite(scale.R2)) {
+        throw std::invalid_argument("Расчетные сопротивления стали должны быть положительными.");
+    }
+
+    QVector<DesignResistance> resistances;
+    resistances.reserve(grades.size());
+    PipelineParameters gradeParams = params;
+    for (const SteelGrade& grade : grades) {
+        gradeParams.yieldStrength = grade.yieldStrength;
+        gradeParams.tensileStrength = grade.tensileStrength;
+        resistances.append(DesignResistance::fromParameters(gradeParams));
+    }
+    return resistances;
+}
+
+// Проверка характеристик марки
+void checkGrade(const SteelGrade& grade)
+{
+    if (!(grade.yieldStrength > 0.0) || !(grade.tensileStrength > 0.0) || !(grade.price >= 0.0) ||
+        !std::isfinite(grade.yieldStrength) || !std::isfinite(grade.tensileStrength) ||
+        !std::isfinite(grade.price)) {
+        throw std::invalid_argument(QString("Недопустимые характеристики марки стали \"%1\".")
+                                        .arg(grade.name).toStdString());
+    }
+}
+
+} // namespace
+
+SteelGradeCatalog SteelGradeCatalog::fromList(const QVector<SteelGrade>& grades)
+{
+    for (const SteelGrade& grade : grades) {
+        checkGrade(grade);
+    }
+
+    // По возрастанию цены; при равной цене прочные марки раньше, чтобы
+    // равные по цене, но более слабые отбрасывались
+    QVector<SteelGrade> sorted = grades;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const SteelGrade& a, const SteelGrade& b) {
+        if (a.price != b.price) {
+            return a.price < b.price;
+        }
+        if (a.yieldStrength != b.yieldStrength) {
+            return a.yieldStrength > b.yieldStrength;
+        }
+        return a.tensileStrength > b.tensileStrength;
+    });
+
+    // === ОТБРАСЫВАНИЕ ДОМИНИРУЕМЫХ МАРОК ===
+
+    // Все оставленные марки не дороже текущей: если одна из них не слабее
+    // ни по σ_т, ни по σ_п, текущая марка не нужна
+    SteelGradeCatalog catalog;
+    catalog.m_grades.reserve(sorted.size());
+    for (const SteelGrade& grade : sorted) {
+        const bool dominated = std::any_of(catalog.m_grades.constBegin(), catalog.m_grades.constEnd(),
+                                           [&grade](const SteelGrade& kept) {
+            return kept.yieldStrength >= grade.yieldStrength &&
+                   kept.tensileStrength >= grade.tensileStrength;
+        });
+        if (!dominated) {
+            catalog.m_grades.append(grade);
+        }
+    }
+    catalog.m_prunedCount = sorted.size() - catalog.m_grades.size();
+
+    // === РАЗБИЕНИЕ НА ЦЕПОЧКИ ===
+
+    // Марка дописывается в первую цепочку, последняя марка которой не прочнее
+    // ее ни по σ_т, ни по σ_п
+    for (int i = 0; i < catalog.m_grades.size(); ++i) {
+        const SteelGrade& grade = catalog.m_grades[i];
+        bool placed = false;
+        for (QVector<int>& chain : catalog.m_chains) {
+            const SteelGrade& last = catalog.m_grades[chain.last()];
+            if (last.yieldStrength <= grade.yieldStrength && last.tensileStrength <= grade.tensileStrength) {
+                chain.append(i);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            catalog.m_chains.append(QVector<int>{i});
+        }
+    }
+    return catalog;
+}
+
+SteelGradeCatalog SteelGradeCatalog::fromFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть каталог марок стали %1: %2")
+                                     .arg(path, file.errorString()).toStdString());
+    }
+    const QByteArray data = file.readAll();
+
+    QVector<SteelGrade> grades;
+    TextTableReader table(data.constData(), data.size());
+    while (table.nextLine()) {
+        // Название - первая лексема, затем σ_т, σ_п и цена
+        const char* token;
+        const char* tokenEnd;
+        if (!table.nextToken(token, tokenEnd)) {
+            continue;
+        }
+        SteelGrade grade;
+        grade.name = QString::fromUtf8(token, int(tokenEnd - token));
+
+        double numbers[3];
+        int count = 0;
+        while (table.nextToken(token, tokenEnd)) {
+            if (count == 3 || !TextTableReader::toNumber(token, tokenEnd, numbers[count])) {
+                count = -1;
+                break;
+            }
+            ++count;
+        }
+        if (count != 3) {
+            throw std::invalid_argument(QString("Каталог марок стали, строка %1: ожидается "
+                                                "\"НАЗВАНИЕ σ_т σ_п ЦЕНА\".")
+                                            .arg(table.lineNumber()).toStdString());
+        }
+        grade.yieldStrength = numbers[0];
+        grade.tensileStrength = numbers[1];
+        grade.price = numbers[2];
+        try {
+            checkGrade(grade);
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(QString("Каталог марок стали, строка %1: %2")
+                                            .arg(table.lineNumber()).arg(e.what()).toStdString());
+        }
+        grades.append(grade);
+    }
+    return fromList(grades);
+}
+
+GradeSelection SteelGradeCatalog::select(const PipelineParameters& params,
+                                         double outerDiameter, double thickness) const
+{
+    QVector<GradeSelection> results;
+    select(params, QVector<PipeSection>{PipeSection{outerDiameter, thickness}}, results);
+    return results.first();
+}
+
+void SteelGradeCatalog::select(const PipelineParameters& params, const QVector<PipeSection>& sections,
+                               QVector<GradeSelection>& results) const
+{
+    const QVector<DesignResistance> resistances = gradeResistances(params, m_grades);
+    const DesignResistance* resistance = resistances.constData();
+    const RuntimeMaterial material(params);
+
+    results.resize(sections.size());
+    for (int s = 0; s < sections.size(); ++s) {
+        GradeSelection& selection = results[s];
+        selection = GradeSelection();
+
+        // Напряжения от марки не зависят: один расчет на участок, R1 и R2 здесь
+        // не используются
+        const ThicknessEvaluation ev = evaluateThickness(material, params, 0.0, 0.0, 0.0,
+                                                         sections[s].outerDiameter / 1000.0,
+                                                         sections[s].thickness);
+        if (ev.outcome == ThicknessOutcome::Aborted) {
+            continue;
+        }
+        selection.isValid = true;
+        if (ev.outcome == ThicknessOutcome::FlowSpeedFailed) {
+            continue;
+        }
+        selection.satisfiesFlowSpeed = true;
+
+        auto passes = [&](int i) {
+            ++selection.checks;
+            return ev.hoop <= resistance[i].R1 && ev.axial <= resistance[i].R2 &&
+                   ev.equiv <= resistance[i].allowEquiv;
+        };
+
+        // В каждой цепочке - двоичный поиск первой подходящей марки среди
+        // марок дешевле уже найденной
+        int best = m_grades.size();
+        for (const QVector<int>& chain : m_chains) {
+            int low = 0;
+            int high = int(std::lower_bound(chain.constBegin(), chain.constEnd(), best) - chain.constBegin());
+            while (low < high) {
+                const int mid = low + (high - low) / 2;
+                if (passes(chain[mid])) {
+                    high = mid;
+                } else {
+                    low = mid + 1;
+                }
+            }
+            if (low < chain.size() && chain[low] < best) {
+                best = chain[low];
+            }
+        }
+        selection.grade = best < m_grades.size() ? best : -1;
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef STEELGRADECATALOG_H
+#define STEELGRADECATALOG_H
+
+#include "pipelineparameters.h"
+#include <QString>
+#include <QVector>
+
+// Марка стали с ценой
+struct SteelGrade {
+    QString name;
+    double yieldStrength = 0.0;    // σ_т, МПа
+    double tensileStrength = 0.0;  // σ_п, МПа
+    double price = 0.0;            // Цена (в любых единицах, одинаковых для всего каталога)
+};
+
+// Выбранная марка стали для участка
+struct GradeSelection {
+    bool isValid = false;          // Расчет выполнен без геометрических и числовых ошибок
+    bool satisfiesFlowSpeed = false; // От марки не зависит: без нее подходящей марки нет
+    int grade = -1;                // Индекс в SteelGradeCatalog::grades() (-1 - ни одна не подходит)
+    int checks = 0;                // Сравнений марок с напряжениями при поиске
+};
+
+// Каталог марок стали для подбора самой дешевой подходящей марки.
+//
+// Напряжения трубы заданных диаметра и толщины стенки от σ_т и σ_п не
+// зависят, а условия σ_кц ≤ R1, σ_экв ≤ 0.9σ_т и σ_пр ≤ R2 с ростом σ_т и
+// σ_п только ослабевают. Поэтому марка, которая дороже другой и не прочнее
+// ее ни по σ_т, ни по σ_п, никогда не бывает лучшим выбором и отбрасывается
+// при построении каталога.
+//
+// Оставшиеся марки по возрастанию цены жадно раскладываются на цепочки, в
+// каждой из которых σ_т и σ_п не убывают. Внутри цепочки проверка монотонна
+// (если проходит марка, проходят и все следующие), поэтому первая подходящая
+// марка цепочки ищется двоичным поиском, а ответ - самая дешевая из найденных
+// по цепочкам. Обычно σ_т и σ_п растут вместе с ценой и цепочка одна.
+class SteelGradeCatalog {
+public:
+    SteelGradeCatalog() = default;
+
+    // Марки с σ_т > 0, σ_п > 0 и конечной неотрицательной ценой (иначе
+    // std::invalid_argument); доминируемые марки отбрасываются
+    static SteelGradeCatalog fromList(const QVector<SteelGrade>& grades);
+
+    // Текстовый файл: строка "НАЗВАНИЕ σ_т σ_п ЦЕНА" (разделители - пробелы,
+    // ',' или ';'), пустые строки и строки с '#' пропускаются. Ошибка чтения -
+    // std::runtime_error, ошибка в данных - std::invalid_argument с номером строки.
+    static SteelGradeCatalog fromFile(const QString& path);
+
+    // Оставшиеся марки по возрастанию цены
+    const QVector<SteelGrade>& grades() const { return m_grades; }
+
+    // Сколько марок отброшено как доминируемые
+    int prunedCount() const { return m_prunedCount; }
+
+    bool isEmpty() const { return m_grades.isEmpty(); }
+
+    // Самая дешевая марка, при которой участок с наружным диаметром
+    // outerDiameter (мм) и толщиной стенки thickness (м) проходит все проверки
+    // calculate() при параметрах params (σ_т и σ_п параметров не используются)
+    GradeSelection select(const PipelineParameters& params, double outerDiameter, double thickness) const;
+
+    // То же для списка участков
+    void select(const PipelineParameters& params, const QVector<PipeSection>& sections,
+                QVector<GradeSelection>& results) const;
+
+private:
+    QVector<SteelGrade> m_grades;       // По возрастанию цены
+    QVector<QVector<int>> m_chains;     // Индексы марок: σ_т и σ_п не убывают
+    int m_prunedCount = 0;
+};
+
+#endif // STEELGRADECATALOG_H
@@ -0,0 +1,7 @@
+# Векторные ядра пакетного расчета против скалярной проверки толщины
+TARGET = tst_batchkernel
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_batchkernel.cpp
@@ -0,0 +1,51 @@
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+
+// Векторный пакетный расчет напряжений против скалярного checkThickness()
+// на всех доступных наборах инструкций
+class BatchKernelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stressBatchMatchesCheckThickness();
+};
+
+void BatchKernelTest::stressBatchMatchesCheckThickness()
+{
+    std::mt19937_64 rng(60);
+    StressBatch batch;
+    for (SimdIsa isa : availableIsas()) {
+        for (int n = 0; n < 100; ++n) {
+            const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+            const DesignResistance r = DesignResistance::fromParameters(params);
+            const StressConstants constants = StressConstants::fromParameters(params, r.R1, r.R2, r.allowEquiv);
+            fillRandomBatch(rng, params, r, batch, 1 + n % 50);
+            evaluateStressBatch(constants, batch, isa);
+
+            for (int i = 0; i < batch.size(); ++i) {
+                // Без векторных инструкций все дорожки остаются скалярному расчету
+                if (isa == SimdIsa::None) {
+                    QCOMPARE(batch.flags[i], quint8(0));
+                    continue;
+                }
+                const ThicknessCheck check = PipelineOptimizer::checkThickness(
+                    params, r, batch.outerDiameter[i] * 1000.0, batch.thickness[i]);
+                QCOMPARE(batch.flags[i], expectedLaneFlags(check));
+                if (batch.flags[i] & LaneValid) {
+                    QVERIFY(batch.flowSpeed[i] == check.flowSpeed);
+                }
+                if (batch.flags[i] & LaneFlowSpeed) {
+                    QVERIFY(batch.hoop[i] == check.hoop);
+                    QVERIFY(batch.axial[i] == check.axial);
+                    QVERIFY(batch.equivalent[i] == check.equivalent);
+                }
+            }
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(BatchKernelTest)
+
+#include "tst_batchkernel.moc"
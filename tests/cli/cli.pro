@@ -0,0 +1,12 @@
+# Консольный пакетный расчет (curwork-cli): аргументы, вход и выход
+TARGET = tst_cli
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_cli.cpp \
+    clidriver.cpp
+
+HEADERS += \
+    clidriver.h
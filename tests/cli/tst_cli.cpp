@@ -0,0 +1,590 @@
+#include "clidriver.h"
+#include "continuousoptimizer.h"
+#include "elevationprofile.h"
+#include "parameterfields.h"
+#include "parametersweep.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include "pressurelimit.h"
+#include "reliabilityanalysis.h"
+#include "routeoptimizer.h"
+#include "safetysensitivities.h"
+#include "steelgradecatalog.h"
+#include "testsupport.h"
+#include "thermalmodel.h"
+#include "waterhammer.h"
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtTest>
+
+// Консольный расчет: вывод совпадает с PipelineOptimizer::calculate(),
+// ошибки в сценариях и аргументах дают коды завершения 1 и 2
+class CliTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void jsonOutputMatchesCalculate();
+    void csvOutputHasHeader();
+    void badScenarioIsSkipped();
+    void continuousWithoutCatalogSizeIsInvalid();
+    void sweepMatchesParameterSweep();
+    void reliabilityMatchesAnalysis();
+    void sensitivitiesMatchFunction();
+    void maopMatchesPressureLimit();
+    void gradeMatchesCatalog();
+    void routeMatchesOptimizer();
+    void profileMatchesAnalysis();
+    void waterHammerMatchesSimulator();
+    void thermalMatchesModel();
+    void badArgumentsPrintUsage();
+};
+
+namespace {
+
+// Результат запуска: код завершения, output и errors
+struct CliRun {
+    int code = -1;
+    QByteArray output;
+    QByteArray errors;
+};
+
+CliRun runCli(const QStringList& arguments, const QByteArray& input)
+{
+    QBuffer in;
+    in.setData(input);
+    in.open(QIODevice::ReadOnly);
+    QBuffer out;
+    out.open(QIODevice::WriteOnly);
+    QBuffer err;
+    err.open(QIODevice::WriteOnly);
+
+    CliRun run;
+    run.code = runCommandLine(arguments, &in, &out, &err);
+    run.output = out.buffer();
+    run.errors = err.buffer();
+    return run;
+}
+
+QVector<PipelineParameters> scenarios(int count)
+{
+    std::mt19937_64 rng(1);
+    QVector<PipelineParameters> result;
+    for (int n = 0; n < count; ++n) {
+        result.append(randomParameters(rng, TestMaterial::RuntimeBend, 1 + n % 5));
+    }
+    return result;
+}
+
+} // namespace
+
+void CliTest::jsonOutputMatchesCalculate()
+{
+    const QVector<PipelineParameters> input = scenarios(10);
+    QByteArray text;
+    QByteArray expected;
+    PipelineOptimizer optimizer;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const ValidationResult& r : optimizer.calculate(input[n])) {
+            expected += resultToJsonLine(n, r);
+        }
+    }
+
+    for (const QStringList& arguments : { QStringList(), QStringList({ "--threads", "0", "-" }) }) {
+        const CliRun run = runCli(arguments, text);
+        QCOMPARE(run.code, 0);
+        QVERIFY(run.errors.isEmpty());
+        QCOMPARE(run.output, expected);
+    }
+}
+
+void CliTest::csvOutputHasHeader()
+{
+    const QVector<PipelineParameters> input = scenarios(3);
+    QByteArray text;
+    QByteArray expected = resultCsvHeader();
+    PipelineOptimizer optimizer;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const ValidationResult& r : optimizer.calculate(input[n])) {
+            expected += resultToCsvLine(n, r);
+        }
+    }
+
+    const CliRun run = runCli({ "--format", "csv" }, text);
+    QCOMPARE(run.code, 0);
+    QCOMPARE(run.output, expected);
+}
+
+void CliTest::badScenarioIsSkipped()
+{
+    // Сценарий 1 без давления: ошибка со строкой и номером сценария,
+    // остальные сценарии рассчитываются
+    const QVector<PipelineParameters> input = scenarios(3);
+    QByteArray bad = scenarioToJsonLine(input[1]);
+    bad.replace("\"pressure\":", "\"pressureX\":");
+    const QByteArray text = scenarioToJsonLine(input[0]) + bad + scenarioToJsonLine(input[2]);
+
+    QByteArray expected;
+    PipelineOptimizer optimizer;
+    for (int n : { 0, 2 }) {
+        for (const ValidationResult& r : optimizer.calculate(input[n])) {
+            expected += resultToJsonLine(n, r);
+        }
+    }
+
+    const CliRun run = runCli({}, text);
+    QCOMPARE(run.code, 1);
+    QCOMPARE(run.output, expected);
+    QVERIFY(run.errors.startsWith("Строка 2 (сценарий 1)"));
+}
+
+void CliTest::continuousWithoutCatalogSizeIsInvalid()
+{
+    // При таком давлении ни один размер сортамента не проходит проверки
+    PipelineParameters params = scenarios(1).first();
+    params.pressure = 80.0;
+    const ContinuousDesign design = ContinuousOptimizer(params).run();
+    QVERIFY(!design.snapped);
+
+    ValidationResult invalid{};
+    invalid.diameter = design.diameter;
+    const CliRun run = runCli({ "--continuous" }, scenarioToJsonLine(params));
+    QCOMPARE(run.code, 1);
+    QCOMPARE(run.output, resultToJsonLine(0, invalid));
+    QVERIFY(run.errors.startsWith("Сценарий 0"));
+
+    const CliRun csv = runCli({ "--continuous", "--format", "csv" }, scenarioToJsonLine(params));
+    QCOMPARE(csv.code, 1);
+    QCOMPARE(csv.output, resultCsvHeader() + resultToCsvLine(0, invalid));
+}
+
+void CliTest::sweepMatchesParameterSweep()
+{
+    // Запись точки - запись calculate с номером точки и значениями осей
+    const PipelineParameters base = scenarios(2).last();
+    ParameterSweep sweep(base);
+    sweep.addAxis(SweepAxis::range(&PipelineParameters::pressure, 1.0, 4.0, 1.5));
+    sweep.addAxis(SweepAxis::list(&PipelineParameters::massFlow, { 50.0, 400.0 }));
+    QByteArray expected;
+    sweep.run([&](qint64 point, const PipelineParameters& p, const QVector<ValidationResult>& results) {
+        for (const ValidationResult& r : results) {
+            QByteArray line = resultToJsonLine(0, r);
+            line.replace("{\"scenario\":0,", "{\"scenario\":0,\"point\":" + QByteArray::number(point) +
+                                                ",\"pressure\":" + QByteArray::number(p.pressure, 'g', 17) +
+                                                ",\"massFlow\":" + QByteArray::number(p.massFlow, 'g', 17) + ",");
+            expected += line;
+        }
+    });
+
+    const CliRun run = runCli({ "sweep", "--axis", "pressure=1:4:1.5", "--axis", "massFlow=50,400",
+                                "--threads", "2" },
+                              scenarioToJsonLine(base));
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun csv = runCli({ "sweep", "--axis", "pressure=2", "--format", "csv" }, scenarioToJsonLine(base));
+    QCOMPARE(csv.code, 0);
+    QVERIFY(csv.output.startsWith("scenario,point,pressure,diameter,thickness,"));
+}
+
+void CliTest::reliabilityMatchesAnalysis()
+{
+    const PipelineParameters params = scenarios(3).last();
+    ReliabilitySettings settings;
+    settings.pressure = RandomVariable::uniform(0.8 * params.pressure, 1.5 * params.pressure);
+    settings.yieldStrength = RandomVariable::normal(params.yieldStrength, 20.0);
+    settings.yieldStrength.importanceShift = -1.0;
+    settings.samples = 5000;
+    settings.seed = 3;
+    const QVector<DiameterReliability> expected = ReliabilityAnalysis(params, settings).run();
+
+    const QString pressure = QString("pressure=uniform:%1:%2")
+                                 .arg(settings.pressure.mean - settings.pressure.spread, 0, 'g', 17)
+                                 .arg(settings.pressure.mean + settings.pressure.spread, 0, 'g', 17);
+    const QString yield = QString("yieldStrength=normal:%1:20:-1").arg(params.yieldStrength, 0, 'g', 17);
+    const CliRun run = runCli({ "reliability", "--samples", "5000", "--seed", "3", "--vary", pressure,
+                                "--vary", yield, "--threads", "3", "--format", "csv" },
+                              scenarioToJsonLine(params));
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+
+    QByteArray text = "scenario,diameter,thickness,designed,failureProbability,standardError,"
+                      "flowSpeedFailure,hoopFailure,axialFailure,equivalentFailure\n";
+    for (const DiameterReliability& d : expected) {
+        text += "0";
+        for (double value : { d.diameter, d.thickness }) {
+            text += "," + QByteArray::number(value, 'g', 17);
+        }
+        text += d.designed ? ",1" : ",0";
+        for (double value : { d.failureProbability, d.standardError, d.flowSpeedFailure, d.hoopFailure,
+                              d.axialFailure, d.equivalentFailure }) {
+            text += "," + QByteArray::number(value, 'g', 17);
+        }
+        text += "\n";
+    }
+    QCOMPARE(run.output, text);
+}
+
+void CliTest::sensitivitiesMatchFunction()
+{
+    // Запись на каждый валидный результат: запасы и производные по полям
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const ValidationResult& r : PipelineOptimizer().calculate(input[n])) {
+            if (!r.isValid) {
+                continue;
+            }
+            const SafetySensitivities s = safetySensitivities(input[n], r.diameter, r.finalThickness);
+            expected += "{\"scenario\":" + QByteArray::number(n) +
+                        ",\"diameter\":" + QByteArray::number(r.diameter, 'g', 17) +
+                        ",\"thickness\":" + QByteArray::number(r.finalThickness, 'g', 17) +
+                        ",\"isValid\":" + (s.isValid ? "true" : "false");
+            const char* const names[] = { "safetyHoop", "safetyAxial", "safetyEquivalent" };
+            const SafetyGradient* gradients[] = { &s.hoop, &s.axial, &s.equivalent };
+            for (int j = 0; j < 3; ++j) {
+                expected += ",\"" + QByteArray(names[j]) + "\":" + QByteArray::number(gradients[j]->value, 'g', 17);
+                for (int k = 0; k < ParameterFieldCount; ++k) {
+                    expected += ",\"" + QByteArray(names[j]) + "." + parameterFields()[k].name + "\":" +
+                                QByteArray::number(gradients[j]->gradient[k], 'g', 17);
+                }
+            }
+            expected += "}\n";
+        }
+    }
+    QVERIFY(!expected.isEmpty());
+
+    const CliRun run = runCli({ "sensitivities" }, text);
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun csv = runCli({ "sensitivities", "--format", "csv" }, text);
+    QCOMPARE(csv.code, 0);
+    QVERIFY(csv.output.startsWith("scenario,diameter,thickness,isValid,safetyHoop,safetyHoop.pressure,"));
+}
+
+void CliTest::maopMatchesPressureLimit()
+{
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    const char* const statuses[] = { "found", "flowSpeedFailed", "notFeasible", "unbounded", "invalid" };
+    const char* const criteria[] = { "hoop", "axial", "equivalent" };
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const PipeSection& s : designedSections(input[n])) {
+            const PressureLimit limit = PressureLimitSolver(input[n]).solve(s.outerDiameter, s.thickness);
+            expected += "{\"scenario\":" + QByteArray::number(n) +
+                        ",\"diameter\":" + QByteArray::number(s.outerDiameter, 'g', 17) +
+                        ",\"thickness\":" + QByteArray::number(s.thickness, 'g', 17) +
+                        ",\"status\":\"" + statuses[int(limit.status)] +
+                        "\",\"pressure\":" + QByteArray::number(limit.pressure, 'g', 17) +
+                        ",\"surge\":" + QByteArray::number(limit.surge, 'g', 17) +
+                        ",\"limitingCriterion\":\"" + criteria[int(limit.limitingCriterion)] + "\"}\n";
+        }
+    }
+    QVERIFY(expected.contains("\"status\":\"found\""));
+
+    const CliRun run = runCli({ "maop", "--threads", "2" }, text);
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun csv = runCli({ "maop", "--format", "csv" }, text);
+    QCOMPARE(csv.code, 0);
+    QVERIFY(csv.output.startsWith("scenario,diameter,thickness,status,pressure,surge,limitingCriterion\n"));
+    QVERIFY(csv.output.contains(",found,"));
+}
+
+void CliTest::gradeMatchesCatalog()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("grades.txt");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("К42 245 410 80\nК52 355 510 100\nК60 480 590 130\nК65 550 640 150\n");
+    }
+    const SteelGradeCatalog catalog = SteelGradeCatalog::fromFile(path);
+
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const PipeSection& s : designedSections(input[n])) {
+            const GradeSelection selection = catalog.select(input[n], s.outerDiameter, s.thickness);
+            const SteelGrade* grade = selection.grade >= 0 ? &catalog.grades()[selection.grade] : nullptr;
+            expected += "{\"scenario\":" + QByteArray::number(n) +
+                        ",\"diameter\":" + QByteArray::number(s.outerDiameter, 'g', 17) +
+                        ",\"thickness\":" + QByteArray::number(s.thickness, 'g', 17) +
+                        ",\"isValid\":" + (selection.isValid ? "true" : "false") +
+                        ",\"satisfiesFlowSpeed\":" + (selection.satisfiesFlowSpeed ? "true" : "false") +
+                        ",\"grade\":\"" + (grade ? grade->name.toUtf8() : QByteArray()) +
+                        "\",\"price\":" + QByteArray::number(grade ? grade->price : 0.0, 'g', 17) + "}\n";
+        }
+    }
+    QVERIFY(expected.contains("\"grade\":\"К"));
+
+    const CliRun run = runCli({ "grade", "--grades", path }, text);
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun missing = runCli({ "grade", "--grades", QDir(dir.path()).filePath("missing.txt") }, text);
+    QCOMPARE(missing.code, 2);
+    QVERIFY(missing.output.isEmpty());
+    QVERIFY(missing.errors.startsWith("Не удалось открыть каталог марок стали"));
+}
+
+void CliTest::routeMatchesOptimizer()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("route.txt");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("# длина давление радиус\n3000 6\n1200 4.5 2000\n2500 2\n");
+    }
+    const QVector<RouteSegment> route = readRouteSegments(path);
+
+    const QVector<PipelineParameters> input = scenarios(6);
+    QByteArray text;
+    QByteArray expected;
+    int infeasible = 0;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        RouteOptimizer optimizer(input[n]);
+        optimizer.setMaxDiameterChanges(1);
+        const RouteDesign design = optimizer.run(route);
+        infeasible += !design.isFeasible;
+        for (int i = 0; i < route.size(); ++i) {
+            const PipeSection section = design.isFeasible ? design.sections[i] : PipeSection{};
+            expected += "{\"scenario\":" + QByteArray::number(n) + ",\"segment\":" + QByteArray::number(i) +
+                        ",\"length\":" + QByteArray::number(route[i].length, 'g', 17) +
+                        ",\"pressure\":" + QByteArray::number(route[i].pressure, 'g', 17) +
+                        ",\"bendRadius\":" + QByteArray::number(route[i].bendRadius, 'g', 17) +
+                        ",\"diameter\":" + QByteArray::number(section.outerDiameter, 'g', 17) +
+                        ",\"thickness\":" + QByteArray::number(section.thickness, 'g', 17) +
+                        ",\"feasible\":" + (design.isFeasible ? "true" : "false") +
+                        ",\"mass\":" + QByteArray::number(design.mass, 'g', 17) +
+                        ",\"diameterChanges\":" + QByteArray::number(design.diameterChanges) + "}\n";
+        }
+    }
+    QVERIFY(infeasible < input.size());
+
+    const CliRun run = runCli({ "route", "--route", path, "--max-changes", "1", "--threads", "2" }, text);
+    QCOMPARE(run.code, infeasible > 0 ? 1 : 0);
+    QCOMPARE(run.errors.count('\n'), infeasible);
+    QCOMPARE(run.output, expected);
+
+    const CliRun missing = runCli({ "route", "--route", QDir(dir.path()).filePath("missing.txt") }, text);
+    QCOMPARE(missing.code, 2);
+    QVERIFY(missing.output.isEmpty());
+    QVERIFY(missing.errors.startsWith("Не удалось открыть трассу"));
+}
+
+void CliTest::profileMatchesAnalysis()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("profile.csv");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("пикет высота\n0 120\n5000 80\n12000 -40\n20000 15\n");
+    }
+    const ElevationProfile profile(path);
+
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        for (const PipeSection& s : designedSections(input[n])) {
+            const ProfileAnalysis a = profile.analyze(input[n], s.outerDiameter, s.thickness);
+            auto number = [](double value) { return QByteArray::number(value, 'g', 17); };
+            expected += "{\"scenario\":" + QByteArray::number(n) + ",\"diameter\":" + number(s.outerDiameter) +
+                        ",\"thickness\":" + number(s.thickness) + ",\"points\":" + QByteArray::number(a.points) +
+                        ",\"length\":" + number(a.length) + ",\"hydraulicGradient\":" + number(a.hydraulicGradient) +
+                        ",\"frictionLoss\":" + number(a.frictionLoss) + ",\"staticHead\":" + number(a.staticHead) +
+                        ",\"outletPressure\":" + number(a.outletPressure) +
+                        ",\"minPressure\":" + number(a.minPressure) +
+                        ",\"minPressureChainage\":" + number(a.minPressureChainage) +
+                        ",\"maxPressure\":" + number(a.maxPressure) +
+                        ",\"maxPressureChainage\":" + number(a.maxPressureChainage) +
+                        ",\"checkedPoints\":" + QByteArray::number(a.checkedPoints) +
+                        ",\"failedPoints\":" + QByteArray::number(a.failedPoints) +
+                        ",\"firstFailureChainage\":" + number(a.firstFailureChainage) +
+                        ",\"passes\":" + (a.passes() ? "true" : "false") + "}\n";
+        }
+    }
+    QVERIFY(!expected.isEmpty());
+
+    const CliRun run = runCli({ "profile", "--profile", path }, text);
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun missing = runCli({ "profile", "--profile", QDir(dir.path()).filePath("missing.bin") }, text);
+    QCOMPARE(missing.code, 2);
+    QVERIFY(missing.output.isEmpty());
+    QVERIFY(missing.errors.startsWith("Не удалось открыть профиль высот"));
+}
+
+void CliTest::waterHammerMatchesSimulator()
+{
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    int failures = 0;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        WaterHammerSimulator simulator(input[n]);
+        simulator.setValveCurve(WaterHammerSimulator::closureCurve(4.0));
+        simulator.setDuration(10.0);
+        for (const PipeSection& s : designedSections(input[n])) {
+            WaterHammerResult r;
+            try {
+                r = simulator.run(s.outerDiameter, s.thickness, 3000.0);
+            } catch (const std::invalid_argument&) {
+                ++failures;
+                continue;
+            }
+            auto number = [](double value) { return QByteArray::number(value, 'g', 17); };
+            expected += "{\"scenario\":" + QByteArray::number(n) + ",\"diameter\":" + number(s.outerDiameter) +
+                        ",\"thickness\":" + number(s.thickness) + ",\"waveSpeed\":" + number(r.waveSpeed) +
+                        ",\"flowSpeed\":" + number(r.flowSpeed) + ",\"joukowskySurge\":" + number(r.joukowskySurge) +
+                        ",\"peakPressure\":" + number(r.peakPressure) + ",\"peakChainage\":" + number(r.peakChainage) +
+                        ",\"lowestPressure\":" + number(r.lowestPressure) +
+                        ",\"lowestChainage\":" + number(r.lowestChainage) + ",\"surge\":" + number(r.surge) +
+                        ",\"hoop\":" + number(r.hoop) +
+                        ",\"satisfiesHoopStress\":" + (r.satisfiesHoopStress ? "true" : "false") + "}\n";
+        }
+    }
+    QVERIFY(!expected.isEmpty());
+
+    const CliRun run = runCli({ "waterhammer", "--length", "3000", "--closure-time", "4", "--duration", "10" }, text);
+    QCOMPARE(run.code, failures > 0 ? 1 : 0);
+    QCOMPARE(run.errors.count('\n'), failures);
+    QCOMPARE(run.output, expected);
+}
+
+void CliTest::thermalMatchesModel()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString routePath = QDir(dir.path()).filePath("route.txt");
+    const QString viscosityPath = QDir(dir.path()).filePath("viscosity.txt");
+    {
+        QFile route(routePath);
+        QVERIFY(route.open(QIODevice::WriteOnly));
+        route.write("# длина температура грунта\n20000 4\n35000 -1\n15000 6\n");
+        QFile viscosity(viscosityPath);
+        QVERIFY(viscosity.open(QIODevice::WriteOnly));
+        viscosity.write("0 150\n20 60\n50 15\n90 5\n");
+    }
+
+    const QVector<PipelineParameters> input = scenarios(4);
+    QByteArray text;
+    QByteArray expected;
+    for (int n = 0; n < input.size(); ++n) {
+        text += scenarioToJsonLine(input[n]);
+        ThermalModel model(input[n], 65.0);
+        model.setViscosityCurve(PropertySpline::fromFile(viscosityPath));
+        model.setRoute(readThermalSegments(routePath));
+        for (const PipeSection& s : designedSections(input[n])) {
+            const ThermalProfile profile = model.run(s.outerDiameter, s.thickness);
+            auto number = [](double value) { return QByteArray::number(value, 'g', 17); };
+            expected += "{\"scenario\":" + QByteArray::number(n) + ",\"diameter\":" + number(s.outerDiameter) +
+                        ",\"thickness\":" + number(s.thickness) +
+                        ",\"outletTemperature\":" + number(profile.outletTemperature) +
+                        ",\"outletDensity\":" + number(profile.density.last()) +
+                        ",\"outletTemperatureDelta\":" + number(profile.temperatureDelta.last()) +
+                        ",\"frictionLoss\":" + number(profile.frictionLoss) +
+                        ",\"failedPoints\":" + QByteArray::number(profile.failedPoints) +
+                        ",\"firstFailureChainage\":" + number(profile.firstFailureChainage) +
+                        ",\"passes\":" + (profile.passes() ? "true" : "false") + "}\n";
+        }
+    }
+    QVERIFY(!expected.isEmpty());
+
+    const CliRun run = runCli({ "thermal", "--inlet-temperature", "65", "--route", routePath,
+                                "--viscosity-curve", viscosityPath, "--threads", "2" }, text);
+    QCOMPARE(run.code, 0);
+    QVERIFY(run.errors.isEmpty());
+    QCOMPARE(run.output, expected);
+
+    const CliRun missing = runCli({ "thermal", "--inlet-temperature", "65", "--route", routePath,
+                                    "--density-curve", QDir(dir.path()).filePath("missing.txt") }, text);
+    QCOMPARE(missing.code, 2);
+    QVERIFY(missing.output.isEmpty());
+    QVERIFY(missing.errors.startsWith("Не удалось открыть кривую свойства"));
+}
+
+void CliTest::badArgumentsPrintUsage()
+{
+    const QVector<QStringList> arguments = {
+        { "--format", "xml" },
+        { "--threads", "-1" },
+        { "--threads", "many" },
+        { "--unknown" },
+        { "a.jsonl", "b.jsonl" },
+        { "sweep" },
+        { "sweep", "--axis", "outerDiameters=100,200" },
+        { "sweep", "--axis", "pressure=3:1:1" },
+        { "sweep", "--axis", "pressure=" },
+        { "sweep", "--continuous", "--axis", "pressure=1" },
+        { "--axis", "pressure=1" },
+        { "reliability", "--samples", "0" },
+        { "reliability", "--vary", "massFlow=normal:1:1" },
+        { "reliability", "--vary", "pressure=gamma:1:1" },
+        { "reliability", "--vary", "pressure=uniform:2:1" },
+        { "reliability", "--vary", "pressure=normal:1" },
+        { "sensitivities", "--samples", "10" },
+        { "maop", "--axis", "pressure=1" },
+        { "grade" },
+        { "--grades", "grades.txt" },
+        { "route" },
+        { "route", "--route", "route.txt", "--max-changes", "-1" },
+        { "route", "--route", "route.txt", "--max-changes", "one" },
+        { "--max-changes", "1" },
+        { "grade", "--grades", "grades.txt", "--route", "route.txt" },
+        { "profile" },
+        { "--profile", "profile.csv" },
+        { "waterhammer" },
+        { "waterhammer", "--length", "0" },
+        { "waterhammer", "--length", "1000", "--closure-time", "-1" },
+        { "waterhammer", "--length", "1000", "--duration", "x" },
+        { "--length", "1000" },
+        { "thermal", "--route", "route.txt" },
+        { "thermal", "--inlet-temperature", "60" },
+        { "thermal", "--inlet-temperature", "hot", "--route", "route.txt" },
+        { "--inlet-temperature", "60" },
+        { "route", "--route", "route.txt", "--viscosity-curve", "viscosity.txt" },
+    };
+    for (const QStringList& args : arguments) {
+        const CliRun run = runCli(args, QByteArray());
+        QCOMPARE(run.code, 2);
+        QVERIFY(run.output.isEmpty());
+        QVERIFY(run.errors.startsWith("Использование"));
+    }
+
+    const CliRun missing = runCli({ "/nonexistent/scenarios.jsonl" }, QByteArray());
+    QCOMPARE(missing.code, 2);
+    QVERIFY(missing.errors.startsWith("Не удалось открыть вход"));
+}
+
+QTEST_APPLESS_MAIN(CliTest)
+
+#include "tst_cli.moc"
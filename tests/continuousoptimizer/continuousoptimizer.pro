@@ -0,0 +1,7 @@
+# Непрерывный подбор диаметра и толщины минимальной массы (ContinuousOptimizer)
+TARGET = tst_continuousoptimizer
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_continuousoptimizer.cpp
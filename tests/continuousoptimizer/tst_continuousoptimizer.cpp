@@ -0,0 +1,141 @@
+#include "continuousoptimizer.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <stdexcept>
+
+// Непрерывный подбор: оптимум допустим и не тяжелее перебора по сетке,
+// привязка к каталогу - ближайшие допустимые размеры
+class ContinuousOptimizerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void optimumIsFeasibleAndNotHeavierThanGrid();
+    void snapMatchesNeighbourSearch();
+    void invalidParametersAreRejected();
+};
+
+namespace {
+
+// Прямая труба: условия гладкие, оптимум глобальный
+PipelineParameters straightParameters(std::mt19937_64& rng, int n)
+{
+    const TestMaterial materials[] = { TestMaterial::Mode1, TestMaterial::TypicalSteel,
+                                       TestMaterial::PipelineSteel, TestMaterial::Runtime };
+    PipelineParameters params = randomParameters(rng, materials[n % 4], 0);
+    params.pressure = uniform(rng, 0.5, 10.0);
+    params.massFlow = uniform(rng, 20.0, 1500.0);
+    return params;
+}
+
+} // namespace
+
+void ContinuousOptimizerTest::optimumIsFeasibleAndNotHeavierThanGrid()
+{
+    std::mt19937_64 rng(170);
+    PipelineOptimizer optimizer;
+    int compared = 0;
+    for (int n = 0; n < 40; ++n) {
+        PipelineParameters params = straightParameters(rng, n);
+        const ContinuousDesign design = ContinuousOptimizer(params).run();
+        if (!design.converged) {
+            continue;
+        }
+        QVERIFY(design.diameter >= 100.0 && design.diameter <= 1400.0);
+        QCOMPARE(design.mass, ContinuousOptimizer::steelMass(design.diameter, design.thickness));
+
+        // Оптимум на границе допустимой области: чуть толще - все условия
+        // выполнены (кроме, возможно, скорости потока на ее границе)
+        const DesignResistance r = DesignResistance::fromParameters(params);
+        const ThicknessCheck check =
+            PipelineOptimizer::checkThickness(params, r, design.diameter, design.thickness * (1.0 + 1e-6));
+        QVERIFY2(check.isValid && check.satisfiesHoopStress && check.satisfiesAxialStress &&
+                     check.satisfiesEquivalentStress,
+                 qPrintable(QString("Вариант %1").arg(n)));
+        QVERIFY(check.flowSpeed >= 1.0 - 1e-6 && check.flowSpeed <= 3.0 + 1e-6);
+
+        // Каждый допустимый результат перебора диаметров через 1 мм не легче
+        params.outerDiameters.clear();
+        for (int D = 100; D <= 1400; ++D) {
+            params.outerDiameters.append(D);
+        }
+        for (const ValidationResult& res : optimizer.calculate(params)) {
+            if (res.isValid) {
+                QVERIFY2(ContinuousOptimizer::steelMass(res.diameter, res.finalThickness) >=
+                             design.mass * (1.0 - 1e-6),
+                         qPrintable(QString("Вариант %1, D = %2").arg(n).arg(res.diameter)));
+                ++compared;
+            }
+        }
+    }
+    QVERIFY(compared > 1000);
+}
+
+void ContinuousOptimizerTest::snapMatchesNeighbourSearch()
+{
+    std::mt19937_64 rng(171);
+    const ThicknessCatalog& catalog = ThicknessCatalog::sortament();
+    int snapped = 0;
+    for (int n = 0; n < 100; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        const ContinuousDesign design = ContinuousOptimizer(params).run();
+        if (design.evaluations == 0 || design.diameter == 0.0) {
+            continue;
+        }
+
+        // Ближайшие к D* снизу и сверху диаметры с толщиной, как в calculate()
+        const DesignResistance r = DesignResistance::fromParameters(params);
+        double bestDiameter = 0.0;
+        double bestThickness = 0.0;
+        double bestMass = 0.0;
+        for (int side = 0; side < 2; ++side) {
+            const QVector<double>& diameters = catalog.diameters();
+            for (int k = 0; k < diameters.size(); ++k) {
+                const double D = side == 0 ? diameters[diameters.size() - 1 - k] : diameters[k];
+                if (side == 0 ? D > design.diameter : D <= design.diameter) {
+                    continue;
+                }
+                const double thickness = PipelineOptimizer::catalogThickness(params, r, catalog, D);
+                if (thickness > 0.0) {
+                    const double mass = ContinuousOptimizer::steelMass(D, thickness);
+                    if (bestDiameter == 0.0 || mass < bestMass) {
+                        bestDiameter = D;
+                        bestThickness = thickness;
+                        bestMass = mass;
+                    }
+                    break;
+                }
+            }
+        }
+
+        QCOMPARE(design.snapped, bestDiameter > 0.0);
+        if (design.snapped) {
+            QCOMPARE(design.catalogResult.diameter, bestDiameter);
+            QCOMPARE(design.catalogResult.finalThickness, bestThickness);
+            QCOMPARE(design.catalogMass, bestMass);
+            QVERIFY(design.catalogResult.isValid);
+            QVERIFY(PipelineOptimizer::checkThickness(params, r, bestDiameter, bestThickness).passes());
+            ++snapped;
+        }
+    }
+    QVERIFY(snapped > 20);
+}
+
+void ContinuousOptimizerTest::invalidParametersAreRejected()
+{
+    std::mt19937_64 rng(172);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    PipelineParameters bad = params;
+    bad.massFlow = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ContinuousOptimizer optimizer(bad));
+    bad = params;
+    bad.pressure = std::numeric_limits<double>::quiet_NaN();
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ContinuousOptimizer optimizer(bad));
+    bad = params;
+    bad.yieldStrength = -1.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ContinuousOptimizer optimizer(bad));
+}
+
+QTEST_APPLESS_MAIN(ContinuousOptimizerTest)
+
+#include "tst_continuousoptimizer.moc"
@@ -0,0 +1,8 @@
+# Давление вдоль трассы по профилю высот (elevationprofile.h)
+TARGET = tst_elevationprofile
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_elevationprofile.cpp
@@ -0,0 +1,215 @@
+#include "elevationprofile.h"
+#include "frictionloss.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <QtTest>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// Профиль высот: проход по отображенному файлу против прямого расчета по
+// точкам, одинаковый результат для двоичного файла и CSV, ошибки в данных
+class ElevationProfileTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void analysisMatchesPointwiseReference();
+    void errorsReportPosition();
+};
+
+namespace {
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
+// Двоичный профиль: пары little-endian double (пикет, высота)
+QByteArray binaryProfile(const QVector<double>& chainage, const QVector<double>& elevation)
+{
+    QByteArray data(chainage.size() * 16, '\0');
+    for (int i = 0; i < chainage.size(); ++i) {
+        quint64 x;
+        quint64 z;
+        std::memcpy(&x, &chainage[i], sizeof(double));
+        std::memcpy(&z, &elevation[i], sizeof(double));
+        qToLittleEndian<quint64>(x, data.data() + i * 16);
+        qToLittleEndian<quint64>(z, data.data() + i * 16 + 8);
+    }
+    return data;
+}
+
+// Тот же профиль в CSV с заголовком и комментарием, значения без потери точности
+QByteArray csvProfile(const QVector<double>& chainage, const QVector<double>& elevation)
+{
+    QByteArray data = "# профиль трассы\nпикет;высота\n";
+    for (int i = 0; i < chainage.size(); ++i) {
+        data += QByteArray::number(chainage[i], 'g', 17) + (i % 2 ? ", " : ";") +
+                QByteArray::number(elevation[i], 'g', 17) + "\n";
+    }
+    return data;
+}
+
+// Прямой расчет по точкам: p = p_н - ρg(z - z_н) - i·(x - x_н) и
+// checkThickness() в точках с давлением выше начального
+ProfileAnalysis referenceAnalysis(const PipelineParameters& params, double D, double t,
+                                  const QVector<double>& chainage, const QVector<double>& elevation)
+{
+    ProfileAnalysis a;
+    const DesignResistance r = DesignResistance::fromParameters(params);
+    a.hydraulicGradient = FrictionLossModel(params).evaluate(D, t).pressureLoss / 1000.0;
+    a.points = chainage.size();
+    a.length = chainage.last() - chainage.first();
+    a.staticHead = elevation.last() - elevation.first();
+    a.frictionLoss = a.hydraulicGradient * a.length;
+    const double staticScale = params.density * 9.81 / 1000000.0;
+    a.outletPressure = params.pressure - staticScale * a.staticHead - a.frictionLoss;
+    a.minPressure = std::numeric_limits<double>::infinity();
+    a.maxPressure = -a.minPressure;
+    PipelineParameters local = params;
+    for (int i = 0; i < chainage.size(); ++i) {
+        const double p = params.pressure - staticScale * (elevation[i] - elevation[0]) -
+                         a.hydraulicGradient * (chainage[i] - chainage[0]);
+        if (p < a.minPressure) {
+            a.minPressure = p;
+            a.minPressureChainage = chainage[i];
+        }
+        if (p > a.maxPressure) {
+            a.maxPressure = p;
+            a.maxPressureChainage = chainage[i];
+        }
+        if (p > params.pressure) {
+            ++a.checkedPoints;
+            local.pressure = p;
+            if (!PipelineOptimizer::checkThickness(local, r, D, t).passes()) {
+                if (a.failedPoints == 0) {
+                    a.firstFailureChainage = chainage[i];
+                }
+                ++a.failedPoints;
+            }
+        }
+    }
+    return a;
+}
+
+bool sameAnalysis(const ProfileAnalysis& a, const ProfileAnalysis& b)
+{
+    return a.points == b.points && a.length == b.length && a.hydraulicGradient == b.hydraulicGradient &&
+           a.frictionLoss == b.frictionLoss && a.staticHead == b.staticHead &&
+           a.outletPressure == b.outletPressure && a.minPressure == b.minPressure &&
+           a.minPressureChainage == b.minPressureChainage && a.maxPressure == b.maxPressure &&
+           a.maxPressureChainage == b.maxPressureChainage && a.checkedPoints == b.checkedPoints &&
+           a.failedPoints == b.failedPoints && a.firstFailureChainage == b.firstFailureChainage;
+}
+
+} // namespace
+
+void ElevationProfileTest::analysisMatchesPointwiseReference()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString binaryPath = QDir(dir.path()).filePath("profile.bin");
+    const QString csvPath = QDir(dir.path()).filePath("profile.csv");
+
+    std::mt19937_64 rng(230);
+    int checked = 0;
+    int failed = 0;
+    for (int n = 0; n < 30; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(1 + n % 4), 6);
+        const QVector<PipeSection> sections = designedSections(params);
+        if (sections.isEmpty()) {
+            continue;
+        }
+
+        // Случайное блуждание высот с уклоном вниз: давление растет по
+        // рельефу и частично превышает начальное; пикеты не убывают
+        QVector<double> chainage;
+        QVector<double> elevation;
+        double x = uniform(rng, 0.0, 1000.0);
+        double z = uniform(rng, 0.0, 500.0);
+        const double slope = uniform(rng, -0.05, 0.01);
+        for (int i = 0; i < 3000; ++i) {
+            chainage.append(x);
+            elevation.append(z);
+            const double step = i % 50 == 7 ? 0.0 : uniform(rng, 1.0, 200.0);
+            x += step;
+            z += slope * step + uniform(rng, -2.0, 2.0);
+        }
+        writeFile(binaryPath, binaryProfile(chainage, elevation));
+        writeFile(csvPath, csvProfile(chainage, elevation));
+
+        const ElevationProfile binary(binaryPath);
+        const ElevationProfile csv(csvPath);
+        QVERIFY(binary.format() == ElevationProfile::Format::Binary);
+        QVERIFY(csv.format() == ElevationProfile::Format::Csv);
+        for (const PipeSection& s : sections) {
+            const ProfileAnalysis expected =
+                referenceAnalysis(params, s.outerDiameter, s.thickness, chainage, elevation);
+            const QString context = QString("Сценарий %1, D = %2").arg(n).arg(s.outerDiameter);
+            QVERIFY2(sameAnalysis(binary.analyze(params, s.outerDiameter, s.thickness), expected),
+                     qPrintable(context));
+            QVERIFY2(sameAnalysis(csv.analyze(params, s.outerDiameter, s.thickness), expected),
+                     qPrintable(context));
+            checked += expected.checkedPoints > 0;
+            failed += expected.failedPoints > 0;
+        }
+    }
+    QVERIFY2(checked > 10 && failed > 0,
+             qPrintable(QString("Проверенных профилей: %1, с отказами: %2").arg(checked).arg(failed)));
+}
+
+void ElevationProfileTest::errorsReportPosition()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    std::mt19937_64 rng(231);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 1);
+    const QString csvPath = QDir(dir.path()).filePath("profile.txt");
+    const QString binaryPath = QDir(dir.path()).filePath("profile.bin");
+
+    // Ошибка в строке CSV - с номером строки
+    const QByteArray invalid[] = { "0 10\n100 x\n", "0 10\n100 5 1\n", "0 10\n-5 12\n", "0 10\n100\n" };
+    for (const QByteArray& content : invalid) {
+        writeFile(csvPath, content);
+        const ElevationProfile profile(csvPath);
+        try {
+            profile.analyze(params, 500.0, 0.01);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+
+    // Нечисловое значение двоичного профиля - с номером точки
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    writeFile(binaryPath, binaryProfile({ 0.0, 100.0, 200.0 }, { 10.0, 11.0, nan }));
+    try {
+        ElevationProfile(binaryPath).analyze(params, 500.0, 0.01);
+        QVERIFY(false);
+    } catch (const std::invalid_argument& e) {
+        QVERIFY2(QString(e.what()).contains("точка 3"), e.what());
+    }
+
+    // Одна точка, пустой файл, размер не кратен 16 байтам, нет файла
+    writeFile(csvPath, "пикет высота\n0 10\n");
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ElevationProfile(csvPath).analyze(params, 500.0, 0.01));
+    writeFile(binaryPath, QByteArray());
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ElevationProfile(binaryPath).analyze(params, 500.0, 0.01));
+    writeFile(binaryPath, QByteArray(20, '\0'));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ElevationProfile{ binaryPath });
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, ElevationProfile{ QDir(dir.path()).filePath("missing.bin") });
+
+    // Недопустимые размеры трубы
+    writeFile(csvPath, "0 10\n100 12\n");
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ElevationProfile(csvPath).analyze(params, 500.0, 0.3));
+}
+
+QTEST_APPLESS_MAIN(ElevationProfileTest)
+
+#include "tst_elevationprofile.moc"
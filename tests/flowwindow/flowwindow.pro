@@ -0,0 +1,7 @@
+# Исключение диаметров вне окна скорости потока из пакетного расчета
+TARGET = tst_flowwindow
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_flowwindow.cpp
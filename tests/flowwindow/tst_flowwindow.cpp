@@ -0,0 +1,74 @@
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include "thicknesscatalog.h"
+#include <QtTest>
+#include <algorithm>
+
+// Окно скорости потока: для упорядоченного списка диаметры вне окна не
+// попадают в пакет, результаты те же, что без исключения
+class FlowWindowTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void prunedMatchesUnpruned();
+    void prunedMatchesUnprunedWithCatalog();
+};
+
+namespace {
+
+// Тот же список с переставленными двумя первыми диаметрами: для
+// неупорядоченного списка окно не применяется, и все диаметры идут в пакет.
+// Порядок остальных не меняется, поэтому при равных запасах оптимальным
+// остается тот же диаметр
+QVector<ValidationResult> unprunedCalculate(PipelineOptimizer& optimizer, PipelineParameters params)
+{
+    std::swap(params.outerDiameters[0], params.outerDiameters[1]);
+    QVector<ValidationResult> results = optimizer.calculate(params);
+    std::stable_sort(results.begin(), results.end(), [](const ValidationResult& a, const ValidationResult& b) {
+        return a.diameter < b.diameter;
+    });
+    return results;
+}
+
+void comparePrunedWithUnpruned(const ThicknessCatalog* catalog, int seed)
+{
+    if (detectSimdIsa() == SimdIsa::None) {
+        QSKIP("Векторные инструкции недоступны: пакетного расчета нет");
+    }
+    std::mt19937_64 rng(seed);
+    PipelineOptimizer optimizer;
+    optimizer.setThicknessCatalog(catalog);
+    int pruned = 0;
+    for (int n = 0; n < 300; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        setCatalogDiameters(params.outerDiameters);
+        // Расход, при котором окно лежит внутри сортамента
+        params.massFlow = uniform(rng, 10.0, 2000.0);
+
+        const QVector<ValidationResult> results = optimizer.calculate(params);
+        pruned += optimizer.lastStats().prunedDiameters;
+        const QVector<ValidationResult> expected = unprunedCalculate(optimizer, params);
+        QCOMPARE(optimizer.lastStats().prunedDiameters, 0);
+        const QString mismatch = compareResults(results, expected);
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+    QVERIFY(pruned > 1000);
+}
+
+} // namespace
+
+void FlowWindowTest::prunedMatchesUnpruned()
+{
+    comparePrunedWithUnpruned(nullptr, 60);
+}
+
+void FlowWindowTest::prunedMatchesUnprunedWithCatalog()
+{
+    const ThicknessCatalog catalog = ThicknessCatalog::fromSortament();
+    comparePrunedWithUnpruned(&catalog, 61);
+}
+
+QTEST_APPLESS_MAIN(FlowWindowTest)
+
+#include "tst_flowwindow.moc"
@@ -0,0 +1,7 @@
+# Потери давления на трение (frictionloss.h)
+TARGET = tst_frictionloss
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_frictionloss.cpp
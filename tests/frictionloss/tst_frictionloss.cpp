@@ -0,0 +1,141 @@
+#include "frictionloss.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <cmath>
+#include <stdexcept>
+
+// Потери на трение: λ по Колбруку - Уайту против итерационного решения и
+// потери по формуле Дарси - Вейсбаха
+class FrictionLossTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void colebrookMatchesIterativeReference();
+    void lossMatchesDarcyWeisbach();
+    void invalidInputIsRejected();
+};
+
+namespace {
+
+// λ из уравнения Колбрука - Уайта простой итерацией
+//     x ← -2·lg(Δ/(3.7d) + 2.51x/Re),  x = 1/√λ
+// в long double от x = 8 до неподвижной точки; итерация сжимающая, так что
+// результат не зависит от начального приближения Свами - Джейна
+double colebrookReference(double reynolds, double relativeRoughness)
+{
+    long double x = 8.0L;
+    for (int i = 0; i < 500; ++i) {
+        const long double next =
+            -2.0L * std::log10(relativeRoughness / 3.7L + 2.51L * x / reynolds);
+        if (next == x) {
+            break;
+        }
+        x = next;
+    }
+    return double(1.0L / (x * x));
+}
+
+double relativeError(double value, double expected)
+{
+    return std::abs(value - expected) / std::abs(expected);
+}
+
+} // namespace
+
+void FrictionLossTest::colebrookMatchesIterativeReference()
+{
+    std::mt19937_64 rng(220);
+    for (int n = 0; n < 20000; ++n) {
+        // Re и Δ/d - логарифмически равномерно: от границы ламинарного режима
+        // до 10⁸ и от гладкой трубы до 0.05
+        const double reynolds = std::pow(10.0, uniform(rng, std::log10(2320.0), 8.0));
+        const double relativeRoughness = n % 10 == 0 ? 0.0 : std::pow(10.0, uniform(rng, -7.0, std::log10(0.05)));
+        const double lambda = FrictionLossModel::frictionFactor(reynolds, relativeRoughness);
+        const double expected = colebrookReference(reynolds, relativeRoughness);
+        QVERIFY2(relativeError(lambda, expected) < 1e-12,
+                 qPrintable(QString("Re = %1, Δ/d = %2: λ = %3, ожидается %4")
+                                .arg(reynolds, 0, 'g', 17).arg(relativeRoughness, 0, 'g', 17)
+                                .arg(lambda, 0, 'g', 17).arg(expected, 0, 'g', 17)));
+    }
+
+    // Ламинарный режим и вырожденное Re
+    QCOMPARE(FrictionLossModel::frictionFactor(1000.0, 0.001), 0.064);
+    QCOMPARE(FrictionLossModel::frictionFactor(2319.0, 0.0), 64.0 / 2319.0);
+    QCOMPARE(FrictionLossModel::frictionFactor(0.0, 0.001), 0.0);
+}
+
+void FrictionLossTest::lossMatchesDarcyWeisbach()
+{
+    std::mt19937_64 rng(221);
+    int turbulent = 0;
+    for (int n = 0; n < 200; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 5);
+        const double roughness = uniform(rng, 0.0, 0.5);
+        const FrictionLossModel model(params, roughness);
+
+        QVector<PipeSection> sections;
+        for (double D : params.outerDiameters) {
+            PipeSection s;
+            s.outerDiameter = D;
+            s.thickness = uniform(rng, 0.003, 0.03);
+            sections.append(s);
+        }
+        QVector<FrictionLoss> losses;
+        model.evaluate(sections, losses);
+        QCOMPARE(losses.size(), sections.size());
+
+        for (int i = 0; i < sections.size(); ++i) {
+            const FrictionLoss& loss = losses[i];
+            QVERIFY(loss.isValid);
+
+            // ϑ = 4G/(ρπd²), Re = ϑd/ν, Δp = λ·(1000/d)·ρϑ²/2 на 1 км
+            const double d = sections[i].outerDiameter / 1000.0 - 2.0 * sections[i].thickness;
+            const double speed = 4.0 * params.massFlow / (params.density * M_PI * d * d);
+            const double reynolds = speed * d / (params.viscosity * 1e-6);
+            QVERIFY(relativeError(loss.reynolds, reynolds) < 1e-12);
+            QCOMPARE(loss.frictionFactor,
+                     FrictionLossModel::frictionFactor(loss.reynolds, roughness / 1000.0 / d));
+            const double pressureLoss = loss.frictionFactor * 1000.0 / d * params.density * speed * speed / 2.0 / 1e6;
+            QVERIFY(relativeError(loss.pressureLoss, pressureLoss) < 1e-12);
+            turbulent += loss.reynolds >= 2320.0;
+
+            const FrictionLoss single = model.evaluate(sections[i].outerDiameter, sections[i].thickness);
+            QCOMPARE(single.pressureLoss, loss.pressureLoss);
+        }
+    }
+    QVERIFY(turbulent > 500);
+}
+
+void FrictionLossTest::invalidInputIsRejected()
+{
+    std::mt19937_64 rng(222);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 1);
+    const FrictionLossModel model(params);
+
+    // Толщина, не оставляющая сечения, и нулевая толщина
+    QVERIFY(!model.evaluate(200.0, 0.1).isValid);
+    QVERIFY(!model.evaluate(200.0, 0.0).isValid);
+
+    // Результаты calculate() без подобранной толщины
+    QVector<ValidationResult> results(2);
+    results[0].diameter = 500.0;
+    results[0].finalThickness = 0.01;
+    results[1].diameter = 500.0;
+    QVector<FrictionLoss> losses;
+    model.evaluate(results, losses);
+    QCOMPARE(losses.size(), 2);
+    QVERIFY(losses[0].isValid);
+    QVERIFY(!losses[1].isValid);
+
+    PipelineParameters bad = params;
+    bad.viscosity = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, FrictionLossModel{ bad });
+    bad = params;
+    bad.density = -1.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, FrictionLossModel{ bad });
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, FrictionLossModel(params, -0.1));
+}
+
+QTEST_APPLESS_MAIN(FrictionLossTest)
+
+#include "tst_frictionloss.moc"
@@ -0,0 +1,7 @@
+# Пересчет при изменении параметров (IncrementalOptimizer)
+TARGET = tst_incrementaloptimizer
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_incrementaloptimizer.cpp
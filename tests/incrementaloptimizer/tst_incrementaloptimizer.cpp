@@ -0,0 +1,119 @@
+#include "incrementaloptimizer.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include "thicknesscatalog.h"
+#include <QtTest>
+
+// Пересчет при изменении параметров: результаты как у calculate(), заново
+// рассчитываются только новые диаметры
+class IncrementalOptimizerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void addedAndRemovedDiameters();
+    void scalarChangeRecalculatesAll();
+    void randomEditsMatchCalculate();
+    void catalogChangeResetsResults();
+};
+
+namespace {
+
+QString compareWithCalculate(IncrementalOptimizer& incremental, const PipelineParameters& params,
+                             const ThicknessCatalog* catalog = nullptr)
+{
+    PipelineOptimizer optimizer;
+    optimizer.setThicknessCatalog(catalog);
+    return compareResults(incremental.update(params), optimizer.calculate(params));
+}
+
+} // namespace
+
+void IncrementalOptimizerTest::addedAndRemovedDiameters()
+{
+    std::mt19937_64 rng(300);
+    PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    params.outerDiameters = { 530.0, 720.0, 1020.0 };
+    IncrementalOptimizer incremental;
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+    QCOMPARE(incremental.lastSolvedCount(), 3);
+
+    // Добавленный диаметр: рассчитывается только он
+    params.outerDiameters.append(820.0);
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+    QCOMPARE(incremental.lastSolvedCount(), 1);
+
+    // Удаленный и переставленные диаметры: пересчета нет
+    params.outerDiameters = { 1020.0, 530.0, 820.0 };
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+    QCOMPARE(incremental.lastSolvedCount(), 0);
+
+    // Возвращенный диаметр взят из запомненных результатов
+    params.outerDiameters.append(720.0);
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+    QCOMPARE(incremental.lastSolvedCount(), 0);
+}
+
+void IncrementalOptimizerTest::scalarChangeRecalculatesAll()
+{
+    std::mt19937_64 rng(301);
+    PipelineParameters params = randomParameters(rng, TestMaterial::RuntimeBend, 12);
+    IncrementalOptimizer incremental;
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+
+    for (const ParameterField& f : parameterFields()) {
+        params.*f.field *= 1.01;
+        const QString mismatch = compareWithCalculate(incremental, params);
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("%1: %2").arg(f.name).arg(mismatch)));
+        QCOMPARE(incremental.lastSolvedCount(), int(params.outerDiameters.size()));
+    }
+
+    params.mode = Mode::Mode1;
+    setTypicalMode1Values(params);
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+}
+
+void IncrementalOptimizerTest::randomEditsMatchCalculate()
+{
+    // Случайная последовательность правок диаметров и параметров
+    std::mt19937_64 rng(302);
+    PipelineParameters params = randomParameters(rng, TestMaterial::PipelineSteel, 8);
+    IncrementalOptimizer incremental;
+    for (int step = 0; step < 200; ++step) {
+        switch (rng() % 4) {
+        case 0:
+            params.outerDiameters.append(std::round(uniform(rng, 100.0, 1400.0)));
+            break;
+        case 1:
+            if (params.outerDiameters.size() > 1) {
+                params.outerDiameters.remove(int(rng() % params.outerDiameters.size()));
+            }
+            break;
+        case 2:
+            params.pressure = uniform(rng, 0.1, 20.0);
+            break;
+        default:
+            params.massFlow = uniform(rng, 1.0, 3000.0);
+            break;
+        }
+        const QString mismatch = compareWithCalculate(incremental, params);
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Шаг %1: %2").arg(step).arg(mismatch)));
+    }
+}
+
+void IncrementalOptimizerTest::catalogChangeResetsResults()
+{
+    std::mt19937_64 rng(303);
+    PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    params.outerDiameters = { 219.0, 325.0, 530.0, 720.0, 1020.0 };
+    IncrementalOptimizer incremental;
+    QVERIFY(compareWithCalculate(incremental, params).isEmpty());
+
+    const ThicknessCatalog catalog = ThicknessCatalog::fromSortament();
+    incremental.setThicknessCatalog(&catalog);
+    QVERIFY(compareWithCalculate(incremental, params, &catalog).isEmpty());
+    QCOMPARE(incremental.lastSolvedCount(), int(params.outerDiameters.size()));
+}
+
+QTEST_APPLESS_MAIN(IncrementalOptimizerTest)
+
+#include "tst_incrementaloptimizer.moc"
@@ -0,0 +1,7 @@
+# Политики материала (materialpolicy.h): выбор и расчет со свернутыми константами
+TARGET = tst_materialpolicy
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_materialpolicy.cpp
@@ -0,0 +1,76 @@
+#include "materialpolicy.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+
+// Политики материала: выбор по свойствам стали и среды, результаты каждой
+// политики совпадают с эталонным перебором
+class MaterialPolicyTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void materialPoliciesMatchReference();
+    void changedConstantSelectsRuntime();
+
+private:
+    void compareWithReference(TestMaterial material, int cases, int diameterCount);
+};
+
+void MaterialPolicyTest::compareWithReference(TestMaterial material, int cases, int diameterCount)
+{
+    std::mt19937_64 rng(int(material) + 1);
+    PipelineOptimizer optimizer;
+    for (int n = 0; n < cases; ++n) {
+        const PipelineParameters params = randomParameters(rng, material, diameterCount);
+        const QString mismatch = compareResults(optimizer.calculate(params), referenceCalculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+}
+
+void MaterialPolicyTest::materialPoliciesMatchReference()
+{
+    const struct {
+        TestMaterial material;
+        MaterialPolicy policy;
+    } policies[] = {
+        { TestMaterial::Mode1, MaterialPolicy::Mode1 },
+        { TestMaterial::PipelineSteel, MaterialPolicy::PipelineSteel },
+        { TestMaterial::TypicalSteel, MaterialPolicy::TypicalSteel },
+        { TestMaterial::Runtime, MaterialPolicy::Runtime },
+    };
+    for (const auto& p : policies) {
+        std::mt19937_64 rng(20 + int(p.material));
+        QCOMPARE(selectMaterialPolicy(randomParameters(rng, p.material, 1)), p.policy);
+        compareWithReference(p.material, 300, 25);
+    }
+}
+
+void MaterialPolicyTest::changedConstantSelectsRuntime()
+{
+    // Отличие любой свернутой константы от значения политики - общий расчет
+    std::mt19937_64 rng(25);
+    double PipelineParameters::*const steelFields[] = {
+        &PipelineParameters::steelYoungModulus,
+        &PipelineParameters::poissonRatio,
+        &PipelineParameters::thermalExpansionCoeff,
+        &PipelineParameters::bendRadius,
+    };
+    for (TestMaterial material : { TestMaterial::PipelineSteel, TestMaterial::TypicalSteel }) {
+        const PipelineParameters params = randomParameters(rng, material, 1);
+        QVERIFY(selectMaterialPolicy(params) != MaterialPolicy::Runtime);
+        for (double PipelineParameters::*field : steelFields) {
+            PipelineParameters changed = params;
+            changed.*field += 1e-3;
+            QVERIFY(selectMaterialPolicy(changed) == MaterialPolicy::Runtime);
+        }
+    }
+
+    PipelineParameters mode1 = randomParameters(rng, TestMaterial::Mode1, 1);
+    QVERIFY(selectMaterialPolicy(mode1) == MaterialPolicy::Mode1);
+    mode1.density += 1.0;
+    QVERIFY(selectMaterialPolicy(mode1) != MaterialPolicy::Mode1);
+}
+
+QTEST_APPLESS_MAIN(MaterialPolicyTest)
+
+#include "tst_materialpolicy.moc"
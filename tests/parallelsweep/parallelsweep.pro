@@ -0,0 +1,7 @@
+# Многопоточный перебор диаметров в PipelineOptimizer::calculate()
+TARGET = tst_parallelsweep
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_parallelsweep.cpp
@@ -0,0 +1,40 @@
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QThread>
+#include <QtTest>
+
+// Многопоточный перебор диаметров: результаты не зависят от числа потоков
+class ParallelSweepTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void threadCountDoesNotChangeResults();
+    void threadCountZeroUsesAllCores();
+};
+
+void ParallelSweepTest::threadCountDoesNotChangeResults()
+{
+    std::mt19937_64 rng(40);
+    PipelineOptimizer single;
+    PipelineOptimizer parallel;
+    parallel.setThreadCount(4);
+    for (int n = 0; n < 50; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 900);
+        const QString mismatch = compareResults(parallel.calculate(params), single.calculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+}
+
+void ParallelSweepTest::threadCountZeroUsesAllCores()
+{
+    PipelineOptimizer optimizer;
+    QCOMPARE(optimizer.threadCount(), 1);
+    optimizer.setThreadCount(0);
+    QCOMPARE(optimizer.threadCount(), qMax(1, QThread::idealThreadCount()));
+    optimizer.setThreadCount(-3);
+    QCOMPARE(optimizer.threadCount(), qMax(1, QThread::idealThreadCount()));
+}
+
+QTEST_APPLESS_MAIN(ParallelSweepTest)
+
+#include "tst_parallelsweep.moc"
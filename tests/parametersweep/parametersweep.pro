@@ -0,0 +1,8 @@
+# Развертка расчета по параметрам (ParameterSweep)
+TARGET = tst_parametersweep
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_parametersweep.cpp
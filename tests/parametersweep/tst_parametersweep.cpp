@@ -0,0 +1,65 @@
+#include "parametersweep.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <stdexcept>
+
+// Развертка по параметрам: точки в порядке номеров, результаты как у calculate()
+class ParameterSweepTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sweepMatchesCalculate();
+    void axesFromRangeAndNames();
+};
+
+void ParameterSweepTest::sweepMatchesCalculate()
+{
+    std::mt19937_64 rng(100);
+    const PipelineParameters base = randomParameters(rng, TestMaterial::Runtime, 30);
+    ParameterSweep sweep(base);
+    sweep.addAxis(SweepAxis::range(&PipelineParameters::pressure, 1.0, 10.0, 1.5));
+    sweep.addAxis(SweepAxis::list(&PipelineParameters::massFlow, { 50.0, 400.0, 1500.0 }));
+    sweep.setThreadCount(3);
+    QCOMPARE(sweep.pointCount(), qint64(7 * 3));
+
+    PipelineOptimizer optimizer;
+    qint64 expectedIndex = 0;
+    sweep.run([&](qint64 pointIndex, const PipelineParameters& point, const QVector<ValidationResult>& results) {
+        QCOMPARE(pointIndex, expectedIndex++);
+        QCOMPARE(point.pressure, sweep.point(pointIndex).pressure);
+        QCOMPARE(point.massFlow, sweep.point(pointIndex).massFlow);
+        const QString mismatch = compareResults(results, optimizer.calculate(point));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Точка %1: %2").arg(pointIndex).arg(mismatch)));
+    });
+    QCOMPARE(expectedIndex, sweep.pointCount());
+}
+
+void ParameterSweepTest::axesFromRangeAndNames()
+{
+    // Правая граница, кратная шагу, входит в ось; последняя ось меняется быстрее всех
+    const SweepAxis range = SweepAxis::range(&PipelineParameters::pressure, 0.1, 0.7, 0.2);
+    QCOMPARE(range.values.size(), 4);
+    QCOMPARE(range.values.last(), 0.1 + 3 * 0.2);
+
+    QVERIFY(SweepAxis::fieldByName("massFlow") == &PipelineParameters::massFlow);
+    QVERIFY(SweepAxis::fieldByName("bendRadius") == &PipelineParameters::bendRadius);
+    QVERIFY(SweepAxis::fieldByName("outerDiameters") == nullptr);
+
+    std::mt19937_64 rng(101);
+    ParameterSweep sweep(randomParameters(rng, TestMaterial::Mode1, 3));
+    sweep.addAxis(range);
+    sweep.addAxis(SweepAxis::list(&PipelineParameters::massFlow, { 10.0, 20.0 }));
+    QCOMPARE(sweep.point(1).pressure, 0.1);
+    QCOMPARE(sweep.point(1).massFlow, 20.0);
+    QCOMPARE(sweep.point(2).pressure, 0.1 + 0.2);
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument,
+                             SweepAxis::range(&PipelineParameters::pressure, 1.0, 0.0, 0.1));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument,
+                             SweepAxis::range(&PipelineParameters::pressure, 0.0, 1.0, 0.0));
+}
+
+QTEST_APPLESS_MAIN(ParameterSweepTest)
+
+#include "tst_parametersweep.moc"
@@ -0,0 +1,7 @@
+# Парето-фронт вариантов по массе и запасам (paretofront.h)
+TARGET = tst_paretofront
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_paretofront.cpp
@@ -0,0 +1,126 @@
+#include "continuousoptimizer.h"
+#include "paretofront.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <limits>
+
+// Парето-фронт: совпадает с попарным сравнением всех вариантов, варианты
+// фронта не доминируют друг друга
+class ParetoFrontTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void frontMatchesPairwiseFilter();
+    void nonFiniteCandidatesAreIgnored();
+    void resultsFrontUsesPassingDiameters();
+};
+
+namespace {
+
+// a не хуже b ни по одному критерию
+bool notWorse(const ParetoPoint& a, const ParetoPoint& b)
+{
+    return a.mass <= b.mass && a.minSafety >= b.minSafety && a.flowSpeedMargin >= b.flowSpeedMargin;
+}
+
+bool samePoint(const ParetoPoint& a, const ParetoPoint& b)
+{
+    return a.mass == b.mass && a.minSafety == b.minSafety && a.flowSpeedMargin == b.flowSpeedMargin;
+}
+
+// Эталон O(n²): вариант остается, если никакой другой не лучше его хотя бы
+// по одному критерию при не худших остальных; из совпадающих - первый
+QVector<int> pairwiseFront(const QVector<ParetoPoint>& candidates)
+{
+    QVector<int> front;
+    for (int i = 0; i < candidates.size(); ++i) {
+        bool dominated = false;
+        for (int j = 0; j < candidates.size() && !dominated; ++j) {
+            if (j != i && notWorse(candidates[j], candidates[i])) {
+                dominated = !samePoint(candidates[j], candidates[i]) || j < i;
+            }
+        }
+        if (!dominated) {
+            front.append(candidates[i].index);
+        }
+    }
+    return front;
+}
+
+} // namespace
+
+void ParetoFrontTest::frontMatchesPairwiseFilter()
+{
+    std::mt19937_64 rng(200);
+    for (int n = 0; n < 300; ++n) {
+        // Значения на грубой сетке, чтобы были равные массы, запасы и
+        // полностью совпадающие варианты
+        const int count = 1 + n % 60;
+        const double step = n % 3 == 0 ? 0.25 : 0.0;
+        QVector<ParetoPoint> candidates;
+        for (int i = 0; i < count; ++i) {
+            ParetoPoint p;
+            p.mass = uniform(rng, 10.0, 500.0);
+            p.minSafety = uniform(rng, 0.0, 3.0);
+            p.flowSpeedMargin = uniform(rng, 0.0, 1.0);
+            if (step > 0.0) {
+                p.mass = std::round(p.mass / 100.0);
+                p.minSafety = std::round(p.minSafety / step) * step;
+                p.flowSpeedMargin = std::round(p.flowSpeedMargin / step) * step;
+            }
+            p.index = i;
+            candidates.append(p);
+        }
+
+        const QVector<ParetoPoint> front = paretoFront(candidates);
+        QVector<int> indices;
+        for (int k = 0; k < front.size(); ++k) {
+            indices.append(front[k].index);
+            QVERIFY(samePoint(front[k], candidates[front[k].index]));
+            // По возрастанию массы, и никакой вариант фронта не доминирует другой
+            QVERIFY(k == 0 || front[k - 1].mass <= front[k].mass);
+            for (int j = 0; j < k; ++j) {
+                QVERIFY(!notWorse(front[j], front[k]));
+                QVERIFY(!notWorse(front[k], front[j]));
+            }
+        }
+        std::sort(indices.begin(), indices.end());
+        QVERIFY2(indices == pairwiseFront(candidates), qPrintable(QString("Вариант %1").arg(n)));
+    }
+}
+
+void ParetoFrontTest::nonFiniteCandidatesAreIgnored()
+{
+    QVector<ParetoPoint> candidates(3);
+    candidates[0] = { 10.0, 1.5, 0.5, 0 };
+    candidates[1] = { std::numeric_limits<double>::quiet_NaN(), 5.0, 1.0, 1 };
+    candidates[2] = { 5.0, std::numeric_limits<double>::infinity(), 1.0, 2 };
+    const QVector<ParetoPoint> front = paretoFront(candidates);
+    QCOMPARE(front.size(), 1);
+    QCOMPARE(front[0].index, 0);
+}
+
+void ParetoFrontTest::resultsFrontUsesPassingDiameters()
+{
+    std::mt19937_64 rng(201);
+    int points = 0;
+    for (int n = 0; n < 50; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 40);
+        const QVector<ValidationResult> results = PipelineOptimizer().calculate(params);
+        for (const ParetoPoint& p : paretoFront(results)) {
+            const ValidationResult& res = results[p.index];
+            QVERIFY(res.isValid);
+            QCOMPARE(p.mass, ContinuousOptimizer::steelMass(res.diameter, res.finalThickness));
+            QCOMPARE(p.minSafety, std::min({ res.safetyHoop, res.safetyAxial, res.safetyEquivalent }));
+            QCOMPARE(p.flowSpeedMargin, std::min(res.flowSpeed - 1.0, 3.0 - res.flowSpeed));
+            QVERIFY(p.flowSpeedMargin >= 0.0);
+            ++points;
+        }
+    }
+    QVERIFY(points > 50);
+}
+
+QTEST_APPLESS_MAIN(ParetoFrontTest)
+
+#include "tst_paretofront.moc"
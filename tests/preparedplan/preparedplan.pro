@@ -0,0 +1,7 @@
+# Повторные расчеты одного набора параметров (PreparedPlan)
+TARGET = tst_preparedplan
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_preparedplan.cpp
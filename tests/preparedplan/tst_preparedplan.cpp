@@ -0,0 +1,87 @@
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include "thicknesscatalog.h"
+#include <QtTest>
+#include <stdexcept>
+
+// Подготовленный план: выполнения с другим давлением и диаметрами совпадают
+// с calculate()
+class PreparedPlanTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void preparedPlanMatchesCalculate();
+    void catalogPlanMatchesCalculate();
+    void invalidParametersAreRejected();
+};
+
+void PreparedPlanTest::preparedPlanMatchesCalculate()
+{
+    std::mt19937_64 rng(50);
+    PipelineOptimizer optimizer;
+    PreparedPlan::Workspace workspace;
+    QVector<ValidationResult> results;
+    for (int n = 0; n < 100; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 1 + n % 60);
+        const PreparedPlan plan(params);
+
+        plan.execute(workspace, results);
+        QString mismatch = compareResults(results, optimizer.calculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+
+        params.pressure = uniform(rng, 0.1, 20.0);
+        plan.execute(workspace, params.pressure, results);
+        mismatch = compareResults(results, optimizer.calculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1, другое давление: %2").arg(n).arg(mismatch)));
+
+        params.outerDiameters = randomParameters(rng, TestMaterial::Mode1, 1 + n % 30).outerDiameters;
+        plan.execute(workspace, params.outerDiameters, params.pressure, results);
+        mismatch = compareResults(results, optimizer.calculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1, другие диаметры: %2").arg(n).arg(mismatch)));
+    }
+}
+
+void PreparedPlanTest::catalogPlanMatchesCalculate()
+{
+    std::mt19937_64 rng(51);
+    const ThicknessCatalog catalog = ThicknessCatalog::fromSortament();
+    PipelineOptimizer optimizer;
+    optimizer.setThicknessCatalog(&catalog);
+    PreparedPlan::Workspace workspace;
+    QVector<ValidationResult> results;
+    for (int n = 0; n < 50; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        setCatalogDiameters(params.outerDiameters);
+        const PreparedPlan plan(params, &catalog);
+        for (int k = 0; k < 3; ++k) {
+            params.pressure = uniform(rng, 0.1, 20.0);
+            plan.execute(workspace, params.pressure, results);
+            const QString mismatch = compareResults(results, optimizer.calculate(params));
+            QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+        }
+    }
+}
+
+void PreparedPlanTest::invalidParametersAreRejected()
+{
+    std::mt19937_64 rng(52);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 5);
+    PipelineParameters bad = params;
+    bad.massFlow = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PreparedPlan plan(bad));
+    bad = params;
+    bad.outerDiameters.append(1500.0);
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PreparedPlan plan(bad));
+
+    // Диаметры выполнения проверяются так же, как диаметры плана
+    const PreparedPlan plan(params);
+    PreparedPlan::Workspace workspace;
+    QVector<ValidationResult> results;
+    const QVector<double> outOfRange = { 530.0, 50.0 };
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument,
+                             plan.execute(workspace, outOfRange, params.pressure, results));
+}
+
+QTEST_APPLESS_MAIN(PreparedPlanTest)
+
+#include "tst_preparedplan.moc"
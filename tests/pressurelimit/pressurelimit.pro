@@ -0,0 +1,8 @@
+# Наибольшее допустимое давление участка (pressurelimit.h)
+TARGET = tst_pressurelimit
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_pressurelimit.cpp
@@ -0,0 +1,85 @@
+#include "pipelineoptimizer.h"
+#include "pressurelimit.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <stdexcept>
+
+// Наибольшее допустимое давление (PressureLimitSolver) против
+// PipelineOptimizer::checkThickness()
+class PressureLimitTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void pressureLimitIsTight();
+    void flowSpeedFailureDoesNotDependOnPressure();
+    void invalidParametersAreRejected();
+};
+
+void PressureLimitTest::pressureLimitIsTight()
+{
+    // При p_max все проверки выполнены, при p_max + tolerance - уже нет
+    std::mt19937_64 rng(110);
+    int found = 0;
+    for (int n = 0; n < 50; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 20);
+        const QVector<PipeSection> sections = designedSections(params);
+        PressureLimitSolver solver(params);
+        PipelineParameters probe = params;
+        const DesignResistance r = DesignResistance::fromParameters(params);
+        for (const PipeSection& s : sections) {
+            const PressureLimit limit = solver.solve(s.outerDiameter, s.thickness);
+            // Толщина подобрана при давлении параметров - предел не ниже его
+            QVERIFY(limit.isFound());
+            QVERIFY(limit.pressure >= params.pressure - 1e-6);
+            ++found;
+
+            probe.pressure = limit.pressure;
+            QVERIFY(PipelineOptimizer::checkThickness(probe, r, s.outerDiameter, s.thickness).passes());
+            probe.pressure = limit.pressure + 1e-6;
+            QVERIFY(!PipelineOptimizer::checkThickness(probe, r, s.outerDiameter, s.thickness).passes());
+        }
+
+        // Пакетный расчет совпадает с расчетом по одному участку
+        QVector<PressureLimit> limits;
+        solver.setThreadCount(4);
+        solver.solve(sections, limits);
+        QCOMPARE(limits.size(), sections.size());
+        for (int i = 0; i < sections.size(); ++i) {
+            QCOMPARE(limits[i].pressure, solver.solve(sections[i].outerDiameter, sections[i].thickness).pressure);
+        }
+    }
+    QVERIFY(found > 100);
+}
+
+void PressureLimitTest::flowSpeedFailureDoesNotDependOnPressure()
+{
+    // Вне диапазона скорости потока предела нет при любом давлении
+    std::mt19937_64 rng(111);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    const DesignResistance r = DesignResistance::fromParameters(params);
+    PressureLimitSolver solver(params);
+    int failed = 0;
+    for (int D = 100; D <= 1400; D += 50) {
+        const double thickness = D / 1000.0 / 20.0;
+        if (PipelineOptimizer::checkThickness(params, r, D, thickness).satisfiesFlowSpeed) {
+            continue;
+        }
+        const PressureLimit limit = solver.solve(D, thickness);
+        QVERIFY(limit.status == PressureLimit::Status::FlowSpeedFailed);
+        QVERIFY(!limit.isFound());
+        ++failed;
+    }
+    QVERIFY(failed > 0);
+}
+
+void PressureLimitTest::invalidParametersAreRejected()
+{
+    std::mt19937_64 rng(112);
+    PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    params.density = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PressureLimitSolver solver(params));
+}
+
+QTEST_APPLESS_MAIN(PressureLimitTest)
+
+#include "tst_pressurelimit.moc"
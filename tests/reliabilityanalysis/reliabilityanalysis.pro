@@ -0,0 +1,8 @@
+# Вероятностный расчет методом Монте-Карло (ReliabilityAnalysis)
+TARGET = tst_reliabilityanalysis
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_reliabilityanalysis.cpp
@@ -0,0 +1,71 @@
+#include "pipelineoptimizer.h"
+#include "reliabilityanalysis.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <algorithm>
+
+// Вероятностный расчет: согласованность с calculate() и независимость от потоков
+class ReliabilityAnalysisTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void reliabilityWithFixedVariablesIsDeterministic();
+    void reliabilityDoesNotDependOnThreadCount();
+};
+
+void ReliabilityAnalysisTest::reliabilityWithFixedVariablesIsDeterministic()
+{
+    // Без разброса каждое испытание повторяет детерминированный расчет
+    std::mt19937_64 rng(130);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 40);
+    ReliabilitySettings settings;
+    settings.samples = 1000;
+    const QVector<DiameterReliability> reliability = ReliabilityAnalysis(params, settings).run();
+    const QVector<ValidationResult> results = PipelineOptimizer().calculate(params);
+
+    int designed = 0;
+    for (const DiameterReliability& d : reliability) {
+        if (!d.designed) {
+            QCOMPARE(d.failureProbability, 1.0);
+            continue;
+        }
+        ++designed;
+        QCOMPARE(d.failureProbability, 0.0);
+        const auto it = std::find_if(results.begin(), results.end(), [&](const ValidationResult& r) {
+            return r.isValid && r.diameter == d.diameter;
+        });
+        QVERIFY(it != results.end());
+        QCOMPARE(d.thickness, it->finalThickness);
+    }
+    QVERIFY(designed > 0);
+}
+
+void ReliabilityAnalysisTest::reliabilityDoesNotDependOnThreadCount()
+{
+    std::mt19937_64 rng(140);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::PipelineSteel, 20);
+    ReliabilitySettings settings;
+    settings.yieldStrength = RandomVariable::normal(params.yieldStrength, 0.08 * params.yieldStrength);
+    settings.tensileStrength = RandomVariable::logNormal(params.tensileStrength, 0.05 * params.tensileStrength);
+    settings.pressure = RandomVariable::uniform(0.8 * params.pressure, 1.3 * params.pressure);
+    settings.temperatureDelta = RandomVariable::normal(params.temperatureDelta, 10.0);
+    settings.samples = 200000;
+    settings.seed = 7;
+
+    ReliabilityAnalysis single(params, settings);
+    ReliabilityAnalysis parallel(params, settings);
+    parallel.setThreadCount(4);
+    const QVector<DiameterReliability> a = single.run();
+    const QVector<DiameterReliability> b = parallel.run();
+    QCOMPARE(a.size(), b.size());
+    for (int i = 0; i < a.size(); ++i) {
+        QCOMPARE(a[i].failureProbability, b[i].failureProbability);
+        QCOMPARE(a[i].standardError, b[i].standardError);
+        QCOMPARE(a[i].hoopFailure, b[i].hoopFailure);
+        QCOMPARE(a[i].equivalentFailure, b[i].equivalentFailure);
+    }
+}
+
+QTEST_APPLESS_MAIN(ReliabilityAnalysisTest)
+
+#include "tst_reliabilityanalysis.moc"
@@ -0,0 +1,7 @@
+# Кэш результатов в памяти и на диске (ResultCache)
+TARGET = tst_resultcache
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_resultcache.cpp
@@ -0,0 +1,178 @@
+#include "pipelineoptimizer.h"
+#include "resultcache.h"
+#include "testsupport.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+// Кэш результатов: ключ, чтение записанного, пропуск оборванных записей
+class ResultCacheTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void canonicalKey();
+    void memoryRoundTrip();
+    void storeRoundTrip();
+    void tornRecordIsSkipped();
+    void optimizerUsesCache();
+};
+
+namespace {
+
+QVector<PipelineParameters> scenarios(int count)
+{
+    std::mt19937_64 rng(200);
+    QVector<PipelineParameters> result;
+    for (int n = 0; n < count; ++n) {
+        result.append(randomParameters(rng, TestMaterial(n % 5), 1 + n % 9));
+    }
+    return result;
+}
+
+QString storePath(const QTemporaryDir& dir)
+{
+    return QDir(dir.path()).filePath(QString("results-v%1.cwcache").arg(PipelineOptimizer::SolverVersion));
+}
+
+} // namespace
+
+void ResultCacheTest::canonicalKey()
+{
+    // Ключ зависит от всех полей, режима, диаметров и variant; -0.0 и 0.0 не различаются
+    const PipelineParameters base = scenarios(1).first();
+    const QByteArray key = ResultCache::canonicalKey(base);
+    for (const ParameterField& f : parameterFields()) {
+        PipelineParameters changed = base;
+        changed.*f.field += 1.0;
+        QVERIFY2(ResultCache::canonicalKey(changed) != key, f.name);
+    }
+    PipelineParameters changed = base;
+    changed.outerDiameters.append(530.0);
+    QVERIFY(ResultCache::canonicalKey(changed) != key);
+    changed = base;
+    changed.mode = base.mode == Mode::Mode1 ? Mode::Mode2 : Mode::Mode1;
+    QVERIFY(ResultCache::canonicalKey(changed) != key);
+    QVERIFY(ResultCache::canonicalKey(base, "catalog") != key);
+
+    changed = base;
+    changed.temperatureDelta = 0.0;
+    PipelineParameters negativeZero = base;
+    negativeZero.temperatureDelta = -0.0;
+    QCOMPARE(ResultCache::canonicalKey(negativeZero), ResultCache::canonicalKey(changed));
+}
+
+void ResultCacheTest::memoryRoundTrip()
+{
+    ResultCache cache;
+    PipelineOptimizer optimizer;
+    const QVector<PipelineParameters> input = scenarios(20);
+    for (const PipelineParameters& p : input) {
+        cache.insert(p, optimizer.calculate(p));
+    }
+
+    QVector<ValidationResult> results;
+    for (const PipelineParameters& p : input) {
+        QVERIFY(cache.find(p, results));
+        const QString mismatch = compareResults(results, optimizer.calculate(p));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(mismatch));
+        QVERIFY(!cache.find(p, results, "catalog"));
+    }
+    QCOMPARE(cache.hits(), qint64(input.size()));
+    QCOMPARE(cache.misses(), qint64(input.size()));
+}
+
+void ResultCacheTest::storeRoundTrip()
+{
+    // Записи одного кэша читает другой, открывший тот же каталог
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    PipelineOptimizer optimizer;
+    const QVector<PipelineParameters> input = scenarios(30);
+    {
+        ResultCache writer;
+        QVERIFY(writer.openStore(dir.path()));
+        for (const PipelineParameters& p : input) {
+            writer.insert(p, optimizer.calculate(p));
+        }
+    }
+
+    ResultCache reader;
+    QVERIFY(reader.openStore(dir.path()));
+    QVector<ValidationResult> results;
+    for (const PipelineParameters& p : input) {
+        QVERIFY(reader.find(p, results));
+        const QString mismatch = compareResults(results, optimizer.calculate(p));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(mismatch));
+    }
+    QCOMPARE(reader.hits(), qint64(input.size()));
+}
+
+void ResultCacheTest::tornRecordIsSkipped()
+{
+    // Файл: запись 0, половина записи 1 (процесс завершился посреди записи),
+    // запись 2. Индексация после оборванной записи продолжается с записи 2
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    PipelineOptimizer optimizer;
+    const QVector<PipelineParameters> input = scenarios(3);
+    {
+        ResultCache writer;
+        QVERIFY(writer.openStore(dir.path()));
+        writer.insert(input[1], optimizer.calculate(input[1]));
+    }
+    QFile file(storePath(dir));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const QByteArray content = file.readAll();
+    const QByteArray torn = content.mid(16, (content.size() - 16) / 2 + 3);
+    file.close();
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.resize(0);
+    file.write(content.left(16));
+    file.close();
+
+    {
+        ResultCache writer;
+        QVERIFY(writer.openStore(dir.path()));
+        writer.insert(input[0], optimizer.calculate(input[0]));
+    }
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.seek(file.size());
+    file.write(torn);
+    file.close();
+    {
+        ResultCache writer;
+        QVERIFY(writer.openStore(dir.path()));
+        writer.insert(input[2], optimizer.calculate(input[2]));
+    }
+
+    ResultCache reader;
+    QVERIFY(reader.openStore(dir.path()));
+    QVector<ValidationResult> results;
+    for (int n : { 0, 2 }) {
+        QVERIFY(reader.find(input[n], results));
+        const QString mismatch = compareResults(results, optimizer.calculate(input[n]));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(mismatch));
+    }
+    QVERIFY(!reader.find(input[1], results));
+}
+
+void ResultCacheTest::optimizerUsesCache()
+{
+    // Повторный сценарий берется из кэша, результаты те же
+    ResultCache cache;
+    PipelineOptimizer optimizer;
+    optimizer.setCache(&cache);
+    const PipelineParameters params = scenarios(4).last();
+    const QVector<ValidationResult> first = optimizer.calculate(params);
+    const QVector<ValidationResult> second = optimizer.calculate(params);
+    QCOMPARE(cache.misses(), qint64(1));
+    QCOMPARE(cache.hits(), qint64(1));
+    const QString mismatch = compareResults(second, first);
+    QVERIFY2(mismatch.isEmpty(), qPrintable(mismatch));
+    QVERIFY(compareResults(first, PipelineOptimizer().calculate(params)).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(ResultCacheTest)
+
+#include "tst_resultcache.moc"
@@ -0,0 +1,8 @@
+# Телескопическая трасса (routeoptimizer.h): подбор размеров по участкам
+TARGET = tst_routeoptimizer
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_routeoptimizer.cpp
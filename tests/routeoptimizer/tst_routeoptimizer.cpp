@@ -0,0 +1,207 @@
+#include "continuousoptimizer.h"
+#include "pipelineoptimizer.h"
+#include "routeoptimizer.h"
+#include "testsupport.h"
+#include "thicknesscatalog.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <limits>
+#include <stdexcept>
+
+// Телескопическая трасса: динамическое программирование против полного
+// перебора и чтение участков из файла
+class RouteOptimizerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void designMatchesBruteForce();
+    void readRouteSegmentsParsesAndReportsLine();
+};
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Наименьшая масса трассы полным перебором диаметров участков при не больше
+// maxChanges сменах диаметра (-1 - без ограничения); mass[i·k + j] - масса
+// участка i с диаметром j. Массы складываются в порядке участков, как в
+// RouteOptimizer::run(), поэтому совпадают точно.
+double bruteForceMass(const QVector<double>& mass, int n, int k, int maxChanges)
+{
+    QVector<int> choice(n, 0);
+    double best = kInfinity;
+    for (;;) {
+        double total = mass[choice[0]];
+        int changes = 0;
+        for (int i = 1; i < n; ++i) {
+            total = mass[i * k + choice[i]] + total;
+            changes += choice[i] != choice[i - 1];
+        }
+        if ((maxChanges < 0 || changes <= maxChanges) && total < best) {
+            best = total;
+        }
+        int i = 0;
+        while (i < n && ++choice[i] == k) {
+            choice[i++] = 0;
+        }
+        if (i == n) {
+            return best;
+        }
+    }
+}
+
+} // namespace
+
+void RouteOptimizerTest::designMatchesBruteForce()
+{
+    const double sizes[] = { 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 14.0, 16.0, 18.0, 20.0 };
+    const int maxChanges[] = { 0, 1, 2, -1 };
+    std::mt19937_64 rng(210);
+    int feasible = 0;
+    int constrained = 0;  // Трассы, где ограничение смен увеличило массу
+    for (int n = 0; n < 60; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        params.outerDiameters = ThicknessCatalog::sortament().diameters();
+        const DesignResistance r = DesignResistance::fromParameters(params);
+
+        // Четыре соседних диаметра, проходящих по скорости потока, с
+        // неполными наборами толщин - иначе выгоден один наименьший диаметр
+        const QVector<PipeSection> designed = designedSections(params);
+        if (designed.size() < 4) {
+            continue;
+        }
+        QMap<double, QVector<double>> map;
+        for (int j = 0; j < 4; ++j) {
+            QVector<double>& thicknesses = map[designed[j].outerDiameter];
+            for (double t : sizes) {
+                if (uniform(rng, 0.0, 1.0) < 0.35) {
+                    thicknesses.append(t);
+                }
+            }
+            thicknesses.append(sizes[13]);
+        }
+        const ThicknessCatalog catalog = ThicknessCatalog::fromMap(map);
+        const QVector<double>& diameters = catalog.diameters();
+        const int k = diameters.size();
+
+        QVector<RouteSegment> segments;
+        for (int i = 0; i < 6; ++i) {
+            RouteSegment segment;
+            segment.length = uniform(rng, 100.0, 5000.0);
+            segment.pressure = params.pressure * uniform(rng, 0.5, 1.5);
+            segment.bendRadius = (i % 3 == 2) ? uniform(rng, 500.0, 5000.0) : 0.0;
+            segments.append(segment);
+        }
+        segments.append(segments[1]);  // Повторная нагрузка
+        const int count = segments.size();
+
+        QVector<double> thickness(count * k);
+        QVector<double> mass(count * k, kInfinity);
+        PipelineParameters local = params;
+        for (int i = 0; i < count; ++i) {
+            local.pressure = segments[i].pressure;
+            local.bendRadius = segments[i].bendRadius;
+            for (int j = 0; j < k; ++j) {
+                const double delta = PipelineOptimizer::catalogThickness(local, r, catalog, diameters[j]);
+                thickness[i * k + j] = delta;
+                if (delta > 0.0) {
+                    mass[i * k + j] = ContinuousOptimizer::steelMass(diameters[j], delta) * segments[i].length;
+                }
+            }
+        }
+
+        RouteOptimizer optimizer(params);
+        optimizer.setThicknessCatalog(&catalog);
+        optimizer.setThreadCount(n % 3);
+        double unlimitedMass = kInfinity;
+        double fixedMass = kInfinity;
+        for (int c : maxChanges) {
+            optimizer.setMaxDiameterChanges(c);
+            const RouteDesign design = optimizer.run(segments);
+            const double expected = bruteForceMass(mass, count, k, c);
+            const QString context = QString("Сценарий %1, смен не больше %2").arg(n).arg(c);
+            QCOMPARE(design.distinctLoads, count - 1);
+            QVERIFY2(design.isFeasible == (expected < kInfinity), qPrintable(context));
+            if (!design.isFeasible) {
+                QVERIFY(design.sections.isEmpty());
+                continue;
+            }
+            QVERIFY2(design.mass == expected, qPrintable(context));
+
+            // Размеры участков дают ту же массу и не больше c смен диаметра
+            QCOMPARE(design.sections.size(), count);
+            double total = 0.0;
+            int changes = 0;
+            for (int i = 0; i < count; ++i) {
+                const int j = int(std::find(diameters.begin(), diameters.end(),
+                                            design.sections[i].outerDiameter) - diameters.begin());
+                QVERIFY(j < k);
+                QCOMPARE(design.sections[i].thickness, thickness[i * k + j]);
+                total = i == 0 ? mass[j] : mass[i * k + j] + total;
+                changes += i > 0 && design.sections[i].outerDiameter != design.sections[i - 1].outerDiameter;
+            }
+            QVERIFY2(total == design.mass, qPrintable(context));
+            QCOMPARE(design.diameterChanges, changes);
+            QVERIFY2(c < 0 || changes <= c, qPrintable(context));
+            if (c == 0) {
+                fixedMass = design.mass;
+            } else if (c < 0) {
+                unlimitedMass = design.mass;
+            }
+        }
+        if (unlimitedMass < kInfinity) {
+            ++feasible;
+            QVERIFY(unlimitedMass <= fixedMass);
+            constrained += unlimitedMass < fixedMass;
+        }
+    }
+    QVERIFY2(feasible >= 10, qPrintable(QString("Допустимых трасс: %1").arg(feasible)));
+    QVERIFY2(constrained > 0, "Ограничение смен диаметра ни разу не увеличило массу");
+}
+
+void RouteOptimizerTest::readRouteSegmentsParsesAndReportsLine()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("route.txt");
+    auto writeFile = [&](const QByteArray& content) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    };
+
+    writeFile("# длина давление [радиус]\n"
+              "1200 7.5\n"
+              "\n"
+              "800;6.3, 1500\n"
+              "350\t5\n");
+    const QVector<RouteSegment> segments = readRouteSegments(path);
+    QCOMPARE(segments.size(), 3);
+    QCOMPARE(segments[0].length, 1200.0);
+    QCOMPARE(segments[0].pressure, 7.5);
+    QCOMPARE(segments[0].bendRadius, 0.0);
+    QCOMPARE(segments[1].length, 800.0);
+    QCOMPARE(segments[1].pressure, 6.3);
+    QCOMPARE(segments[1].bendRadius, 1500.0);
+    QCOMPARE(segments[2].pressure, 5.0);
+
+    const QByteArray invalid[] = { "100 5\n100 x\n", "100 5\n100\n", "100 5\n0 5\n",
+                                   "100 5\n100 5 -1\n", "100 5\n100 5 1 2\n" };
+    for (const QByteArray& content : invalid) {
+        writeFile(content);
+        try {
+            readRouteSegments(path);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, readRouteSegments(QDir(dir.path()).filePath("missing.txt")));
+}
+
+QTEST_APPLESS_MAIN(RouteOptimizerTest)
+
+#include "tst_routeoptimizer.moc"
@@ -0,0 +1,8 @@
+# Производные коэффициентов запаса (safetysensitivities.h)
+TARGET = tst_safetysensitivities
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_safetysensitivities.cpp
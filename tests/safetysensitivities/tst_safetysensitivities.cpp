@@ -0,0 +1,90 @@
+#include "parameterfields.h"
+#include "pipelineoptimizer.h"
+#include "safetysensitivities.h"
+#include "testsupport.h"
+#include <QtTest>
+
+// Производные коэффициентов запаса (safetysensitivities.h) против конечных
+// разностей
+class SafetySensitivitiesTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void safetySensitivitiesMatchFiniteDifferences();
+    void valuesMatchCheckThickness();
+};
+
+void SafetySensitivitiesTest::safetySensitivitiesMatchFiniteDifferences()
+{
+    std::mt19937_64 rng(90);
+    const ParameterFieldList& fields = parameterFields();
+    for (int n = 0; n < 50; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        const double D = std::round(uniform(rng, 100.0, 1400.0));
+        const DesignResistance r = DesignResistance::fromParameters(params);
+        const double delta = params.pressureReliability * params.pressure * (D / 1000.0) /
+                             (2.0 * qMin(r.R1, r.R2)) + 0.005;
+        const SafetySensitivities s = safetySensitivities(params, D, delta);
+        if (!s.isValid) {
+            continue;
+        }
+
+        // Центральная разность n = R/σ по каждому полю
+        for (int k = 0; k < ParameterFieldCount; ++k) {
+            double& x = params.*fields[k].field;
+            const double x0 = x;
+            if (fields[k].field == &PipelineParameters::bendRadius && x0 == 0.0) {
+                continue;  // Прямая труба: при r < 0 изгиб не учитывается, разность не определена
+            }
+            const double h = 1e-6 * (x0 != 0.0 ? std::abs(x0) : 1.0);
+            x = x0 + h;
+            const SafetySensitivities plus = safetySensitivities(params, D, delta);
+            x = x0 - h;
+            const SafetySensitivities minus = safetySensitivities(params, D, delta);
+            x = x0;
+            if (!plus.isValid || !minus.isValid) {
+                continue;
+            }
+            const SafetyGradient* gradients[] = { &s.hoop, &s.axial, &s.equivalent };
+            const SafetyGradient* plusValues[] = { &plus.hoop, &plus.axial, &plus.equivalent };
+            const SafetyGradient* minusValues[] = { &minus.hoop, &minus.axial, &minus.equivalent };
+            for (int j = 0; j < 3; ++j) {
+                // Запас обнуляется при σ ≤ 0: у границы разность не определена
+                if (!(plusValues[j]->value > 0.0) || !(minusValues[j]->value > 0.0)) {
+                    continue;
+                }
+                const double numeric = (plusValues[j]->value - minusValues[j]->value) / (2.0 * h);
+                const double analytic = gradients[j]->gradient[k];
+                QVERIFY2(std::abs(numeric - analytic) <= 1e-4 * qMax(std::abs(analytic), gradients[j]->value),
+                         qPrintable(QString("Вариант %1, поле %2, запас %3: %4 / %5")
+                                        .arg(n).arg(fields[k].name).arg(j).arg(analytic).arg(numeric)));
+            }
+        }
+    }
+}
+
+void SafetySensitivitiesTest::valuesMatchCheckThickness()
+{
+    // Значения запасов - как у calculate() при найденной толщине
+    std::mt19937_64 rng(91);
+    int checked = 0;
+    for (int n = 0; n < 50; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 20);
+        for (const ValidationResult& r : PipelineOptimizer().calculate(params)) {
+            if (!r.isValid) {
+                continue;
+            }
+            const SafetySensitivities s = safetySensitivities(params, r.diameter, r.finalThickness);
+            QVERIFY(s.isValid);
+            QVERIFY(std::abs(s.hoop.value - r.safetyHoop) <= 1e-12 * r.safetyHoop);
+            QVERIFY(std::abs(s.axial.value - r.safetyAxial) <= 1e-12 * r.safetyAxial);
+            QVERIFY(std::abs(s.equivalent.value - r.safetyEquivalent) <= 1e-12 * r.safetyEquivalent);
+            ++checked;
+        }
+    }
+    QVERIFY(checked > 100);
+}
+
+QTEST_APPLESS_MAIN(SafetySensitivitiesTest)
+
+#include "tst_safetysensitivities.moc"
@@ -0,0 +1,7 @@
+# Потоковое чтение сценариев JSONL и CSV
+TARGET = tst_scenarioreader
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_scenarioreader.cpp
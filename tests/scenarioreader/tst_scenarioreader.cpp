@@ -0,0 +1,259 @@
+#include "parameterfields.h"
+#include "pipelineio.h"
+#include "scenarioreader.h"
+#include "testsupport.h"
+#include <QBuffer>
+#include <QtTest>
+#include <stdexcept>
+
+// Потоковое чтение сценариев: форматы, разбиение на блоки, ошибки в записях
+class ScenarioReaderTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void jsonLinesAndCsvGiveSameScenarios();
+    void crlfLineEndings();
+    void quotedCsvFields();
+    void recordsSplitAcrossChunks();
+    void badRecordsAreSkipped();
+    void nonFiniteValuesAreRejected();
+    void catalogDiameters();
+};
+
+namespace {
+
+// Результат чтения всего текста: сценарии и номера строк с ошибками в записях
+struct ReadResult {
+    QVector<PipelineParameters> scenarios;
+    QVector<qint64> errorLines;
+};
+
+ReadResult readAll(const QByteArray& text, ScenarioReader::Format format = ScenarioReader::Format::Auto)
+{
+    QBuffer buffer;
+    buffer.setData(text);
+    buffer.open(QIODevice::ReadOnly);
+    ScenarioReader reader(&buffer, format, 4096);
+    ReadResult result;
+    PipelineParameters params;
+    for (;;) {
+        try {
+            if (!reader.next(params)) {
+                break;
+            }
+            result.scenarios.append(params);
+        } catch (const std::invalid_argument&) {
+            result.errorLines.append(reader.lineNumber());
+        }
+    }
+    return result;
+}
+
+bool sameParameters(const PipelineParameters& a, const PipelineParameters& b)
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (a.*f.field != b.*f.field) {
+            return false;
+        }
+    }
+    return a.mode == b.mode && a.outerDiameters == b.outerDiameters;
+}
+
+QByteArray number(double value)
+{
+    return QByteArray::number(value, 'g', 17);
+}
+
+// Сценарий в CSV (столбцы - csvHeader()); JSONL - scenarioToJsonLine()
+QByteArray csvHeader()
+{
+    QByteArray line = "mode";
+    for (const ParameterField& f : parameterFields()) {
+        line += ',';
+        line += f.name;
+    }
+    line += ",outerDiameters\n";
+    return line;
+}
+
+QByteArray toCsvLine(const PipelineParameters& p)
+{
+    QByteArray line = p.mode == Mode::Mode2 ? "Mode2" : "Mode1";
+    for (const ParameterField& f : parameterFields()) {
+        line += ',';
+        line += number(p.*f.field);
+    }
+    line += ',';
+    for (int i = 0; i < p.outerDiameters.size(); ++i) {
+        line += i ? ";" : "";
+        line += number(p.outerDiameters[i]);
+    }
+    line += '\n';
+    return line;
+}
+
+// Сценарий режима 2 со всеми полями
+PipelineParameters mode2Scenario(std::mt19937_64& rng, int diameterCount)
+{
+    return randomParameters(rng, TestMaterial::RuntimeBend, diameterCount);
+}
+
+} // namespace
+
+void ScenarioReaderTest::jsonLinesAndCsvGiveSameScenarios()
+{
+    std::mt19937_64 rng(1);
+    QVector<PipelineParameters> expected;
+    QByteArray json;
+    QByteArray csv = csvHeader();
+    for (int n = 0; n < 20; ++n) {
+        expected.append(mode2Scenario(rng, 1 + n % 7));
+        json += scenarioToJsonLine(expected.last());
+        csv += toCsvLine(expected.last());
+    }
+
+    for (const QByteArray& text : { json, csv }) {
+        const ReadResult result = readAll(text);
+        QVERIFY(result.errorLines.isEmpty());
+        QCOMPARE(result.scenarios.size(), expected.size());
+        for (int n = 0; n < expected.size(); ++n) {
+            QVERIFY2(sameParameters(result.scenarios[n], expected[n]), qPrintable(QString::number(n)));
+        }
+    }
+}
+
+void ScenarioReaderTest::crlfLineEndings()
+{
+    std::mt19937_64 rng(2);
+    const PipelineParameters expected = mode2Scenario(rng, 3);
+    QByteArray json = scenarioToJsonLine(expected);
+    json.chop(1);
+    json += "\r\n\r\n# комментарий\r\n";
+    json += json;
+    QByteArray csv = csvHeader() + toCsvLine(expected);
+    csv.replace("\n", "\r\n");
+
+    for (const QByteArray& text : { json, csv }) {
+        const ReadResult result = readAll(text);
+        QVERIFY(result.errorLines.isEmpty());
+        QVERIFY(!result.scenarios.isEmpty());
+        for (const PipelineParameters& p : result.scenarios) {
+            QVERIFY(sameParameters(p, expected));
+        }
+    }
+}
+
+void ScenarioReaderTest::quotedCsvFields()
+{
+    const QByteArray csv =
+        "\"mode\",\"pressure\",massFlow,operationalFactor,reliabilityYield,reliabilityStrength,"
+        "responsibilityFactor,pressureReliability,outerDiameters,comment\n"
+        "\"Mode1\", \"5.5\" ,1000,0.9,1.1,1.15,1.1,1.15,\"530, 720;1020\",\"a, b\"\n";
+    const ReadResult result = readAll(csv);
+    QVERIFY(result.errorLines.isEmpty());
+    QCOMPARE(result.scenarios.size(), 1);
+    const PipelineParameters& p = result.scenarios.first();
+    QCOMPARE(p.pressure, 5.5);
+    QCOMPARE(p.massFlow, 1000.0);
+    QCOMPARE(p.outerDiameters, QVector<double>({ 530.0, 720.0, 1020.0 }));
+}
+
+void ScenarioReaderTest::recordsSplitAcrossChunks()
+{
+    // Записи пересекают границы блоков по 4096 байт; одна строка длиннее блока
+    std::mt19937_64 rng(3);
+    QVector<PipelineParameters> expected;
+    QByteArray json;
+    for (int n = 0; n < 300; ++n) {
+        expected.append(mode2Scenario(rng, n == 150 ? 800 : 1 + n % 11));
+        json += scenarioToJsonLine(expected.last());
+    }
+    QVERIFY(json.size() > 10 * 4096);
+
+    const ReadResult result = readAll(json);
+    QVERIFY(result.errorLines.isEmpty());
+    QCOMPARE(result.scenarios.size(), expected.size());
+    for (int n = 0; n < expected.size(); ++n) {
+        QVERIFY2(sameParameters(result.scenarios[n], expected[n]), qPrintable(QString::number(n)));
+    }
+}
+
+void ScenarioReaderTest::badRecordsAreSkipped()
+{
+    std::mt19937_64 rng(4);
+    const PipelineParameters good = mode2Scenario(rng, 2);
+    QByteArray missingField = scenarioToJsonLine(good);
+    missingField.replace("\"massFlow\":", "\"massFlowX\":");
+    const QByteArray json = scenarioToJsonLine(good) +
+                            "{\"mode\":\"Mode1\",\"pressure\":abc}\n" +
+                            scenarioToJsonLine(good) +
+                            missingField +
+                            "{\"mode\":\"Mode3\"}\n" +
+                            "не JSON\n" +
+                            scenarioToJsonLine(good);
+
+    const ReadResult result = readAll(json, ScenarioReader::Format::JsonLines);
+    QCOMPARE(result.scenarios.size(), 3);
+    for (const PipelineParameters& p : result.scenarios) {
+        QVERIFY(sameParameters(p, good));
+    }
+    QCOMPARE(result.errorLines, QVector<qint64>({ 2, 4, 5, 6 }));
+
+    QByteArray csv = csvHeader() + toCsvLine(good);
+    QByteArray badCsv = toCsvLine(good);
+    badCsv.insert(badCsv.indexOf(',') + 1, 'x');
+    csv += badCsv + toCsvLine(good);
+    const ReadResult csvResult = readAll(csv);
+    QCOMPARE(csvResult.scenarios.size(), 2);
+    QCOMPARE(csvResult.errorLines, QVector<qint64>({ 3 }));
+}
+
+void ScenarioReaderTest::nonFiniteValuesAreRejected()
+{
+    std::mt19937_64 rng(5);
+    const PipelineParameters good = mode2Scenario(rng, 2);
+    const QByteArray line = scenarioToJsonLine(good);
+    const QByteArray pressure = "\"pressure\":" + number(good.pressure);
+    const QByteArray diameters = "\"outerDiameters\":[" + number(good.outerDiameters[0]);
+
+    QVector<QByteArray> bad;
+    for (const char* value : { "nan", "inf", "-inf", "1e400" }) {
+        bad.append(QByteArray(line).replace(pressure, "\"pressure\":" + QByteArray(value)));
+        bad.append(QByteArray(line).replace(diameters, "\"outerDiameters\":[" + QByteArray(value)));
+    }
+    for (const QByteArray& text : bad) {
+        const ReadResult result = readAll(text);
+        QVERIFY2(result.scenarios.isEmpty(), text.constData());
+        QCOMPARE(result.errorLines.size(), 1);
+    }
+
+    // validateOuterDiameters() отвергает и нечисловой диаметр
+    const QVector<double> notANumber = { 530.0, std::nan("") };
+    const QVector<double> tooSmall = { 99.0 };
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, validateOuterDiameters(notANumber));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, validateOuterDiameters(tooSmall));
+    validateOuterDiameters({ 100.0, 1400.0 });
+}
+
+void ScenarioReaderTest::catalogDiameters()
+{
+    std::mt19937_64 rng(6);
+    PipelineParameters p = mode2Scenario(rng, 1);
+    QByteArray json = scenarioToJsonLine(p);
+    json.replace(json.indexOf("\"outerDiameters\""), json.size(), "\"outerDiameters\":\"catalog\"}\n");
+    QByteArray csv = csvHeader() + toCsvLine(p);
+    csv.replace(csv.lastIndexOf(',') + 1, csv.size(), "catalog\n");
+
+    QVector<double> catalog;
+    setCatalogDiameters(catalog);
+    QVERIFY(!catalog.isEmpty());
+    for (const QByteArray& text : { json, csv }) {
+        const ReadResult result = readAll(text);
+        QCOMPARE(result.scenarios.size(), 1);
+        QCOMPARE(result.scenarios.first().outerDiameters, catalog);
+    }
+}
+
+QTEST_APPLESS_MAIN(ScenarioReaderTest)
+
+#include "tst_scenarioreader.moc"
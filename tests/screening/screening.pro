@@ -0,0 +1,7 @@
+# Отбраковка пакета в одинарной точности (PipelineOptimizer::setScreening())
+TARGET = tst_screening
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_screening.cpp
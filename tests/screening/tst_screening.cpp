@@ -0,0 +1,76 @@
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+#include <algorithm>
+
+// Двухэтапный пакетный расчет: отбраковка в float и уточнение в double дают
+// те же результаты, что расчет в double
+class ScreeningTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void screeningDoesNotChangeResults();
+    void screenedBatchMatchesExactBatch();
+};
+
+void ScreeningTest::screeningDoesNotChangeResults()
+{
+    std::mt19937_64 rng(30);
+    PipelineOptimizer screened;
+    PipelineOptimizer exact;
+    exact.setScreening(false);
+    qint64 screenedDiameters = 0;
+    for (int n = 0; n < 200; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 200);
+        if (n % 2) {
+            // Упорядоченный список: в пакет попадает только окно скорости
+            // потока, и группы дорожек чаще отбраковываются целиком
+            std::sort(params.outerDiameters.begin(), params.outerDiameters.end());
+        }
+        const QVector<ValidationResult> expected = exact.calculate(params);
+        QCOMPARE(exact.lastStats().screenedDiameters, 0);
+        const QString mismatch = compareResults(screened.calculate(params), expected);
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+        screenedDiameters += screened.lastStats().screenedDiameters;
+    }
+    // Без векторных инструкций пакетного расчета и отбраковки нет
+    QVERIFY(detectSimdIsa() == SimdIsa::None || screenedDiameters > 0);
+}
+
+void ScreeningTest::screenedBatchMatchesExactBatch()
+{
+    // Отбраковка в float и досчет неразрешенных групп в double дают те же
+    // флаги, что и расчет всего пакета в double
+    std::mt19937_64 rng(70);
+    StressBatch screened;
+    StressBatch exact;
+    for (SimdIsa isa : availableIsas()) {
+        for (int n = 0; n < 200; ++n) {
+            const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+            const DesignResistance r = DesignResistance::fromParameters(params);
+            const StressConstants constants = StressConstants::fromParameters(params, r.R1, r.R2, r.allowEquiv);
+            fillRandomBatch(rng, params, r, exact, 1 + n % 100);
+            screened = exact;
+
+            evaluateStressBatch(constants, exact, isa);
+            screenStressBatch(constants, screened, 0, screened.size(), isa);
+            // Разрешенная в float дорожка нарушает хотя бы одно условие прочности
+            const quint8 allStress = LaneHoopStress | LaneAxialStress | LaneEquivalentStress;
+            for (int i = 0; i < exact.size(); ++i) {
+                if (!(screened.flags[i] & LaneUnresolved)) {
+                    QCOMPARE(screened.flags[i], exact.flags[i]);
+                    QVERIFY((screened.flags[i] & allStress) != allStress);
+                }
+            }
+            confirmStressBatch(constants, screened, 0, screened.size(), isa);
+            for (int i = 0; i < exact.size(); ++i) {
+                QCOMPARE(screened.flags[i], exact.flags[i]);
+            }
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(ScreeningTest)
+
+#include "tst_screening.moc"
@@ -0,0 +1,7 @@
+# Ядро: calculate() против эталонного расчета
+TARGET = tst_solver
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_solver.cpp
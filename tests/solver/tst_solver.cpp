@@ -0,0 +1,69 @@
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include <QtTest>
+
+// Расчетное ядро: calculate() против эталонного перебора с шагом 1 мм
+// (testsupport.h)
+class SolverTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void bisectionMatchesReference();
+    void steppingMatchesReference();
+    void gridEndMatchesReference();
+};
+
+void SolverTest::bisectionMatchesReference()
+{
+    // Без изгиба и при (2μ - 1)·(-EαΔt) ≥ 0 толщина ищется бисекцией
+    std::mt19937_64 rng(11);
+    PipelineOptimizer optimizer;
+    int bisected = 0;
+    for (int n = 0; n < 400; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 1 + n % 40);
+        if (!SolverInvariants::fromParameters(params).monotoneMargins) {
+            continue;
+        }
+        ++bisected;
+        const QString mismatch = compareResults(optimizer.calculate(params), referenceCalculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+    QVERIFY(bisected > 100);
+}
+
+void SolverTest::steppingMatchesReference()
+{
+    // При изгибе запасы немонотонны по толщине - пошаговый перебор
+    std::mt19937_64 rng(12);
+    PipelineOptimizer optimizer;
+    for (int n = 0; n < 400; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial::RuntimeBend, 1 + n % 40);
+        QVERIFY(!SolverInvariants::fromParameters(params).monotoneMargins);
+        const QString mismatch = compareResults(optimizer.calculate(params), referenceCalculate(params));
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+}
+
+void SolverTest::gridEndMatchesReference()
+{
+    // При большом давлении подходящей толщины часто нет до радиуса трубы:
+    // поиск доходит до конца сетки 1 мм, размер которой заранее не известен
+    std::mt19937_64 rng(13);
+    PipelineOptimizer optimizer;
+    int skipped = 0;
+    for (int n = 0; n < 400; ++n) {
+        const TestMaterial material = n % 2 ? TestMaterial::Runtime : TestMaterial::RuntimeBend;
+        PipelineParameters params = randomParameters(rng, material, 1 + n % 40);
+        params.pressure = uniform(rng, 50.0, 3000.0);
+        params.massFlow = uniform(rng, 1.0, 300.0);
+        const QVector<ValidationResult> expected = referenceCalculate(params);
+        skipped += params.outerDiameters.size() - expected.size();
+        const QString mismatch = compareResults(optimizer.calculate(params), expected);
+        QVERIFY2(mismatch.isEmpty(), qPrintable(QString("Вариант %1: %2").arg(n).arg(mismatch)));
+    }
+    QVERIFY(skipped > 100);
+}
+
+QTEST_APPLESS_MAIN(SolverTest)
+
+#include "tst_solver.moc"
@@ -0,0 +1,7 @@
+# Сортамент труб ГОСТ 10704-91 (sortament.h)
+TARGET = tst_sortament
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_sortament.cpp
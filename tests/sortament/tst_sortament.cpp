@@ -0,0 +1,121 @@
+#include "pipelineio.h"
+#include "sortament.h"
+#include "testsupport.h"
+#include <QtTest>
+
+// Сортамент: двоичный поиск совпадает с перебором таблиц
+class SortamentTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void diameterLookupMatchesLinearScan();
+    void thicknessLookupMatchesLinearScan();
+    void rangeMatchesLinearScan();
+    void catalogDiameters();
+};
+
+namespace {
+
+// Запросы: все диаметры и толщины таблиц, соседние значения и случайные
+QVector<double> diameterQueries()
+{
+    QVector<double> queries = { 0.0, 50.0, 101.9, 1420.1, 2000.0 };
+    for (const Sortament::PipeSize& s : Sortament::kPipeSizes) {
+        queries << s.outerDiameter << s.outerDiameter - 0.1 << s.outerDiameter + 0.1;
+    }
+    std::mt19937_64 rng(400);
+    for (int i = 0; i < 1000; ++i) {
+        queries << uniform(rng, 90.0, 1500.0);
+    }
+    return queries;
+}
+
+QVector<double> thicknessQueries()
+{
+    QVector<double> queries = { 0.0, 0.5, 32.5, 40.0 };
+    for (double t : Sortament::kWallSeries) {
+        queries << t << t - 0.05 << t + 0.05;
+    }
+    return queries;
+}
+
+} // namespace
+
+void SortamentTest::diameterLookupMatchesLinearScan()
+{
+    for (double d : diameterQueries()) {
+        const Sortament::PipeSize* expected = nullptr;
+        for (const Sortament::PipeSize& s : Sortament::kPipeSizes) {
+            if (s.outerDiameter == d) {
+                expected = &s;
+            }
+        }
+        QVERIFY2(Sortament::findDiameter(d) == expected, qPrintable(QString::number(d)));
+        QCOMPARE(Sortament::isStandardDiameter(d), expected != nullptr);
+    }
+}
+
+void SortamentTest::thicknessLookupMatchesLinearScan()
+{
+    for (double t : thicknessQueries()) {
+        double expected = 0.0;
+        for (double w : Sortament::kWallSeries) {
+            if (w >= t) {
+                expected = w;
+                break;
+            }
+        }
+        QCOMPARE(Sortament::nextSeriesThickness(t), expected);
+
+        for (const Sortament::PipeSize& s : Sortament::kPipeSizes) {
+            double standard = 0.0;
+            for (int i = 0; i < s.thicknessCount(); ++i) {
+                if (s.thickness(i) >= t) {
+                    standard = s.thickness(i);
+                    break;
+                }
+            }
+            QCOMPARE(Sortament::nextStandardThickness(s.outerDiameter, t), standard);
+        }
+        QCOMPARE(Sortament::nextStandardThickness(531.0, t), 0.0);
+    }
+}
+
+void SortamentTest::rangeMatchesLinearScan()
+{
+    const QVector<double> bounds = diameterQueries();
+    for (int i = 0; i + 1 < bounds.size(); i += 7) {
+        const double from = qMin(bounds[i], bounds[i + 1]);
+        const double to = qMax(bounds[i], bounds[i + 1]);
+        QVector<double> expected;
+        for (const Sortament::PipeSize& s : Sortament::kPipeSizes) {
+            if (s.outerDiameter >= from && s.outerDiameter <= to) {
+                expected << s.outerDiameter;
+            }
+        }
+        QVector<double> actual;
+        for (const Sortament::PipeSize& s : Sortament::diametersInRange(from, to)) {
+            actual << s.outerDiameter;
+        }
+        QCOMPARE(actual, expected);
+    }
+}
+
+void SortamentTest::catalogDiameters()
+{
+    // Значение "catalog" - стандартные диаметры 100-1400 мм по возрастанию
+    QVector<double> diameters;
+    setCatalogDiameters(diameters);
+    QVERIFY(!diameters.isEmpty());
+    QCOMPARE(diameters.first(), 102.0);
+    QCOMPARE(diameters.last(), 1220.0);
+    for (int i = 0; i < diameters.size(); ++i) {
+        QVERIFY(Sortament::isStandardDiameter(diameters[i]));
+        QVERIFY(i == 0 || diameters[i - 1] < diameters[i]);
+    }
+    validateOuterDiameters(diameters);
+}
+
+QTEST_APPLESS_MAIN(SortamentTest)
+
+#include "tst_sortament.moc"
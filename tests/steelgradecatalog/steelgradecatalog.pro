@@ -0,0 +1,8 @@
+# Подбор марки стали по цене (steelgradecatalog.h)
+TARGET = tst_steelgradecatalog
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_steelgradecatalog.cpp
@@ -0,0 +1,117 @@
+#include "pipelineoptimizer.h"
+#include "steelgradecatalog.h"
+#include "testsupport.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <stdexcept>
+
+// Подбор самой дешевой марки стали (SteelGradeCatalog) против перебора всех марок
+class SteelGradeCatalogTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void steelGradeMatchesExhaustiveSearch();
+    void dominatedGradesArePruned();
+    void fromFileParsesAndReportsLine();
+};
+
+void SteelGradeCatalogTest::steelGradeMatchesExhaustiveSearch()
+{
+    std::mt19937_64 rng(120);
+    for (int n = 0; n < 30; ++n) {
+        QVector<SteelGrade> list;
+        for (int g = 0; g < 12; ++g) {
+            SteelGrade grade;
+            grade.name = QString("Марка %1").arg(g);
+            grade.yieldStrength = uniform(rng, 200.0, 700.0);
+            grade.tensileStrength = uniform(rng, 300.0, 900.0);
+            grade.price = std::round(uniform(rng, 10.0, 100.0));
+            list.append(grade);
+        }
+        const SteelGradeCatalog catalog = SteelGradeCatalog::fromList(list);
+
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 20);
+        for (const PipeSection& s : designedSections(params)) {
+            // Перебор всех марок (включая отброшенные как доминируемые)
+            double cheapest = -1.0;
+            for (const SteelGrade& grade : list) {
+                params.yieldStrength = grade.yieldStrength;
+                params.tensileStrength = grade.tensileStrength;
+                const DesignResistance r = DesignResistance::fromParameters(params);
+                if (PipelineOptimizer::checkThickness(params, r, s.outerDiameter, s.thickness).passes() &&
+                    (cheapest < 0.0 || grade.price < cheapest)) {
+                    cheapest = grade.price;
+                }
+            }
+
+            const GradeSelection selection = catalog.select(params, s.outerDiameter, s.thickness);
+            if (cheapest < 0.0) {
+                QCOMPARE(selection.grade, -1);
+            } else {
+                QVERIFY(selection.grade >= 0);
+                QCOMPARE(catalog.grades()[selection.grade].price, cheapest);
+            }
+        }
+    }
+}
+
+void SteelGradeCatalogTest::dominatedGradesArePruned()
+{
+    // Дороже и не прочнее другой марки - отбрасывается; при равной цене
+    // остается более прочная
+    QVector<SteelGrade> list(4);
+    list[0] = { "А", 300.0, 450.0, 10.0 };
+    list[1] = { "Б", 290.0, 440.0, 12.0 };  // Доминируется А
+    list[2] = { "В", 350.0, 500.0, 10.0 };  // При той же цене прочнее А
+    list[3] = { "Г", 400.0, 480.0, 15.0 };
+    const SteelGradeCatalog catalog = SteelGradeCatalog::fromList(list);
+    QCOMPARE(catalog.prunedCount(), 2);
+    QCOMPARE(catalog.grades().size(), 2);
+    QCOMPARE(catalog.grades()[0].name, QString("В"));
+    QCOMPARE(catalog.grades()[1].name, QString("Г"));
+
+    list[3].price = -1.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, SteelGradeCatalog::fromList(list));
+}
+
+void SteelGradeCatalogTest::fromFileParsesAndReportsLine()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("grades.txt");
+    auto writeFile = [&](const QByteArray& content) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    };
+
+    writeFile("# Марка σ_т σ_п цена\n"
+              "К52 355; 510; 100\n"
+              "\n"
+              "К60\t480 590 130\n");
+    const SteelGradeCatalog catalog = SteelGradeCatalog::fromFile(path);
+    QCOMPARE(catalog.grades().size(), 2);
+    QCOMPARE(catalog.grades()[0].name, QString("К52"));
+    QCOMPARE(catalog.grades()[1].yieldStrength, 480.0);
+
+    const QByteArray invalid[] = { "К52 355 510 100\nК60 480 590\n", "К52 355 510 100\nК60 480 590 x\n",
+                                   "К52 355 510 100\nК60 0 590 130\n" };
+    for (const QByteArray& content : invalid) {
+        writeFile(content);
+        try {
+            SteelGradeCatalog::fromFile(path);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error,
+                             SteelGradeCatalog::fromFile(QDir(dir.path()).filePath("missing.txt")));
+}
+
+QTEST_APPLESS_MAIN(SteelGradeCatalogTest)
+
+#include "tst_steelgradecatalog.moc"
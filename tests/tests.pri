@@ -0,0 +1,14 @@
+# Общие настройки тестов: исходники ядра берутся из корня проекта
+
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/.. $$PWD
+VPATH += $$PWD/..
+
+include(../solver.pri)
+
+HEADERS += \
+    $$PWD/testsupport.h
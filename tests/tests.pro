@@ -0,0 +1,30 @@
+# Автотесты расчетного ядра и расчетных модулей:
+#   qmake && make && make check
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    solver \
+    batchkernel \
+    parallelsweep \
+    scenarioreader \
+    resultcache \
+    incrementaloptimizer \
+    sortament \
+    thicknesscatalog \
+    continuousoptimizer \
+    paretofront \
+    frictionloss \
+    materialpolicy \
+    preparedplan \
+    flowwindow \
+    screening \
+    cli \
+    parametersweep \
+    reliabilityanalysis \
+    safetysensitivities \
+    pressurelimit \
+    steelgradecatalog \
+    routeoptimizer \
+    elevationprofile \
+    waterhammer \
+    thermalmodel
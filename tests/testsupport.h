@@ -0,0 +1,284 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include "materialpolicy.h"
+#include "parameterfields.h"
+#include "pipelinebatchkernel.h"
+#include "pipelineio.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparameters.h"
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal> // For M_PI
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// Общие функции тестов: случайные параметры, эталонный расчет и пакеты
+// для проверки векторных ядер
+
+// Набор свойств стали и среды, определяющий политику материала (materialpolicy.h)
+enum class TestMaterial {
+    Mode1,          // Типовые значения режима 1 - Mode1Material
+    PipelineSteel,  // E, μ, α трубной стали - SteelMaterial<PipelineSteel>
+    TypicalSteel,   // E, μ, α типовой стали - SteelMaterial<TypicalSteel>
+    Runtime,        // Произвольные свойства без изгиба - RuntimeMaterial
+    RuntimeBend     // Произвольные свойства с упругим изгибом (r > 0)
+};
+
+inline double uniform(std::mt19937_64& rng, double from, double to)
+{
+    return std::uniform_real_distribution<double>(from, to)(rng);
+}
+
+// Случайные параметры расчета с diameterCount диаметрами из 100-1400 мм
+inline PipelineParameters randomParameters(std::mt19937_64& rng, TestMaterial material, int diameterCount)
+{
+    PipelineParameters p;
+    p.mode = material == TestMaterial::Mode1 ? Mode::Mode1 : Mode::Mode2;
+    p.pressure = uniform(rng, 0.1, 20.0);
+    p.massFlow = uniform(rng, 1.0, 3000.0);
+    p.operationalFactor = uniform(rng, 0.5, 1.2);
+    p.reliabilityYield = uniform(rng, 0.9, 1.3);
+    p.reliabilityStrength = uniform(rng, 0.9, 1.3);
+    p.responsibilityFactor = uniform(rng, 0.9, 1.3);
+    p.pressureReliability = uniform(rng, 0.9, 1.3);
+    for (int i = 0; i < diameterCount; ++i) {
+        p.outerDiameters.append(std::round(uniform(rng, 100.0, 1400.0)));
+    }
+
+    setTypicalMode1Values(p);
+    if (material == TestMaterial::Mode1) {
+        return p;
+    }
+    p.density = uniform(rng, 700.0, 1000.0);
+    p.yieldStrength = uniform(rng, 200.0, 1000.0);
+    p.tensileStrength = uniform(rng, 200.0, 1000.0);
+    p.fluidBulkModulus = uniform(rng, 1000.0, 250000.0);
+    p.temperatureDelta = uniform(rng, -60.0, 60.0);
+    p.viscosity = uniform(rng, 1.0, 100.0);
+    switch (material) {
+    case TestMaterial::PipelineSteel:
+        p.steelYoungModulus = PipelineSteel::youngModulus;
+        p.poissonRatio = PipelineSteel::poissonRatio;
+        p.thermalExpansionCoeff = PipelineSteel::thermalExpansionCoeff;
+        break;
+    case TestMaterial::TypicalSteel:
+        break;  // Свойства стали уже заданы setTypicalMode1Values()
+    default:
+        p.steelYoungModulus = uniform(rng, 1000.0, 250000.0);
+        p.poissonRatio = uniform(rng, 0.2, 0.4);
+        p.thermalExpansionCoeff = uniform(rng, 1e-6, 20e-6);
+        p.bendRadius = material == TestMaterial::RuntimeBend ? uniform(rng, 1.0, 10000.0) : 0.0;
+        break;
+    }
+    return p;
+}
+
+// Участки из валидных результатов calculate(): диаметр и найденная толщина
+inline QVector<PipeSection> designedSections(const PipelineParameters& params)
+{
+    QVector<PipeSection> sections;
+    for (const ValidationResult& r : PipelineOptimizer().calculate(params)) {
+        if (r.isValid) {
+            PipeSection s;
+            s.outerDiameter = r.diameter;
+            s.thickness = r.finalThickness;
+            sections.append(s);
+        }
+    }
+    return sections;
+}
+
+// Сценарий в строке JSONL (ScenarioReader), значения без потери точности
+inline QByteArray scenarioToJsonLine(const PipelineParameters& p)
+{
+    QByteArray line = "{\"mode\":\"";
+    line += p.mode == Mode::Mode2 ? "Mode2" : "Mode1";
+    line += "\"";
+    for (const ParameterField& f : parameterFields()) {
+        line += ",\"";
+        line += f.name;
+        line += "\":";
+        line += QByteArray::number(p.*f.field, 'g', 17);
+    }
+    line += ",\"outerDiameters\":[";
+    for (int i = 0; i < p.outerDiameters.size(); ++i) {
+        line += i ? "," : "";
+        line += QByteArray::number(p.outerDiameters[i], 'g', 17);
+    }
+    line += "]}\n";
+    return line;
+}
+
+// Исходный расчет: толщина стенки перебирается с шагом 1 мм от δ_0 по
+// формуле 9 без пакетного расчета, бисекции и отбраковки. С ним сравниваются
+// результаты PipelineOptimizer::calculate() и PreparedPlan.
+inline QVector<ValidationResult> referenceCalculate(const PipelineParameters& params)
+{
+    QVector<ValidationResult> results;
+    const double R1 = (params.operationalFactor * params.yieldStrength) /
+                      (params.reliabilityYield * params.responsibilityFactor);
+    const double R2 = (params.operationalFactor * params.tensileStrength) /
+                      (params.reliabilityStrength * params.responsibilityFactor);
+    const double allowEquiv = 0.9 * params.yieldStrength;
+
+    for (double Di : params.outerDiameters) {
+        ValidationResult res;
+        res.diameter = Di;
+        res.finalThickness = 0.0;
+        const double Di_m = Di / 1000.0;
+        if (Di_m <= 0 || params.massFlow <= 0 || params.density <= 0) {
+            results.append(res);
+            continue;
+        }
+
+        double delta = (params.pressureReliability * params.pressure * Di_m) / (2.0 * qMin(R1, R2));
+        while (delta > 0 && delta < Di_m / 2.0) {
+            const double di = Di_m - 2.0 * delta;
+            if (di <= 0) {
+                break;
+            }
+            const double theta = (4.0 * params.massFlow) / (params.density * M_PI * di * di);
+            if (!std::isfinite(theta)) {
+                break;
+            }
+            res.flowSpeed = theta;
+            res.satisfiesFlowSpeed = (theta >= 1.0 && theta <= 3.0);
+            if (!res.satisfiesFlowSpeed) {
+                results.append(res);
+                break;
+            }
+
+            const double waveSpeed = 1.0 / std::sqrt(params.density / params.fluidBulkModulus +
+                                                     di / (params.steelYoungModulus * delta));
+            const double surge = params.density * waveSpeed * theta / 1000000.0;
+            const double pressureAtSurge = params.pressure + surge;
+            const double hoop = (params.pressureReliability * pressureAtSurge * Di_m) / (2.0 * delta);
+            const double thermalTerm = -params.steelYoungModulus * params.thermalExpansionCoeff *
+                                       params.temperatureDelta;
+            const double bendTerm = params.bendRadius > 0
+                                        ? (params.steelYoungModulus * Di_m) / (2.0 * params.bendRadius)
+                                        : 0.0;
+            const double axialPlus = params.poissonRatio * hoop + thermalTerm + bendTerm;
+            const double axialMinus = params.poissonRatio * hoop + thermalTerm - bendTerm;
+            const double axial = std::abs(axialPlus) > std::abs(axialMinus) ? axialPlus : axialMinus;
+            const double equiv = std::sqrt(hoop * hoop - hoop * axial + axial * axial);
+            if (!std::isfinite(waveSpeed) || !std::isfinite(surge) || !std::isfinite(pressureAtSurge) ||
+                !std::isfinite(hoop) || !std::isfinite(axial) || !std::isfinite(equiv)) {
+                break;
+            }
+
+            res.satisfiesHoopStress = hoop <= R1;
+            res.satisfiesAxialStress = axial <= R2;
+            res.satisfiesEquivalentStress = equiv <= allowEquiv;
+            if (res.satisfiesHoopStress && res.satisfiesAxialStress && res.satisfiesEquivalentStress) {
+                res.safetyHoop = (hoop > 0.0) ? R1 / hoop : 0.0;
+                res.safetyAxial = (axial > 0.0) ? R2 / axial : 0.0;
+                res.safetyEquivalent = (equiv > 0.0) ? allowEquiv / equiv : 0.0;
+                res.finalThickness = delta;
+                res.isOptimal = true;
+                res.isValid = true;
+                results.append(res);
+                break;
+            }
+            delta += 0.001;
+        }
+    }
+
+    // Оптимальный - первый диаметр с наибольшим из минимальных запасов
+    auto minSafety = [](const ValidationResult& r) {
+        return std::min({r.safetyHoop, r.safetyAxial, r.safetyEquivalent});
+    };
+    const ValidationResult* best = nullptr;
+    for (const ValidationResult& r : results) {
+        if (r.isOptimal && (!best || minSafety(*best) < minSafety(r))) {
+            best = &r;
+        }
+    }
+    const double bestDiameter = best ? best->diameter : 0.0;
+    for (ValidationResult& r : results) {
+        r.isOptimal = best && qFuzzyCompare(r.diameter, bestDiameter);
+    }
+    return results;
+}
+
+// Описание первого расхождения результатов (пустая строка - совпадают бит в
+// бит). Толщина сравнивается только у валидных результатов: у остальных
+// calculate() ее не заполняет.
+inline QString compareResults(const QVector<ValidationResult>& actual,
+                              const QVector<ValidationResult>& expected)
+{
+    if (actual.size() != expected.size()) {
+        return QString("Результатов %1, ожидалось %2").arg(actual.size()).arg(expected.size());
+    }
+    for (int i = 0; i < actual.size(); ++i) {
+        const ValidationResult& a = actual[i];
+        const ValidationResult& e = expected[i];
+        const bool same = a.diameter == e.diameter && a.isValid == e.isValid &&
+                          (!e.isValid || a.finalThickness == e.finalThickness) &&
+                          a.satisfiesFlowSpeed == e.satisfiesFlowSpeed &&
+                          a.satisfiesHoopStress == e.satisfiesHoopStress &&
+                          a.satisfiesAxialStress == e.satisfiesAxialStress &&
+                          a.satisfiesEquivalentStress == e.satisfiesEquivalentStress &&
+                          a.safetyHoop == e.safetyHoop && a.safetyAxial == e.safetyAxial &&
+                          a.safetyEquivalent == e.safetyEquivalent && a.minSafery == e.minSafery &&
+                          a.isOptimal == e.isOptimal && a.flowSpeed == e.flowSpeed;
+        if (!same) {
+            return QString("Результат %1 (D = %2 мм): δ = %3 / %4, n_кц = %5 / %6, ϑ = %7 / %8, "
+                           "оптимальный %9 / %10")
+                .arg(i).arg(e.diameter)
+                .arg(a.finalThickness, 0, 'g', 17).arg(e.finalThickness, 0, 'g', 17)
+                .arg(a.safetyHoop, 0, 'g', 17).arg(e.safetyHoop, 0, 'g', 17)
+                .arg(a.flowSpeed, 0, 'g', 17).arg(e.flowSpeed, 0, 'g', 17)
+                .arg(int(a.isOptimal)).arg(int(e.isOptimal));
+        }
+    }
+    return QString();
+}
+
+// Пакет из count случайных труб: толщина около δ_0 (формула 9), чтобы
+// проверки прочности давали оба ответа
+inline void fillRandomBatch(std::mt19937_64& rng, const PipelineParameters& params,
+                            const DesignResistance& resistance, StressBatch& batch, int count)
+{
+    batch.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const double Di_m = std::round(uniform(rng, 100.0, 1400.0)) / 1000.0;
+        const double delta0 = params.pressureReliability * params.pressure * Di_m /
+                              (2.0 * qMin(resistance.R1, resistance.R2));
+        batch.outerDiameter[i] = Di_m;
+        batch.thickness[i] = delta0 * uniform(rng, 0.8, 1.2) + uniform(rng, 0.0, 0.005);
+    }
+}
+
+// Флаги дорожки, которые дал бы пакетный расчет для результата checkThickness()
+inline quint8 expectedLaneFlags(const ThicknessCheck& check)
+{
+    if (!check.isValid) {
+        return 0;
+    }
+    if (!check.satisfiesFlowSpeed) {
+        return LaneValid;
+    }
+    quint8 flags = LaneValid | LaneFlowSpeed;
+    if (check.satisfiesHoopStress) flags |= LaneHoopStress;
+    if (check.satisfiesAxialStress) flags |= LaneAxialStress;
+    if (check.satisfiesEquivalentStress) flags |= LaneEquivalentStress;
+    return flags;
+}
+
+// Наборы инструкций, доступные на этом процессоре (None - всегда)
+inline QVector<SimdIsa> availableIsas()
+{
+    QVector<SimdIsa> isas;
+    for (SimdIsa isa : { SimdIsa::None, SimdIsa::Sse2, SimdIsa::Avx2, SimdIsa::Avx512 }) {
+        if (int(isa) <= int(detectSimdIsa())) {
+            isas.append(isa);
+        }
+    }
+    return isas;
+}
+
+#endif // TESTSUPPORT_H
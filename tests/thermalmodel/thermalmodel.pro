@@ -0,0 +1,8 @@
+# Тепловой расчет трассы (thermalmodel.h) и табличные кривые свойств (propertyspline.h)
+TARGET = tst_thermalmodel
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_thermalmodel.cpp
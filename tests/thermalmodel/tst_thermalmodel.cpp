@@ -0,0 +1,302 @@
+#include "frictionloss.h"
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "propertyspline.h"
+#include "testsupport.h"
+#include "thermalmodel.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <cmath>
+#include <stdexcept>
+
+// Тепловой расчет: температура по формуле Шухова, свойства по табличным
+// кривым, проверка напряжений при местных ρ и Δt - как checkThickness()
+class ThermalModelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void temperatureFollowsShukhov();
+    void thermalChecksMatchCheckThickness();
+    void localStressBatchMatchesCheckThickness();
+    void splineIsMonotoneThroughNodes();
+    void readersParseAndReportLine();
+};
+
+namespace {
+
+bool sameCheck(const ThicknessCheck& a, const ThicknessCheck& b)
+{
+    return a.isValid == b.isValid && a.flowSpeed == b.flowSpeed && a.hoop == b.hoop &&
+           a.axial == b.axial && a.equivalent == b.equivalent &&
+           a.satisfiesFlowSpeed == b.satisfiesFlowSpeed && a.satisfiesHoopStress == b.satisfiesHoopStress &&
+           a.satisfiesAxialStress == b.satisfiesAxialStress &&
+           a.satisfiesEquivalentStress == b.satisfiesEquivalentStress;
+}
+
+double relativeError(double value, double expected)
+{
+    return std::abs(value - expected) / qMax(std::abs(expected), 1e-300);
+}
+
+void writeFile(const QString& path, const QByteArray& content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
+} // namespace
+
+void ThermalModelTest::temperatureFollowsShukhov()
+{
+    std::mt19937_64 rng(250);
+    for (int n = 0; n < 50; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(1 + n % 4), 0);
+        const double inlet = uniform(rng, 40.0, 90.0);
+        const double ground = uniform(rng, -5.0, 15.0);
+        const double heatCapacity = uniform(rng, 1700.0, 2300.0);
+        const double heatTransfer = uniform(rng, 0.5, 5.0);
+        const double D = std::round(uniform(rng, 200.0, 1200.0));
+        const double thickness = uniform(rng, 0.005, 0.02);
+
+        ThermalModel model(params, inlet);
+        model.setHeatCapacity(heatCapacity);
+        model.setHeatTransferCoefficient(heatTransfer);
+        const PropertySpline density({ 0.0, 40.0, 90.0 },
+                                     { params.density * 1.04, params.density, params.density * 0.97 });
+        const PropertySpline viscosity({ 0.0, 20.0, 50.0, 90.0 }, { 150.0, 60.0, 15.0, 5.0 });
+        model.setDensityCurve(density);
+        model.setViscosityCurve(viscosity);
+
+        // Постоянная температура грунта: участки складываются в одну трубу
+        QVector<ThermalSegment> route;
+        double length = 0.0;
+        for (int k = 0; k < 1 + n % 20; ++k) {
+            ThermalSegment segment;
+            segment.length = uniform(rng, 1000.0, 20000.0);
+            segment.groundTemperature = ground;
+            length += segment.length;
+            route.append(segment);
+        }
+        model.setRoute(route);
+        const ThermalProfile profile = model.run(D, thickness);
+
+        // T(L) = T_гр + (T_н - T_гр)·exp(-K·π·D·L / (G·c))
+        const double decay = heatTransfer * M_PI * (D / 1000.0) / (params.massFlow * heatCapacity);
+        const double expected = ground + (inlet - ground) * std::exp(-decay * length);
+        QVERIFY2(std::abs(profile.outletTemperature - expected) <= 1e-9 * inlet,
+                 qPrintable(QString("Вариант %1: %2 против %3").arg(n).arg(profile.outletTemperature).arg(expected)));
+        QCOMPARE(profile.temperature.size(), route.size() + 1);
+        QCOMPARE(profile.temperature.first(), inlet);
+        QCOMPARE(profile.temperature.last(), profile.outletTemperature);
+
+        // Свойства и Δt в точках, потери на участках - при средней температуре
+        double frictionLoss = 0.0;
+        PipelineParameters local = params;
+        for (int k = 0; k < route.size(); ++k) {
+            const double mean = profile.meanTemperature[k];
+            QVERIFY(mean < profile.temperature[k] && mean > profile.temperature[k + 1]);
+            local.density = density.value(mean);
+            local.viscosity = viscosity.value(mean);
+            const double loss = FrictionLossModel(local).evaluate(D, thickness).pressureLoss * route[k].length / 1000.0;
+            QCOMPARE(profile.pressureLoss[k], loss);
+            frictionLoss += loss;
+        }
+        QVERIFY(relativeError(profile.frictionLoss, frictionLoss) < 1e-12);
+        for (int i = 0; i < profile.temperature.size(); ++i) {
+            QCOMPARE(profile.density[i], density.value(profile.temperature[i]));
+            QCOMPARE(profile.temperatureDelta[i],
+                     params.temperatureDelta + (profile.temperature[i] - inlet));
+        }
+    }
+}
+
+void ThermalModelTest::thermalChecksMatchCheckThickness()
+{
+    // Проверка в каждой точке профиля - checkThickness() при местных ρ и Δt
+    std::mt19937_64 rng(150);
+    const PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 40);
+    const DesignResistance r = DesignResistance::fromParameters(params);
+    ThermalModel model(params, 60.0);
+    model.setDensityCurve(PropertySpline({ 0.0, 20.0, 50.0, 80.0 },
+                                         { params.density * 1.03, params.density, params.density * 0.98,
+                                           params.density * 0.96 }));
+    model.setViscosityCurve(PropertySpline({ 0.0, 30.0, 80.0 }, { 80.0, 20.0, 6.0 }));
+    QVector<ThermalSegment> route;
+    for (int k = 0; k < 37; ++k) {
+        ThermalSegment segment;
+        segment.length = uniform(rng, 500.0, 5000.0);
+        segment.groundTemperature = uniform(rng, -5.0, 15.0);
+        route.append(segment);
+    }
+    model.setRoute(route);
+
+    const QVector<PipeSection> sections = designedSections(params);
+    QVERIFY(!sections.isEmpty());
+    QVector<ThermalProfile> profiles;
+    model.setThreadCount(3);
+    model.run(sections, profiles);
+    QCOMPARE(profiles.size(), sections.size());
+
+    PipelineParameters local = params;
+    for (int s = 0; s < sections.size(); ++s) {
+        const ThermalProfile& profile = profiles[s];
+        QCOMPARE(profile.checks.size(), route.size() + 1);
+        QVERIFY(profile.temperature.last() < profile.temperature.first());
+        for (int i = 0; i < profile.checks.size(); ++i) {
+            local.density = profile.density[i];
+            local.temperatureDelta = profile.temperatureDelta[i];
+            const ThicknessCheck expected = PipelineOptimizer::checkThickness(
+                local, r, sections[s].outerDiameter, sections[s].thickness);
+            QVERIFY2(sameCheck(profile.checks[i], expected),
+                     qPrintable(QString("Участок %1, точка %2").arg(s).arg(i)));
+        }
+    }
+}
+
+void ThermalModelTest::localStressBatchMatchesCheckThickness()
+{
+    // Плотность и Δt каждой дорожки - как у точек профиля ThermalModel
+    std::mt19937_64 rng(80);
+    StressBatch batch;
+    QVector<double> density;
+    QVector<double> thermalTerm;
+    const SimdIsa isa = detectSimdIsa();
+    if (isa == SimdIsa::None) {
+        QSKIP("Векторные инструкции недоступны");
+    }
+    for (int n = 0; n < 200; ++n) {
+        const PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        const DesignResistance r = DesignResistance::fromParameters(params);
+        const StressConstants constants = StressConstants::fromParameters(params, r.R1, r.R2, r.allowEquiv);
+        fillRandomBatch(rng, params, r, batch, 1 + n % 50);
+
+        QVector<PipelineParameters> local(batch.size(), params);
+        density.fill(params.density, batch.paddedSize());
+        thermalTerm.fill(0.0, batch.paddedSize());
+        for (int i = 0; i < batch.size(); ++i) {
+            local[i].density = params.density * uniform(rng, 0.9, 1.1);
+            local[i].temperatureDelta = params.temperatureDelta + uniform(rng, -30.0, 30.0);
+            density[i] = local[i].density;
+            thermalTerm[i] = -params.steelYoungModulus * params.thermalExpansionCoeff * local[i].temperatureDelta;
+        }
+        evaluateLocalStressBatch(constants, batch, density.constData(), thermalTerm.constData(),
+                                 0, batch.paddedSize(), isa);
+
+        for (int i = 0; i < batch.size(); ++i) {
+            const ThicknessCheck check = PipelineOptimizer::checkThickness(
+                local[i], r, batch.outerDiameter[i] * 1000.0, batch.thickness[i]);
+            QCOMPARE(batch.flags[i], expectedLaneFlags(check));
+            if (batch.flags[i] & LaneFlowSpeed) {
+                QVERIFY(batch.flowSpeed[i] == check.flowSpeed);
+                QVERIFY(batch.hoop[i] == check.hoop);
+                QVERIFY(batch.axial[i] == check.axial);
+                QVERIFY(batch.equivalent[i] == check.equivalent);
+            }
+        }
+    }
+}
+
+void ThermalModelTest::splineIsMonotoneThroughNodes()
+{
+    std::mt19937_64 rng(251);
+    for (int n = 0; n < 200; ++n) {
+        // Неравномерные узлы; значения монотонны (как вязкость) или с экстремумами
+        const int count = 2 + n % 12;
+        QVector<double> t(count);
+        QVector<double> y(count);
+        t[0] = uniform(rng, -20.0, 20.0);
+        y[0] = uniform(rng, 1.0, 100.0);
+        for (int k = 1; k < count; ++k) {
+            t[k] = t[k - 1] + uniform(rng, 0.1, 30.0);
+            y[k] = n % 2 ? y[k - 1] * uniform(rng, 0.3, 1.0) : uniform(rng, 1.0, 100.0);
+        }
+        const PropertySpline spline(t, y);
+        QCOMPARE(spline.temperatures(), t);
+
+        // Через узлы, постоянна вне таблицы
+        for (int k = 0; k < count; ++k) {
+            QVERIFY(relativeError(spline.value(t[k]), y[k]) < 1e-12);
+        }
+        QCOMPARE(spline.value(t.first() - 100.0), y.first());
+        QCOMPARE(spline.value(t.last() + 100.0), y.last());
+
+        // Между узлами - в пределах значений соседних узлов (нет ложных экстремумов)
+        QVector<double> samples;
+        for (int k = 0; k + 1 < count; ++k) {
+            for (int j = 1; j < 16; ++j) {
+                const double x = t[k] + (t[k + 1] - t[k]) * j / 16.0;
+                const double v = spline.value(x);
+                const double tolerance = 1e-12 * qMax(y[k], y[k + 1]);
+                QVERIFY2(v >= qMin(y[k], y[k + 1]) - tolerance && v <= qMax(y[k], y[k + 1]) + tolerance,
+                         qPrintable(QString("Вариант %1, интервал %2: %3").arg(n).arg(k).arg(v)));
+                samples.append(x);
+            }
+        }
+
+        // Пакетный расчет совпадает с поточечным
+        QVector<double> values(samples.size());
+        spline.evaluate(samples.constData(), values.data(), samples.size());
+        for (int i = 0; i < samples.size(); ++i) {
+            QCOMPARE(values[i], spline.value(samples[i]));
+        }
+    }
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PropertySpline({ 1.0 }, { 1.0 }));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PropertySpline({ 1.0, 2.0 }, { 1.0 }));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PropertySpline({ 1.0, 1.0 }, { 1.0, 2.0 }));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PropertySpline({ 1.0, 2.0 }, { 1.0, std::nan("") }));
+}
+
+void ThermalModelTest::readersParseAndReportLine()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("table.txt");
+
+    writeFile(path, "# длина температура грунта\n12000 5\n\n8000;-2.5\n");
+    const QVector<ThermalSegment> route = readThermalSegments(path);
+    QCOMPARE(route.size(), 2);
+    QCOMPARE(route[0].length, 12000.0);
+    QCOMPARE(route[0].groundTemperature, 5.0);
+    QCOMPARE(route[1].length, 8000.0);
+    QCOMPARE(route[1].groundTemperature, -2.5);
+
+    writeFile(path, "# температура вязкость\n0 120\n20, 45\n60 9.5\n");
+    const PropertySpline curve = PropertySpline::fromFile(path);
+    QCOMPARE(curve.temperatures(), QVector<double>({ 0.0, 20.0, 60.0 }));
+    QCOMPARE(curve.value(20.0), 45.0);
+
+    const QByteArray invalid[] = { "100 5\n100 x\n", "100 5\n100\n", "100 5\n0 5\n", "100 5\n100 5 1\n" };
+    for (const QByteArray& content : invalid) {
+        writeFile(path, content);
+        try {
+            readThermalSegments(path);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+    const QByteArray invalidCurves[] = { "0 5\n20 x\n", "0 5\n20\n", "0 5\n20 5 1\n" };
+    for (const QByteArray& content : invalidCurves) {
+        writeFile(path, content);
+        try {
+            PropertySpline::fromFile(path);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+    writeFile(path, "20 5\n0 6\n");
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, PropertySpline::fromFile(path));
+
+    const QString missing = QDir(dir.path()).filePath("missing.txt");
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, readThermalSegments(missing));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, PropertySpline::fromFile(missing));
+}
+
+QTEST_APPLESS_MAIN(ThermalModelTest)
+
+#include "tst_thermalmodel.moc"
@@ -0,0 +1,7 @@
+# Каталог допустимых толщин (thicknesscatalog.h) и выбор толщины из него
+TARGET = tst_thicknesscatalog
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_thicknesscatalog.cpp
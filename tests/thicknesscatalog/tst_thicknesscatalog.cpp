@@ -0,0 +1,173 @@
+#include "pipelineoptimizer.h"
+#include "testsupport.h"
+#include "thicknesscatalog.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <algorithm>
+#include <stdexcept>
+
+// Каталог толщин: построение, чтение из файла и выбор толщины в calculate()
+class ThicknessCatalogTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void fromMapSortsAndValidates();
+    void fromFileParsesAndReportsLine();
+    void selectionMatchesLinearScan();
+    void missingDiameterIsInvalid();
+};
+
+namespace {
+
+// Толщина (м), выбранная перебором всех толщин диаметра по порядку: первая
+// не тоньше δ_0, при которой расчет не отвергает толщину; 0 - если при ней
+// не выполнены условия (скорость потока, ошибка) или такой толщины нет
+double linearScanThickness(const PipelineParameters& params, const DesignResistance& r,
+                           const ThicknessCatalog& catalog, double D)
+{
+    const double delta0 = params.pressureReliability * params.pressure * (D / 1000.0) /
+                          (2.0 * qMin(r.R1, r.R2));
+    for (double t : catalog.thicknesses(D)) {
+        if (t < delta0) {
+            continue;
+        }
+        const ThicknessCheck check = PipelineOptimizer::checkThickness(params, r, D, t);
+        if (check.passes()) {
+            return t;
+        }
+        if (!check.isValid || !check.satisfiesFlowSpeed) {
+            return 0.0;
+        }
+    }
+    return 0.0;
+}
+
+} // namespace
+
+void ThicknessCatalogTest::fromMapSortsAndValidates()
+{
+    QMap<double, QVector<double>> map;
+    map[219.0] = { 8.0, 5.0, 6.0, 5.0 };
+    map[108.0] = { 4.0 };
+    const ThicknessCatalog catalog = ThicknessCatalog::fromMap(map);
+    QCOMPARE(catalog.diameters(), QVector<double>({ 108.0, 219.0 }));
+
+    const ThicknessCatalog::Thicknesses t = catalog.thicknesses(219.0);
+    QCOMPARE(t.count, 3);
+    QCOMPARE(t[0], 0.005);
+    QCOMPARE(t[1], 0.006);
+    QCOMPARE(t[2], 0.008);
+    QCOMPARE(t.lowerBound(0.0055), 1);
+    QCOMPARE(t.lowerBound(0.006), 1);
+    QCOMPARE(t.lowerBound(0.009), 3);
+    QVERIFY(catalog.thicknesses(220.0).isEmpty());
+
+    // Тот же каталог в другом порядке - тот же отпечаток
+    QMap<double, QVector<double>> reordered;
+    reordered[108.0] = { 4.0, 4.0 };
+    reordered[219.0] = { 6.0, 8.0, 5.0 };
+    QCOMPARE(ThicknessCatalog::fromMap(reordered).fingerprint(), catalog.fingerprint());
+
+    map[108.0] = { 54.0 };  // δ ≥ D/2
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ThicknessCatalog::fromMap(map));
+    map[108.0] = { 0.0 };
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, ThicknessCatalog::fromMap(map));
+}
+
+void ThicknessCatalogTest::fromFileParsesAndReportsLine()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = QDir(dir.path()).filePath("thicknesses.txt");
+    auto writeFile = [&](const QByteArray& content) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    };
+
+    writeFile("# D δ1 δ2 ...\n"
+              "219 6;5, 8\n"
+              "\n"
+              "108\t4 3.5\n"
+              "219 10\n");
+    const ThicknessCatalog catalog = ThicknessCatalog::fromFile(path);
+    QCOMPARE(catalog.diameters(), QVector<double>({ 108.0, 219.0 }));
+    QCOMPARE(catalog.thicknesses(108.0).count, 2);
+    QCOMPARE(catalog.thicknesses(219.0).count, 4);
+    QCOMPARE(catalog.thicknesses(219.0)[3], 0.01);
+
+    const QByteArray invalid[] = { "219 6\n108 x\n", "219 6\n108\n", "219 6\n108 60\n" };
+    for (const QByteArray& content : invalid) {
+        writeFile(content);
+        try {
+            ThicknessCatalog::fromFile(path);
+            QVERIFY2(false, content.constData());
+        } catch (const std::invalid_argument& e) {
+            QVERIFY2(QString(e.what()).contains("строка 2"), e.what());
+        }
+    }
+
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error,
+                             ThicknessCatalog::fromFile(QDir(dir.path()).filePath("missing.txt")));
+}
+
+void ThicknessCatalogTest::selectionMatchesLinearScan()
+{
+    const ThicknessCatalog& catalog = ThicknessCatalog::sortament();
+    std::mt19937_64 rng(140);
+    PipelineOptimizer optimizer;
+    optimizer.setThicknessCatalog(&catalog);
+    int valid = 0;
+    for (int n = 0; n < 100; ++n) {
+        PipelineParameters params = randomParameters(rng, TestMaterial(n % 5), 0);
+        params.outerDiameters = catalog.diameters();
+        const DesignResistance r = DesignResistance::fromParameters(params);
+
+        // Результаты - по диаметрам в порядке списка (пропущенные диаметры без записи)
+        const QVector<ValidationResult> results = optimizer.calculate(params);
+        int next = 0;
+        for (double D : params.outerDiameters) {
+            const double expected = linearScanThickness(params, r, catalog, D);
+            QCOMPARE(PipelineOptimizer::catalogThickness(params, r, catalog, D), expected);
+
+            const bool hasResult = next < results.size() && results[next].diameter == D;
+            if (expected > 0.0) {
+                QVERIFY2(hasResult && results[next].isValid,
+                         qPrintable(QString("Вариант %1, D = %2").arg(n).arg(D)));
+                QCOMPARE(results[next].finalThickness, expected);
+                ++valid;
+            } else {
+                QVERIFY2(!hasResult || !results[next].isValid,
+                         qPrintable(QString("Вариант %1, D = %2").arg(n).arg(D)));
+            }
+            next += hasResult ? 1 : 0;
+        }
+        QCOMPARE(next, results.size());
+    }
+    QVERIFY(valid > 200);
+}
+
+void ThicknessCatalogTest::missingDiameterIsInvalid()
+{
+    std::mt19937_64 rng(141);
+    PipelineParameters params = randomParameters(rng, TestMaterial::Runtime, 0);
+    const ThicknessCatalog& catalog = ThicknessCatalog::sortament();
+    const DesignResistance r = DesignResistance::fromParameters(params);
+    params.outerDiameters = { 101.5, 219.0, 1000.5 };
+
+    PipelineOptimizer optimizer;
+    optimizer.setThicknessCatalog(&catalog);
+    const QVector<ValidationResult> results = optimizer.calculate(params);
+    QVERIFY(results.size() >= 2);
+    QCOMPARE(results.first().diameter, 101.5);
+    QVERIFY(!results.first().isValid);
+    QCOMPARE(results.last().diameter, 1000.5);
+    QVERIFY(!results.last().isValid);
+    QCOMPARE(PipelineOptimizer::catalogThickness(params, r, catalog, 101.5), 0.0);
+}
+
+QTEST_APPLESS_MAIN(ThicknessCatalogTest)
+
+#include "tst_thicknesscatalog.moc"
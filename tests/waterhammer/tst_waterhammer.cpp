@@ -0,0 +1,176 @@
+#include "frictionloss.h"
+#include "testsupport.h"
+#include "waterhammer.h"
+#include <QtTest>
+#include <cmath>
+#include <stdexcept>
+
+// Гидроудар: метод характеристик против формулы Жуковского при мгновенном
+// закрытии, смягчение удара при медленном закрытии, независимость от числа
+// потоков
+class WaterHammerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void instantClosureMatchesJoukowsky();
+    void slowClosureReducesSurge();
+    void resultDoesNotDependOnThreads();
+    void invalidInputIsRejected();
+};
+
+namespace {
+
+// Случайная труба из валидных результатов calculate() и длина, на которой
+// потери на трение - от 1% до 30% давления в начале
+struct TestPipe {
+    PipelineParameters params;
+    PipeSection section;
+    double length = 0.0;
+};
+
+bool randomPipe(std::mt19937_64& rng, TestPipe& pipe)
+{
+    pipe.params = randomParameters(rng, TestMaterial::Runtime, 3);
+    const QVector<PipeSection> sections = designedSections(pipe.params);
+    if (sections.isEmpty()) {
+        return false;
+    }
+    pipe.section = sections[int(uniform(rng, 0.0, sections.size() - 0.5))];
+    const FrictionLoss loss =
+        FrictionLossModel(pipe.params).evaluate(pipe.section.outerDiameter, pipe.section.thickness);
+    pipe.length = uniform(rng, 0.01, 0.3) * pipe.params.pressure / loss.pressureLoss * 1000.0;
+    return true;
+}
+
+} // namespace
+
+void WaterHammerTest::instantClosureMatchesJoukowsky()
+{
+    std::mt19937_64 rng(240);
+    int pipes = 0;
+    for (int n = 0; n < 100; ++n) {
+        TestPipe pipe;
+        if (!randomPipe(rng, pipe)) {
+            continue;
+        }
+        ++pipes;
+        WaterHammerSimulator simulator(pipe.params);
+        simulator.setReachCount(200);
+        WaterHammerResult r = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+        const double pressure = pipe.params.pressure;
+        const double valve = r.valvePressure[0];
+
+        // Первый шаг после мгновенного закрытия: C+ из соседнего узла дает
+        // ровно Δp = ρcϑ (потери на участке до задвижки компенсируются
+        // перепадом установившегося потока)
+        QVERIFY2(std::abs(r.valvePressure[1] - valve - r.joukowskySurge) <= 1e-9 * (pressure + r.joukowskySurge),
+                 qPrintable(QString("Труба %1: скачок %2, Жуковский %3")
+                                .arg(n).arg(r.valvePressure[1] - valve, 0, 'g', 17)
+                                .arg(r.joukowskySurge, 0, 'g', 17)));
+
+        // До прихода отраженной волны (2L/c) давление у задвижки не ниже
+        // p_з + ρcϑ и выше его не больше, чем на потери на трение по трубе
+        // (дозарядка трубы)
+        simulator.setDuration(1.9 * pipe.length / r.waveSpeed);
+        r = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+        const double friction = pressure - valve;
+        const double tolerance = 1e-9 * (pressure + r.joukowskySurge);
+        for (int k = 1; k < r.valvePressure.size(); ++k) {
+            QVERIFY(r.valvePressure[k] >= valve + r.joukowskySurge - tolerance);
+            QVERIFY(r.valvePressure[k] <= valve + r.joukowskySurge + friction + tolerance);
+        }
+        QVERIFY(r.peakPressure >= valve + r.joukowskySurge - tolerance);
+        QVERIFY(r.peakPressure <= valve + r.joukowskySurge + friction + tolerance);
+        QCOMPARE(r.surge, r.peakPressure - pressure);
+
+        // σ_кц - по огибающей
+        QCOMPARE(r.hoop, pipe.params.pressureReliability * r.peakPressure * (pipe.section.outerDiameter / 1000.0) /
+                             (2.0 * pipe.section.thickness));
+    }
+    QVERIFY(pipes > 30);
+}
+
+void WaterHammerTest::slowClosureReducesSurge()
+{
+    std::mt19937_64 rng(241);
+    int pipes = 0;
+    for (int n = 0; n < 40; ++n) {
+        TestPipe pipe;
+        if (!randomPipe(rng, pipe)) {
+            continue;
+        }
+        ++pipes;
+        WaterHammerSimulator simulator(pipe.params);
+        simulator.setReachCount(100);
+        const WaterHammerResult instant =
+            simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+
+        // Закрытие за 20 пробегов волны туда и обратно: давление поднимается
+        // до статического p с превышением много меньше ρcϑ
+        const double roundTrip = 2.0 * pipe.length / instant.waveSpeed;
+        simulator.setValveCurve(WaterHammerSimulator::closureCurve(20.0 * roundTrip));
+        simulator.setDuration(30.0 * roundTrip);
+        const WaterHammerResult slow = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+        QVERIFY2(slow.surge < 0.5 * instant.joukowskySurge,
+                 qPrintable(QString("Труба %1: повышение %2, Жуковский %3")
+                                .arg(n).arg(slow.surge).arg(instant.joukowskySurge)));
+        QVERIFY(slow.peakPressure > pipe.params.pressure - 1e-9);
+    }
+    QVERIFY(pipes > 10);
+}
+
+void WaterHammerTest::resultDoesNotDependOnThreads()
+{
+    std::mt19937_64 rng(242);
+    TestPipe pipe;
+    while (!randomPipe(rng, pipe)) {
+    }
+    WaterHammerSimulator simulator(pipe.params);
+    simulator.setReachCount(40000);  // Больше двух блоков узлов
+    simulator.setDuration(0.0);
+    simulator.setValveCurve(WaterHammerSimulator::closureCurve(0.0));
+    const WaterHammerResult probe = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+    simulator.setDuration(700.0 * probe.timeStep);  // Несколько эпох
+
+    const WaterHammerResult single = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+    simulator.setThreadCount(4);
+    const WaterHammerResult parallel = simulator.run(pipe.section.outerDiameter, pipe.section.thickness, pipe.length);
+    QCOMPARE(parallel.steps, single.steps);
+    QVERIFY(parallel.maxPressure == single.maxPressure);
+    QVERIFY(parallel.minPressure == single.minPressure);
+    QVERIFY(parallel.valvePressure == single.valvePressure);
+    QCOMPARE(parallel.peakPressure, single.peakPressure);
+}
+
+void WaterHammerTest::invalidInputIsRejected()
+{
+    std::mt19937_64 rng(243);
+    TestPipe pipe;
+    while (!randomPipe(rng, pipe)) {
+    }
+    WaterHammerSimulator simulator(pipe.params);
+    const double D = pipe.section.outerDiameter;
+    const double t = pipe.section.thickness;
+
+    // Потери на трение больше давления: установившегося потока нет
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, simulator.run(D, t, 1000.0 * pipe.length));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, simulator.run(D, t, 0.0));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, simulator.run(D, D / 1000.0, pipe.length));
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, simulator.setValveCurve({}));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument,
+                             simulator.setValveCurve({ ValvePoint{ 1.0, 1.0 }, ValvePoint{ 0.5, 0.0 } }));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, simulator.setValveCurve({ ValvePoint{ 0.0, 1.5 } }));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, WaterHammerSimulator::closureCurve(-1.0));
+
+    PipelineParameters bad = pipe.params;
+    bad.pressure = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, WaterHammerSimulator{ bad });
+    bad = pipe.params;
+    bad.fluidBulkModulus = 0.0;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, WaterHammerSimulator{ bad });
+}
+
+QTEST_APPLESS_MAIN(WaterHammerTest)
+
+#include "tst_waterhammer.moc"
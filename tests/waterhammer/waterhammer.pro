@@ -0,0 +1,8 @@
+# Гидроудар методом характеристик (waterhammer.h)
+TARGET = tst_waterhammer
+
+include(../tests.pri)
+include(../../engines.pri)
+
+SOURCES += \
+    tst_waterhammer.cpp
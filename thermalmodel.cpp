@@ -0,0 +1,292 @@
+#include "thermalmodel.h"
+#include "frictionloss.h"
+#include "pipelinebatchkernel.h"
+#include "parameterfields.h"
+#include "pipelineio.h"
+#include "pipelineparallel.h"
+#include <QFile>
+#include <QtGlobal> // For M_PI
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Размер блока участков каталога при пакетном расчете
+const int kSectionBlock = 4;
+
+// Кривая свойства с положительными значениями в узлах (монотонный сплайн
+// между узлами не выходит за значения соседних узлов)
+void requirePositive(const PropertySpline& curve, const char* name)
+{
+    for (double t : curve.temperatures()) {
+        if (!(curve.value(t) > 0.0)) {
+            throw std::invalid_argument(QString("Кривая \"%1\": значения должны быть положительными.")
+                                            .arg(name).toStdString());
+        }
+    }
+}
+
+bool isFiniteStress(const StressBatch& batch, int i)
+{
+    return std::isfinite(batch.waveSpeed[i]) && std::isfinite(batch.pressureSurge[i]) &&
+           std::isfinite(batch.hoop[i]) && std::isfinite(batch.axial[i]) && std::isfinite(batch.equivalent[i]);
+}
+
+} // namespace
+
+// Рабочие массивы одного потока расчета
+struct ThermalModel::Workspace {
+    StressBatch batch;
+    QVector<double> density;      // ρ дорожек пакета
+    QVector<double> thermalTerm;  // -EαΔt дорожек пакета
+};
+
+QVector<ThermalSegment> readThermalSegments(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть трассу %1: %2")
+                                     .arg(path, file.errorString()).toStdString());
+    }
+    const QByteArray data = file.readAll();
+
+    QVector<ThermalSegment> segments;
+    TextTableReader table(data.constData(), data.size());
+    while (table.nextLine()) {
+        double numbers[2];
+        int count = 0;
+        const char* token;
+        const char* tokenEnd;
+        while (table.nextToken(token, tokenEnd)) {
+            if (count == 2 || !TextTableReader::toNumber(token, tokenEnd, numbers[count])) {
+                count = -1;
+                break;
+            }
+            ++count;
+        }
+        if (count == 0) {
+            continue;
+        }
+        ThermalSegment segment;
+        segment.length = numbers[0];
+        segment.groundTemperature = numbers[1];
+        if (count != 2 || !(segment.length > 0.0) || !std::isfinite(segment.length) ||
+            !std::isfinite(segment.groundTemperature)) {
+            throw std::invalid_argument(QString("Трасса, строка %1: ожидается \"ДЛИНА ТЕМПЕРАТУРА_ГРУНТА\" "
+                                                "с длиной > 0.")
+                                            .arg(table.lineNumber()).toStdString());
+        }
+        segments.append(segment);
+    }
+    return segments;
+}
+
+ThermalModel::ThermalModel(const PipelineParameters& params, double inletTemperature)
+    : m_params(params)
+    , m_inletTemperature(inletTemperature)
+    , m_heatCapacity(2000.0)
+    , m_heatTransfer(1.5)
+    , m_threadCount(1)
+    , m_resistance(DesignResistance::fromParameters(params))
+{
+    for (const ParameterField& f : parameterFields()) {
+        if (!std::isfinite(params.*f.field)) {
+            throw std::invalid_argument(
+                QString("Поле \"%1\" не является конечным числом.").arg(f.name).toStdString());
+        }
+    }
+    if (params.massFlow <= 0 || params.density <= 0 || params.viscosity <= 0) {
+        throw std::invalid_argument("Массовый расход, плотность и вязкость должны быть положительными.");
+    }
+    if (!std::isfinite(inletTemperature)) {
+        throw std::invalid_argument("Температура в начале трассы не является конечным числом.");
+    }
+}
+
+void ThermalModel::setDensityCurve(const PropertySpline& curve)
+{
+    requirePositive(curve, "плотность");
+    m_density = curve;
+}
+
+void ThermalModel::setViscosityCurve(const PropertySpline& curve)
+{
+    requirePositive(curve, "вязкость");
+    m_viscosity = curve;
+}
+
+void ThermalModel::setHeatCapacity(double heatCapacity)
+{
+    if (!(heatCapacity > 0.0) || !std::isfinite(heatCapacity)) {
+        throw std::invalid_argument("Теплоемкость должна быть положительной.");
+    }
+    m_heatCapacity = heatCapacity;
+}
+
+void ThermalModel::setHeatTransferCoefficient(double coefficient)
+{
+    if (!(coefficient >= 0.0) || !std::isfinite(coefficient)) {
+        throw std::invalid_argument("Коэффициент теплопередачи должен быть неотрицательным.");
+    }
+    m_heatTransfer = coefficient;
+}
+
+void ThermalModel::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+void ThermalModel::setRoute(const QVector<ThermalSegment>& segments)
+{
+    for (int i = 0; i < segments.size(); ++i) {
+        const ThermalSegment& s = segments[i];
+        if (!(s.length > 0.0) || !std::isfinite(s.length) || !std::isfinite(s.groundTemperature)) {
+            throw std::invalid_argument(QString("Участок трассы %1: недопустимые длина "
+                                                "или температура грунта.").arg(i + 1).toStdString());
+        }
+    }
+    m_segments = segments;
+}
+
+ThermalProfile ThermalModel::run(double outerDiameter, double thickness) const
+{
+    Workspace workspace;
+    return runSection(outerDiameter, thickness, workspace);
+}
+
+void ThermalModel::run(const QVector<PipeSection>& sections, QVector<ThermalProfile>& profiles) const
+{
+    const int count = sections.size();
+    profiles.resize(count);
+    const int blockCount = (count + kSectionBlock - 1) / kSectionBlock;
+
+    // Каждый участок записывает только свой результат
+    QVector<Workspace> workspaces(parallelWorkerCount(blockCount, m_threadCount));
+    Workspace* workerSpace = workspaces.data();
+    ThermalProfile* out = profiles.data();
+    parallelForBlocks(blockCount, m_threadCount, [&](qint64 block, int worker) {
+        const int end = qMin(int(block + 1) * kSectionBlock, count);
+        for (int i = int(block) * kSectionBlock; i < end; ++i) {
+            out[i] = runSection(sections[i].outerDiameter, sections[i].thickness, workerSpace[worker]);
+        }
+    });
+}
+
+ThermalProfile ThermalModel::runSection(double outerDiameter, double thickness, Workspace& workspace) const
+{
+    const double Di_m = outerDiameter / 1000.0;
+    if (!(thickness > 0.0) || !(Di_m - 2.0 * thickness > 0.0) || !std::isfinite(Di_m) || !std::isfinite(thickness)) {
+        throw std::invalid_argument("Недопустимые диаметр или толщина стенки трубы.");
+    }
+
+    const int n = m_segments.size();
+    const int points = n + 1;
+    ThermalProfile profile;
+    profile.temperature.resize(points);
+    profile.density.resize(points);
+    profile.temperatureDelta.resize(points);
+    profile.checks.resize(points);
+    profile.meanTemperature.resize(n);
+    profile.pressureLoss.resize(n);
+
+    // === ТЕМПЕРАТУРА (ШУХОВ) ===
+
+    // Показатель на метр трассы: K·π·D / (G·c)
+    const double decay = m_heatTransfer * M_PI * Di_m / (m_params.massFlow * m_heatCapacity);
+    double temperature = m_inletTemperature;
+    profile.temperature[0] = temperature;
+    for (int k = 0; k < n; ++k) {
+        const double ground = m_segments[k].groundTemperature;
+        const double exponent = decay * m_segments[k].length;
+        const double excess = temperature - ground;
+        // Средняя по длине участка: T_гр + (T - T_гр)·(1 - e^(-ax)) / (ax)
+        profile.meanTemperature[k] = exponent > 0.0 ? ground - excess * std::expm1(-exponent) / exponent
+                                                    : temperature;
+        temperature = ground + excess * std::exp(-exponent);
+        profile.temperature[k + 1] = temperature;
+    }
+    profile.outletTemperature = temperature;
+
+    // === СВОЙСТВА СРЕДЫ И ПОТЕРИ НА ТРЕНИЕ ===
+
+    if (m_density.isEmpty()) {
+        profile.density.fill(m_params.density);
+    } else {
+        m_density.evaluate(profile.temperature.constData(), profile.density.data(), points);
+    }
+    for (int i = 0; i < points; ++i) {
+        profile.temperatureDelta[i] = m_params.temperatureDelta + (profile.temperature[i] - m_inletTemperature);
+    }
+
+    PipelineParameters local = m_params;
+    for (int k = 0; k < n; ++k) {
+        const double mean = profile.meanTemperature[k];
+        local.density = m_density.isEmpty() ? m_params.density : m_density.value(mean);
+        local.viscosity = m_viscosity.isEmpty() ? m_params.viscosity : m_viscosity.value(mean);
+        const FrictionLoss loss = FrictionLossModel(local).evaluate(outerDiameter, thickness);
+        profile.pressureLoss[k] = loss.pressureLoss * m_segments[k].length / 1000.0;
+        profile.frictionLoss += profile.pressureLoss[k];
+    }
+
+    // === НАПРЯЖЕНИЯ ПРИ МЕСТНЫХ ρ И Δt ===
+
+    const SimdIsa isa = detectSimdIsa();
+    if (isa != SimdIsa::None) {
+        StressBatch& batch = workspace.batch;
+        batch.resize(points);
+        const int padded = batch.paddedSize();
+        workspace.density.fill(m_params.density, padded);
+        workspace.thermalTerm.fill(0.0, padded);
+        for (int i = 0; i < points; ++i) {
+            batch.outerDiameter[i] = Di_m;
+            batch.thickness[i] = thickness;
+            workspace.density[i] = profile.density[i];
+            // -EαΔt - в том же порядке, что и в RuntimeMaterial
+            workspace.thermalTerm[i] = -m_params.steelYoungModulus * m_params.thermalExpansionCoeff *
+                                       profile.temperatureDelta[i];
+        }
+        const StressConstants constants = StressConstants::fromParameters(
+            m_params, m_resistance.R1, m_resistance.R2, m_resistance.allowEquiv);
+        evaluateLocalStressBatch(constants, batch, workspace.density.constData(),
+                                 workspace.thermalTerm.constData(), 0, padded, isa);
+
+        // Как в checkThickness(): при скорости потока вне 1-3 м/с напряжения
+        // тоже проверяются
+        for (int i = 0; i < points; ++i) {
+            const quint8 flags = batch.flags[i];
+            if (!(flags & LaneValid) || !isFiniteStress(batch, i)) {
+                continue;
+            }
+            ThicknessCheck& check = profile.checks[i];
+            check.isValid = true;
+            check.flowSpeed = batch.flowSpeed[i];
+            check.hoop = batch.hoop[i];
+            check.axial = batch.axial[i];
+            check.equivalent = batch.equivalent[i];
+            check.satisfiesFlowSpeed = (flags & LaneFlowSpeed) != 0;
+            check.satisfiesHoopStress = check.hoop <= m_resistance.R1;
+            check.satisfiesAxialStress = check.axial <= m_resistance.R2;
+            check.satisfiesEquivalentStress = check.equivalent <= m_resistance.allowEquiv;
+        }
+    } else {
+        for (int i = 0; i < points; ++i) {
+            local.density = profile.density[i];
+            local.temperatureDelta = profile.temperatureDelta[i];
+            profile.checks[i] = PipelineOptimizer::checkThickness(local, m_resistance, outerDiameter, thickness);
+        }
+    }
+
+    double chainage = 0.0;
+    for (int i = 0; i < points; ++i) {
+        if (!profile.checks[i].passes()) {
+            if (profile.failedPoints == 0) {
+                profile.firstFailureChainage = chainage;
+            }
+            ++profile.failedPoints;
+        }
+        if (i < n) {
+            chainage += m_segments[i].length;
+        }
+    }
+    return profile;
+}
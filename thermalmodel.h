@@ -0,0 +1,109 @@
+#ifndef THERMALMODEL_H
+#define THERMALMODEL_H
+
+#include "pipelineoptimizer.h"
+#include "pipelineparameters.h"
+#include "propertyspline.h"
+#include <QString>
+#include <QVector>
+
+// Участок трассы для теплового расчета
+struct ThermalSegment {
+    double length = 0.0;             // Длина участка, м
+    double groundTemperature = 0.0;  // Температура окружающей среды (грунта), °C
+};
+
+// Участки трассы из текстового файла: строка "ДЛИНА ТЕМПЕРАТУРА_ГРУНТА" (м, °C;
+// разделители - пробелы, ',' или ';'), пустые строки и строки с '#'
+// пропускаются. Ошибка чтения - std::runtime_error, ошибка в данных (не
+// число, длина ≤ 0) - std::invalid_argument с номером строки.
+QVector<ThermalSegment> readThermalSegments(const QString& path);
+
+// Температура, свойства среды и проверка напряжений вдоль трассы.
+// Точки - начала участков и конец трассы (n + 1 точка для n участков).
+struct ThermalProfile {
+    QVector<double> temperature;       // T, °C
+    QVector<double> density;           // ρ(T), кг/м³
+    QVector<double> temperatureDelta;  // Местный Δt, °C
+    QVector<ThicknessCheck> checks;    // Проверка по условиям calculate() при местных ρ и Δt
+
+    QVector<double> meanTemperature;   // Средняя температура участка, °C
+    QVector<double> pressureLoss;      // Потери на трение на участке, МПа
+
+    double outletTemperature = 0.0;    // Температура в конце трассы, °C
+    double frictionLoss = 0.0;         // Потери на трение по всей трассе, МПа
+    int failedPoints = 0;              // Точек, не прошедших проверку
+    double firstFailureChainage = -1.0; // Пикет первой такой точки, м (-1 - нет)
+
+    bool passes() const { return failedPoints == 0; }
+};
+
+// Тепловой расчет трубопровода с подогретой нефтью по формуле Шухова
+//     T(x) = T_гр + (T_н - T_гр)·exp(-K·π·D·x / (G·c)),
+// где K - полный коэффициент теплопередачи от нефти в грунт, c -
+// теплоемкость нефти. Формула применяется последовательно к участкам со своей
+// температурой грунта; теплота трения не учитывается.
+//
+// Плотность и вязкость берутся по температуре из табличных кривых
+// (PropertySpline; пустая кривая - постоянное значение из параметров).
+// Потери на трение участка (FrictionLossModel) считаются по свойствам при
+// средней температуре участка, а напряжения в каждой точке - по местным
+// плотности и температурному перепаду
+//     Δt(x) = Δt + (T(x) - T_н),
+// т.е. Δt параметров относится к началу трассы. Давление и радиус изгиба -
+// из параметров.
+//
+// Температуры - одна рекуррентная формула на участок, а проверка напряжений
+// во всех точках - один векторный пакетный расчет (evaluateLocalStressBatch())
+// с плотностью и Δt своими для каждой дорожки; результаты побитово совпадают с
+// PipelineOptimizer::checkThickness(). Поэтому расчет одного диаметра дешев, и
+// его можно выполнять для всего каталога (пакетный run(), параллельно).
+class ThermalModel {
+public:
+    // Проверка параметров: нечисловые значения, G ≤ 0, ρ ≤ 0, ν ≤ 0 или
+    // нечисловая температура в начале трассы inletTemperature (°C) -
+    // std::invalid_argument
+    ThermalModel(const PipelineParameters& params, double inletTemperature);
+
+    // ρ(T), кг/м³ и ν(T), мм²/с. Значения кривой должны быть положительными
+    // (иначе std::invalid_argument)
+    void setDensityCurve(const PropertySpline& curve);
+    void setViscosityCurve(const PropertySpline& curve);
+
+    // Теплоемкость нефти c, Дж/(кг·°C) (по умолчанию 2000)
+    void setHeatCapacity(double heatCapacity);
+
+    // Полный коэффициент теплопередачи K, Вт/(м²·°C) (по умолчанию 1.5)
+    void setHeatTransferCoefficient(double coefficient);
+
+    // Количество потоков пакетного расчета, см. parallelForBlocks() (по умолчанию 1)
+    void setThreadCount(int count);
+
+    // Участки трассы. Длина ≤ 0 или нечисловые данные - std::invalid_argument
+    void setRoute(const QVector<ThermalSegment>& segments);
+
+    // Труба с наружным диаметром outerDiameter (мм) и толщиной стенки
+    // thickness (м). Недопустимые размеры - std::invalid_argument
+    ThermalProfile run(double outerDiameter, double thickness) const;
+
+    // Пакетный расчет по участкам каталога; результат каждого не зависит от
+    // числа потоков
+    void run(const QVector<PipeSection>& sections, QVector<ThermalProfile>& profiles) const;
+
+private:
+    struct Workspace;
+
+    ThermalProfile runSection(double outerDiameter, double thickness, Workspace& workspace) const;
+
+    PipelineParameters m_params;
+    double m_inletTemperature;
+    PropertySpline m_density;
+    PropertySpline m_viscosity;
+    double m_heatCapacity;
+    double m_heatTransfer;
+    int m_threadCount;
+    QVector<ThermalSegment> m_segments;
+    DesignResistance m_resistance;
+};
+
+#endif // THERMALMODEL_H
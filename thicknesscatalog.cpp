@@ -0,0 +1,126 @@
+#include "thicknesscatalog.h"
+#include "pipelineio.h"
+#include "sortament.h"
+#include <QFile>
+#include <QCryptographicHash>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ThicknessCatalog ThicknessCatalog::fromSortament()
+{
+    // Только диаметры проверенного диапазона 100-1400 мм (как в
+    // validateOuterDiameters()); 1420 мм в каталог не входит
+    QMap<double, QVector<double>> thicknesses;
+    for (const Sortament::PipeSize& size : Sortament::diametersInRange(100.0, 1400.0)) {
+        QVector<double>& list = thicknesses[size.outerDiameter];
+        for (int i = 0; i < size.thicknessCount(); ++i) {
+            list.append(size.thickness(i));
+        }
+    }
+    return fromMap(thicknesses);
+}
+
+const ThicknessCatalog& ThicknessCatalog::sortament()
+{
+    static const ThicknessCatalog catalog = fromSortament();
+    return catalog;
+}
+
+ThicknessCatalog ThicknessCatalog::fromFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Не удалось открыть каталог толщин %1: %2")
+                                     .arg(path, file.errorString()).toStdString());
+    }
+    const QByteArray data = file.readAll();
+
+    QMap<double, QVector<double>> thicknesses;
+    TextTableReader table(data.constData(), data.size());
+    while (table.nextLine()) {
+        // Числа строки: первое - диаметр, остальные - толщины
+        QVector<double> numbers;
+        const char* token;
+        const char* tokenEnd;
+        while (table.nextToken(token, tokenEnd)) {
+            double value = 0.0;
+            if (!TextTableReader::toNumber(token, tokenEnd, value)) {
+                throw std::invalid_argument(QString("Каталог толщин, строка %1: ожидается число.")
+                                                .arg(table.lineNumber()).toStdString());
+            }
+            numbers.append(value);
+        }
+
+        if (!numbers.isEmpty()) {
+            const double diameter = numbers.takeFirst();
+            try {
+                if (numbers.isEmpty()) {
+                    throw std::invalid_argument("после диаметра нет толщин.");
+                }
+                checkThicknesses(diameter, numbers);
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument(QString("Каталог толщин, строка %1: %2")
+                                                .arg(table.lineNumber()).arg(e.what()).toStdString());
+            }
+            thicknesses[diameter] += numbers;
+        }
+    }
+    return fromMap(thicknesses);
+}
+
+void ThicknessCatalog::checkThicknesses(double outerDiameter, const QVector<double>& thicknesses)
+{
+    if (!(outerDiameter > 0.0) || !std::isfinite(outerDiameter)) {
+        throw std::invalid_argument(QString("Недопустимый диаметр %1 мм.").arg(outerDiameter).toStdString());
+    }
+    for (double t : thicknesses) {
+        if (!(t > 0.0 && 2.0 * t < outerDiameter)) {
+            throw std::invalid_argument(QString("Толщина %1 мм недопустима для диаметра %2 мм.")
+                                            .arg(t).arg(outerDiameter).toStdString());
+        }
+    }
+}
+
+ThicknessCatalog ThicknessCatalog::fromMap(const QMap<double, QVector<double>>& thicknesses)
+{
+    // Плоские массивы строятся один раз; QMap уже упорядочен по диаметру
+    ThicknessCatalog catalog;
+    catalog.m_diameters.reserve(thicknesses.size());
+    catalog.m_offsets.reserve(thicknesses.size() + 1);
+    for (auto it = thicknesses.constBegin(); it != thicknesses.constEnd(); ++it) {
+        checkThicknesses(it.key(), it.value());
+        QVector<double> sorted = it.value();
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        catalog.m_diameters.append(it.key());
+        catalog.m_offsets.append(catalog.m_thicknesses.size());
+        for (double t : sorted) {
+            catalog.m_thicknesses.append(t / 1000.0);
+        }
+    }
+    catalog.m_offsets.append(catalog.m_thicknesses.size());
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(catalog.m_diameters.constData()),
+                                         int(catalog.m_diameters.size() * sizeof(double))));
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(catalog.m_offsets.constData()),
+                                         int(catalog.m_offsets.size() * sizeof(int))));
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(catalog.m_thicknesses.constData()),
+                                         int(catalog.m_thicknesses.size() * sizeof(double))));
+    catalog.m_fingerprint = hash.result();
+    return catalog;
+}
+
+ThicknessCatalog::Thicknesses ThicknessCatalog::thicknesses(double outerDiameter) const
+{
+    Thicknesses result;
+    const double* it = std::lower_bound(m_diameters.constBegin(), m_diameters.constEnd(), outerDiameter);
+    if (it != m_diameters.constEnd() && *it == outerDiameter) {
+        const int i = int(it - m_diameters.constBegin());
+        result.data = m_thicknesses.constData() + m_offsets[i];
+        result.count = m_offsets[i + 1] - m_offsets[i];
+    }
+    return result;
+}
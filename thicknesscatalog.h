@@ -0,0 +1,75 @@
+#ifndef THICKNESSCATALOG_H
+#define THICKNESSCATALOG_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+// Допустимые толщины стенок для каждого наружного диаметра.
+//
+// С каталогом PipelineOptimizer выбирает не толщину с шагом 1 мм, а
+// наименьшую толщину из списка диаметра, при которой выполнены все
+// условия, поэтому finalThickness - всегда выпускаемая толщина. Диаметры,
+// которых нет в каталоге, попадают в результаты невалидными (isValid = false).
+//
+// Каталог хранится в плоских массивах (диаметры по возрастанию, толщины
+// подряд по диаметрам) и после построения не изменяется, поэтому его можно
+// использовать из нескольких потоков.
+class ThicknessCatalog {
+public:
+    // Толщины одного диаметра, м (по возрастанию)
+    struct Thicknesses {
+        const double* data = nullptr;
+        int count = 0;
+
+        bool isEmpty() const { return count == 0; }
+        const double* begin() const { return data; }
+        const double* end() const { return data + count; }
+        double operator[](int i) const { return data[i]; }
+
+        // Индекс первой толщины не меньше thickness (м); count - такой нет
+        int lowerBound(double thickness) const {
+            return int(std::lower_bound(begin(), end(), thickness) - begin());
+        }
+    };
+
+    ThicknessCatalog() = default;
+
+    // Сортамент ГОСТ 10704-91 (sortament.h) в диапазоне диаметров 100-1400 мм
+    static ThicknessCatalog fromSortament();
+
+    // Общий экземпляр fromSortament(), строится при первом обращении
+    static const ThicknessCatalog& sortament();
+
+    // Текстовый файл: строка "D δ1 δ2 ..." (мм, разделители - пробелы, ',' или
+    // ';'), пустые строки и строки с '#' пропускаются. Ошибка чтения -
+    // std::runtime_error, ошибка в данных - std::invalid_argument с номером строки.
+    static ThicknessCatalog fromFile(const QString& path);
+
+    // Диаметр, мм → толщины, мм. Каждая толщина больше 0 и меньше D/2
+    // (иначе std::invalid_argument); порядок и повторы толщин не важны.
+    static ThicknessCatalog fromMap(const QMap<double, QVector<double>>& thicknesses);
+
+    // Толщины диаметра outerDiameter, мм (пусто, если диаметра нет в каталоге)
+    Thicknesses thicknesses(double outerDiameter) const;
+
+    // Диаметры каталога, мм (по возрастанию)
+    const QVector<double>& diameters() const { return m_diameters; }
+
+    bool isEmpty() const { return m_diameters.isEmpty(); }
+
+    // Отпечаток содержимого: входит в ключ ResultCache вместе с параметрами
+    const QByteArray& fingerprint() const { return m_fingerprint; }
+
+private:
+    static void checkThicknesses(double outerDiameter, const QVector<double>& thicknesses);
+
+    QVector<double> m_diameters;    // Диаметры, мм (по возрастанию)
+    QVector<int> m_offsets;         // Начало толщин диаметра в m_thicknesses (+ конец)
+    QVector<double> m_thicknesses;  // Толщины, м
+    QByteArray m_fingerprint;
+};
+
+#endif // THICKNESSCATALOG_H
@@ -0,0 +1,326 @@
+#include "waterhammer.h"
+#include "pipelinebatchkernel.h"
+#include "pipelineoptimizer.h"
+#include "pipelineparallel.h"
+#include <QtGlobal> // For M_PI
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Узлов в блоке при параллельном расчете
+const int kChunkNodes = 16384;
+
+// Шагов в эпохе при параллельном расчете (запас узлов блока с каждой стороны)
+const int kEpochSteps = 256;
+
+// C+ из узла i-1
+inline double plusCharacteristic(const CharacteristicConstants& c, const double* p, const double* v, int i)
+{
+    const double vA = v[i - 1];
+    return (p[i - 1] + c.impedance * vA) - c.friction * vA * std::abs(vA);
+}
+
+// C- из узла i+1
+inline double minusCharacteristic(const CharacteristicConstants& c, const double* p, const double* v, int i)
+{
+    const double vB = v[i + 1];
+    return (p[i + 1] - c.impedance * vB) + c.friction * vB * std::abs(vB);
+}
+
+inline void updateEnvelope(double pressure, double& high, double& low)
+{
+    high = pressure > high ? pressure : high;
+    low = low > pressure ? pressure : low;
+}
+
+// Рабочие массивы одного потока (узлы блока с запасом, два слоя по времени)
+struct ChunkBuffers {
+    QVector<double> p[2];
+    QVector<double> v[2];
+};
+
+} // namespace
+
+WaterHammerSimulator::WaterHammerSimulator(const PipelineParameters& params, double roughness)
+    : m_params(params)
+    , m_friction(params, roughness)
+    , m_valveCurve({ValvePoint{0.0, 0.0}})
+    , m_reachCount(1000)
+    , m_duration(300.0)
+    , m_threadCount(1)
+{
+    if (!(params.pressure > 0.0) || !std::isfinite(params.pressure)) {
+        throw std::invalid_argument("Давление в начале трубы должно быть положительным.");
+    }
+    if (!(params.fluidBulkModulus > 0.0) || !(params.steelYoungModulus > 0.0) ||
+        !std::isfinite(params.fluidBulkModulus) || !std::isfinite(params.steelYoungModulus)) {
+        throw std::invalid_argument("Модули упругости среды и стали должны быть положительными.");
+    }
+}
+
+void WaterHammerSimulator::setValveCurve(const QVector<ValvePoint>& curve)
+{
+    if (curve.isEmpty()) {
+        throw std::invalid_argument("Кривая закрытия задвижки не содержит точек.");
+    }
+    for (int i = 0; i < curve.size(); ++i) {
+        const ValvePoint& point = curve[i];
+        if (!std::isfinite(point.time) || !(point.opening >= 0.0 && point.opening <= 1.0) ||
+            (i > 0 && point.time < curve[i - 1].time)) {
+            throw std::invalid_argument(QString("Кривая закрытия задвижки, точка %1: время убывает "
+                                                "или открытие вне [0, 1].").arg(i + 1).toStdString());
+        }
+    }
+    m_valveCurve = curve;
+}
+
+QVector<ValvePoint> WaterHammerSimulator::closureCurve(double closureTime, double exponent, int points)
+{
+    if (!(closureTime >= 0.0) || !std::isfinite(closureTime) || !(exponent > 0.0) || !std::isfinite(exponent)) {
+        throw std::invalid_argument("Время закрытия должно быть неотрицательным, показатель - положительным.");
+    }
+    points = qMax(2, points);
+    QVector<ValvePoint> curve(points);
+    for (int i = 0; i < points; ++i) {
+        const double fraction = double(i) / (points - 1);
+        curve[i].time = closureTime * fraction;
+        curve[i].opening = i + 1 < points ? std::pow(1.0 - fraction, exponent) : 0.0;
+    }
+    return curve;
+}
+
+void WaterHammerSimulator::setReachCount(int count)
+{
+    m_reachCount = qMax(2, count);
+}
+
+void WaterHammerSimulator::setDuration(double seconds)
+{
+    if (!(seconds >= 0.0) || !std::isfinite(seconds)) {
+        throw std::invalid_argument("Продолжительность расчета должна быть неотрицательной.");
+    }
+    m_duration = seconds;
+}
+
+void WaterHammerSimulator::setThreadCount(int count)
+{
+    m_threadCount = qMax(0, count);
+}
+
+double WaterHammerSimulator::openingAt(double time) const
+{
+    const auto after = std::upper_bound(m_valveCurve.begin(), m_valveCurve.end(), time,
+                                        [](double t, const ValvePoint& point) { return t < point.time; });
+    if (after == m_valveCurve.begin()) {
+        return after->opening;
+    }
+    if (after == m_valveCurve.end()) {
+        return m_valveCurve.last().opening;
+    }
+    const ValvePoint& a = *(after - 1);
+    const ValvePoint& b = *after;
+    return a.opening + (b.opening - a.opening) * (time - a.time) / (b.time - a.time);
+}
+
+WaterHammerResult WaterHammerSimulator::run(double outerDiameter, double thickness, double length) const
+{
+    if (!(length > 0.0) || !std::isfinite(length)) {
+        throw std::invalid_argument("Длина трубы должна быть положительной.");
+    }
+    const FrictionLoss friction = m_friction.evaluate(outerDiameter, thickness);
+    if (!friction.isValid) {
+        throw std::invalid_argument("Недопустимые диаметр или толщина стенки трубы.");
+    }
+
+    // === УСТАНОВИВШИЙСЯ ПОТОК ===
+
+    WaterHammerResult result;
+    const double Di_m = outerDiameter / 1000.0;
+    const double d = Di_m - 2.0 * thickness;
+    const double density = m_params.density;
+    const double bulkModulus = m_params.fluidBulkModulus * 1000000.0;
+
+    // c = √(E_0/ρ / (1 + E_0·d/(E·δ))) (формула 4 в единицах СИ; в calculate()
+    // E_0 и E в МПа, поэтому c там в 1000 раз меньше, см. waterhammer.h)
+    result.waveSpeed = std::sqrt(bulkModulus / density /
+                                 (1.0 + m_params.fluidBulkModulus * d / (m_params.steelYoungModulus * thickness)));
+    // ϑ = 4G / (ρ * π * d²) (формула 1)
+    result.flowSpeed = 4.0 * m_params.massFlow / (density * M_PI * d * d);
+    result.frictionFactor = friction.frictionFactor;
+    result.joukowskySurge = density * result.waveSpeed * result.flowSpeed / 1000000.0;
+
+    const int reaches = m_reachCount;
+    const int nodes = reaches + 1;
+    result.reach = length / reaches;
+    result.timeStep = result.reach / result.waveSpeed;
+    result.steps = int(std::ceil(m_duration / result.timeStep));
+
+    CharacteristicConstants c;
+    c.impedance = density * result.waveSpeed;
+    c.friction = density * result.frictionFactor * result.reach / (2.0 * d);
+    const SimdIsa isa = detectSimdIsa();
+    const double inletPressure = m_params.pressure * 1000000.0;  // Па
+
+    // Перепад на участке R·ϑ² = λ·Δx/d·ρϑ²/2 (Дарси - Вейсбах)
+    const double reachLoss = c.friction * result.flowSpeed * result.flowSpeed;
+    const double valvePressure = inletPressure - reaches * reachLoss;
+    if (!(valvePressure > 0.0)) {
+        throw std::invalid_argument("Потери на трение не меньше давления в начале трубы: "
+                                    "установившийся поток с таким расходом невозможен.");
+    }
+    // Задвижка: ϑ = τ·k·√p, k = ϑ₀/√p₀
+    const double valveCoefficient = result.flowSpeed / std::sqrt(valvePressure);
+
+    QVector<double> p(nodes);
+    QVector<double> v(nodes, result.flowSpeed);
+    for (int i = 0; i < nodes; ++i) {
+        p[i] = inletPressure - i * reachLoss;
+    }
+    QVector<double> pNext(nodes);
+    QVector<double> vNext(nodes);
+    QVector<double> pMax = p;
+    QVector<double> pMin = p;
+    QVector<double> valveHistory(result.steps + 1);
+    valveHistory[0] = p[nodes - 1];
+
+    // === ПЕРЕХОДНЫЙ ПРОЦЕСС ===
+
+    // Массивы отделяются до запуска потоков; слои p, v меняются местами между эпохами
+    double* high = pMax.data();
+    double* low = pMin.data();
+    double* history = valveHistory.data();
+    double* pIn = p.data();
+    double* vIn = v.data();
+    double* pOut = pNext.data();
+    double* vOut = vNext.data();
+
+    // Блок узлов [a, b) проходит шаги firstStep + 1 .. firstStep + count: узлы
+    // [lo, hi) копируются, и на каждом шаге достоверная часть сужается на узел
+    // с каждой стороны, не прилегающей к концу трубы
+    auto advanceChunk = [&](ChunkBuffers& buffers, int a, int b, int firstStep, int count) {
+        const int lo = qMax(0, a - count);
+        const int hi = qMin(nodes, b + count);
+        const int width = hi - lo;
+        for (int layer = 0; layer < 2; ++layer) {
+            buffers.p[layer].resize(width);
+            buffers.v[layer].resize(width);
+        }
+        std::copy(pIn + lo, pIn + hi, buffers.p[0].begin());
+        std::copy(vIn + lo, vIn + hi, buffers.v[0].begin());
+
+        int current = 0;
+        for (int s = 1; s <= count; ++s) {
+            // Локальные массивы начинаются с узла lo
+            const double* pc = buffers.p[current].constData();
+            const double* vc = buffers.v[current].constData();
+            double* pn = buffers.p[1 - current].data();
+            double* vn = buffers.v[1 - current].data();
+
+            const int l = lo > 0 ? lo + s : 0;
+            const int h = hi < nodes ? hi - s : nodes;
+            const int interiorBegin = qMax(l, 1);
+            const int interiorEnd = qMin(h, nodes - 1);
+            const int ownBegin = qBound(interiorBegin, a, interiorEnd);
+            const int ownEnd = qBound(ownBegin, b, interiorEnd);
+
+            // Огибающие обновляются только для своих узлов блока
+            advanceCharacteristics(c, pc + interiorBegin - lo, vc + interiorBegin - lo,
+                                   pn + interiorBegin - lo, vn + interiorBegin - lo,
+                                   nullptr, nullptr, ownBegin - interiorBegin, isa);
+            advanceCharacteristics(c, pc + ownBegin - lo, vc + ownBegin - lo,
+                                   pn + ownBegin - lo, vn + ownBegin - lo,
+                                   high + ownBegin, low + ownBegin, ownEnd - ownBegin, isa);
+            advanceCharacteristics(c, pc + ownEnd - lo, vc + ownEnd - lo,
+                                   pn + ownEnd - lo, vn + ownEnd - lo,
+                                   nullptr, nullptr, interiorEnd - ownEnd, isa);
+
+            // Резервуар (lo = 0): p = p_н, ϑ из C-
+            if (l == 0) {
+                pn[0] = inletPressure;
+                vn[0] = (inletPressure - minusCharacteristic(c, pc, vc, 0)) / c.impedance;
+                if (a == 0) {
+                    updateEnvelope(pn[0], high[0], low[0]);
+                }
+            }
+
+            // Задвижка (hi = nodes): из C+ и ϑ = τ·k·√p
+            //     p + B·τk·√p = C+ - квадратное уравнение относительно √p
+            if (h == nodes) {
+                const int last = nodes - 1 - lo;
+                const double cPlus = plusCharacteristic(c, pc, vc, last);
+                const double valve = c.impedance * openingAt((firstStep + s) * result.timeStep) * valveCoefficient;
+                if (cPlus > 0.0) {
+                    const double root = 2.0 * cPlus / (valve + std::sqrt(valve * valve + 4.0 * cPlus));
+                    pn[last] = root * root;
+                    vn[last] = valve / c.impedance * root;
+                } else {
+                    // Обратный ток через задвижку не моделируется
+                    pn[last] = cPlus;
+                    vn[last] = 0.0;
+                }
+                if (b == nodes) {
+                    updateEnvelope(pn[last], high[nodes - 1], low[nodes - 1]);
+                    history[firstStep + s] = pn[last];
+                }
+            }
+            current = 1 - current;
+        }
+
+        std::copy(buffers.p[current].constBegin() + (a - lo), buffers.p[current].constBegin() + (b - lo),
+                  pOut + a);
+        std::copy(buffers.v[current].constBegin() + (a - lo), buffers.v[current].constBegin() + (b - lo),
+                  vOut + a);
+    };
+
+    const int chunkCount = nodes / kChunkNodes;
+    if (parallelWorkerCount(chunkCount, m_threadCount) <= 1) {
+        ChunkBuffers buffers;
+        if (result.steps > 0) {
+            advanceChunk(buffers, 0, nodes, 0, result.steps);
+        }
+    } else {
+        // Каждый блок пишет только свои узлы и огибающие
+        QVector<ChunkBuffers> buffers(parallelWorkerCount(chunkCount, m_threadCount));
+        ChunkBuffers* workerBuffers = buffers.data();
+        for (int firstStep = 0; firstStep < result.steps; firstStep += kEpochSteps) {
+            const int count = qMin(kEpochSteps, result.steps - firstStep);
+            parallelForBlocks(chunkCount, m_threadCount, [&](qint64 chunk, int worker) {
+                const int a = int(qint64(nodes) * chunk / chunkCount);
+                const int b = int(qint64(nodes) * (chunk + 1) / chunkCount);
+                advanceChunk(workerBuffers[worker], a, b, firstStep, count);
+            });
+            std::swap(pIn, pOut);
+            std::swap(vIn, vOut);
+        }
+    }
+
+    // === ОГИБАЮЩИЕ И ПРОВЕРКА ===
+
+    result.maxPressure.resize(nodes);
+    result.minPressure.resize(nodes);
+    for (int i = 0; i < nodes; ++i) {
+        result.maxPressure[i] = pMax[i] / 1000000.0;
+        result.minPressure[i] = pMin[i] / 1000000.0;
+        if (i == 0 || result.maxPressure[i] > result.peakPressure) {
+            result.peakPressure = result.maxPressure[i];
+            result.peakChainage = i * result.reach;
+        }
+        if (i == 0 || result.minPressure[i] < result.lowestPressure) {
+            result.lowestPressure = result.minPressure[i];
+            result.lowestChainage = i * result.reach;
+        }
+    }
+    result.valvePressure.resize(valveHistory.size());
+    for (int k = 0; k < valveHistory.size(); ++k) {
+        result.valvePressure[k] = valveHistory[k] / 1000000.0;
+    }
+    result.surge = result.peakPressure - m_params.pressure;
+
+    // σ_кц = (y_fp * p_max * D) / (2δ) (формула 10) по огибающей вместо p + Δp
+    const DesignResistance resistance = DesignResistance::fromParameters(m_params);
+    result.hoop = m_params.pressureReliability * result.peakPressure * Di_m / (2.0 * thickness);
+    result.satisfiesHoopStress = result.hoop <= resistance.R1;
+    return result;
+}
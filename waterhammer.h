@@ -0,0 +1,115 @@
+#ifndef WATERHAMMER_H
+#define WATERHAMMER_H
+
+#include "frictionloss.h"
+#include "pipelineparameters.h"
+#include <QVector>
+
+// Точка кривой закрытия задвижки
+struct ValvePoint {
+    double time = 0.0;     // Время от начала расчета, с
+    double opening = 1.0;  // Относительное открытие τ: 1 - открыта полностью, 0 - закрыта
+};
+
+// Результат расчета переходного процесса
+struct WaterHammerResult {
+    double waveSpeed = 0.0;       // c, м/с
+    double flowSpeed = 0.0;       // ϑ установившегося потока, м/с
+    double frictionFactor = 0.0;  // λ установившегося потока
+    double reach = 0.0;           // Шаг сетки Δx, м
+    double timeStep = 0.0;        // Шаг по времени Δt = Δx/c, с
+    int steps = 0;                // Шагов по времени
+    double joukowskySurge = 0.0;  // Δp = ρcϑ (формула 3) при той же c, МПа (не Δp calculate(), см. ниже)
+
+    QVector<double> maxPressure;   // Огибающая наибольших давлений в узлах x_k = k·Δx, МПа
+    QVector<double> minPressure;   // Огибающая наименьших давлений, МПа
+    QVector<double> valvePressure; // Давление перед задвижкой на шагах 0..steps, МПа
+
+    double peakPressure = 0.0;     // Наибольшее давление на трубе, МПа
+    double peakChainage = 0.0;     // Пикет наибольшего давления, м
+    double lowestPressure = 0.0;   // Наименьшее давление на трубе, МПа
+    double lowestChainage = 0.0;   // Пикет наименьшего давления, м
+    double surge = 0.0;            // Повышение давления peakPressure - p, МПа
+
+    double hoop = 0.0;                 // σ_кц при peakPressure (формула 10), МПа
+    bool satisfiesHoopStress = false;  // σ_кц ≤ R1
+};
+
+// Гидроудар при закрытии задвижки: решение одномерных уравнений
+// неустановившегося течения методом характеристик.
+//
+// Труба длиной L разбивается на N участков Δx = L/N, шаг по времени
+// Δt = Δx/c (число Куранта 1), поэтому характеристики C+ и C- приходят точно
+// в соседние узлы и интерполяция не нужна. Потери на трение - по формуле
+// Дарси - Вейсбаха с λ установившегося потока (FrictionLossModel). В начале
+// трубы - резервуар с давлением p параметров, в конце - задвижка, за которой
+// избыточное давление 0; расход через нее пропорционален τ(t)·√p. Начальное
+// состояние - установившийся поток с массовым расходом параметров.
+// Отрицательное давление (разрыв сплошности) не моделируется - оно только
+// отмечается в огибающей наименьших давлений.
+//
+// Скорость волны - формула 4 в единицах СИ: c = √(E_0/ρ / (1 + E_0·d/(E·δ))).
+// Удар Жуковского ρcϑ с этой c - верхняя оценка для мгновенного закрытия;
+// расчет по кривой закрытия дает фактическую огибающую давлений, по которой
+// заново проверяются кольцевые напряжения.
+//
+// Внимание: calculate() и checkThickness() считают формулу 4 как
+// 1/√(ρ/E₀ + d/(E·δ)) с модулями в МПа, т.е. их c и Δp = ρcϑ примерно в 1000
+// раз меньше, чем waveSpeed и joukowskySurge здесь. Это разные величины:
+// результаты calculate() сохраняют принятую в методике запись формулы, а
+// моделирование переходного процесса требует физической скорости волны.
+// Сравнивать joukowskySurge с Δp calculate() нельзя.
+//
+// Давление и скорость в узлах хранятся отдельными массивами (SoA), шаг во
+// внутренних узлах - векторное ядро advanceCharacteristics(). Длинная труба
+// делится на блоки узлов, которые считаются параллельно эпохами по
+// нескольку шагов: блок копирует узлы с запасом по числу шагов эпохи в каждую
+// сторону и досчитывает их сам, поэтому потоки синхронизируются раз в эпоху,
+// а не на каждом шаге. Результат побитово не зависит от числа потоков.
+class WaterHammerSimulator {
+public:
+    // Проверка параметров: нечисловые значения, p ≤ 0, G ≤ 0, ρ ≤ 0, ν ≤ 0,
+    // E_0 ≤ 0, E ≤ 0 или шероховатость < 0 (мм) - std::invalid_argument
+    explicit WaterHammerSimulator(const PipelineParameters& params,
+                                  double roughness = FrictionLossModel::DefaultRoughness);
+
+    // Кривая закрытия: точки с неубывающим временем, между ними τ
+    // интерполируется линейно, до первой и после последней точки постоянно.
+    // По умолчанию - мгновенное закрытие в момент 0. Пустая кривая, τ вне
+    // [0, 1] или убывающее время - std::invalid_argument.
+    void setValveCurve(const QVector<ValvePoint>& curve);
+    const QVector<ValvePoint>& valveCurve() const { return m_valveCurve; }
+
+    // Закрытие за closureTime секунд по закону τ = (1 - t/T)^exponent
+    // (points точек; exponent = 1 - равномерное закрытие)
+    static QVector<ValvePoint> closureCurve(double closureTime, double exponent = 1.0, int points = 32);
+
+    // Число участков сетки (по умолчанию 1000, не меньше 2)
+    void setReachCount(int count);
+    int reachCount() const { return m_reachCount; }
+
+    // Продолжительность расчета, с (по умолчанию 300)
+    void setDuration(double seconds);
+    double duration() const { return m_duration; }
+
+    // Количество потоков, см. parallelForBlocks() (по умолчанию 1). Параллельно
+    // считаются только трубы длиннее двух блоков узлов.
+    void setThreadCount(int count);
+
+    // Труба с наружным диаметром outerDiameter (мм), толщиной стенки
+    // thickness (м) и длиной length (м). Недопустимые размеры или потери на
+    // трение не меньше давления p (задвижка без перепада) - std::invalid_argument.
+    WaterHammerResult run(double outerDiameter, double thickness, double length) const;
+
+private:
+    double openingAt(double time) const;
+
+    PipelineParameters m_params;
+    FrictionLossModel m_friction;
+    QVector<ValvePoint> m_valveCurve;
+    int m_reachCount;
+    double m_duration;
+    int m_threadCount;
+};
+
+#endif // WATERHAMMER_H